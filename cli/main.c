@@ -1,6 +1,319 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "modeling_rcs.h"
+#include "ffi_merge.h"
+#include "mesh_submodel.h"
+#include "ffi_restart.h"
 
-int main() {
-	printf("Hello World!\n");
+void print_usage(const char *program) {
+	printf("usage: %s <input.json> <output.ffi> [options]\n", program);
+	printf("       %s --estimate <input.json>...\n", program);
+	printf("       %s --section <input.json>...\n", program);
+	printf("       %s --submodel <box> <input.ffi> <output.ffi>\n", program);
+	printf("       %s --merge <output.ffi> <input.ffi>[@<node offset>,<element offset>]...\n", program);
+	printf("options:\n");
+	printf("  --renumber rcm        renumber nodes by Reverse Cuthill-McKee\n");
+	printf("  --node-map <file>     write new_id,original_id of nodes (CSV)\n");
+	printf("  --reorder-elements    renumber elements to reduce the assembly front\n");
+	printf("  --element-map <file>  write new_id,original_id,kind,type of elements (CSV)\n");
+	printf("  --partition <k>       partition elements into k parts (writes <output>.epart.<k>.csv)\n");
+	printf("  --partition-file <file>  write element_id,part to <file> instead\n");
+	printf("  --compress            rewrite nodes and elements as NODE/element + COPY cards\n");
+	printf("  --fit-ids             coarsen the far field until node/element numbers fit in 5 digits\n");
+	printf("  --full                mirror the half model across the beam center plane\n");
+	printf("  --quarter sym|anti    cut the half model at the column center (symmetric / antisymmetric restraints)\n");
+	printf("  --frame <b>x<s>       instance the joint b times in x (bays) and s times in z (stories)\n");
+	printf("  --submodel <region>   keep elements whose centroid is in panel, joint or x0:x1,y0:y1,z0:z1 (empty = unbounded)\n");
+	printf("  --bond-zone <zone>    keep rebar bond (LINE) elements only in joint or z0:z1; rebars share concrete nodes elsewhere\n");
+	printf("  --adaptive-steps      refine \"loading\" increments near cracking, yielding and reversals, coarsen elsewhere\n");
+	printf("  --yield-drift <R>     yield drift ratio for --adaptive-steps (default: from the column fiber section)\n");
+	printf("  --restart-segments <N> split the \"loading\" steps into N runs (<output>.run<k>.ffi, RESTART from run 2)\n");
+	printf("  --output-budget <MB>  limit \"loading\" results: reversals, zero crossings and the last step, others sparse (POST only)\n");
+	printf("  --rigid-jig           remove the steel jigs and tie their faces to the load and pin nodes (SUB1)\n");
+	printf("  --symmetry-map <file>  write kind,id,mirror_id,sign_x,sign_y,sign_z and the adjusted FN/UE (default <output>.quarter.csv)\n");
+	printf("  --estimate            print predicted node, element, dof and file size without writing\n");
+	printf("  --section             print column moment-curvature, yield/ultimate capacity and joint shear without writing\n");
+	printf("  --rebar-area <mm2>    area of one column rebar for --section and --adaptive-steps (default D13)\n");
+	printf("  --merge               combine .ffi files, shifting ids by the given or automatic (next 1000) offsets\n");
+}
+
+/**
+ * --merge: <出力> <入力>[@<節点のずれ>,<要素のずれ>]... を結合する
+ *
+ * @return 0: 成功, 1: 失敗
+ */
+int merge_files(char **file_names, int file_num) {
+	if(file_num < 2) {
+		return 1;
+	}
+	int input_num = file_num - 1;
+	FfiMergeInput *inputs = (FfiMergeInput *)malloc((size_t)input_num * sizeof(FfiMergeInput));
+	if(inputs == NULL) {
+		fprintf(stderr, "Error: Memory allocation for merge inputs failed\n");
+		return 1;
+	}
+	for(int i = 0; i < input_num; i++) {
+		char *name = file_names[i + 1];
+		inputs[i].file_name = name;
+		inputs[i].node_offset = FFI_MERGE_AUTO_OFFSET;
+		inputs[i].element_offset = FFI_MERGE_AUTO_OFFSET;
+		char *at = strrchr(name, '@');
+		if(at != NULL) {
+			*at = '\0';
+			if(sscanf(at + 1, "%d,%d", &inputs[i].node_offset, &inputs[i].element_offset) != 2
+			   || inputs[i].node_offset < 0 || inputs[i].element_offset < 0) {
+				fprintf(stderr, "Error: invalid offsets '%s' (expected <node>,<element>)\n", at + 1);
+				free(inputs);
+				return 1;
+			}
+		}
+	}
+	FfiMergeStatistics statistics;
+	int result = merge_ffi_files(file_names[0], inputs, input_num, &statistics);
+	if(result == EXIT_SUCCESS) {
+		for(int i = 0; i < input_num; i++) {
+			printf("%s: node +%d (max %d), element +%d (max %d)\n", inputs[i].file_name,
+				inputs[i].node_offset, inputs[i].max_node, inputs[i].element_offset, inputs[i].max_element);
+		}
+		printf("merged %d files, %d lines: %d definitions (%d duplicates), %d steps\n", input_num,
+			statistics.line_num, statistics.table_num, statistics.duplicate_table_num, statistics.step_num);
+	}
+	free(inputs);
+	return result != EXIT_SUCCESS;
+}
+
+/**
+ * --submodel の範囲 x0:x1,y0:y1,z0:z1 を読む。省略した値は範囲を限らない
+ *
+ * @return 0: 成功, 1: 書式の誤り
+ */
+int parse_submodel_box(const char *text, SelectBox *box) {
+	const char *p = text;
+	for(int axis = 0; axis < 3; axis++) {
+		double *bound[2] = {&box->min[axis], &box->max[axis]};
+		for(int side = 0; side < 2; side++) {
+			char *end;
+			double value = strtod(p, &end);
+			if(end != p) {
+				*bound[side] = value;
+			}
+			char separator = (side == 0) ? ':' : (axis < 2 ? ',' : '\0');
+			if(*end != separator) {
+				return 1;
+			}
+			p = end + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * ffi ファイル名(拡張子 .ffi)かどうか
+ */
+int is_ffi_file(const char *file_name) {
+	size_t length = strlen(file_name);
+	return length >= 4 && strcmp(file_name + length - 4, ".ffi") == 0;
+}
+
+/**
+ * オプションと入力、出力ファイル名を読む
+ *
+ * @param file_names ファイル名(サイズは argc 以上)
+ * @return 0: 成功, 1: 誤り, 2: --help を表示した
+ */
+int parse_arguments(int argc, char *argv[], ModelingRcsOption *option, char **file_names, int *file_num, int *merge) {
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--renumber") == 0 && i + 1 < argc) {
+			i++;
+			if(strcmp(argv[i], "rcm") == 0) {
+				option->node_order = NODE_ORDER_RCM;
+			} else if(strcmp(argv[i], "none") == 0) {
+				option->node_order = NODE_ORDER_DEFAULT;
+			} else {
+				fprintf(stderr, "Error: unknown renumber method '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--node-map") == 0 && i + 1 < argc) {
+			option->node_map_file_name = argv[++i];
+		} else if(strcmp(argv[i], "--reorder-elements") == 0) {
+			option->element_order = ELEMENT_ORDER_FRONT;
+		} else if(strcmp(argv[i], "--element-map") == 0 && i + 1 < argc) {
+			option->element_map_file_name = argv[++i];
+		} else if(strcmp(argv[i], "--partition") == 0 && i + 1 < argc) {
+			option->partition_num = atoi(argv[++i]);
+			if(option->partition_num < 1) {
+				fprintf(stderr, "Error: invalid number of parts '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--partition-file") == 0 && i + 1 < argc) {
+			option->partition_file_name = argv[++i];
+		} else if(strcmp(argv[i], "--compress") == 0) {
+			option->compress = 1;
+		} else if(strcmp(argv[i], "--fit-ids") == 0) {
+			option->fit_id_budget = 1;
+		} else if(strcmp(argv[i], "--full") == 0) {
+			option->scope = MODEL_SCOPE_FULL;
+		} else if(strcmp(argv[i], "--quarter") == 0 && i + 1 < argc) {
+			i++;
+			if(strcmp(argv[i], "sym") == 0) {
+				option->scope = MODEL_SCOPE_QUARTER;
+			} else if(strcmp(argv[i], "anti") == 0) {
+				option->scope = MODEL_SCOPE_QUARTER_ANTISYMMETRIC;
+			} else {
+				fprintf(stderr, "Error: unknown symmetry '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--frame") == 0 && i + 1 < argc) {
+			i++;
+			if(sscanf(argv[i], "%dx%d", &option->frame_bay_num, &option->frame_story_num) != 2
+			   || option->frame_bay_num < 1 || option->frame_story_num < 1) {
+				fprintf(stderr, "Error: invalid frame size '%s' (expected <bays>x<stories>)\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--submodel") == 0 && i + 1 < argc) {
+			i++;
+			if(strcmp(argv[i], "panel") == 0) {
+				option->submodel = SUBMODEL_PANEL;
+			} else if(strcmp(argv[i], "joint") == 0) {
+				option->submodel = SUBMODEL_JOINT;
+			} else if(parse_submodel_box(argv[i], &option->submodel_box) == 0) {
+				option->submodel = SUBMODEL_BOX;
+			} else {
+				fprintf(stderr, "Error: invalid submodel region '%s' (expected panel, joint or x0:x1,y0:y1,z0:z1)\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--bond-zone") == 0 && i + 1 < argc) {
+			i++;
+			if(strcmp(argv[i], "joint") == 0) {
+				option->bond_zone = BOND_ZONE_JOINT;
+			} else if(sscanf(argv[i], "%lf:%lf", &option->bond_zone_min, &option->bond_zone_max) == 2
+			          && option->bond_zone_min < option->bond_zone_max) {
+				option->bond_zone = BOND_ZONE_RANGE;
+			} else {
+				fprintf(stderr, "Error: invalid bond zone '%s' (expected joint or z0:z1)\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--adaptive-steps") == 0) {
+			option->adaptive_steps = 1;
+		} else if(strcmp(argv[i], "--yield-drift") == 0 && i + 1 < argc) {
+			option->yield_drift = atof(argv[++i]);
+			option->adaptive_steps = 1;
+			if(option->yield_drift <= 0.0) {
+				fprintf(stderr, "Error: invalid yield drift '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--restart-segments") == 0 && i + 1 < argc) {
+			option->restart_run_num = atoi(argv[++i]);
+			if(option->restart_run_num < 2 || option->restart_run_num > FFI_RESTART_RUN_MAX) {
+				fprintf(stderr, "Error: invalid number of restart segments '%s' (2 - %d)\n", argv[i], FFI_RESTART_RUN_MAX);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--output-budget") == 0 && i + 1 < argc) {
+			option->output_budget = atof(argv[++i]);
+			if(option->output_budget <= 0.0) {
+				fprintf(stderr, "Error: invalid output budget '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--rigid-jig") == 0) {
+			option->rigid_jig = 1;
+		} else if(strcmp(argv[i], "--symmetry-map") == 0 && i + 1 < argc) {
+			option->symmetry_map_file_name = argv[++i];
+		} else if(strcmp(argv[i], "--estimate") == 0) {
+			option->estimate = 1;
+		} else if(strcmp(argv[i], "--section") == 0) {
+			option->section = 1;
+		} else if(strcmp(argv[i], "--rebar-area") == 0 && i + 1 < argc) {
+			option->rebar_area = atof(argv[++i]);
+			if(option->rebar_area <= 0.0) {
+				fprintf(stderr, "Error: invalid rebar area '%s'\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(argv[i], "--merge") == 0) {
+			*merge = 1;
+		} else if(strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+			print_usage(argv[0]);
+			return 2;
+		} else if(argv[i][0] == '-') {
+			fprintf(stderr, "Error: unknown option '%s'\n", argv[i]);
+			print_usage(argv[0]);
+			return 1;
+		} else {
+			file_names[(*file_num)++] = argv[i];
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	const char *input_file = NULL;
+	const char *output_file = NULL;
+	int file_num = 0;
+	int merge = 0;
+	ModelingRcsOption option;
+	initialize_modeling_rcs_option(&option);
+
+	// 入力、出力ファイル名(--estimate、--section の場合は全て入力ファイル名)
+	char **file_names = (char **)malloc((size_t)argc * sizeof(char *));
+	if(file_names == NULL) {
+		fprintf(stderr, "Error: Memory allocation for file names failed\n");
+		return 1;
+	}
+
+	int parsed = parse_arguments(argc, argv, &option, file_names, &file_num, &merge);
+	if(parsed != 0) {
+		free(file_names);
+		return parsed == 1;
+	}
+
+	// 規模の予測、断面の検討: 入力ファイルごとに表示する
+	if(option.estimate || option.section) {
+		int failed = file_num == 0;
+		if(failed) {
+			print_usage(argv[0]);
+		}
+		for(int i = 0; i < file_num; i++) {
+			if(modeling_rcs_with_option(file_names[i], NULL, &option) != MODELING_RCS_SUCCESS) {
+				failed = 1;
+			}
+		}
+		free(file_names);
+		return failed;
+	}
+
+	// ffi ファイルの結合: 最初のファイル名が出力
+	if(merge) {
+		if(file_num < 2) {
+			print_usage(argv[0]);
+		}
+		int failed = merge_files(file_names, file_num);
+		free(file_names);
+		return failed;
+	}
+
+	if(file_num == 2) {
+		input_file = file_names[0];
+		output_file = file_names[1];
+	}
+	free(file_names);
+
+	if(input_file == NULL || output_file == NULL) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	// 既存の ffi からの部分モデルの切り出し(境界点の名前は使えない)
+	if(option.submodel != SUBMODEL_NONE && is_ffi_file(input_file)) {
+		if(option.submodel != SUBMODEL_BOX) {
+			fprintf(stderr, "Error: panel and joint need the input .json; give x0:x1,y0:y1,z0:z1 for an .ffi\n");
+			return 1;
+		}
+		return extract_submodel_file(input_file, output_file, &option.submodel_box,
+			option.node_map_file_name, option.element_map_file_name) != EXIT_SUCCESS;
+	}
+
+	if(modeling_rcs_with_option(input_file, output_file, &option) != MODELING_RCS_SUCCESS) {
+		return 1;
+	}
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,29 @@
+#ifndef AUTO_MESH_H
+#define AUTO_MESH_H
+
+#include "json_parser.h"
+
+// 内側の節点の座標の丸め単位(COPYカードの DX=%.2f で誤差が積み重ならない寸法にする)
+#define AUTO_MESH_RESOLUTION 0.5
+
+// 同じ格子線とみなす座標の差
+#define AUTO_MESH_TOLERANCE 1e-6
+
+/**
+ * AutoMeshGrading構造体
+ *
+ * 1つの軸の要素寸法の分布。joint_low ... joint_high は寸法 size で等分し、
+ * その外側は離れるほど h = size + (growth - 1) * 距離 (公比 growth の等比数列) で大きくし、max_size で頭打ちにする。
+ */
+typedef struct {
+    double joint_low;
+    double joint_high;
+    double size;
+    double growth;
+    double max_size;
+} AutoMeshGrading;
+
+int auto_mesh_axis(const double breakpoint[], int breakpoint_num, const AutoMeshGrading* grading, int jig, Mesh* mesh);
+int generate_auto_mesh(JsonData* data);
+
+#endif
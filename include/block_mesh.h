@@ -0,0 +1,66 @@
+#ifndef BLOCK_MESH_H
+#define BLOCK_MESH_H
+
+#include <stdio.h>
+#include "mesh_model.h"
+
+/**
+ * MeshBlock構造体
+ *
+ * 軸の格子線 low[axis] ... high[axis] (low < high) で囲まれた六面体要素のブロック。
+ * 要素は格子線の間 low[axis] ... high[axis] - 1 に並ぶ。
+ */
+typedef struct {
+    int low[3];
+    int high[3];
+    int type;     // TYPH
+} MeshBlock;
+
+/**
+ * BlockMesh構造体
+ *
+ * 軸ごとの格子線の座標の上にブロックを並べた試験体の記述。
+ * 隣り合うブロックの境界面の節点は共有する。split[axis][g] = 1 の格子面 g は二重にし、
+ * low[axis] = g のブロックは別の節点番号を使う(接合部の柱の上下のように節点を分ける場合)。
+ *
+ * 番号は origin の格子点(格子線の間)を先頭に
+ *   節点: node_head + Σ (n(g[axis]) - n(origin[axis])) * node_increment[axis]
+ *         n(g) は g の手前の二重の格子面の数だけ g をずらしたもの
+ *   要素: element_head + Σ (c[axis] - origin[axis]) * element_increment[axis]
+ *
+ * メンバ:
+ * - axis_num, axis: 軸ごとの格子線の数と座標(昇順)
+ * - split: 軸ごとの二重の格子面。サイズは axis_num[axis]
+ * - origin, node_head, element_head, node_increment, element_increment: 番号の付け方
+ * - block_num, block: ブロック
+ */
+typedef struct {
+    int axis_num[3];
+    double* axis[3];
+    unsigned char* split[3];
+    int origin[3];
+    int node_head;
+    int element_head;
+    int node_increment[3];
+    int element_increment[3];
+    int block_num;
+    int block_capacity;
+    MeshBlock* block;
+} BlockMesh;
+
+BlockMesh* create_block_mesh(double* const axis[3], const int axis_num[3]);
+int free_block_mesh(BlockMesh* mesh);
+
+int add_mesh_block(BlockMesh* mesh, const int low[3], const int high[3], int type);
+int split_block_plane(BlockMesh* mesh, int axis, int grid_index);
+int set_block_numbering(BlockMesh* mesh, const int origin[3], int node_head, int element_head,
+                        const int node_increment[3], const int element_increment[3]);
+int derive_block_numbering(BlockMesh* mesh, int node_head, int element_head);
+
+int block_node_number(const BlockMesh* mesh, int b, const int grid[3]);
+int block_element_number(const BlockMesh* mesh, const int cell[3]);
+
+int build_block_mesh_model(const BlockMesh* mesh, MeshModel* model);
+int print_block_mesh(FILE* f, const BlockMesh* mesh);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef FFI_MERGE_H
+#define FFI_MERGE_H
+
+// 1行の最大の長さ
+#define FFI_MERGE_LINE_MAX 512
+// 番号のずれを前のファイルの最大の番号から決める
+#define FFI_MERGE_AUTO_OFFSET -1
+
+/**
+ * FfiMergeInput構造体
+ *
+ * 結合する ffi ファイル1つ分。
+ *
+ * メンバ:
+ * - file_name: ファイル名
+ * - node_offset, element_offset: 節点、要素番号のずれ。FFI_MERGE_AUTO_OFFSET の場合は
+ *   それまでのファイルの最大の番号を 1000 単位に切り上げた値(merge_ffi_files で決めた値に置き換える)
+ * - max_node, max_element: ずらした後の最大の番号(COPY で作る番号を含む)
+ * - min_node, min_element: ずらした後の最小の番号。他のファイルの範囲と重なる場合は結合をエラーにする
+ */
+typedef struct {
+    const char* file_name;
+    int node_offset;
+    int element_offset;
+    int max_node;
+    int max_element;
+    int min_node;
+    int min_element;
+} FfiMergeInput;
+
+/**
+ * FfiMergeStatistics構造体
+ *
+ * メンバ:
+ * - line_num: 読み込んだ行
+ * - table_num: 書き込んだ TYP*、MAT*、AXIS の定義
+ * - duplicate_table_num: 同じ定義のため1つにまとめたもの
+ * - step_num: STEP の数
+ * - max_node, max_element: 結合したモデルの最大の番号
+ */
+typedef struct {
+    int line_num;
+    int table_num;
+    int duplicate_table_num;
+    int step_num;
+    int max_node;
+    int max_element;
+} FfiMergeStatistics;
+
+int merge_ffi_files(const char* output_file_name, FfiMergeInput inputs[], int file_num, FfiMergeStatistics* statistics);
+
+#endif
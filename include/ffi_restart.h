@@ -0,0 +1,14 @@
+#ifndef FFI_RESTART_H
+#define FFI_RESTART_H
+
+// 1行の最大の長さ
+#define FFI_RESTART_LINE_MAX 512
+// 分ける解析の回数の上限
+#define FFI_RESTART_RUN_MAX 99
+// ファイル名の最大の長さ
+#define FFI_RESTART_NAME_MAX 1024
+
+int restart_file_name(const char* file_name, int run, char* buffer, int size);
+int write_restart_runs(const char* file_name, const int restart_step[], int run_num);
+
+#endif
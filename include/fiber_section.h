@@ -0,0 +1,126 @@
+#ifndef FIBER_SECTION_H
+#define FIBER_SECTION_H
+
+#include "json_parser.h"
+
+// 柱のせい方向のコンクリートの層の数
+#define FIBER_CONCRETE_LAYER_NUM 64
+// M-φ の点の数(軸力だけの状態から終局まで)
+#define FIBER_CURVATURE_NUM 100
+// 中立軸を求める反復の上限と、軸力の釣り合いの許容誤差(軸力に対する比)
+#define FIBER_SOLVE_ITERATION_MAX 48
+#define FIBER_SOLVE_TOLERANCE 1.0e-9
+
+// コンクリート(圧縮を正。引張は無視する)。最大の応力のひずみ、終局のひずみと、終局での応力の低下の割合
+#define FIBER_CONCRETE_PEAK_STRAIN 0.002
+#define FIBER_CONCRETE_ULTIMATE_STRAIN 0.004
+#define FIBER_CONCRETE_SOFTENING 0.15
+
+// 主筋の断面積の既定値(D13)。主筋の材料は print_MATS の値(ES=2(E+5)、SY=300、HR=0.01)
+#define FIBER_REBAR_AREA 126.7
+#define FIBER_STEEL_MODULUS 2.0e5
+#define FIBER_STEEL_YIELD 300.0
+#define FIBER_STEEL_HARDENING 0.01
+// 柱の軸応力の既定値(print_axial_force_step の UE)
+#define FIBER_AXIAL_STRESS 10.0
+
+/**
+ * SectionMaterial構造体
+ *
+ * JSON に無い断面の条件。initialize_section_material() で既定値にする。
+ *
+ * メンバ:
+ * - rebar_area: 主筋1本の断面積
+ * - steel_modulus, steel_yield, steel_hardening: 主筋のヤング係数、降伏強度、降伏後の剛性の比
+ * - axial_stress: 柱の軸応力(圧縮を正。柱の断面積を掛けて軸力にする)
+ */
+typedef struct {
+    double rebar_area;
+    double steel_modulus;
+    double steel_yield;
+    double steel_hardening;
+    double axial_stress;
+} SectionMaterial;
+
+/**
+ * FiberSection構造体
+ *
+ * 柱の断面をせい(x)方向の層に分けたファイバー。位置は断面の中心から x 方向に測る。
+ * 配列はSoA形式で、長さは SIMD_WIDTH の倍数に切り上げ、余りは面積 0 にする(simd.h)。
+ *
+ * メンバ:
+ * - width, depth, compressive_strength: 柱の幅、せい、コンクリートの圧縮強度
+ * - concrete_num, concrete_x, concrete_area: コンクリートの層(切り上げた長さ)
+ * - steel_num, steel_x, steel_area: 主筋(ハーフモデルの位置を梁芯で鏡映した全断面の主筋)
+ * - rebar_num: 主筋の本数
+ * - axial_force: 軸力(圧縮を正)
+ */
+typedef struct {
+    double width;
+    double depth;
+    double compressive_strength;
+    int concrete_num;
+    double* concrete_x;
+    double* concrete_area;
+    int steel_num;
+    double* steel_x;
+    double* steel_area;
+    int rebar_num;
+    double axial_force;
+    SectionMaterial material;
+} FiberSection;
+
+/**
+ * MomentCurvature構造体
+ *
+ * 圧縮縁のひずみを軸力だけの状態から終局のひずみまで増やした M-φ の関係。
+ *
+ * メンバ:
+ * - curvature, moment: M-φ の点(point_num 個。最初は軸力だけの状態で 0)
+ * - yield_curvature, yield_moment: 引張側の主筋が初めて降伏する点(降伏しない場合は 0)
+ * - ultimate_curvature, ultimate_moment: 圧縮縁が終局のひずみに達する点
+ * - max_moment: 最大の曲げモーメント
+ */
+typedef struct {
+    int point_num;
+    double curvature[FIBER_CURVATURE_NUM + 1];
+    double moment[FIBER_CURVATURE_NUM + 1];
+    double yield_curvature;
+    double yield_moment;
+    double ultimate_curvature;
+    double ultimate_moment;
+    double max_moment;
+} MomentCurvature;
+
+/**
+ * SectionScreening構造体
+ *
+ * 柱の曲げと接合部のせん断から求めた、柱端の載荷点の水平力(柱のせん断力)の目安。
+ *
+ * メンバ:
+ * - column: 柱の M-φ
+ * - column_yield_shear, column_ultimate_shear: 柱が接合部の面で降伏、最大の曲げモーメントに達するときの柱のせん断力
+ * - joint_shear_strength: 接合部パネルのせん断強度(コンクリートのみ。0.8 fc^0.7 x 柱の幅 x せい)
+ * - joint_column_shear: 接合部パネルがせん断強度に達するときの柱のせん断力
+ * - yield_drift: 柱の降伏曲率から求めた降伏の部材角(estimate_yield_drift と同じ片持ち柱)
+ * - joint_governs: 1の場合は接合部のせん断で決まる
+ */
+typedef struct {
+    MomentCurvature column;
+    double column_yield_shear;
+    double column_ultimate_shear;
+    double joint_shear_strength;
+    double joint_column_shear;
+    double yield_drift;
+    int joint_governs;
+} SectionScreening;
+
+void initialize_section_material(SectionMaterial* material);
+FiberSection* create_fiber_section(const JsonData* data, const SectionMaterial* material);
+int free_fiber_section(FiberSection* section);
+void section_force(const FiberSection* section, double top_strain, double curvature, double* axial, double* moment);
+int analyze_moment_curvature(const FiberSection* section, MomentCurvature* result);
+int screen_section(const JsonData* data, const SectionMaterial* material, SectionScreening* screening);
+void print_section_screening(const SectionScreening* screening, double elapsed_us);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef FRAME_ASSEMBLY_H
+#define FRAME_ASSEMBLY_H
+
+#include "mesh_model.h"
+
+/**
+ * FrameLayout構造体
+ *
+ * 1つの接合部のモデルを x 方向に bay_num 個、z 方向に story_num 個並べる架構の配置。
+ * 接合部 (i, k) (i = 0 ... bay_num - 1, k = 0 ... story_num - 1) の節点、要素番号は
+ * 元の番号 + (k * bay_num + i) * offset、座標は (i * pitch[0], 0, k * pitch[1]) ずらす。
+ *
+ * メンバ:
+ * - bay_num, story_num: x (スパン)、z (層) 方向の数
+ * - pitch: 並べる間隔(x: 梁の全長、z: 柱の全長)
+ * - node_offset, element_offset: 接合部1つ当りの番号のずれ(最大の番号を 1000 単位に切り上げたもの)
+ * - stitch_num: 隣り合う接合部の梁端、柱端で同じ位置にある節点の組(SUB1 で結ぶ)
+ * - unmatched_num: 反対側の端に同じ位置の節点が無い端部の節点
+ */
+typedef struct {
+    int bay_num;
+    int story_num;
+    double pitch[2];
+    int node_offset;
+    int element_offset;
+    int stitch_num;
+    int unmatched_num;
+} FrameLayout;
+
+int plan_frame_layout(const MeshModel* joint, int bay_num, int story_num, FrameLayout* layout);
+int assemble_frame(MeshModel* joint, FrameLayout* layout, int interface_rc);
+
+#endif
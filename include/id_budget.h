@@ -0,0 +1,46 @@
+#ifndef ID_BUDGET_H
+#define ID_BUDGET_H
+
+#include "json_parser.h"
+#include "modeling_data.h"
+
+// FINALの節点、要素番号の桁数(%5d)と上限
+#define ID_BUDGET_DIGITS 5
+#define ID_BUDGET_MAX 99999
+
+// 部位の数(柱、主筋、主筋付着、接合部鋼板、接合部フィルム、梁)
+#define ID_BUDGET_PART_NUM 6
+
+/**
+ * IdBudgetPart構造体
+ *
+ * make_modeling_data が部位に割り当てた番号の範囲 head ... head + occupied - 1。
+ * 節点を持たない部位(LINE、FILM)は occupied.node = 0。
+ */
+typedef struct {
+    const char* name;
+    NodeElement head;
+    NodeElement occupied;
+} IdBudgetPart;
+
+/**
+ * IdBudget構造体
+ *
+ * ffiを書き込む前に、割り当てた番号の最大値が ID_BUDGET_MAX に収まるかを確認するための表。
+ *
+ * メンバ:
+ * - part: 部位ごとの番号の範囲
+ * - max: 割り当てた番号の最大値(節点、要素)
+ */
+typedef struct {
+    IdBudgetPart part[ID_BUDGET_PART_NUM];
+    NodeElement max;
+} IdBudget;
+
+int plan_id_budget(const ModelingData* modeling_data, IdBudget* budget);
+int id_budget_fits(const IdBudget* budget);
+void print_id_budget(const IdBudget* budget);
+int compact_id_gaps(ModelingData* modeling_data);
+int coarsen_far_field(JsonData* source_data, const ModelingData* modeling_data);
+
+#endif
@@ -39,6 +39,33 @@ typedef struct {
     double* lengths;   // 動的配列 (length, length_y, length_z に対応)
 } Mesh;
 
+// 自動メッシュ分割の既定値
+#define AUTO_MESH_DEFAULT_GROWTH 1.3
+#define AUTO_MESH_DEFAULT_MAX_ASPECT 4.0
+
+// 自動メッシュ分割の条件 ("auto_mesh" があれば mesh_x, mesh_y, mesh_z は不要)
+typedef struct {
+	int enabled;          // "auto_mesh" が指定されたか
+	double element_size;  // 接合部の目標要素寸法
+	double growth;        // 隣り合う要素の寸法比の上限
+	double max_aspect;    // 要素の縦横比の上限
+	double jig_x;         // 梁端の治具の長さ
+	double jig_z;         // 柱端の治具の長さ
+} AutoMesh;
+
+// 繰り返し載荷の1段分 ("loading" の配列の要素)
+typedef struct {
+	double drift;  // 部材角(柱端の間の相対変位 / 柱端の間の距離)
+	int cycles;    // 正負の繰り返し数
+	int steps;     // 0 から最大の変位までのステップ数
+} LoadingLevel;
+
+// 繰り返し載荷 ("loading" が無い場合は level_num = 0 で単調載荷)
+typedef struct {
+	int level_num;
+	LoadingLevel *levels;
+} Loading;
+
 // JsonData構造体の定義
 typedef struct {
 	Column column;
@@ -47,6 +74,8 @@ typedef struct {
 	Mesh mesh_x;
 	Mesh mesh_y;
 	Mesh mesh_z;
+	AutoMesh auto_mesh;
+	Loading loading;
 } JsonData;
 
 typedef enum {
@@ -0,0 +1,65 @@
+#ifndef LOADING_PROTOCOL_H
+#define LOADING_PROTOCOL_H
+
+#include <stdio.h>
+#include "json_parser.h"
+
+// ステップ番号の上限(STEP、EXEC の5桁)
+#define LOADING_STEP_MAX 99999
+// FN の DISP の単位(小数点以下2桁)。変位は 1/LOADING_DISP_SCALE mm の整数で扱う
+#define LOADING_DISP_SCALE 100
+
+// 降伏変位の推定に使う主筋の降伏ひずみ(SD345)
+#define LOADING_YIELD_STRAIN 0.0019
+// ひび割れの部材角 / 降伏の部材角の目安
+#define LOADING_CRACK_RATIO 0.15
+// 0 から降伏変位までの細かいステップの数(細かい増分 = 降伏変位 / この値)
+#define LOADING_STEPS_TO_YIELD 10
+// 反転の直後に細かい増分で進むステップの数
+#define LOADING_REVERSAL_STEPS 3
+
+/**
+ * LoadingSegment構造体
+ *
+ * 同じ変位増分が続くステップの区間。STEP カード1枚分。
+ *
+ * メンバ:
+ * - step_num: ステップ数
+ * - increment: 1ステップ当りの柱上端の変位増分(1/LOADING_DISP_SCALE mm)。柱下端は符号を逆にする
+ */
+typedef struct {
+    int step_num;
+    int increment;
+} LoadingSegment;
+
+/**
+ * LoadingProtocol構造体
+ *
+ * 繰り返し載荷の変位履歴。0 -> +δ1 -> -δ1 -> ... -> +δn -> -δn -> 0 の各区間を、
+ * 変位増分が一定のステップの区間(高々2つ)に分けて持つ。最大の変位は丸めた値にちょうど一致する。
+ *
+ * メンバ:
+ * - segment: 区間(記載順)。隣り合う区間の増分は異なる(plan_restart_steps で再開点に分けた区間を除く)
+ * - first_step, last_step: 最初、最後のステップ番号
+ * - peak_num: 正負の最大の変位の数
+ */
+typedef struct {
+    int segment_num;
+    int segment_capacity;
+    LoadingSegment* segment;
+    int first_step;
+    int last_step;
+    int peak_num;
+} LoadingProtocol;
+
+LoadingProtocol* create_loading_protocol();
+int free_loading_protocol(LoadingProtocol* protocol);
+int build_loading_protocol(const LoadingLevel levels[], int level_num, double height, int first_step, LoadingProtocol* protocol);
+double estimate_yield_drift(double depth, double height);
+int build_adaptive_loading_protocol(const LoadingLevel levels[], int level_num, double height, double yield_drift,
+                                    int first_step, LoadingProtocol* protocol);
+int plan_restart_steps(LoadingProtocol* protocol, int run_num, int restart_step[]);
+struct OutputPlan;
+int print_loading_protocol(FILE* f, const LoadingProtocol* protocol, const int load_nodes[], const struct OutputPlan* output);
+
+#endif
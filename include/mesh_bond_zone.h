@@ -0,0 +1,27 @@
+#ifndef MESH_BOND_ZONE_H
+#define MESH_BOND_ZONE_H
+
+#include "mesh_model.h"
+
+/**
+ * BondZoneStatistics構造体
+ *
+ * restrict_bond_zone で削除、共有したものの数。
+ *
+ * メンバ:
+ * - line_num: 残した付着要素(LINE)
+ * - removed_line_num: 付着区間の外で削除した LINE
+ * - merged_node_num: コンクリートの節点と共有した主筋の節点(削除した節点)
+ * - remapped_card_num: 共有した節点を参照していた REST、SUB1、FN(番号をコンクリートの節点に替えた)
+ */
+typedef struct {
+    int line_num;
+    int removed_line_num;
+    int merged_node_num;
+    int remapped_card_num;
+} BondZoneStatistics;
+
+int restrict_bond_zone(MeshModel* model, double z_min, double z_max, BondZoneStatistics* statistics);
+void print_bond_zone_statistics(const BondZoneStatistics* statistics);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef MESH_COPY_H
+#define MESH_COPY_H
+
+#include <stdio.h>
+#include "mesh_model.h"
+
+// 複写の次元の最大数(行、面、ブロック)
+#define MESH_COPY_DIM_MAX 3
+
+// 複写を探す候補の数(番号順に近いもの)
+#define MESH_COPY_CANDIDATE_NUM 8
+
+// カードの種類
+typedef enum {
+    COPY_CARD_NODE = 0,          // NODE
+    COPY_CARD_ELEMENT = 1,       // HEXA、QUAD、FILM、LINE、BEAM
+    COPY_CARD_COPY_NODE = 2,     // COPY :NODE
+    COPY_CARD_COPY_ELEMENT = 3,  // COPY :ELM
+    COPY_CARD_ETYP = 4           // ETYP
+} CopyCardKind;
+
+/**
+ * CopyCard構造体
+ *
+ * NODE、要素のカードは start が節点番号、要素番号で、座標、節点はMeshModelから書き込む。
+ * 要素のカードのタイプは type で、複写した要素のうち type と異なるものは ETYP (S-E-I, INC-SET, type) で変更する。
+ * COPYカードは S-E-I = start-end-interval (1つだけの場合は end = interval = 0) を
+ * 番号は k*increment、座標は k*distance (axis方向)、節点番号は k*node_increment ずらして
+ * k = 1 ... set まで複写する。
+ */
+typedef struct {
+    CopyCardKind kind;
+    int start;
+    int end;
+    int interval;
+    int increment;
+    int node_increment;
+    int axis;
+    double distance;
+    int set;
+    int type;
+} CopyCard;
+
+/**
+ * CopyCardList構造体
+ */
+typedef struct {
+    int card_num;
+    int card_capacity;
+    CopyCard* card;
+} CopyCardList;
+
+CopyCardList* create_copy_card_list();
+int free_copy_card_list(CopyCardList* list);
+
+int synthesize_node_cards(const MeshModel* model, CopyCardList* list);
+int synthesize_element_cards(const MeshModel* model, CopyCardList* list);
+int verify_copy_cards(const MeshModel* model, const CopyCardList* node_cards, const CopyCardList* element_cards);
+void print_copy_cards(FILE* f, const MeshModel* model, const CopyCardList* list);
+
+#endif
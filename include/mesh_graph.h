@@ -0,0 +1,36 @@
+#ifndef MESH_GRAPH_H
+#define MESH_GRAPH_H
+
+#include <stdint.h>
+#include "mesh_model.h"
+
+/**
+ * CsrGraph構造体
+ *
+ * 隣接関係をCSR形式(offset + index)で格納する。
+ * 行 r の隣接先は index[offset[r]] ... index[offset[r + 1] - 1] で、昇順に並ぶ。
+ * 行番号、隣接先はMeshModelの配列番号(節点番号、要素番号ではない)。
+ *
+ * メンバ:
+ * - row_num: 行数
+ * - column_num: 隣接先の数(節点 -> 要素の場合は要素数)
+ * - offset: 各行の先頭位置。サイズは row_num + 1。
+ * - index: 隣接先。サイズは offset[row_num]。
+ */
+typedef struct {
+    int row_num;
+    int column_num;
+    uint32_t* offset;
+    uint32_t* index;
+} CsrGraph;
+
+CsrGraph* allocate_csr_graph(int row_num, int column_num, uint32_t nnz);
+int free_csr_graph(CsrGraph* graph);
+
+CsrGraph* build_node_element_graph(const MeshModel* model);
+CsrGraph* build_element_graph(const MeshModel* model, const CsrGraph* node_element, int min_shared_nodes);
+CsrGraph* build_node_graph(const MeshModel* model, const CsrGraph* node_element);
+
+void print_csr_graph(const char* name, const CsrGraph* graph, int max_rows);
+
+#endif
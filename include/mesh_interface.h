@@ -0,0 +1,56 @@
+#ifndef MESH_INTERFACE_H
+#define MESH_INTERFACE_H
+
+#include <stdio.h>
+#include "mesh_model.h"
+#include "mesh_graph.h"
+#include "mesh_select.h"
+
+// 1節点当りのハッシュの区画数の目安
+#define MESH_INTERFACE_HASH_LOAD 2
+
+// 同じ座標にある節点の最大数(二重の境界面の交わりを含む)
+#define MESH_INTERFACE_COINCIDENT_MAX 8
+
+/**
+ * CoincidentHash構造体
+ *
+ * 節点を座標(0.01単位に丸めたもの)のハッシュで区画に分け、同じ座標の節点を探す。
+ * 区画 b の節点は item[bucket_start[b]] ... item[bucket_start[b + 1] - 1] (MeshModelの配列番号)。
+ */
+typedef struct {
+    int bucket_num;
+    int* bucket_start;
+    int* item;
+} CoincidentHash;
+
+/**
+ * MeshInterface構造体
+ *
+ * 部品の境界面で、同じ座標にある節点の組から作る要素(FILM、LINE)の生成に使う情報。
+ *
+ * メンバ:
+ * - model: 生成元のメッシュ
+ * - hash: 同じ座標の節点の検索
+ * - node_element: 節点 -> 要素の隣接関係(境界面の相手の要素を探す)
+ */
+typedef struct {
+    const MeshModel* model;
+    CoincidentHash* hash;
+    CsrGraph* node_element;
+} MeshInterface;
+
+CoincidentHash* build_coincident_hash(const MeshModel* model);
+int free_coincident_hash(CoincidentHash* hash);
+int find_coincident_nodes(const CoincidentHash* hash, const MeshModel* model, int n, int coincident[], int max);
+
+MeshInterface* create_mesh_interface(const MeshModel* model);
+int free_mesh_interface(MeshInterface* mesh_interface);
+
+int generate_interface_films(const MeshInterface* mesh_interface, const MeshSelection* faces, const MeshSelection* solids,
+                             int typf, int* film_id, MeshModel* out);
+int generate_bond_lines(const MeshInterface* mesh_interface, const MeshSelection* bars, const MeshSelection* solids,
+                        int offset, MeshModel* out);
+int print_interface_elements(FILE* f, const MeshModel* out);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef MESH_MIRROR_H
+#define MESH_MIRROR_H
+
+#include "mesh_model.h"
+
+// 対称面上にあるとみなす座標の差
+#define MESH_MIRROR_TOLERANCE 1e-6
+
+/**
+ * MirrorStatistics構造体
+ *
+ * mirror_mesh_model で追加、変更したものの数。
+ *
+ * メンバ:
+ * - plane_node_num: 対称面上の節点(鏡像と共有する)
+ * - node_num, element_num: 追加した節点、要素
+ * - plane_element_num: 全ての節点が対称面上にあり、複製しなかった要素
+ * - released_restraint_num: 対称面の法線方向の拘束を外した節点
+ * - anchor_node: 法線方向の拘束を残した対称面上の節点(拘束が無かった場合は 0)
+ * - node_offset, element_offset: 鏡像の番号 = 元の番号 + offset。0 の場合は5桁に収まらないため最大の番号の後に詰めた
+ */
+typedef struct {
+    int plane_node_num;
+    int node_num;
+    int element_num;
+    int plane_element_num;
+    int released_restraint_num;
+    int anchor_node;
+    int node_offset;
+    int element_offset;
+} MirrorStatistics;
+
+// 対称面で切断したモデルの境界条件
+typedef enum {
+    SYMMETRY_SYMMETRIC = 0,     // 対称: 法線方向の変位を拘束する
+    SYMMETRY_ANTISYMMETRIC = 1  // 逆対称: 面内の2方向の変位を拘束する
+} SymmetryKind;
+
+/**
+ * SymmetryCutStatistics構造体
+ *
+ * cut_mesh_model で削除、追加したものの数。
+ *
+ * メンバ:
+ * - removed_node_num, removed_element_num: 対称面の反対側にあり削除した節点、要素
+ * - plane_node_num: 対称面の拘束を付けた節点
+ * - unmatched_node_num, unmatched_element_num: 鏡像が見つからなかった節点、要素(対応表は 0)
+ * - conflict_num: 対称面の拘束と重なるため削除した SUB1 と値が 0 の FN
+ * - adjusted_load_num: 切断の種類と対称性が異なるため値を変えた、除いた FN、UE(adjusted_load の数)
+ * - removed_load_num: adjusted_load_num のうち除いたもの
+ */
+typedef struct {
+    int removed_node_num;
+    int removed_element_num;
+    int plane_node_num;
+    int unmatched_node_num;
+    int unmatched_element_num;
+    int conflict_num;
+    int adjusted_load_num;
+    int removed_load_num;
+} SymmetryCutStatistics;
+
+/**
+ * SymmetryLoad構造体
+ *
+ * cut_mesh_model で値を変えた、除いた FN、UE 1つ分(対称性が異なる成分は片側のモデルでは表せない)。
+ *
+ * メンバ:
+ * - step: STEP の UP TO NO.
+ * - kind, id, dir: カードの種類、節点または要素の番号、方向
+ * - mirror_id: 鏡像の節点、要素の番号(対称面上は自身、削除した側のカードは 0)
+ * - value: 元の値
+ * - used: 1/4モデルで使う値(0 は除いた)
+ */
+typedef struct {
+    int step;
+    StepCardKind kind;
+    int id;
+    int mirror_id;
+    int dir;
+    double value;
+    double used;
+} SymmetryLoad;
+
+int mirror_mesh_model(MeshModel* model, int dir, double plane, MirrorStatistics* statistics);
+int cut_mesh_model(MeshModel* model, int dir, double plane, SymmetryKind kind,
+                   int mirror_node[], int mirror_element[], SymmetryLoad adjusted_load[], SymmetryCutStatistics* statistics);
+int write_symmetry_map(const char* file_name, const MeshModel* model, int dir, SymmetryKind kind,
+                       const int mirror_node[], const int mirror_element[], const SymmetryLoad adjusted_load[], int adjusted_load_num);
+
+#endif
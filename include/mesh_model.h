@@ -0,0 +1,176 @@
+#ifndef MESH_MODEL_H
+#define MESH_MODEL_H
+
+#include <stdio.h>
+
+// 要素1つ当りの最大節点数 (HEXA, FILM)
+#define ELEMENT_NODE_MAX 8
+
+// 要素の種類
+typedef enum {
+    ELEMENT_HEXA = 0,  // 六面体要素
+    ELEMENT_QUAD = 1,  // 四辺形要素
+    ELEMENT_FILM = 2,  // フィルム要素
+    ELEMENT_LINE = 3,  // ライン要素
+    ELEMENT_BEAM = 4,  // 線材要素
+    ELEMENT_KIND_MAX = 5
+} ElementKind;
+
+// STEPデータのカードの種類
+typedef enum {
+    STEP_CARD_STEP = 0,  // STEP :UP TO NO.
+    STEP_CARD_FN = 1,    // FN :NODE 強制変位
+    STEP_CARD_UE = 2,    // UE :ELM 要素一様荷重
+    STEP_CARD_OUT = 3    // OUT :STEP 結果出力
+} StepCardKind;
+
+typedef enum {
+    MESH_MODEL_SUCCESS = 0,  // 成功
+    MESH_MODEL_ERROR = 1     // 失敗
+} MeshModelResult;
+
+// REST - 節点1つ分の拘束条件。rcは RC=(xyz000) の xyz を整数にしたもの(例: 010)
+typedef struct {
+    int node;
+    int rc;
+} MeshRestraint;
+
+// SUB1 - 節点1つ分の従属条件
+typedef struct {
+    int node;
+    int dir;
+    int master;
+    int master_dir;
+} MeshConstraint;
+
+/**
+ * 部品の複写(COPY :NODE、COPY :ELM)1枚分。S-E-I = start-end-interval を k = 1 ... set について
+ * 番号は k*increment、座標は k*distance (axis方向: 0:x, 1:y, 2:z)、節点番号は k*node_increment (COPY :ELM) ずらして複写する。
+ * write_mesh_model は節点、要素の後にそのまま書き込む。read_mesh_model はCOPYカードを展開するため使わない。
+ */
+typedef struct {
+    int element;  // 0: COPY :NODE, 1: COPY :ELM
+    int start;
+    int end;
+    int interval;
+    int increment;
+    int node_increment;
+    int axis;
+    double distance;
+    int set;
+} MeshInstanceCopy;
+
+/**
+ * STEPデータのカード1行分。FN、UEは節点、要素1つ分に展開して格納する。
+ *
+ * - STEP: id = 最終ステップ, real = 最大荷重増分(0は空欄)
+ * - FN  : id = 節点番号, real = 強制変位, value[0] = 方向
+ * - UE  : id = 要素番号, real = 単位面積当りの荷重, value[0] = 方向, value[1] = 面
+ * - OUT : id = 開始ステップ, value[0] = 終了ステップ, value[1] = 間隔, value[2] = 出力レベル
+ */
+typedef struct {
+    StepCardKind kind;
+    int id;
+    int value[3];
+    double real;
+} StepCard;
+
+/**
+ * MeshModel構造体
+ *
+ * .ffiのNODE、COPY、要素カードを展開した陽な節点、要素データを格納する構造体。
+ * 節点座標は要素ごとの計算で連続アクセスできるようにSoA形式で保持する。
+ *
+ * メンバ:
+ * - node_id, x, y, z: 節点番号と座標。配列のサイズは node_num に一致する。
+ * - node_index: 節点番号 -> 配列番号の対応表。存在しない番号は -1。
+ * - element_id, element_kind, element_type: 要素番号、種類、タイプ番号(TYPH, TYPQ ...)。
+ * - connectivity: 要素の節点番号。要素ごとに ELEMENT_NODE_MAX 個分の領域を持ち、未使用は 0。
+ * - element_index: 要素番号 -> 配列番号の対応表。存在しない番号は -1。
+ * - last_step, disp_node, disp_dir, load_node, load_dir: 解析制御データ(方向は 1:x, 2:y, 3:z)
+ * - restraint, constraint: REST、SUB1を節点ごとに展開したもの
+ * - instance_copy: 節点、要素の後に書き込む部品の複写(節点、要素の配列には展開しない)
+ * - table_line: TYP*、AXIS、MAT*カードの行(そのまま書き戻す)
+ * - step_card: STEPデータのカード(記載順)
+ */
+typedef struct {
+    // 節点
+    int node_num;
+    int node_capacity;
+    int* node_id;
+    double* x;
+    double* y;
+    double* z;
+    int node_index_size;
+    int* node_index;
+
+    // 要素
+    int element_num;
+    int element_capacity;
+    int* element_id;
+    ElementKind* element_kind;
+    int* element_type;
+    int* connectivity;
+    int element_index_size;
+    int* element_index;
+
+    // 解析制御データ
+    int last_step;
+    int disp_node;
+    int disp_dir;
+    int load_node;
+    int load_dir;
+
+    // 境界条件
+    int restraint_num;
+    int restraint_capacity;
+    MeshRestraint* restraint;
+    int constraint_num;
+    int constraint_capacity;
+    MeshConstraint* constraint;
+
+    // 部品の複写
+    int instance_copy_num;
+    int instance_copy_capacity;
+    MeshInstanceCopy* instance_copy;
+
+    // 要素タイプ、材料モデル
+    int table_line_num;
+    int table_line_capacity;
+    char** table_line;
+
+    // STEPデータ
+    int step_card_num;
+    int step_card_capacity;
+    StepCard* step_card;
+} MeshModel;
+
+MeshModel* allocate_mesh_model(int node_capacity, int element_capacity);
+void initialize_mesh_model(MeshModel* model);
+int free_mesh_model(MeshModel* model);
+MeshModel* create_mesh_model();
+
+int element_node_count(ElementKind kind);
+const char* element_kind_name(ElementKind kind);
+
+int find_mesh_node(const MeshModel* model, int node_id);
+int find_mesh_element(const MeshModel* model, int element_id);
+int add_mesh_node(MeshModel* model, int node_id, double x, double y, double z);
+int add_mesh_element(MeshModel* model, int element_id, ElementKind kind, int type, const int node[]);
+int add_mesh_restraint(MeshModel* model, int node, int rc);
+int add_mesh_constraint(MeshModel* model, int node, int dir, int master, int master_dir);
+int add_mesh_instance_copy(MeshModel* model, const MeshInstanceCopy* copy);
+int add_mesh_table_line(MeshModel* model, const char* line);
+int add_mesh_step_card(MeshModel* model, StepCardKind kind, int id, int value0, int value1, int value2, double real);
+
+int parse_card_fields(const char* line, int values[], int max_values);
+void expand_copy_node(MeshModel* model, const int values[], double length, int dir);
+void expand_copy_element(MeshModel* model, const int values[]);
+MeshModelResult read_mesh_model(const char* file_name, MeshModel* model);
+MeshModelResult write_mesh_model(const char* file_name, const MeshModel* model);
+void print_mesh_element(FILE* f, const MeshModel* model, int e, int type);
+
+void print_indent_mm(int level);
+void print_mesh_model(const MeshModel* model);
+
+#endif
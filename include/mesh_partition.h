@@ -0,0 +1,45 @@
+#ifndef MESH_PARTITION_H
+#define MESH_PARTITION_H
+
+#include "mesh_model.h"
+#include "mesh_graph.h"
+
+// 粗視化をやめる頂点数
+#define MESH_PARTITION_COARSEN_LIMIT 80
+
+// 最も粗いグラフの初期分割の試行回数
+#define MESH_PARTITION_INITIAL_TRIALS 8
+
+// 境界の改善(FM法)のパス数の上限、改善しない移動を続ける回数の上限
+#define MESH_PARTITION_REFINE_PASSES 8
+#define MESH_PARTITION_REFINE_STALL 64
+
+// 許容する重みの超過(目標の重みに対する比)
+#define MESH_PARTITION_IMBALANCE 0.03
+
+/**
+ * PartitionStatistics構造体
+ *
+ * 要素の分割の良さ。
+ *
+ * メンバ:
+ * - part_num: 分割数
+ * - edge_cut: 異なる部分にまたがる要素 - 要素の隣接(辺または面を共有)の数
+ * - interface_node_num: 複数の部分の要素に含まれる節点の数
+ * - min_part_size, max_part_size: 部分ごとの要素数の最小値、最大値
+ * - imbalance: 最大の要素数 / 平均の要素数
+ */
+typedef struct {
+    int part_num;
+    int edge_cut;
+    int interface_node_num;
+    int min_part_size;
+    int max_part_size;
+    double imbalance;
+} PartitionStatistics;
+
+int partition_mesh_elements(const MeshModel* model, int part_num, int part[]);
+int compute_partition_statistics(const MeshModel* model, int part_num, const int part[], PartitionStatistics* statistics);
+int write_element_partition(const char* file_name, const MeshModel* model, const int part[]);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef MESH_QUALITY_H
+#define MESH_QUALITY_H
+
+#include "mesh_model.h"
+
+// 要素をまとめて計算する個数(SIMD_WIDTHの倍数)
+#define MESH_QUALITY_BLOCK 256
+
+// ヒストグラムの区間数
+#define MESH_QUALITY_BIN_NUM 5
+
+// 警告のしきい値
+#define MESH_QUALITY_ASPECT_WARNING 5.0            // 辺長比
+#define MESH_QUALITY_SCALED_JACOBIAN_WARNING 0.2   // 正規化ヤコビアン
+#define MESH_QUALITY_SKEW_WARNING 0.5              // ゆがみ
+
+/**
+ * MeshQuality構造体
+ *
+ * HEXA、QUAD要素の形状指標を要素ごとに格納する。配列番号はMeshModelの要素の配列番号と同じ。
+ * HEXA、QUAD以外の要素は全て 0 とし、evaluated を 0 とする。
+ *
+ * メンバ:
+ * - volume: 体積(HEXA)または面積(QUAD)
+ * - min_jacobian: 角点ヤコビアンの最小値。負の場合は要素が裏返っている。
+ * - scaled_jacobian: 角点ヤコビアンを辺の長さで正規化した値の最小値(1が理想)
+ * - aspect_ratio: 最大辺長 / 最小辺長
+ * - skew: 要素の主軸同士のなす角の余弦の最大値(0が理想)
+ */
+typedef struct {
+    int element_num;
+    char* evaluated;
+    double* volume;
+    double* min_jacobian;
+    double* scaled_jacobian;
+    double* aspect_ratio;
+    double* skew;
+} MeshQuality;
+
+MeshQuality* create_mesh_quality(int element_num);
+int free_mesh_quality(MeshQuality* quality);
+
+int compute_mesh_quality(const MeshModel* model, MeshQuality* quality);
+int print_mesh_quality_summary(const MeshModel* model, const MeshQuality* quality);
+int check_mesh_quality(const char* file_name);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef MESH_RENUMBER_H
+#define MESH_RENUMBER_H
+
+#include "mesh_model.h"
+#include "mesh_graph.h"
+
+/**
+ * RenumberStatistics構造体
+ *
+ * 節点番号の並びによる剛性行列の帯幅、プロファイル(スカイライン)の大きさ。
+ * いずれも節点単位(自由度単位ではない)で数える。
+ */
+typedef struct {
+    int bandwidth;       // max |i - j| (i, jは同じ要素または同じSUB1に含まれる節点)
+    long long profile;   // 各行の対角から最も左の非零までの距離の合計
+    int component_num;   // 連結成分の数
+} RenumberStatistics;
+
+/**
+ * FrontStatistics構造体
+ *
+ * 要素を番号順に組み立てた場合のフロント(組み立て中の節点)の大きさ。
+ * 節点は最初に現れた要素で追加され、最後に現れた要素の後に消去されるものとする。
+ */
+typedef struct {
+    int max_front;       // フロント幅の最大値
+    double mean_front;   // フロント幅の平均値
+} FrontStatistics;
+
+CsrGraph* build_renumber_graph(const MeshModel* model);
+int compute_rcm_order(const CsrGraph* graph, int order[], int* component_num);
+void compute_renumber_statistics(const CsrGraph* graph, const int position[], RenumberStatistics* statistics);
+
+int apply_node_renumbering(MeshModel* model, const int new_id[]);
+int renumber_nodes_rcm(MeshModel* model, int original_id[], RenumberStatistics* before, RenumberStatistics* after);
+int write_node_map(const char* file_name, const MeshModel* model, const int original_id[]);
+
+void compute_front_statistics(const MeshModel* model, const int order[], FrontStatistics* statistics);
+int compute_element_order(const MeshModel* model, int order[]);
+int apply_element_renumbering(MeshModel* model, const int new_id[]);
+int renumber_elements_front(MeshModel* model, int original_id[], FrontStatistics* before, FrontStatistics* after);
+int write_element_map(const char* file_name, const MeshModel* model, const int original_id[]);
+
+#endif
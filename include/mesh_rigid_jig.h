@@ -0,0 +1,31 @@
+#ifndef MESH_RIGID_JIG_H
+#define MESH_RIGID_JIG_H
+
+#include "mesh_model.h"
+
+// 治具の六面体要素のタイプ番号(TYPH)
+#define RIGID_JIG_TYPE 5
+
+/**
+ * RigidJigStatistics構造体
+ *
+ * remove_jig_elements で削除したものの数。
+ *
+ * メンバ:
+ * - removed_node_num, removed_element_num: 削除した節点(治具の要素だけが使う節点)、要素
+ * - interface_node_num: 治具と他の要素が共有していた節点
+ * - untied_node_num: interface_node_num のうち SUB1 の従属節点、主節点のどちらでもないもの
+ * - removed_card_num: 削除した節点、要素の REST、SUB1、FN、UE
+ */
+typedef struct {
+    int removed_node_num;
+    int removed_element_num;
+    int interface_node_num;
+    int untied_node_num;
+    int removed_card_num;
+} RigidJigStatistics;
+
+int remove_jig_elements(MeshModel* model, int jig_type, RigidJigStatistics* statistics);
+void print_rigid_jig_statistics(const RigidJigStatistics* statistics);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef MESH_SELECT_H
+#define MESH_SELECT_H
+
+#include <stdio.h>
+#include "mesh_model.h"
+
+// 一様格子の1セル当りの点数の目安
+#define MESH_SELECT_CELL_POINTS 4
+
+// 座標を比べる許容差(ffiの座標の精度 0.01 の半分)
+#define MESH_SELECT_TOLERANCE 0.005
+
+// 選択の対象
+typedef enum {
+    SELECT_NODE = 0,     // 節点
+    SELECT_ELEMENT = 1   // 要素
+} SelectTarget;
+
+/**
+ * SelectBox構造体
+ *
+ * 座標の範囲 min[axis] <= 座標 <= max[axis] (axis = 0:x, 1:y, 2:z)。
+ */
+typedef struct {
+    double min[3];
+    double max[3];
+} SelectBox;
+
+/**
+ * SpatialIndex構造体
+ *
+ * 節点の座標(要素は節点の重心)を一様格子に登録し、範囲の検索を O(セル数 + 該当数) で行う。
+ *
+ * メンバ:
+ * - target: 節点または要素
+ * - point_num: 点の数(節点数または要素数)。点の番号はMeshModelの配列番号。
+ * - point: 点の座標。サイズは 3 * point_num。
+ * - origin, cell_size, cell_num: 格子の原点、セルの大きさ、軸ごとのセル数
+ * - cell_start: セル c の点は item[cell_start[c]] ... item[cell_start[c + 1] - 1]
+ * - line, line_num: 軸ごとの座標の異なる値(昇順)。格子番号(x, y, z方向の何本目の線か)に使う。
+ */
+typedef struct {
+    SelectTarget target;
+    int point_num;
+    double* point;
+    double origin[3];
+    double cell_size[3];
+    int cell_num[3];
+    int* cell_start;
+    int* item;
+    int line_num[3];
+    double* line[3];
+} SpatialIndex;
+
+/**
+ * MeshSelection構造体
+ *
+ * 選んだ節点または要素の集合。flag[i] = 1 はMeshModelの配列番号 i を選んだことを表す。
+ */
+typedef struct {
+    SelectTarget target;
+    int size;
+    int count;
+    unsigned char* flag;
+} MeshSelection;
+
+SpatialIndex* build_spatial_index(const MeshModel* model, SelectTarget target);
+int free_spatial_index(SpatialIndex* index);
+
+MeshSelection* create_mesh_selection(const MeshModel* model, SelectTarget target);
+int free_mesh_selection(MeshSelection* selection);
+void clear_mesh_selection(MeshSelection* selection);
+
+int select_in_box(const SpatialIndex* index, const SelectBox* box, MeshSelection* selection);
+int select_on_plane(const SpatialIndex* index, int axis, double value, MeshSelection* selection);
+int select_grid_range(const SpatialIndex* index, const int low[3], const int high[3], MeshSelection* selection);
+int select_elements_by_type(const MeshModel* model, ElementKind kind, int type, MeshSelection* selection);
+int select_elements_of_nodes(const MeshModel* model, const MeshSelection* nodes, int require_all, MeshSelection* selection);
+int select_nodes_of_elements(const MeshModel* model, const MeshSelection* elements, MeshSelection* selection);
+
+int selection_and(MeshSelection* selection, const MeshSelection* other);
+int selection_or(MeshSelection* selection, const MeshSelection* other);
+int selection_minus(MeshSelection* selection, const MeshSelection* other);
+int selection_invert(MeshSelection* selection);
+
+int selection_ids(const MeshModel* model, const MeshSelection* selection, int ids[]);
+
+#endif
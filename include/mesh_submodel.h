@@ -0,0 +1,41 @@
+#ifndef MESH_SUBMODEL_H
+#define MESH_SUBMODEL_H
+
+#include "mesh_model.h"
+#include "mesh_select.h"
+
+// 範囲を指定しない軸の座標
+#define SUBMODEL_UNBOUNDED 1.0e30
+
+/**
+ * SubmodelStatistics構造体
+ *
+ * extract_submodel で残した、削除したものの数。
+ *
+ * メンバ:
+ * - node_num, element_num: 残した節点、要素(番号は 1 から詰めた)
+ * - removed_node_num, removed_element_num: 削除した節点、要素
+ * - cut_node_num: 削除した要素と共有していた節点(切断面。荷重を移す方向以外を拘束する)
+ * - tied_node_num: 切断面の節点のうち、FN を移した主節点に SUB1 で従属させたもの
+ * - moved_card_num: 切断面に移した FN、UE(UE は要素ごと)
+ * - removed_card_num: 削除した節点、要素の REST、SUB1、FN、UE と、切断面の拘束と重なる SUB1、FN
+ * - elapsed_ms: 選択から番号の付け替えまでの時間
+ */
+typedef struct {
+    int node_num;
+    int element_num;
+    int removed_node_num;
+    int removed_element_num;
+    int cut_node_num;
+    int tied_node_num;
+    int moved_card_num;
+    int removed_card_num;
+    double elapsed_ms;
+} SubmodelStatistics;
+
+int extract_submodel(MeshModel* model, const SelectBox* box, int original_node[], int original_element[], SubmodelStatistics* statistics);
+int extract_submodel_file(const char* input_file_name, const char* output_file_name, const SelectBox* box,
+                          const char* node_map_file_name, const char* element_map_file_name);
+void print_submodel_statistics(const SubmodelStatistics* statistics);
+
+#endif
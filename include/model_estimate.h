@@ -0,0 +1,80 @@
+#ifndef MODEL_ESTIMATE_H
+#define MODEL_ESTIMATE_H
+
+#include "modeling_data.h"
+
+// 部位の数(柱、主筋、主筋付着、接合部鋼板、接合部フィルム、梁)
+#define MODEL_ESTIMATE_PART_NUM 6
+
+// 1節点当りの自由度
+#define MODEL_ESTIMATE_NODE_DOF 3
+
+// カード1行のバイト数(改行を含む。print_ffi.c の書式)
+#define MODEL_ESTIMATE_NODE_CARD_BYTES 63
+#define MODEL_ESTIMATE_COPY_CARD_BYTES 73
+#define MODEL_ESTIMATE_HEXA_CARD_BYTES 73
+#define MODEL_ESTIMATE_QUAD_CARD_BYTES 49
+#define MODEL_ESTIMATE_BEAM_CARD_BYTES 52
+#define MODEL_ESTIMATE_LINE_CARD_BYTES 49
+#define MODEL_ESTIMATE_FILM_CARD_BYTES 73
+#define MODEL_ESTIMATE_ETYP_CARD_BYTES 71
+#define MODEL_ESTIMATE_SUB1_CARD_BYTES 64
+// 区切りの行("---- ...")の平均のバイト数
+#define MODEL_ESTIMATE_COMMENT_BYTES 16
+
+// 部位の外のカード(print_head_template、fix_cut_surface、set_pin、print_type_mat、単調載荷の STEP)
+#define MODEL_ESTIMATE_FIXED_CARD_NUM 48
+#define MODEL_ESTIMATE_FIXED_BYTES 3108
+
+// 接合部の辺(add_column_hexa の edge 1 ... 11)の区切りの数と HEXA、COPY :ELM の枚数
+#define MODEL_ESTIMATE_EDGE_NUM 11
+#define MODEL_ESTIMATE_EDGE_HEXA_NUM 16
+#define MODEL_ESTIMATE_EDGE_COPY_NUM 10
+
+// 接合部フィルムの FILM、COPY カードの枚数(直交梁フランジ、梁フランジの y の層当り、層の間で共有する分)
+#define MODEL_ESTIMATE_FILM_ORTHOGONAL_ROW_CARD_NUM 16
+#define MODEL_ESTIMATE_FILM_BEAM_ROW_CARD_NUM 30
+#define MODEL_ESTIMATE_FILM_SHARED_CARD_NUM 12
+
+/**
+ * ModelEstimatePart構造体
+ *
+ * 部位ごとの節点、要素数の予測と、既定の書き込み(NODE、要素のカードと COPY カード)のカード数、バイト数。
+ */
+typedef struct {
+    const char* name;
+    int node_num;
+    int element_num;
+    long card_num;
+    long bytes;
+} ModelEstimatePart;
+
+/**
+ * ModelEstimate構造体
+ *
+ * ffiを書き込まずに make_modeling_data の境界点から求めた解析モデルの規模。
+ *
+ * メンバ:
+ * - part: 部位ごとの節点、要素数
+ * - node_num, element_num, dof: 合計
+ * - card_num, bytes: 既定の書き込み(COPY カードを使う)の ffi のカード数(区切りの行、空行を除く)とバイト数
+ * - front: 柱を z 方向、梁を x 方向に順に消去する場合の最大のフロント幅(自由度)
+ * - profile: スカイラインの成分数の目安(自由度 x フロント幅)
+ * - memory: profile を倍精度で持つ場合のバイト数
+ */
+typedef struct {
+    ModelEstimatePart part[MODEL_ESTIMATE_PART_NUM];
+    int node_num;
+    int element_num;
+    long dof;
+    long card_num;
+    long bytes;
+    long front;
+    double profile;
+    double memory;
+} ModelEstimate;
+
+int estimate_model(const ModelingData* modeling_data, ModelEstimate* estimate);
+void print_model_estimate(const ModelEstimate* estimate, double elapsed_us);
+
+#endif
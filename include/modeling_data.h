@@ -112,6 +112,7 @@ typedef struct {
 // 梁
 typedef struct {
     NodeElement increment[3];
+    NodeElement occupied_indices;
     NodeElement head;
 } BeamHexaQuad;
 
@@ -163,6 +164,8 @@ int free_rebar_fiber(RebarFiber* rebar);
 
 int free_modeling_data(ModelingData* data);
 
+void set_modeling_data_free_log(int enabled);
+
 ModelingData* create_modeling_data(int x_node_num, int y_node_num, int z_node_num, int rebar_num);
 
 void print_indent_md(int level);
@@ -1,11 +1,110 @@
 #ifndef MODELING_RCS_H
 #define MODELING_RCS_H
 
+#include "mesh_select.h"
+
 typedef enum {
 	MODELING_RCS_SUCCESS = 0,  // 成功
     MODELING_RCS_ERROR = 1     // 失敗
 } ModelingRcsResult;
 
+// 節点番号の付け方
+typedef enum {
+    NODE_ORDER_DEFAULT = 0,  // make_modeling_dataの番号(head + increment)のまま
+    NODE_ORDER_RCM = 1       // Reverse Cuthill-McKeeで付け替える
+} NodeOrder;
+
+// 要素番号の付け方
+typedef enum {
+    ELEMENT_ORDER_DEFAULT = 0,  // 部位ごとの番号のまま
+    ELEMENT_ORDER_FRONT = 1     // 節点番号順に並べてフロント幅を小さくする
+} ElementOrder;
+
+// 解析モデルの範囲
+typedef enum {
+    MODEL_SCOPE_HALF = 0,  // 梁芯(y)で切断したハーフモデル
+    MODEL_SCOPE_FULL = 1,  // ハーフモデルを梁芯の面で鏡映したフルモデル
+    MODEL_SCOPE_QUARTER = 2,               // ハーフモデルを柱芯(x)で切断した1/4モデル(対称な荷重)
+    MODEL_SCOPE_QUARTER_ANTISYMMETRIC = 3  // 1/4モデル(逆対称な荷重。柱の水平方向の強制変位など)
+} ModelScope;
+
+// 部分モデルの範囲
+typedef enum {
+    SUBMODEL_NONE = 0,   // 切り出さない
+    SUBMODEL_PANEL = 1,  // COLUMN_BEAM_Z から BEAM_COLUMN_Z の層(梁の部分を含む)
+    SUBMODEL_JOINT = 2,  // パネルゾーン(上の層のうち BEAM_COLUMN_X から COLUMN_BEAM_X)
+    SUBMODEL_BOX = 3     // submodel_box の座標の範囲
+} SubmodelRegion;
+
+// 主筋の付着要素(LINE)を作る区間
+typedef enum {
+    BOND_ZONE_ALL = 0,    // 主筋の全長
+    BOND_ZONE_JOINT = 1,  // COLUMN_BEAM_Z から BEAM_COLUMN_Z (接合部)
+    BOND_ZONE_RANGE = 2   // bond_zone_min から bond_zone_max の z 座標
+} BondZone;
+
+/**
+ * ModelingRcsOption構造体
+ *
+ * modeling_rcsの出力に対するオプション。initialize_modeling_rcs_option()で既定値にする。
+ *
+ * メンバ:
+ * - node_order: 節点番号の付け方
+ * - node_map_file_name: 節点番号を付け替えた場合の対応表(CSV)のファイル名。NULLの場合は書き込まない。
+ * - element_order: 要素番号の付け方
+ * - element_map_file_name: 要素番号を付け替えた場合の対応表(CSV)のファイル名。NULLの場合は書き込まない。
+ * - partition_num: 要素の分割数。0の場合は分割しない。
+ * - partition_file_name: 要素番号 -> 部分の番号(CSV)のファイル名。NULLの場合は <出力ファイル名>.epart.<分割数>.csv
+ * - compress: 1の場合は節点、要素をCOPYカードにまとめて書き直す(番号を付け替えた場合は常にまとめる)
+ * - fit_id_budget: 1の場合、節点、要素番号が5桁を超えるときは治具と接合部の間の要素をまとめて収める(0の場合はエラー)
+ * - estimate: 1の場合はffiを書き込まず、節点、要素、自由度数などの予測だけを表示する(outputFileNameは使わない)
+ * - scope: 解析モデルの範囲。フルモデル、1/4モデルはハーフモデルを書き込んだ後に読み直して鏡映、切断する
+ * - symmetry_map_file_name: 1/4モデルの節点、要素 -> 削除した側の番号の対応表(CSV)のファイル名。NULLの場合は <出力ファイル名>.quarter.csv
+ * - frame_bay_num, frame_story_num: 接合部を x (スパン)、z (層) 方向に並べる数。どちらも 1 の場合は接合部1つ
+ * - submodel, submodel_box: 部分モデルとして残す範囲(要素の重心)。番号は 1 から詰め、node_map_file_name、
+ *   element_map_file_name に元の番号との対応表を書き込む
+ * - bond_zone, bond_zone_min, bond_zone_max: 主筋の付着要素を残す区間(LINE の重心)。区間の外は主筋の節点を
+ *   コンクリートの節点と共有する(完全付着)
+ * - adaptive_steps: 1の場合は "loading" の変位履歴の増分を、ひび割れ、降伏、反転の付近で細かく、弾性、除荷の範囲で粗くする
+ * - yield_drift: adaptive_steps の降伏の部材角。0の場合は柱断面のファイバー解析(降伏しない場合は柱のせいと載荷点の間の距離)から推定する
+ * - restart_run_num: 2以上の場合は "loading" の変位履歴をこの回数の解析に分け、再開点を EXEC に書いた
+ *   <出力ファイル名>.run<k>.ffi も書き込む(0の場合は分けない)
+ * - output_budget: 0より大きい場合は "loading" の結果出力(OUT)をこの大きさ(MB)に収まるよう、反転などのステップと
+ *   間隔をあけたステップに限る(0の場合は全てのステップを出力する)
+ * - section: 1の場合はffiを書き込まず、柱断面のファイバー解析と接合部のせん断の検討だけを表示する(outputFileNameは使わない)
+ * - rebar_area: 主筋1本の断面積(ファイバー解析)。0の場合は FIBER_REBAR_AREA
+ * - rigid_jig: 1の場合は柱端、梁端の治具(TYPH 5)を削除し、治具との境界面の節点を載荷点、支点に SUB1 で従属させる
+ */
+typedef struct {
+    NodeOrder node_order;
+    const char *node_map_file_name;
+    ElementOrder element_order;
+    const char *element_map_file_name;
+    int partition_num;
+    const char *partition_file_name;
+    int compress;
+    int fit_id_budget;
+    int estimate;
+    ModelScope scope;
+    const char *symmetry_map_file_name;
+    int frame_bay_num;
+    int frame_story_num;
+    SubmodelRegion submodel;
+    SelectBox submodel_box;
+    int rigid_jig;
+    int adaptive_steps;
+    double yield_drift;
+    int restart_run_num;
+    double output_budget;
+    int section;
+    double rebar_area;
+    BondZone bond_zone;
+    double bond_zone_min;
+    double bond_zone_max;
+} ModelingRcsOption;
+
+void initialize_modeling_rcs_option(ModelingRcsOption *option);
 ModelingRcsResult modeling_rcs(const char *inputFileName, const char *outputFileName);
+ModelingRcsResult modeling_rcs_with_option(const char *inputFileName, const char *outputFileName, const ModelingRcsOption *option);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef OUTPUT_PLAN_H
+#define OUTPUT_PLAN_H
+
+#include "loading_protocol.h"
+
+// OUT の出力レベル
+#define OUTPUT_LEVEL_RESULT 1
+#define OUTPUT_LEVEL_POST 2
+#define OUTPUT_LEVEL_ALL 3
+
+// 1ステップの結果の大きさの目安(バイト)。RESULT はリスト(節点の変位、反力、要素の積分点の応力、ひずみ)、
+// POST は図化用のデータ(節点の変位、要素の応力、ひび割れ)
+#define OUTPUT_RESULT_NODE_BYTES 120
+#define OUTPUT_RESULT_ELEMENT_BYTES 960
+#define OUTPUT_POST_NODE_BYTES 24
+#define OUTPUT_POST_ELEMENT_BYTES 256
+
+/**
+ * OutputRange構造体
+ *
+ * OUT カード1枚分(start から end まで interval ごとに level で出力する)。1ステップだけの場合は end = start。
+ */
+typedef struct {
+    int start;
+    int end;
+    int interval;
+    int level;
+} OutputRange;
+
+/**
+ * OutputPlan構造体
+ *
+ * 繰り返し載荷の結果出力(OUT)の計画。
+ *
+ * メンバ:
+ * - range: OUT カード(ステップ順)
+ * - key_step_num: 必ず出力するステップ(正負の最大の変位 = 反転、0 を通るステップ、最後のステップ)
+ * - key_level: key のステップの出力レベル(予算に収まらない場合は POST だけにする)
+ * - sparse_interval: その他のステップを POST だけ出力する間隔(ステップ番号が interval の倍数)。0 の場合は出力しない
+ * - sparse_step_num: 間隔で出力するステップ
+ * - bytes: 計画した出力の大きさの目安
+ * - full_bytes: 全てのステップを LEVEL=(3) で出力した場合の大きさの目安
+ */
+typedef struct OutputPlan {
+    int range_num;
+    int range_capacity;
+    OutputRange* range;
+    int key_step_num;
+    int key_level;
+    int sparse_interval;
+    int sparse_step_num;
+    double bytes;
+    double full_bytes;
+} OutputPlan;
+
+OutputPlan* create_output_plan();
+int free_output_plan(OutputPlan* plan);
+double estimate_output_step_bytes(int node_num, int element_num, int level);
+int plan_output(const LoadingProtocol* protocol, int node_num, int element_num, double budget_bytes, OutputPlan* plan);
+void print_output_plan(const OutputPlan* plan, double budget_bytes);
+
+#endif
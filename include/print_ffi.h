@@ -5,6 +5,8 @@
 
 int print_head_template(FILE *f, int last_step, int disp_node, char disp_dir, int load_node, char load_dir);
 
+int print_EXEC(FILE *f, int first_step, int last_step, int restart);
+
 void print_NODE(FILE *f, int node, double coordinate_x, double coordinate_y, double coordinate_z);
 
 void print_COPYNODE(FILE *f, int start, int end, int interval, double meshLen, int increment, int set, int dir);
@@ -61,4 +63,6 @@ void print_UE(FILE *f, int start_element, int end_element, int interval, double
 
 void print_OUT(FILE *f, int start_step, int end_step, int interval);
 
+void print_OUT_level(FILE *f, int start_step, int end_step, int interval, int level);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef RANGE_SET_H
+#define RANGE_SET_H
+
+#include <stdio.h>
+
+// d おきの並びに分ける d の候補の数(多く現れる順)と、差をとる番号の先の数
+#define RANGE_SET_CANDIDATE_NUM 4
+#define RANGE_SET_LOOKAHEAD 3
+
+/**
+ * RangeSet構造体
+ *
+ * S-E-I = start-end-interval の番号と、それを k*increment (k = 1 ... set) ずらした番号。
+ * 1つだけの場合は end = start, interval = 1。INC-SET を使わない場合は increment = set = 0。
+ */
+typedef struct {
+    int start;
+    int end;
+    int interval;
+    int increment;
+    int set;
+} RangeSet;
+
+/**
+ * RangeSetList構造体
+ */
+typedef struct {
+    int range_num;
+    int range_capacity;
+    RangeSet* range;
+} RangeSetList;
+
+RangeSetList* create_range_set_list();
+int free_range_set_list(RangeSetList* list);
+
+int append_range_ids(int** ids, int* n, int* capacity, int start, int end, int interval, int increment, int set);
+int encode_range_set(const int ids[], int n, int use_set, RangeSetList* list);
+
+int print_REST_set(FILE* f, const int ids[], int n, int rc);
+int print_SUB1_set(FILE* f, const int ids[], int n, int dir, int master, int m_dir);
+int print_ETYP_set(FILE* f, const int ids[], int n, int type);
+int print_UE_set(FILE* f, const int ids[], int n, double unit, char direction, int face);
+
+#endif
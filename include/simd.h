@@ -0,0 +1,102 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * 倍精度のSIMD演算をまとめたヘッダ
+ *
+ * AVX2でコンパイルした場合(-mavx2。make SIMD=avx2 または SIMD=native)は4要素を1レジスタで処理し、
+ * それ以外はスカラー(1要素)で同じ関数を使えるようにする。
+ * 配列はSoA形式で並べ、SIMD_WIDTH 個ずつ読み込む事。
+ */
+
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+#define SIMD_WIDTH 4
+typedef __m256d simd_double;
+
+static inline simd_double simd_load(const double* p) { return _mm256_loadu_pd(p); }
+static inline void simd_store(double* p, simd_double a) { _mm256_storeu_pd(p, a); }
+static inline simd_double simd_set1(double a) { return _mm256_set1_pd(a); }
+static inline simd_double simd_add(simd_double a, simd_double b) { return _mm256_add_pd(a, b); }
+static inline simd_double simd_sub(simd_double a, simd_double b) { return _mm256_sub_pd(a, b); }
+static inline simd_double simd_mul(simd_double a, simd_double b) { return _mm256_mul_pd(a, b); }
+static inline simd_double simd_div(simd_double a, simd_double b) { return _mm256_div_pd(a, b); }
+static inline simd_double simd_min(simd_double a, simd_double b) { return _mm256_min_pd(a, b); }
+static inline simd_double simd_max(simd_double a, simd_double b) { return _mm256_max_pd(a, b); }
+static inline simd_double simd_sqrt(simd_double a) { return _mm256_sqrt_pd(a); }
+static inline simd_double simd_abs(simd_double a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+#if defined(__FMA__)
+static inline simd_double simd_fmadd(simd_double a, simd_double b, simd_double c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+static inline simd_double simd_fmadd(simd_double a, simd_double b, simd_double c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+
+#else
+
+#define SIMD_WIDTH 1
+typedef double simd_double;
+
+static inline simd_double simd_load(const double* p) { return *p; }
+static inline void simd_store(double* p, simd_double a) { *p = a; }
+static inline simd_double simd_set1(double a) { return a; }
+static inline simd_double simd_add(simd_double a, simd_double b) { return a + b; }
+static inline simd_double simd_sub(simd_double a, simd_double b) { return a - b; }
+static inline simd_double simd_mul(simd_double a, simd_double b) { return a * b; }
+static inline simd_double simd_div(simd_double a, simd_double b) { return a / b; }
+static inline simd_double simd_min(simd_double a, simd_double b) { return a < b ? a : b; }
+static inline simd_double simd_max(simd_double a, simd_double b) { return a > b ? a : b; }
+static inline simd_double simd_sqrt(simd_double a) { return sqrt(a); }
+static inline simd_double simd_abs(simd_double a) { return fabs(a); }
+static inline simd_double simd_fmadd(simd_double a, simd_double b, simd_double c) { return a * b + c; }
+
+#endif
+
+// 3次元ベクトル(各成分がSIMD_WIDTH個の要素分)
+typedef struct {
+    simd_double x;
+    simd_double y;
+    simd_double z;
+} simd_vec3;
+
+static inline simd_vec3 simd_vec3_load(const double* x, const double* y, const double* z) {
+    simd_vec3 v = { simd_load(x), simd_load(y), simd_load(z) };
+    return v;
+}
+
+static inline simd_vec3 simd_vec3_add(simd_vec3 a, simd_vec3 b) {
+    simd_vec3 v = { simd_add(a.x, b.x), simd_add(a.y, b.y), simd_add(a.z, b.z) };
+    return v;
+}
+
+static inline simd_vec3 simd_vec3_sub(simd_vec3 a, simd_vec3 b) {
+    simd_vec3 v = { simd_sub(a.x, b.x), simd_sub(a.y, b.y), simd_sub(a.z, b.z) };
+    return v;
+}
+
+static inline simd_vec3 simd_vec3_scale(simd_vec3 a, simd_double s) {
+    simd_vec3 v = { simd_mul(a.x, s), simd_mul(a.y, s), simd_mul(a.z, s) };
+    return v;
+}
+
+static inline simd_double simd_vec3_dot(simd_vec3 a, simd_vec3 b) {
+    return simd_fmadd(a.x, b.x, simd_fmadd(a.y, b.y, simd_mul(a.z, b.z)));
+}
+
+static inline simd_vec3 simd_vec3_cross(simd_vec3 a, simd_vec3 b) {
+    simd_vec3 v = {
+        simd_sub(simd_mul(a.y, b.z), simd_mul(a.z, b.y)),
+        simd_sub(simd_mul(a.z, b.x), simd_mul(a.x, b.z)),
+        simd_sub(simd_mul(a.x, b.y), simd_mul(a.y, b.x))
+    };
+    return v;
+}
+
+// (a x b)・c
+static inline simd_double simd_vec3_triple(simd_vec3 a, simd_vec3 b, simd_vec3 c) {
+    return simd_vec3_dot(simd_vec3_cross(a, b), c);
+}
+
+#endif
@@ -4,5 +4,32 @@
 void test_json_parser();
 int test_modeling_data();
 void test_modeling_rcs();
+void test_mesh_quality();
+void test_mesh_graph();
+void test_mesh_renumber();
+void test_mesh_partition();
+void test_mesh_copy();
+void test_range_set();
+void test_mesh_select();
+void test_block_mesh();
+void test_mesh_interface();
+void test_auto_mesh();
+void test_id_budget();
+void test_estimate_model();
+void test_mirror_mesh_model();
+void test_cut_mesh_model();
+void test_frame_assembly();
+void test_merge_ffi();
+void test_extract_submodel();
+void test_rigid_jig();
+void test_restrict_bond_zone();
+void test_loading_protocol();
+void test_adaptive_loading_protocol();
+void test_restart_runs();
+void test_output_plan();
+void test_fiber_section();
+void test_simd();
+void test_extract_panel();
+void test_quarter_model();
 
 #endif
\ No newline at end of file
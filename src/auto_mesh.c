@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "auto_mesh.h"
+
+/**
+ * 柱、梁、主筋の寸法から mesh_x, mesh_y, mesh_z を作る。
+ *
+ * make_modeling_data が find_index_double で探す座標(柱と梁の面、直交梁の面、柱芯、梁芯)と
+ * 主筋の位置を必ず格子線にし、その間を AutoMeshGrading の寸法の分布で分割する。
+ *   x: 接合部(柱の幅)を目標寸法で分割し、梁端の治具に向かって大きくする
+ *   y: 柱の幅全体を目標寸法で分割する
+ *   z: 接合部(梁せい)を目標寸法で分割し、柱端の治具に向かって大きくする
+ * 治具は両端の1要素(jig_element_num = 1)とする。
+ */
+
+/**
+ * 接合部の端から距離 d までの 1 / h の積分
+ */
+static double grading_distance_integral(const AutoMeshGrading* grading, double d) {
+    double rate = grading->growth - 1.0;
+    if (rate <= 0.0) {
+        return d / grading->size;
+    }
+    double cap = (grading->max_size - grading->size) / rate;  // 頭打ちになる距離
+    if (d <= cap) {
+        return log(1.0 + rate * d / grading->size) / rate;
+    }
+    return log(grading->max_size / grading->size) / rate + (d - cap) / grading->max_size;
+}
+
+static double grading_distance_inverse(const AutoMeshGrading* grading, double u) {
+    double rate = grading->growth - 1.0;
+    if (rate <= 0.0) {
+        return u * grading->size;
+    }
+    double cap = (grading->max_size - grading->size) / rate;
+    double cap_integral = log(grading->max_size / grading->size) / rate;
+    if (u <= cap_integral) {
+        return grading->size * (exp(rate * u) - 1.0) / rate;
+    }
+    return cap + (u - cap_integral) * grading->max_size;
+}
+
+/**
+ * 座標 s までの 1 / h の積分(接合部の始まりを 0 とする)。区間の要素数はこの差になる。
+ */
+static double grading_integral(const AutoMeshGrading* grading, double s) {
+    double joint = (grading->joint_high - grading->joint_low) / grading->size;
+    if (s < grading->joint_low) {
+        return -grading_distance_integral(grading, grading->joint_low - s);
+    }
+    if (s <= grading->joint_high) {
+        return (s - grading->joint_low) / grading->size;
+    }
+    return joint + grading_distance_integral(grading, s - grading->joint_high);
+}
+
+static double grading_inverse(const AutoMeshGrading* grading, double t) {
+    double joint = (grading->joint_high - grading->joint_low) / grading->size;
+    if (t < 0.0) {
+        return grading->joint_low - grading_distance_inverse(grading, -t);
+    }
+    if (t <= joint) {
+        return grading->joint_low + t * grading->size;
+    }
+    return grading->joint_high + grading_distance_inverse(grading, t - joint);
+}
+
+static int compare_double(const void* a, const void* b) {
+    double p = *(const double*)a;
+    double q = *(const double*)b;
+    return (p > q) - (p < q);
+}
+
+/**
+ * 区間 [a, b] の要素数。治具の区間は1要素。
+ */
+static int interval_element_num(const AutoMeshGrading* grading, double a, double b, int jig) {
+    if (jig) {
+        return 1;
+    }
+    long n = lround(grading_integral(grading, b) - grading_integral(grading, a));
+    return n < 1 ? 1 : (int)n;
+}
+
+/**
+ * 格子線にする座標(順不同、重複可)から1つの軸の要素長さを作る
+ *
+ * 隣り合う座標の区間ごとに、1 / h の積分を四捨五入した数の要素に分け、
+ * 内側の節点は積分を等分する位置(AUTO_MESH_RESOLUTION に丸める)に置く。
+ *
+ * @param breakpoint 格子線にする座標。最小と最大が軸の両端になる
+ * @param breakpoint_num breakpoint の数
+ * @param grading 要素寸法の分布
+ * @param jig 1 の場合、両端の区間を治具として1要素にする
+ * @param mesh 要素長さ(既にある lengths は解放して置き換える)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int auto_mesh_axis(const double breakpoint[], int breakpoint_num, const AutoMeshGrading* grading, int jig, Mesh* mesh) {
+    if (breakpoint == NULL || grading == NULL || mesh == NULL || breakpoint_num < 2) {
+        fprintf(stderr, "Error: Invalid argument passed to auto_mesh_axis\n");
+        return EXIT_FAILURE;
+    }
+    if (grading->size <= 0.0 || grading->growth < 1.0 || grading->max_size < grading->size) {
+        fprintf(stderr, "Error: Invalid mesh grading (size %.2f, growth %.2f, max size %.2f)\n",
+                grading->size, grading->growth, grading->max_size);
+        return EXIT_FAILURE;
+    }
+
+    double* point = (double*)malloc((size_t)breakpoint_num * sizeof(double));
+    if (point == NULL) {
+        fprintf(stderr, "Error: Memory allocation for mesh breakpoints failed\n");
+        return EXIT_FAILURE;
+    }
+    memcpy(point, breakpoint, (size_t)breakpoint_num * sizeof(double));
+    qsort(point, (size_t)breakpoint_num, sizeof(double), compare_double);
+    int point_num = 1;
+    for (int i = 1; i < breakpoint_num; i++) {
+        if (point[i] - point[point_num - 1] > AUTO_MESH_TOLERANCE) {
+            point[point_num++] = point[i];
+        }
+    }
+    if (point_num < (jig ? 4 : 2)) {
+        fprintf(stderr, "Error: Too few grid lines for automatic mesh (%d)\n", point_num);
+        free(point);
+        return EXIT_FAILURE;
+    }
+
+    int element_num = 0;
+    for (int i = 0; i + 1 < point_num; i++) {
+        int is_jig = jig && (i == 0 || i == point_num - 2);
+        element_num += interval_element_num(grading, point[i], point[i + 1], is_jig);
+    }
+    double* lengths = (double*)malloc((size_t)element_num * sizeof(double));
+    if (lengths == NULL) {
+        fprintf(stderr, "Error: Memory allocation for mesh lengths failed\n");
+        free(point);
+        return EXIT_FAILURE;
+    }
+
+    int k = 0;
+    for (int i = 0; i + 1 < point_num; i++) {
+        double a = point[i];
+        double b = point[i + 1];
+        int is_jig = jig && (i == 0 || i == point_num - 2);
+        int n = interval_element_num(grading, a, b, is_jig);
+        double ta = grading_integral(grading, a);
+        double tb = grading_integral(grading, b);
+        double previous = a;
+        for (int e = 1; e < n; e++) {
+            double s = grading_inverse(grading, ta + (tb - ta) * e / n);
+            double rounded = round(s / AUTO_MESH_RESOLUTION) * AUTO_MESH_RESOLUTION;
+            if (rounded > previous + AUTO_MESH_TOLERANCE && rounded < b - AUTO_MESH_TOLERANCE) {
+                s = rounded;
+            }
+            lengths[k++] = s - previous;
+            previous = s;
+        }
+        lengths[k++] = b - previous;
+    }
+    free(point);
+
+    free(mesh->lengths);
+    mesh->lengths = lengths;
+    mesh->mesh_num = element_num;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 座標が軸の内側(治具を除く)にあるかを確認する
+ */
+static int check_breakpoints(const double breakpoint[], int breakpoint_num, double low, double high, const char* axis_name) {
+    for (int i = 0; i < breakpoint_num; i++) {
+        if (breakpoint[i] < low - AUTO_MESH_TOLERANCE || breakpoint[i] > high + AUTO_MESH_TOLERANCE) {
+            fprintf(stderr, "Error: %s coordinate %.2f is outside %.2f ... %.2f\n", axis_name, breakpoint[i], low, high);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * JsonData の柱、梁、主筋、auto_mesh の条件から mesh_x, mesh_y, mesh_z を作る
+ *
+ * @param data json_parser で読み込んだデータ。auto_mesh.enabled が 0 の場合は何もしない
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int generate_auto_mesh(JsonData* data) {
+    if (data == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to generate_auto_mesh\n");
+        return EXIT_FAILURE;
+    }
+    const AutoMesh* param = &data->auto_mesh;
+    if (!param->enabled) {
+        return EXIT_SUCCESS;
+    }
+    if (param->element_size <= 0.0 || param->growth < 1.0 || param->max_aspect < 1.0 ||
+        param->jig_x <= 0.0 || param->jig_z <= 0.0) {
+        fprintf(stderr, "Error: 'auto_mesh' needs element_size > 0, growth >= 1, max_aspect >= 1, jig_x > 0 and jig_z > 0\n");
+        return EXIT_FAILURE;
+    }
+
+    const Column* column = &data->column;
+    const Beam* beam = &data->beam;
+    double length_x = beam->span;
+    double length_y = column->width;
+    double length_z = column->span;
+    double column_x = column->center_x - column->depth / 2;  // 梁、柱の境界(主筋の x の原点)
+
+    double* breakpoint = (double*)malloc((size_t)(9 + data->rebar.rebar_num) * sizeof(double));
+    if (breakpoint == NULL) {
+        fprintf(stderr, "Error: Memory allocation for mesh breakpoints failed\n");
+        return EXIT_FAILURE;
+    }
+    AutoMeshGrading grading = {0.0, 0.0, param->element_size, param->growth, param->element_size * param->max_aspect};
+    int result = EXIT_SUCCESS;
+
+    // x軸方向: 治具の内側に柱、直交梁の面、柱芯、主筋
+    int n = 0;
+    breakpoint[n++] = column_x;
+    breakpoint[n++] = column->center_x - beam->orthogonal_beam_width / 2;
+    breakpoint[n++] = column->center_x;
+    breakpoint[n++] = column->center_x + beam->orthogonal_beam_width / 2;
+    breakpoint[n++] = column->center_x + column->depth / 2;
+    for (int i = 0; i < data->rebar.rebar_num; i++) {
+        breakpoint[n++] = data->rebar.rebars[i].x + column_x;
+    }
+    result = check_breakpoints(breakpoint, n, param->jig_x, length_x - param->jig_x, "x");
+    if (result == EXIT_SUCCESS) {
+        breakpoint[n++] = 0.0;
+        breakpoint[n++] = param->jig_x;
+        breakpoint[n++] = length_x - param->jig_x;
+        breakpoint[n++] = length_x;
+        grading.joint_low = column_x;
+        grading.joint_high = column->center_x + column->depth / 2;
+        result = auto_mesh_axis(breakpoint, n, &grading, 1, &data->mesh_x);
+    }
+
+    // y軸方向: 梁の面、梁芯、主筋
+    if (result == EXIT_SUCCESS) {
+        n = 0;
+        breakpoint[n++] = beam->center_y - beam->width / 2;
+        breakpoint[n++] = beam->center_y;
+        breakpoint[n++] = beam->center_y + beam->width / 2;
+        for (int i = 0; i < data->rebar.rebar_num; i++) {
+            breakpoint[n++] = data->rebar.rebars[i].y;
+        }
+        result = check_breakpoints(breakpoint, n, 0.0, length_y, "y");
+    }
+    if (result == EXIT_SUCCESS) {
+        breakpoint[n++] = 0.0;
+        breakpoint[n++] = length_y;
+        grading.joint_low = 0.0;
+        grading.joint_high = length_y;
+        result = auto_mesh_axis(breakpoint, n, &grading, 0, &data->mesh_y);
+    }
+
+    // z軸方向: 治具の内側に梁の面、梁芯
+    if (result == EXIT_SUCCESS) {
+        n = 0;
+        breakpoint[n++] = beam->center_z - beam->depth / 2;
+        breakpoint[n++] = beam->center_z;
+        breakpoint[n++] = beam->center_z + beam->depth / 2;
+        result = check_breakpoints(breakpoint, n, param->jig_z, length_z - param->jig_z, "z");
+    }
+    if (result == EXIT_SUCCESS) {
+        breakpoint[n++] = 0.0;
+        breakpoint[n++] = param->jig_z;
+        breakpoint[n++] = length_z - param->jig_z;
+        breakpoint[n++] = length_z;
+        grading.joint_low = beam->center_z - beam->depth / 2;
+        grading.joint_high = beam->center_z + beam->depth / 2;
+        result = auto_mesh_axis(breakpoint, n, &grading, 1, &data->mesh_z);
+    }
+
+    free(breakpoint);
+    return result;
+}
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "block_mesh.h"
+#include "mesh_copy.h"
+#include "print_ffi.h"
+
+/**
+ * 軸の格子線の上に並べたブロック(IJK の範囲と TYPH)から六面体要素のメッシュを作る。
+ *
+ * 節点、要素の番号は格子の位置から決まり、隣り合うブロックの境界面の節点は同じ番号になる。
+ * 二重にした格子面(split_block_plane)は面の上側のブロックに別の番号を与える。
+ * NODE、HEXAとCOPYカードは陽な節点、要素から mesh_copy.c で作るため、
+ * ブロックの並べ方(外柱、隅柱、十字形の接合部など)によらず同じ手順で書き込める。
+ *   例: 梁の左右 → add_mesh_block を2つ → set_block_numbering → print_block_mesh
+ */
+
+/**
+ * 格子の軸の座標を複写してBlockMeshを作る
+ *
+ * @param axis 軸ごとの格子線の座標(昇順)
+ * @param axis_num 軸ごとの格子線の数
+ * @return BlockMesh。失敗した場合はNULL
+ */
+BlockMesh* create_block_mesh(double* const axis[3], const int axis_num[3]) {
+    if (axis == NULL || axis_num == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to create_block_mesh\n");
+        return NULL;
+    }
+    BlockMesh* mesh = (BlockMesh*)calloc(1, sizeof(BlockMesh));
+    if (mesh == NULL) {
+        fprintf(stderr, "Error: Memory allocation for BlockMesh failed\n");
+        return NULL;
+    }
+    for (int a = 0; a < 3; a++) {
+        if (axis[a] == NULL || axis_num[a] < 2) {
+            fprintf(stderr, "Error: Block mesh axis %d needs at least 2 grid lines\n", a);
+            free_block_mesh(mesh);
+            return NULL;
+        }
+        mesh->axis_num[a] = axis_num[a];
+        mesh->axis[a] = (double*)malloc((size_t)axis_num[a] * sizeof(double));
+        mesh->split[a] = (unsigned char*)calloc((size_t)axis_num[a], sizeof(unsigned char));
+        if (mesh->axis[a] == NULL || mesh->split[a] == NULL) {
+            fprintf(stderr, "Error: Memory allocation for block mesh axis failed\n");
+            free_block_mesh(mesh);
+            return NULL;
+        }
+        memcpy(mesh->axis[a], axis[a], (size_t)axis_num[a] * sizeof(double));
+    }
+    return mesh;
+}
+
+int free_block_mesh(BlockMesh* mesh) {
+    if (mesh == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (int a = 0; a < 3; a++) {
+        free(mesh->axis[a]);
+        free(mesh->split[a]);
+    }
+    free(mesh->block);
+    free(mesh);
+    return EXIT_SUCCESS;
+}
+
+static int blocks_overlap(const MeshBlock* p, const MeshBlock* q) {
+    for (int a = 0; a < 3; a++) {
+        if (p->high[a] <= q->low[a] || q->high[a] <= p->low[a]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * ブロックを加える。既にあるブロックと要素が重なる場合は加えない。
+ *
+ * @param low, high 格子線の番号の範囲(0 <= low < high < axis_num)
+ * @param type TYPH
+ * @return ブロックの番号。失敗した場合は-1
+ */
+int add_mesh_block(BlockMesh* mesh, const int low[3], const int high[3], int type) {
+    if (mesh == NULL || low == NULL || high == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to add_mesh_block\n");
+        return -1;
+    }
+    MeshBlock block;
+    for (int a = 0; a < 3; a++) {
+        if (low[a] < 0 || high[a] >= mesh->axis_num[a] || low[a] >= high[a]) {
+            fprintf(stderr, "Error: Invalid block range on axis %d (%d - %d)\n", a, low[a], high[a]);
+            return -1;
+        }
+        block.low[a] = low[a];
+        block.high[a] = high[a];
+    }
+    block.type = type;
+    for (int b = 0; b < mesh->block_num; b++) {
+        if (blocks_overlap(&mesh->block[b], &block)) {
+            fprintf(stderr, "Error: Block overlaps block %d\n", b);
+            return -1;
+        }
+    }
+    if (mesh->block_num >= mesh->block_capacity) {
+        int capacity = mesh->block_capacity > 0 ? mesh->block_capacity * 2 : 4;
+        MeshBlock* block_new = (MeshBlock*)realloc(mesh->block, (size_t)capacity * sizeof(MeshBlock));
+        if (block_new == NULL) {
+            fprintf(stderr, "Error: Memory allocation for mesh blocks failed\n");
+            return -1;
+        }
+        mesh->block = block_new;
+        mesh->block_capacity = capacity;
+    }
+    mesh->block[mesh->block_num] = block;
+    return mesh->block_num++;
+}
+
+/**
+ * 格子面を二重にする。面の上側(low[axis] = grid_index)のブロックは下側と別の節点を使う。
+ * 二重の格子面はブロックの境界でなければならない(build_block_mesh_modelで確かめる)。
+ */
+int split_block_plane(BlockMesh* mesh, int axis, int grid_index) {
+    if (mesh == NULL || axis < 0 || axis > 2 || grid_index <= 0 || grid_index >= mesh->axis_num[axis] - 1) {
+        fprintf(stderr, "Error: Invalid block plane (axis %d, %d)\n", axis, grid_index);
+        return EXIT_FAILURE;
+    }
+    mesh->split[axis][grid_index] = 1;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 番号の付け方を与える(既存の番号の割り当てに合わせる場合)
+ *
+ * @param origin 先頭の格子点(格子線の番号)
+ * @param node_head, element_head origin の節点番号、要素番号
+ * @param node_increment, element_increment 軸ごとの番号の増分
+ */
+int set_block_numbering(BlockMesh* mesh, const int origin[3], int node_head, int element_head,
+                        const int node_increment[3], const int element_increment[3]) {
+    if (mesh == NULL || origin == NULL || node_increment == NULL || element_increment == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to set_block_numbering\n");
+        return EXIT_FAILURE;
+    }
+    for (int a = 0; a < 3; a++) {
+        mesh->origin[a] = origin[a];
+        mesh->node_increment[a] = node_increment[a];
+        mesh->element_increment[a] = element_increment[a];
+    }
+    mesh->node_head = node_head;
+    mesh->element_head = element_head;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * g の手前の二重の格子面の数だけずらした格子線の番号(節点の並び)
+ */
+static int shifted_line(const BlockMesh* mesh, int axis, int g) {
+    int n = g;
+    for (int s = 0; s < g; s++) {
+        n += mesh->split[axis][s];
+    }
+    return n;
+}
+
+/**
+ * ブロックを囲む範囲に番号を詰めて付ける。
+ * 格子線(節点)の少ない軸から順に番号を進め、要素の節点番号の差(バンド幅)が小さくなるようにする。
+ *
+ * @param node_head, element_head 先頭の節点番号、要素番号
+ */
+int derive_block_numbering(BlockMesh* mesh, int node_head, int element_head) {
+    if (mesh == NULL || mesh->block_num == 0) {
+        fprintf(stderr, "Error: No block to number\n");
+        return EXIT_FAILURE;
+    }
+    int low[3], high[3];
+    for (int a = 0; a < 3; a++) {
+        low[a] = mesh->block[0].low[a];
+        high[a] = mesh->block[0].high[a];
+        for (int b = 1; b < mesh->block_num; b++) {
+            if (mesh->block[b].low[a] < low[a]) low[a] = mesh->block[b].low[a];
+            if (mesh->block[b].high[a] > high[a]) high[a] = mesh->block[b].high[a];
+        }
+    }
+
+    int line_num[3], cell_num[3], order[3] = {0, 1, 2};
+    for (int a = 0; a < 3; a++) {
+        line_num[a] = shifted_line(mesh, a, high[a]) - shifted_line(mesh, a, low[a]) + 1;
+        cell_num[a] = high[a] - low[a];
+    }
+    // 格子線の少ない順(同数は軸の順)
+    for (int i = 1; i < 3; i++) {
+        for (int j = i; j > 0 && line_num[order[j]] < line_num[order[j - 1]]; j--) {
+            int t = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = t;
+        }
+    }
+    int node_increment[3], element_increment[3];
+    int node_step = 1, element_step = 1;
+    for (int i = 0; i < 3; i++) {
+        node_increment[order[i]] = node_step;
+        element_increment[order[i]] = element_step;
+        node_step *= line_num[order[i]];
+        element_step *= cell_num[order[i]];
+    }
+    return set_block_numbering(mesh, low, node_head, element_head, node_increment, element_increment);
+}
+
+/**
+ * ブロック b の格子点 grid の節点番号
+ */
+int block_node_number(const BlockMesh* mesh, int b, const int grid[3]) {
+    int id = mesh->node_head;
+    for (int a = 0; a < 3; a++) {
+        int n = shifted_line(mesh, a, grid[a]) - shifted_line(mesh, a, mesh->origin[a]);
+        if (mesh->split[a][grid[a]] && mesh->block[b].low[a] == grid[a]) {
+            n++;
+        }
+        id += n * mesh->node_increment[a];
+    }
+    return id;
+}
+
+/**
+ * 格子線 cell ... cell + 1 の間の要素の番号
+ */
+int block_element_number(const BlockMesh* mesh, const int cell[3]) {
+    int id = mesh->element_head;
+    for (int a = 0; a < 3; a++) {
+        id += (cell[a] - mesh->origin[a]) * mesh->element_increment[a];
+    }
+    return id;
+}
+
+/**
+ * ブロックの節点、六面体要素をMeshModelに加える。
+ * 要素の節点の順番は print_HEXA_increment と同じ(下面 x, y の反時計回り、上面も同様)。
+ */
+int build_block_mesh_model(const BlockMesh* mesh, MeshModel* model) {
+    if (mesh == NULL || model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_block_mesh_model\n");
+        return EXIT_FAILURE;
+    }
+    // 八隅の格子のずれ
+    static const int corner[8][3] = {
+        {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+        {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}
+    };
+    for (int b = 0; b < mesh->block_num; b++) {
+        const MeshBlock* block = &mesh->block[b];
+        for (int a = 0; a < 3; a++) {
+            for (int g = block->low[a] + 1; g < block->high[a]; g++) {
+                if (mesh->split[a][g]) {
+                    fprintf(stderr, "Error: Block %d crosses the split plane (axis %d, %d)\n", b, a, g);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        int grid[3];
+        for (grid[2] = block->low[2]; grid[2] <= block->high[2]; grid[2]++) {
+            for (grid[1] = block->low[1]; grid[1] <= block->high[1]; grid[1]++) {
+                for (grid[0] = block->low[0]; grid[0] <= block->high[0]; grid[0]++) {
+                    int id = block_node_number(mesh, b, grid);
+                    if (add_mesh_node(model, id, mesh->axis[0][grid[0]], mesh->axis[1][grid[1]], mesh->axis[2][grid[2]]) < 0) {
+                        return EXIT_FAILURE;
+                    }
+                }
+            }
+        }
+
+        int cell[3];
+        for (cell[2] = block->low[2]; cell[2] < block->high[2]; cell[2]++) {
+            for (cell[1] = block->low[1]; cell[1] < block->high[1]; cell[1]++) {
+                for (cell[0] = block->low[0]; cell[0] < block->high[0]; cell[0]++) {
+                    int node[ELEMENT_NODE_MAX];
+                    for (int c = 0; c < 8; c++) {
+                        int point[3] = {cell[0] + corner[c][0], cell[1] + corner[c][1], cell[2] + corner[c][2]};
+                        node[c] = block_node_number(mesh, b, point);
+                    }
+                    if (add_mesh_element(model, block_element_number(mesh, cell), ELEMENT_HEXA, block->type, node) < 0) {
+                        return EXIT_FAILURE;
+                    }
+                }
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * ブロックの節点、要素をNODE、HEXAとCOPYカードで書き込む。
+ * COPYカードが展開後に一致しない場合は1行ずつ書き込む。
+ */
+int print_block_mesh(FILE* f, const BlockMesh* mesh) {
+    MeshModel* model = create_mesh_model();
+    if (model == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (build_block_mesh_model(mesh, model) != EXIT_SUCCESS) {
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+
+    CopyCardList* node_cards = create_copy_card_list();
+    CopyCardList* element_cards = create_copy_card_list();
+    int compressed = node_cards != NULL && element_cards != NULL &&
+                     synthesize_node_cards(model, node_cards) == EXIT_SUCCESS &&
+                     synthesize_element_cards(model, element_cards) == EXIT_SUCCESS &&
+                     verify_copy_cards(model, node_cards, element_cards) == EXIT_SUCCESS;
+    if (compressed) {
+        print_copy_cards(f, model, node_cards);
+        fprintf(f, "\n");
+        print_copy_cards(f, model, element_cards);
+    } else {
+        for (int n = 0; n < model->node_num; n++) {
+            print_NODE(f, model->node_id[n], model->x[n], model->y[n], model->z[n]);
+        }
+        fprintf(f, "\n");
+        for (int e = 0; e < model->element_num; e++) {
+            print_mesh_element(f, model, e, model->element_type[e]);
+        }
+    }
+    fprintf(f, "\n");
+
+    free_copy_card_list(node_cards);
+    free_copy_card_list(element_cards);
+    free_mesh_model(model);
+    return EXIT_SUCCESS;
+}
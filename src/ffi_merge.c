@@ -0,0 +1,619 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "ffi_merge.h"
+#include "mesh_model.h"
+#include "id_budget.h"
+
+/**
+ * ffi ファイルの結合(--merge)
+ *
+ * 各ファイルを先頭から1回だけ読み、節点、要素のカード(NODE、要素、COPY、ETYP、REST、SUB1)は
+ * 番号をずらしてそのまま出力ファイルに書き込む。MeshModel には読み込まないため、
+ * 使うメモリはモデルの大きさによらない。
+ *
+ * - ヘッダ(TITL、EXEC、DISP、LOAD など)は最初のファイルのものを使う
+ * - TYP*、MAT*、AXIS の定義は種類と番号ごとに1つにまとめ、最後にまとめて書き込む。
+ *   同じ番号で内容が異なる定義は要素の TYP 番号を変えられないためエラーにする
+ * - STEP 以降(FN、UE、OUT)は一時ファイルに退避し、STEP ごとに全てのファイルの荷重を並べる。
+ *   STEP の区切り(UP TO NO.)は全てのファイルで同じでなければならない。
+ *   一時ファイルはファイルごとに STEP の順に並ぶため、ファイルごとの読み込み位置を覚えておき、
+ *   全体を1回だけ読む
+ */
+
+// カードの種類
+typedef enum {
+    FFI_CARD_OTHER,
+    FFI_CARD_COMMENT,       // 空行、----
+    FFI_CARD_HEADER,        // TITL、EXEC、LIST、FILE、UNIT
+    FFI_CARD_MONITOR,       // DISP、LOAD (NO. が節点番号)
+    FFI_CARD_NODE,          // NODE :
+    FFI_CARD_ELEMENT,       // HEXA、QUAD、FILM、LINE、BEAM
+    FFI_CARD_NODE_RANGE,    // COPY、REST、SUB1、FN :NODE (S、E、M が節点番号)
+    FFI_CARD_ELEMENT_RANGE, // COPY、ETYP、UE :ELM (S、E が要素番号)
+    FFI_CARD_TABLE,         // TYP*、MAT*、AXIS
+    FFI_CARD_STEP,
+    FFI_CARD_OUT,
+    FFI_CARD_END
+} FfiCardKind;
+
+// 番号の種類
+#define FFI_FIELD_NONE    0
+#define FFI_FIELD_NODE    1
+#define FFI_FIELD_ELEMENT 2
+
+// TYP*、MAT*、AXIS の定義1つ
+typedef struct {
+    char name[5];
+    int id;
+    int kind_order;
+    int file_index;
+    char line[FFI_MERGE_LINE_MAX];
+} FfiTableEntry;
+
+// 結合中の状態
+typedef struct {
+    FILE* output;
+    FILE* spool;
+    long* spool_position;   // ファイルごとの一時ファイルの次に読む位置
+    int file_num;
+    FfiTableEntry* table;
+    int table_num;
+    int table_capacity;
+    char kind_name[32][5];
+    int kind_num;
+    int* step;
+    int step_num;
+    int step_capacity;
+    int step_file_index;
+    FfiMergeStatistics* statistics;
+} FfiMergeState;
+
+static int starts_with(const char* s, const char* prefix) {
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+static const char* skip_space(const char* line) {
+    while (*line == ' ') {
+        line++;
+    }
+    return line;
+}
+
+static FfiCardKind classify_card(const char* line) {
+    const char* p = skip_space(line);
+    if (*p == '\0' || *p == '\n' || *p == '\r' || starts_with(p, "--")) {
+        return FFI_CARD_COMMENT;
+    }
+    if (starts_with(p, "TITL :") || starts_with(p, "EXEC :") || starts_with(p, "LIST :") ||
+        starts_with(p, "FILE :") || starts_with(p, "UNIT :")) {
+        return FFI_CARD_HEADER;
+    }
+    if (starts_with(p, "DISP :") || starts_with(p, "LOAD :")) {
+        return FFI_CARD_MONITOR;
+    }
+    if (starts_with(p, "NODE :")) {
+        return FFI_CARD_NODE;
+    }
+    if (starts_with(p, "HEXA :") || starts_with(p, "QUAD :") || starts_with(p, "FILM :") ||
+        starts_with(p, "LINE :") || starts_with(p, "BEAM :")) {
+        return FFI_CARD_ELEMENT;
+    }
+    if ((starts_with(p, "TYP") || starts_with(p, "MAT") || starts_with(p, "AXIS")) && starts_with(p + 4, " :(")) {
+        return FFI_CARD_TABLE;
+    }
+    if (starts_with(p, "STEP :")) {
+        return FFI_CARD_STEP;
+    }
+    if (starts_with(p, "OUT :")) {
+        return FFI_CARD_OUT;
+    }
+    if (starts_with(p, "END")) {
+        return FFI_CARD_END;
+    }
+    const char* colon = strchr(p, ':');
+    if (colon != NULL && colon - p <= 5) {
+        if (starts_with(colon + 1, "NODE")) {
+            return FFI_CARD_NODE_RANGE;
+        }
+        if (starts_with(colon + 1, "ELM")) {
+            return FFI_CARD_ELEMENT_RANGE;
+        }
+    }
+    return FFI_CARD_OTHER;
+}
+
+/**
+ * '(' の直前の英字(S、E、M、NO.、NODE など)から括弧内の番号の種類を決める
+ *
+ * @param group 行の中で何番目の括弧か
+ */
+static int field_kind(const char* line, const char* paren, FfiCardKind kind, int group) {
+    const char* q = paren;
+    while (q > line && (isalpha((unsigned char)q[-1]) || q[-1] == '.')) {
+        q--;
+    }
+    size_t length = (size_t)(paren - q);
+    int is_range = (length == 1 && (*q == 'S' || *q == 'E' || *q == 'M'));
+    switch (kind) {
+    case FFI_CARD_NODE:
+        return group == 0 ? FFI_FIELD_NODE : FFI_FIELD_NONE;
+    case FFI_CARD_ELEMENT:
+        if (group == 0) return FFI_FIELD_ELEMENT;
+        if (group == 1 || (length == 4 && strncmp(q, "NODE", 4) == 0)) return FFI_FIELD_NODE;
+        return FFI_FIELD_NONE;
+    case FFI_CARD_NODE_RANGE:
+        return is_range ? FFI_FIELD_NODE : FFI_FIELD_NONE;
+    case FFI_CARD_ELEMENT_RANGE:
+        return (is_range && *q != 'M') ? FFI_FIELD_ELEMENT : FFI_FIELD_NONE;
+    case FFI_CARD_MONITOR:
+        return (length == 3 && strncmp(q, "NO.", 3) == 0) ? FFI_FIELD_NODE : FFI_FIELD_NONE;
+    default:
+        return FFI_FIELD_NONE;
+    }
+}
+
+/**
+ * カードの節点、要素番号をずらした行を作る(桁の位置は変えない)
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE(行が長すぎる)
+ */
+static int shift_card(const char* line, FfiCardKind kind, int node_offset, int element_offset, char* out, size_t size) {
+    size_t n = 0;
+    int group = 0;
+    const char* p = line;
+    while (*p != '\0') {
+        if (n + 1 >= size) {
+            return EXIT_FAILURE;
+        }
+        if (*p != '(') {
+            out[n++] = *p++;
+            continue;
+        }
+        int field = field_kind(line, p, kind, group++);
+        out[n++] = *p++;
+        // 括弧内の ':' で区切った値
+        while (*p != ')' && *p != '\0' && *p != '\n') {
+            const char* start = p;
+            while (*p != ':' && *p != ')' && *p != '\0' && *p != '\n') {
+                p++;
+            }
+            int width = (int)(p - start);
+            char* end;
+            long value = strtol(start, &end, 10);
+            int written;
+            if (field != FFI_FIELD_NONE && end != start && end <= p) {
+                int offset = (field == FFI_FIELD_NODE) ? node_offset : element_offset;
+                written = snprintf(out + n, size - n, "%*ld", width, value + offset);
+            } else {
+                written = snprintf(out + n, size - n, "%.*s", width, start);
+            }
+            if (written < 0 || (size_t)written >= size - n) {
+                return EXIT_FAILURE;
+            }
+            n += (size_t)written;
+            if (*p == ':') {
+                if (n + 1 >= size) {
+                    return EXIT_FAILURE;
+                }
+                out[n++] = *p++;
+            }
+        }
+    }
+    out[n] = '\0';
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点、要素を作るカード(NODE、要素、COPY)から最小、最大の番号を更新する(ずらす前の番号)
+ * COPY の元の番号は NODE、要素のカードにあるため、COPY は最大の番号だけを更新する。
+ */
+static void update_id_range(const char* line, FfiCardKind kind, int* min_node, int* max_node, int* min_element, int* max_element) {
+    int values[16] = {0};
+    const char* p = skip_space(line);
+    if (kind == FFI_CARD_NODE || kind == FFI_CARD_ELEMENT) {
+        parse_card_fields(line, values, 16);
+        int* min_id = (kind == FFI_CARD_NODE) ? min_node : min_element;
+        int* max_id = (kind == FFI_CARD_NODE) ? max_node : max_element;
+        if (values[0] > 0 && (*min_id == 0 || values[0] < *min_id)) *min_id = values[0];
+        if (values[0] > *max_id) *max_id = values[0];
+    } else if (starts_with(p, "COPY :NODE") || starts_with(p, "COPY :ELM")) {
+        // S、E、I、INC、SET (COPY :ELM は S、E、I、INC、NINC、SET)
+        int count = parse_card_fields(line, values, 16);
+        int last = (values[1] > 0 ? values[1] : values[0]) + values[3] * values[count > 5 ? 5 : 4];
+        int* max_id = (kind == FFI_CARD_NODE_RANGE) ? max_node : max_element;
+        if (last > *max_id) *max_id = last;
+    }
+}
+
+static size_t trimmed_length(const char* line) {
+    size_t length = strlen(line);
+    while (length > 0 && isspace((unsigned char)line[length - 1])) {
+        length--;
+    }
+    return length;
+}
+
+/**
+ * TYP*、MAT*、AXIS の定義を登録する。同じ定義は1つにまとめる
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE(同じ番号で内容が異なる、またはメモリ確保の失敗)
+ */
+static int add_table_entry(FfiMergeState* state, const char* line, int file_index, const FfiMergeInput inputs[]) {
+    const char* p = skip_space(line);
+    char name[5];
+    memcpy(name, p, 4);
+    name[4] = '\0';
+    int values[4] = {0};
+    parse_card_fields(line, values, 4);
+    int id = values[0];
+
+    for (int t = 0; t < state->table_num; t++) {
+        FfiTableEntry* entry = &state->table[t];
+        if (entry->id != id || strcmp(entry->name, name) != 0) {
+            continue;
+        }
+        size_t length = trimmed_length(line);
+        if (length != trimmed_length(entry->line) || strncmp(entry->line, line, length) != 0) {
+            fprintf(stderr, "Error: %s %d in %s differs from %s\n", name, id,
+                    inputs[file_index].file_name, inputs[entry->file_index].file_name);
+            return EXIT_FAILURE;
+        }
+        state->statistics->duplicate_table_num++;
+        return EXIT_SUCCESS;
+    }
+
+    int kind_order = 0;
+    while (kind_order < state->kind_num && strcmp(state->kind_name[kind_order], name) != 0) {
+        kind_order++;
+    }
+    if (kind_order == state->kind_num) {
+        if (state->kind_num == 32) {
+            fprintf(stderr, "Error: Too many table kinds in %s\n", inputs[file_index].file_name);
+            return EXIT_FAILURE;
+        }
+        strcpy(state->kind_name[state->kind_num++], name);
+    }
+    if (state->table_num == state->table_capacity) {
+        int capacity = state->table_capacity * 2 + 16;
+        FfiTableEntry* table = (FfiTableEntry*)realloc(state->table, (size_t)capacity * sizeof(FfiTableEntry));
+        if (table == NULL) {
+            fprintf(stderr, "Error: Memory allocation for table entries failed\n");
+            return EXIT_FAILURE;
+        }
+        state->table = table;
+        state->table_capacity = capacity;
+    }
+    FfiTableEntry* entry = &state->table[state->table_num++];
+    strcpy(entry->name, name);
+    entry->id = id;
+    entry->kind_order = kind_order;
+    entry->file_index = file_index;
+    snprintf(entry->line, sizeof(entry->line), "%s", line);
+    return EXIT_SUCCESS;
+}
+
+static int compare_table_entry(const void* a, const void* b) {
+    const FfiTableEntry* ea = (const FfiTableEntry*)a;
+    const FfiTableEntry* eb = (const FfiTableEntry*)b;
+    if (ea->kind_order != eb->kind_order) return ea->kind_order < eb->kind_order ? -1 : 1;
+    return (ea->id > eb->id) - (ea->id < eb->id);
+}
+
+/**
+ * STEP の区切りを確認する。最初に STEP があったファイルの区切りを基準にする
+ *
+ * @param segment ファイル内で何番目の STEP か
+ */
+static int check_step(FfiMergeState* state, const char* line, int segment, int file_index, const FfiMergeInput inputs[]) {
+    int values[2] = {0};
+    parse_card_fields(line, values, 2);
+    if (state->step_file_index < 0) {
+        state->step_file_index = file_index;
+    }
+    if (state->step_file_index == file_index) {
+        if (state->step_num == state->step_capacity) {
+            int capacity = state->step_capacity * 2 + 8;
+            int* step = (int*)realloc(state->step, (size_t)capacity * sizeof(int));
+            if (step == NULL) {
+                fprintf(stderr, "Error: Memory allocation for steps failed\n");
+                return EXIT_FAILURE;
+            }
+            state->step = step;
+            state->step_capacity = capacity;
+        }
+        state->step[state->step_num++] = values[0];
+        return EXIT_SUCCESS;
+    }
+    if (segment >= state->step_num || state->step[segment] != values[0]) {
+        fprintf(stderr, "Error: STEP UP TO NO.(%d) in %s does not match the steps of %s\n", values[0],
+                inputs[file_index].file_name, inputs[state->step_file_index].file_name);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int round_up_offset(int max_id) {
+    return (max_id + 999) / 1000 * 1000;
+}
+
+/**
+ * ファイル1つを読み、モデルのカードを書き込み、定義と STEP 以降を退避する
+ */
+static int merge_one_file(FfiMergeState* state, FfiMergeInput inputs[], int file_index) {
+    FfiMergeInput* input = &inputs[file_index];
+    FILE* f = fopen(input->file_name, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Cannot open %s\n", input->file_name);
+        return EXIT_FAILURE;
+    }
+    char line[FFI_MERGE_LINE_MAX];
+    char shifted[FFI_MERGE_LINE_MAX * 2];
+    state->spool_position[file_index] = ftell(state->spool);
+    int min_node = 0;
+    int max_node = 0;
+    int min_element = 0;
+    int max_element = 0;
+    int in_header = 1;
+    int in_table = 0;
+    int segment = -1;
+    int result = EXIT_SUCCESS;
+
+    while (result == EXIT_SUCCESS && fgets(line, sizeof(line), f) != NULL) {
+        state->statistics->line_num++;
+        if (strchr(line, '\n') == NULL && !feof(f)) {
+            fprintf(stderr, "Error: Line %d of %s is too long\n", state->statistics->line_num, input->file_name);
+            result = EXIT_FAILURE;
+            break;
+        }
+        FfiCardKind kind = classify_card(line);
+        if (kind == FFI_CARD_END) {
+            break;
+        }
+
+        // ヘッダ: 最初のファイルのものだけを書き込む
+        if (in_header) {
+            int section = (kind == FFI_CARD_COMMENT && starts_with(line, "---- "));
+            if (!section && (kind == FFI_CARD_COMMENT || kind == FFI_CARD_HEADER || kind == FFI_CARD_MONITOR)) {
+                if (file_index == 0) {
+                    if (shift_card(line, kind, input->node_offset, input->element_offset, shifted, sizeof(shifted)) != EXIT_SUCCESS) {
+                        result = EXIT_FAILURE;
+                    } else {
+                        fputs(shifted, state->output);
+                    }
+                }
+                continue;
+            }
+            in_header = 0;
+            fprintf(state->output, "---- %s (node +%d, element +%d) ----\n", input->file_name, input->node_offset, input->element_offset);
+        }
+
+        if (kind == FFI_CARD_STEP) {
+            segment++;
+            result = check_step(state, line, segment, file_index, inputs);
+        }
+        if (segment >= 0) {
+            // STEP 以降: 番号をずらして一時ファイルへ
+            if (kind == FFI_CARD_COMMENT) {
+                continue;
+            }
+            if (shift_card(line, kind, input->node_offset, input->element_offset, shifted, sizeof(shifted)) != EXIT_SUCCESS) {
+                result = EXIT_FAILURE;
+            } else {
+                fprintf(state->spool, "%d %d %s", segment, file_index, shifted);
+            }
+        } else if (kind == FFI_CARD_TABLE) {
+            in_table = 1;
+            result = add_table_entry(state, line, file_index, inputs);
+        } else if (kind == FFI_CARD_HEADER || kind == FFI_CARD_MONITOR || (in_table && kind == FFI_CARD_COMMENT)) {
+            // 2つ目以降のヘッダのカード、定義の間の空行は使わない
+            continue;
+        } else {
+            update_id_range(line, kind, &min_node, &max_node, &min_element, &max_element);
+            if (shift_card(line, kind, input->node_offset, input->element_offset, shifted, sizeof(shifted)) != EXIT_SUCCESS) {
+                fprintf(stderr, "Error: Line %d of %s is too long\n", state->statistics->line_num, input->file_name);
+                result = EXIT_FAILURE;
+            } else {
+                fputs(shifted, state->output);
+            }
+        }
+    }
+    fclose(f);
+
+    if (result == EXIT_SUCCESS && state->step_file_index >= 0 && segment >= 0 && segment + 1 != state->step_num) {
+        fprintf(stderr, "Error: %s has %d steps, %s has %d\n", input->file_name, segment + 1,
+                inputs[state->step_file_index].file_name, state->step_num);
+        result = EXIT_FAILURE;
+    }
+    input->min_node = min_node > 0 ? min_node + input->node_offset : 0;
+    input->max_node = max_node > 0 ? max_node + input->node_offset : 0;
+    input->min_element = min_element > 0 ? min_element + input->element_offset : 0;
+    input->max_element = max_element > 0 ? max_element + input->element_offset : 0;
+    if (result == EXIT_SUCCESS && (input->max_node > ID_BUDGET_MAX || input->max_element > ID_BUDGET_MAX)) {
+        fprintf(stderr, "Error: %s needs node %d, element %d (limit %d)\n", input->file_name,
+                input->max_node, input->max_element, ID_BUDGET_MAX);
+        result = EXIT_FAILURE;
+    }
+    return result;
+}
+
+/**
+ * 退避した STEP 以降を STEP ごとに書き込む。OUT は同じものを1つにまとめる
+ *
+ * 各ファイルの読み込み位置から、その STEP の行が続く間だけ読み進める
+ */
+static int write_steps(FfiMergeState* state) {
+    char line[FFI_MERGE_LINE_MAX * 2 + 32];
+    char (*out_line)[FFI_MERGE_LINE_MAX * 2] = NULL;
+    int out_capacity = 0;
+    int result = EXIT_SUCCESS;
+    for (int s = 0; s < state->step_num && result == EXIT_SUCCESS; s++) {
+        int out_num = 0;
+        for (int f = 0; f < state->file_num && result == EXIT_SUCCESS; f++) {
+            if (fseek(state->spool, state->spool_position[f], SEEK_SET) != 0) {
+                fprintf(stderr, "Error: Cannot read the temporary file for steps\n");
+                result = EXIT_FAILURE;
+                break;
+            }
+            while (1) {
+                long position = ftell(state->spool);
+                int segment, file_index, consumed;
+                if (fgets(line, sizeof(line), state->spool) == NULL
+                    || sscanf(line, "%d %d%n", &segment, &file_index, &consumed) != 2
+                    || segment != s || file_index != f) {
+                    // 次の STEP(または次のファイル)の行は次に読む
+                    state->spool_position[f] = position;
+                    break;
+                }
+                const char* card = line + consumed + 1;
+                FfiCardKind kind = classify_card(card);
+                if (kind == FFI_CARD_STEP && file_index != state->step_file_index) {
+                    continue;
+                }
+                if (kind != FFI_CARD_OUT) {
+                    fputs(card, state->output);
+                    continue;
+                }
+                int duplicate = 0;
+                for (int o = 0; o < out_num && !duplicate; o++) {
+                    duplicate = (strcmp(out_line[o], card) == 0);
+                }
+                if (duplicate) {
+                    continue;
+                }
+                if (out_num == out_capacity) {
+                    int capacity = out_capacity * 2 + 4;
+                    char (*grown)[FFI_MERGE_LINE_MAX * 2] = realloc(out_line, (size_t)capacity * sizeof(*out_line));
+                    if (grown == NULL) {
+                        fprintf(stderr, "Error: Memory allocation for OUT cards failed\n");
+                        result = EXIT_FAILURE;
+                        break;
+                    }
+                    out_line = grown;
+                    out_capacity = capacity;
+                }
+                snprintf(out_line[out_num++], sizeof(*out_line), "%s", card);
+            }
+        }
+        for (int o = 0; o < out_num; o++) {
+            fputs(out_line[o], state->output);
+        }
+        fputs("\n", state->output);
+    }
+    free(out_line);
+    return result;
+}
+
+/**
+ * 番号の範囲 [min_a, max_a] と [min_b, max_b] が重なるか(0 は番号が無い)
+ */
+static int id_ranges_overlap(int min_a, int max_a, int min_b, int max_b) {
+    return min_a > 0 && min_b > 0 && min_a <= max_b && min_b <= max_a;
+}
+
+/**
+ * file_index のファイルの節点、要素番号の範囲が、それまでのファイルの範囲と重ならないか調べる
+ */
+static int check_id_overlap(const FfiMergeInput inputs[], int file_index) {
+    const FfiMergeInput* input = &inputs[file_index];
+    for (int i = 0; i < file_index; i++) {
+        if (id_ranges_overlap(input->min_node, input->max_node, inputs[i].min_node, inputs[i].max_node)) {
+            fprintf(stderr, "Error: nodes %d - %d of %s overlap nodes %d - %d of %s (change the offset)\n",
+                    input->min_node, input->max_node, input->file_name, inputs[i].min_node, inputs[i].max_node, inputs[i].file_name);
+            return EXIT_FAILURE;
+        }
+        if (id_ranges_overlap(input->min_element, input->max_element, inputs[i].min_element, inputs[i].max_element)) {
+            fprintf(stderr, "Error: elements %d - %d of %s overlap elements %d - %d of %s (change the offset)\n",
+                    input->min_element, input->max_element, input->file_name, inputs[i].min_element, inputs[i].max_element, inputs[i].file_name);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * ffi ファイルを番号をずらして1つのファイルに結合する
+ *
+ * 各ファイルのずらした後の番号の範囲が他のファイルと重なる場合はエラーにし、出力ファイルを削除する。
+ *
+ * @param inputs 結合するファイル(FFI_MERGE_AUTO_OFFSET のずれは決めた値に置き換える)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int merge_ffi_files(const char* output_file_name, FfiMergeInput inputs[], int file_num, FfiMergeStatistics* statistics) {
+    if (output_file_name == NULL || inputs == NULL || file_num < 1 || statistics == NULL) {
+        fprintf(stderr, "Error: Invalid argument passed to merge_ffi_files\n");
+        return EXIT_FAILURE;
+    }
+    memset(statistics, 0, sizeof(FfiMergeStatistics));
+    FfiMergeState state;
+    memset(&state, 0, sizeof(state));
+    state.statistics = statistics;
+    state.step_file_index = -1;
+    state.file_num = file_num;
+    state.spool_position = (long*)calloc((size_t)file_num, sizeof(long));
+    if (state.spool_position == NULL) {
+        fprintf(stderr, "Error: Memory allocation for merge failed\n");
+        return EXIT_FAILURE;
+    }
+    state.output = fopen(output_file_name, "w");
+    if (state.output == NULL) {
+        fprintf(stderr, "Error: Cannot open %s\n", output_file_name);
+        free(state.spool_position);
+        return EXIT_FAILURE;
+    }
+    state.spool = tmpfile();
+    if (state.spool == NULL) {
+        fprintf(stderr, "Error: Cannot create a temporary file for steps\n");
+        fclose(state.output);
+        remove(output_file_name);
+        free(state.spool_position);
+        return EXIT_FAILURE;
+    }
+
+    int result = EXIT_SUCCESS;
+    for (int i = 0; i < file_num && result == EXIT_SUCCESS; i++) {
+        FfiMergeInput* input = &inputs[i];
+        if (input->node_offset == FFI_MERGE_AUTO_OFFSET) {
+            input->node_offset = round_up_offset(statistics->max_node);
+        }
+        if (input->element_offset == FFI_MERGE_AUTO_OFFSET) {
+            input->element_offset = round_up_offset(statistics->max_element);
+        }
+        result = merge_one_file(&state, inputs, i);
+        if (result == EXIT_SUCCESS) {
+            result = check_id_overlap(inputs, i);
+        }
+        if (input->max_node > statistics->max_node) statistics->max_node = input->max_node;
+        if (input->max_element > statistics->max_element) statistics->max_element = input->max_element;
+    }
+
+    if (result == EXIT_SUCCESS) {
+        // 定義: 種類の現れた順、番号の順
+        qsort(state.table, (size_t)state.table_num, sizeof(FfiTableEntry), compare_table_entry);
+        for (int t = 0; t < state.table_num; t++) {
+            if (t > 0 && starts_with(state.table[t].name, "MAT") && !starts_with(state.table[t - 1].name, "MAT")) {
+                fputs("\n", state.output);
+            }
+            fputs(state.table[t].line, state.output);
+        }
+        fputs("\n", state.output);
+        statistics->table_num = state.table_num;
+        statistics->step_num = state.step_num;
+        result = write_steps(&state);
+        fputs("END\n", state.output);
+    }
+
+    fclose(state.spool);
+    if (fclose(state.output) != 0) {
+        fprintf(stderr, "Error: Failed to write %s\n", output_file_name);
+        result = EXIT_FAILURE;
+    }
+    if (result != EXIT_SUCCESS) {
+        remove(output_file_name);
+    }
+    free(state.spool_position);
+    free(state.table);
+    free(state.step);
+    return result;
+}
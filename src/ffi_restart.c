@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ffi_restart.h"
+#include "mesh_model.h"
+#include "print_ffi.h"
+
+/**
+ * 再開点で分けた解析(--restart-segments)
+ *
+ * 長い繰り返し載荷の解析を、EXEC のステップの範囲と OUT だけが異なる複数の ffi に分ける。
+ * 2回目以降は RESTART=(1) で前の解析の再開用データから続けるため、途中で止まった場合は
+ * 止まった回の ffi から解析し直せばよい。
+ * - STEP、FN、UE は全ての回で同じものを書き込む。STEP の UP TO NO. は通しのステップ番号で、
+ *   前の回の STEP が無いと再開するステップの荷重の区切りが決まらないため。
+ * - OUT はその回のステップの範囲に切り詰め(前の回の結果を重ねて書き出さない)、
+ *   再開点(その回の最終ステップ)は LEVEL=(3) で必ず出力する。
+ * - 再開点は STEP の区切りであること(plan_restart_steps で合わせる)。
+ */
+
+/**
+ * OUT カードをステップの範囲 first - last に切り詰めて書き込む
+ *
+ * 再開点 last を LEVEL=(3) 以外で出力するカードは last の手前までにする(last は STEP の終わりで LEVEL=(3) を加える)。
+ *
+ * @return 再開点 last を LEVEL=(3) で出力する場合は 1
+ */
+static int write_clipped_out(FILE* output, const char* line, int first, int last) {
+    int values[16] = {0};
+    parse_card_fields(line, values, 16);
+    int start = values[0];
+    int end = (values[1] > 0) ? values[1] : start;
+    int interval = (values[2] > 0) ? values[2] : 1;
+    int level = values[3];
+    int clipped_start = start;
+    if (clipped_start < first) {
+        clipped_start = start + (first - start + interval - 1) / interval * interval;
+    }
+    int clipped_end = (end < last) ? end : last;
+    if (clipped_start > clipped_end) {
+        return 0;
+    }
+    int restart_point = (clipped_end == last && (last - clipped_start) % interval == 0);
+    if (restart_point && level != 3) {
+        clipped_end = last - interval;
+        restart_point = 0;
+        if (clipped_start > clipped_end) {
+            return 0;
+        }
+    }
+    if (clipped_start == start && clipped_end == end) {
+        fputs(line, output);
+    } else if (clipped_start == clipped_end) {
+        print_OUT_level(output, clipped_start, 0, 0, level);
+    } else {
+        print_OUT_level(output, clipped_start, clipped_end, interval, level);
+    }
+    return restart_point;
+}
+
+/**
+ * 1回分の ffi を書き込む(EXEC を置き換え、OUT を切り詰め、再開点の OUT を加える)
+ */
+static int write_restart_run(FILE* input, FILE* output, int first_step, int last_step, int restart) {
+    char line[FFI_RESTART_LINE_MAX];
+    int exec_num = 0;
+    int step_end = 0;       // 読んでいる STEP の UP TO NO.
+    int in_step = 0;
+    int restart_out = 0;    // 再開点を LEVEL=(3) で出力したか
+    int restart_found = 0;  // 再開点で終わる STEP があったか
+    int result = EXIT_SUCCESS;
+    while (result == EXIT_SUCCESS && fgets(line, sizeof(line), input) != NULL) {
+        int is_step = (strncmp(line, "STEP :", 6) == 0);
+        int is_end = (strncmp(line, "END", 3) == 0);
+        int is_blank = (strspn(line, " \t\r\n") == strlen(line));
+        // STEP の終わり(次の STEP、空行、END)で再開点の出力を加える
+        if (in_step && (is_step || is_end || is_blank)) {
+            if (step_end == last_step) {
+                restart_found = 1;
+                if (!restart_out) {
+                    print_OUT_level(output, last_step, 0, 0, 3);
+                }
+            }
+            in_step = 0;
+        }
+        if (strncmp(line, "EXEC :", 6) == 0) {
+            result = print_EXEC(output, first_step, last_step, restart);
+            exec_num++;
+        } else if (is_step) {
+            int values[16] = {0};
+            parse_card_fields(line, values, 16);
+            step_end = values[0];
+            in_step = 1;
+            restart_out = 0;
+            fputs(line, output);
+        } else if (in_step && strncmp(line, " OUT :", 6) == 0) {
+            restart_out |= write_clipped_out(output, line, first_step, last_step);
+        } else {
+            fputs(line, output);
+        }
+    }
+    if (in_step && step_end == last_step) {
+        restart_found = 1;
+        if (!restart_out) {
+            print_OUT_level(output, last_step, 0, 0, 3);
+        }
+    }
+    if (result == EXIT_SUCCESS && exec_num != 1) {
+        fprintf(stderr, "Error: expected 1 EXEC card, found %d\n", exec_num);
+        result = EXIT_FAILURE;
+    }
+    if (result == EXIT_SUCCESS && !restart_found) {
+        fprintf(stderr, "Error: restart step %d is not the end of a STEP\n", last_step);
+        result = EXIT_FAILURE;
+    }
+    return result;
+}
+
+/**
+ * k 回目(1から)の解析のファイル名。拡張子 .ffi の前に .run<k> を入れる(.ffi が無い場合は末尾に付ける)
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE (buffer に収まらない)
+ */
+int restart_file_name(const char* file_name, int run, char* buffer, int size) {
+    if (file_name == NULL || buffer == NULL || size <= 0) {
+        return EXIT_FAILURE;
+    }
+    size_t length = strlen(file_name);
+    int stem = (int)length;
+    if (length >= 4 && strcmp(file_name + length - 4, ".ffi") == 0) {
+        stem -= 4;
+    }
+    int written = snprintf(buffer, (size_t)size, "%.*s.run%d.ffi", stem, file_name, run);
+    if (written < 0 || written >= size) {
+        fprintf(stderr, "Error: File name for run %d of %s is too long\n", run, file_name);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 書き込み済みの ffi から、再開点で分けた解析の ffi を run_num 個書き込む
+ *
+ * k 回目の EXEC は STEP (前の回の最終ステップ + 1)-->(restart_step[k])、2回目以降は RESTART=(1)。
+ * OUT はその回の範囲に切り詰め、restart_step[k] を LEVEL=(3) で出力する。その他の行はそのまま写す。
+ *
+ * @param file_name 元の ffi (全てのステップ)
+ * @param restart_step k 回目の最終ステップ(plan_restart_steps)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int write_restart_runs(const char* file_name, const int restart_step[], int run_num) {
+    if (file_name == NULL || restart_step == NULL || run_num < 1) {
+        fprintf(stderr, "Error: invalid arguments passed to write_restart_runs\n");
+        return EXIT_FAILURE;
+    }
+    char run_file_name[FFI_RESTART_NAME_MAX];
+    for (int k = 0; k < run_num; k++) {
+        int first_step = (k == 0) ? 1 : restart_step[k - 1] + 1;
+        if (restart_step[k] < first_step) {
+            fprintf(stderr, "Error: restart step %d of run %d is before step %d\n", restart_step[k], k + 1, first_step);
+            return EXIT_FAILURE;
+        }
+        if (restart_file_name(file_name, k + 1, run_file_name, sizeof(run_file_name)) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        FILE* input = fopen(file_name, "r");
+        if (input == NULL) {
+            fprintf(stderr, "Error: Could not open file %s\n", file_name);
+            return EXIT_FAILURE;
+        }
+        FILE* output = fopen(run_file_name, "w");
+        if (output == NULL) {
+            fprintf(stderr, "Error: Could not open file %s\n", run_file_name);
+            fclose(input);
+            return EXIT_FAILURE;
+        }
+        int result = write_restart_run(input, output, first_step, restart_step[k], k > 0);
+        fclose(input);
+        fclose(output);
+        if (result != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: Failed to write run %d of %s\n", k + 1, file_name);
+            return EXIT_FAILURE;
+        }
+        printf("restart run %d: steps %d - %d -> %s\n", k + 1, first_step, restart_step[k], run_file_name);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,341 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fiber_section.h"
+#include "simd.h"
+
+/**
+ * 柱断面のファイバー解析(--section)
+ *
+ * FINAL で解析する前に、柱の幅、せい、圧縮強度と主筋の位置(JSON)から柱の M-φ と降伏、終局の曲げ耐力、
+ * 接合部パネルのせん断強度を求め、どちらで決まるかと降伏の部材角の目安を出す。
+ * 断面のひずみは平面保持とし、圧縮縁のひずみを増やしながら軸力が釣り合う曲率を求める。
+ * 断面力はファイバーの配列に対して simd.h の関数で SIMD_WIDTH 個ずつまとめて計算する。
+ */
+
+void initialize_section_material(SectionMaterial* material) {
+    if (material == NULL) {
+        return;
+    }
+    material->rebar_area = FIBER_REBAR_AREA;
+    material->steel_modulus = FIBER_STEEL_MODULUS;
+    material->steel_yield = FIBER_STEEL_YIELD;
+    material->steel_hardening = FIBER_STEEL_HARDENING;
+    material->axial_stress = FIBER_AXIAL_STRESS;
+}
+
+// SIMD_WIDTH の倍数に切り上げる
+static int round_up_width(int n) {
+    return (n + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+}
+
+/**
+ * 柱の断面のファイバーを作る
+ *
+ * - コンクリートはせいを FIBER_CONCRETE_LAYER_NUM 層に等分する(主筋の断面積は差し引かない)。
+ * - 主筋はハーフモデルの位置(x: 柱の面から、y: 柱の面から梁芯まで)を梁芯(y = 幅 / 2)で鏡映する。梁芯の上の主筋は1本とする。
+ *
+ * @return FiberSection。失敗した場合は NULL
+ */
+FiberSection* create_fiber_section(const JsonData* data, const SectionMaterial* material) {
+    if (data == NULL || material == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to create_fiber_section\n");
+        return NULL;
+    }
+    const Column* column = &data->column;
+    if (column->width <= 0.0 || column->depth <= 0.0 || column->compressive_strength <= 0.0) {
+        fprintf(stderr, "Error: column width, depth and compressive_strength must be positive\n");
+        return NULL;
+    }
+    FiberSection* section = (FiberSection*)calloc(1, sizeof(FiberSection));
+    if (section == NULL) {
+        fprintf(stderr, "Error: Memory allocation for FiberSection failed\n");
+        return NULL;
+    }
+    section->width = column->width;
+    section->depth = column->depth;
+    section->compressive_strength = column->compressive_strength;
+    section->material = *material;
+    section->axial_force = material->axial_stress * column->width * column->depth;
+
+    int rebar_num = 0;
+    for (int i = 0; i < data->rebar.rebar_num; i++) {
+        rebar_num += (fabs(data->rebar.rebars[i].y - column->width / 2.0) < 1.0e-6) ? 1 : 2;
+    }
+    section->concrete_num = round_up_width(FIBER_CONCRETE_LAYER_NUM);
+    section->steel_num = round_up_width((rebar_num > 0) ? rebar_num : 1);
+    section->concrete_x = (double*)calloc((size_t)section->concrete_num, sizeof(double));
+    section->concrete_area = (double*)calloc((size_t)section->concrete_num, sizeof(double));
+    section->steel_x = (double*)calloc((size_t)section->steel_num, sizeof(double));
+    section->steel_area = (double*)calloc((size_t)section->steel_num, sizeof(double));
+    if (section->concrete_x == NULL || section->concrete_area == NULL || section->steel_x == NULL || section->steel_area == NULL) {
+        fprintf(stderr, "Error: Memory allocation for FiberSection failed\n");
+        free_fiber_section(section);
+        return NULL;
+    }
+
+    double layer = column->depth / FIBER_CONCRETE_LAYER_NUM;
+    for (int i = 0; i < FIBER_CONCRETE_LAYER_NUM; i++) {
+        section->concrete_x[i] = -column->depth / 2.0 + (i + 0.5) * layer;
+        section->concrete_area[i] = layer * column->width;
+    }
+    int k = 0;
+    for (int i = 0; i < data->rebar.rebar_num; i++) {
+        int copies = (fabs(data->rebar.rebars[i].y - column->width / 2.0) < 1.0e-6) ? 1 : 2;
+        for (int c = 0; c < copies; c++) {
+            section->steel_x[k] = data->rebar.rebars[i].x - column->depth / 2.0;
+            section->steel_area[k] = material->rebar_area;
+            k++;
+        }
+    }
+    section->rebar_num = rebar_num;
+    return section;
+}
+
+int free_fiber_section(FiberSection* section) {
+    if (section == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(section->concrete_x);
+    free(section->concrete_area);
+    free(section->steel_x);
+    free(section->steel_area);
+    free(section);
+    return EXIT_SUCCESS;
+}
+
+// SIMD_WIDTH 個の要素の和
+static double simd_sum(simd_double a) {
+    double lane[SIMD_WIDTH];
+    simd_store(lane, a);
+    double sum = 0.0;
+    for (int i = 0; i < SIMD_WIDTH; i++) {
+        sum += lane[i];
+    }
+    return sum;
+}
+
+/**
+ * 断面の軸力と曲げモーメント(断面の中心回り)
+ *
+ * ひずみは ε(x) = top_strain - curvature * (depth / 2 - x) (圧縮を正、x = depth / 2 が圧縮縁)。
+ * - コンクリート: r = clamp(ε / ε0, 0, 1) として fc (2r - r^2)。ε0 を超えると ε = εcu で FIBER_CONCRETE_SOFTENING fc 下がる直線。
+ * - 主筋: clamp(Es ε, -fy, fy) に降伏後の剛性 HR Es の分を加える(バイリニア)。
+ * 分岐しない形にして SIMD_WIDTH 個のファイバーをまとめて計算する。
+ */
+void section_force(const FiberSection* section, double top_strain, double curvature, double* axial, double* moment) {
+    const SectionMaterial* material = &section->material;
+    simd_double offset = simd_set1(top_strain - curvature * section->depth / 2.0);
+    simd_double phi = simd_set1(curvature);
+    simd_double zero = simd_set1(0.0);
+    simd_double one = simd_set1(1.0);
+    simd_double two = simd_set1(2.0);
+
+    simd_double fc = simd_set1(section->compressive_strength);
+    simd_double peak = simd_set1(FIBER_CONCRETE_PEAK_STRAIN);
+    simd_double inverse_peak = simd_set1(1.0 / FIBER_CONCRETE_PEAK_STRAIN);
+    simd_double softening = simd_set1(section->compressive_strength * FIBER_CONCRETE_SOFTENING /
+                                      (FIBER_CONCRETE_ULTIMATE_STRAIN - FIBER_CONCRETE_PEAK_STRAIN));
+    simd_double force = zero;
+    simd_double torque = zero;
+    for (int i = 0; i < section->concrete_num; i += SIMD_WIDTH) {
+        simd_double x = simd_load(&section->concrete_x[i]);
+        simd_double strain = simd_fmadd(phi, x, offset);
+        simd_double r = simd_min(simd_max(simd_mul(strain, inverse_peak), zero), one);
+        simd_double stress = simd_mul(fc, simd_mul(r, simd_sub(two, r)));
+        stress = simd_sub(stress, simd_mul(softening, simd_max(simd_sub(strain, peak), zero)));
+        simd_double f = simd_mul(stress, simd_load(&section->concrete_area[i]));
+        force = simd_add(force, f);
+        torque = simd_fmadd(f, x, torque);
+    }
+
+    simd_double es = simd_set1(material->steel_modulus);
+    simd_double fy = simd_set1(material->steel_yield);
+    simd_double minus_fy = simd_set1(-material->steel_yield);
+    simd_double yield_strain = simd_set1(material->steel_yield / material->steel_modulus);
+    simd_double minus_yield_strain = simd_set1(-material->steel_yield / material->steel_modulus);
+    simd_double hardening = simd_set1(material->steel_hardening * material->steel_modulus);
+    for (int i = 0; i < section->steel_num; i += SIMD_WIDTH) {
+        simd_double x = simd_load(&section->steel_x[i]);
+        simd_double strain = simd_fmadd(phi, x, offset);
+        simd_double stress = simd_min(simd_max(simd_mul(es, strain), minus_fy), fy);
+        simd_double plastic = simd_add(simd_max(simd_sub(strain, yield_strain), zero), simd_min(simd_sub(strain, minus_yield_strain), zero));
+        stress = simd_fmadd(hardening, plastic, stress);
+        simd_double f = simd_mul(stress, simd_load(&section->steel_area[i]));
+        force = simd_add(force, f);
+        torque = simd_fmadd(f, x, torque);
+    }
+    *axial = simd_sum(force);
+    *moment = simd_sum(torque);
+}
+
+/**
+ * 圧縮縁のひずみが top_strain のとき、軸力が釣り合う曲率(Illinois 法)
+ *
+ * 曲率を増やすと中立軸が圧縮縁に近づき軸力は減る。0 と中立軸の深さ depth / 100 の曲率の間で、
+ * 軸力の差が軸力の FIBER_SOLVE_TOLERANCE 倍以下になるまで挟み込む。
+ */
+static double balance_curvature(const FiberSection* section, double top_strain, double* moment) {
+    double target = section->axial_force;
+    double tolerance = FIBER_SOLVE_TOLERANCE * ((target > 1.0) ? target : 1.0);
+    double low = 0.0;
+    double high = top_strain / (0.01 * section->depth);
+    double axial = 0.0;
+    section_force(section, top_strain, low, &axial, moment);
+    double f_low = axial - target;
+    section_force(section, top_strain, high, &axial, moment);
+    double f_high = axial - target;
+    double curvature = high;
+    int side = 0;
+    for (int n = 0; n < FIBER_SOLVE_ITERATION_MAX && fabs(f_high - f_low) > 0.0; n++) {
+        curvature = (low * f_high - high * f_low) / (f_high - f_low);
+        section_force(section, top_strain, curvature, &axial, moment);
+        double f = axial - target;
+        if (fabs(f) <= tolerance) {
+            return curvature;
+        }
+        if (f > 0.0) {
+            low = curvature;
+            f_low = f;
+            if (side == -1) f_high *= 0.5;
+            side = -1;
+        } else {
+            high = curvature;
+            f_high = f;
+            if (side == 1) f_low *= 0.5;
+            side = 1;
+        }
+    }
+    return curvature;
+}
+
+/**
+ * 柱の M-φ を求める
+ *
+ * 軸力だけの一様なひずみ ε_a から圧縮縁のひずみを FIBER_CONCRETE_ULTIMATE_STRAIN まで FIBER_CURVATURE_NUM 等分して増やす。
+ * 引張側の端の主筋のひずみが -εy を超える点を前後の点の直線補間で求めて降伏点とする。
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE (軸力が断面の圧縮耐力を超える)
+ */
+int analyze_moment_curvature(const FiberSection* section, MomentCurvature* result) {
+    if (section == NULL || result == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to analyze_moment_curvature\n");
+        return EXIT_FAILURE;
+    }
+    *result = (MomentCurvature){0};
+
+    // 軸力だけの一様なひずみ
+    double axial = 0.0;
+    double moment = 0.0;
+    section_force(section, FIBER_CONCRETE_ULTIMATE_STRAIN, 0.0, &axial, &moment);
+    if (axial < section->axial_force) {
+        fprintf(stderr, "Error: axial force %.1f kN exceeds the section capacity %.1f kN\n", section->axial_force / 1.0e3, axial / 1.0e3);
+        return EXIT_FAILURE;
+    }
+    double low = 0.0;
+    double high = FIBER_CONCRETE_ULTIMATE_STRAIN;
+    for (int n = 0; n < FIBER_SOLVE_ITERATION_MAX; n++) {
+        double middle = 0.5 * (low + high);
+        section_force(section, middle, 0.0, &axial, &moment);
+        if (axial < section->axial_force) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    double axial_strain = 0.5 * (low + high);
+
+    // 引張側の端の主筋
+    double tension_x = 0.0;
+    for (int i = 0; i < section->rebar_num; i++) {
+        if (i == 0 || section->steel_x[i] < tension_x) tension_x = section->steel_x[i];
+    }
+    double yield_strain = section->material.steel_yield / section->material.steel_modulus;
+
+    result->curvature[0] = 0.0;
+    result->moment[0] = 0.0;
+    double previous_steel = axial_strain;
+    for (int k = 1; k <= FIBER_CURVATURE_NUM; k++) {
+        double top_strain = axial_strain + (FIBER_CONCRETE_ULTIMATE_STRAIN - axial_strain) * k / FIBER_CURVATURE_NUM;
+        double curvature = balance_curvature(section, top_strain, &moment);
+        result->curvature[k] = curvature;
+        result->moment[k] = moment;
+        if (moment > result->max_moment) {
+            result->max_moment = moment;
+        }
+        double steel = top_strain - curvature * (section->depth / 2.0 - tension_x);
+        if (section->rebar_num > 0 && result->yield_curvature == 0.0 && steel <= -yield_strain) {
+            double t = (previous_steel + yield_strain) / (previous_steel - steel);
+            result->yield_curvature = result->curvature[k - 1] + t * (curvature - result->curvature[k - 1]);
+            result->yield_moment = result->moment[k - 1] + t * (moment - result->moment[k - 1]);
+        }
+        previous_steel = steel;
+    }
+    result->point_num = FIBER_CURVATURE_NUM + 1;
+    result->ultimate_curvature = result->curvature[FIBER_CURVATURE_NUM];
+    result->ultimate_moment = result->moment[FIBER_CURVATURE_NUM];
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 柱の曲げと接合部パネルのせん断から、柱のせん断力(載荷点の水平力)の目安を求める
+ *
+ * - 柱: 接合部の面(載荷点から (H - 梁せい) / 2)の曲げモーメントが My、Mmax になるせん断力。H は柱の span。
+ * - 接合部: Vju = 0.8 fc^0.7 x 柱の幅 x せい (コンクリートのみ。鉄骨梁のウェブは考えない)。
+ *   梁のフランジの間の距離を梁せいとして、パネルのせん断力 Vj = Qc (H / 梁せい - 1) から Qc を求める。
+ * - 降伏の部材角は柱を長さ H / 2 の片持ち柱として φy (H / 2) / 3 (estimate_yield_drift と同じ)。
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int screen_section(const JsonData* data, const SectionMaterial* material, SectionScreening* screening) {
+    if (data == NULL || material == NULL || screening == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to screen_section\n");
+        return EXIT_FAILURE;
+    }
+    *screening = (SectionScreening){0};
+    double height = data->column.span;
+    double beam_depth = data->beam.depth;
+    if (height <= beam_depth || beam_depth <= 0.0) {
+        fprintf(stderr, "Error: column span (%.1f) must be larger than the beam depth (%.1f)\n", height, beam_depth);
+        return EXIT_FAILURE;
+    }
+    FiberSection* section = create_fiber_section(data, material);
+    if (section == NULL) {
+        return EXIT_FAILURE;
+    }
+    int result = analyze_moment_curvature(section, &screening->column);
+    free_fiber_section(section);
+    if (result != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    double face = (height - beam_depth) / 2.0;
+    screening->column_yield_shear = screening->column.yield_moment / face;
+    screening->column_ultimate_shear = screening->column.max_moment / face;
+    screening->joint_shear_strength = 0.8 * pow(data->column.compressive_strength, 0.7) * data->column.width * data->column.depth;
+    screening->joint_column_shear = screening->joint_shear_strength / (height / beam_depth - 1.0);
+    screening->yield_drift = screening->column.yield_curvature * (height / 2.0) / 3.0;
+    screening->joint_governs = screening->joint_column_shear < screening->column_ultimate_shear;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 断面の検討の結果を表示する(kN、kN·m)
+ */
+void print_section_screening(const SectionScreening* screening, double elapsed_us) {
+    if (screening == NULL) {
+        return;
+    }
+    const MomentCurvature* column = &screening->column;
+    if (column->yield_curvature > 0.0) {
+        printf("column yield:    phi %.3e 1/mm, M %8.1f kN*m\n", column->yield_curvature, column->yield_moment / 1.0e6);
+    } else {
+        printf("column yield:    none (rebars do not yield before the concrete reaches %.4f)\n", FIBER_CONCRETE_ULTIMATE_STRAIN);
+    }
+    printf("column ultimate: phi %.3e 1/mm, M %8.1f kN*m (max %.1f kN*m)\n", column->ultimate_curvature,
+           column->ultimate_moment / 1.0e6, column->max_moment / 1.0e6);
+    printf("column shear:    yield %.1f kN, max %.1f kN\n", screening->column_yield_shear / 1.0e3, screening->column_ultimate_shear / 1.0e3);
+    printf("joint shear:     Vju %.1f kN -> column shear %.1f kN\n", screening->joint_shear_strength / 1.0e3, screening->joint_column_shear / 1.0e3);
+    printf("governed by %s, yield drift %.5f (%.1f us)\n", screening->joint_governs ? "joint shear" : "column flexure",
+           screening->yield_drift, elapsed_us);
+}
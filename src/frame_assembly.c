@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "frame_assembly.h"
+#include "range_set.h"
+#include "id_budget.h"
+
+/**
+ * 接合部の架構への組み立て
+ *
+ * modeling_rcs で作った1つの接合部のモデル(節点、要素)はそのまま書き込み、
+ * 他の接合部は番号をずらした COPY :NODE、COPY :ELM (MeshModel の instance_copy)で作る。
+ * x 方向の COPY は全ての接合部の番号の範囲を1枚で SET (bay_num - 1) 回複写し、
+ * z 方向の COPY は x 方向の各接合部について SET (story_num - 1) 回複写するため、
+ * 節点、要素のカードの数は接合部の数ではなく元の接合部の番号の範囲の数で決まる。
+ *
+ * 隣り合う接合部の梁端(x)、柱端(z)で同じ位置にある節点は SUB1 (3方向)で結ぶ。
+ * 結んだ端部(架構の内側)の REST は interface_rc の方向(ハーフモデルの切断面など)だけを残し、
+ * SUB1、FN、UE は除く。架構の外側の端部の境界条件、荷重は各接合部のものを番号をずらして付ける。
+ */
+
+// 端部の面
+#define FRAME_FACE_X_LOW  1
+#define FRAME_FACE_X_HIGH 2
+#define FRAME_FACE_Z_LOW  4
+#define FRAME_FACE_Z_HIGH 8
+
+// 端部の面上にあるとみなす座標の差
+#define FRAME_ASSEMBLY_TOLERANCE 1e-6
+
+/**
+ * 端部の節点を同じ位置の節点と組にするための並べ替えのキー(座標は 0.01 単位)
+ */
+typedef struct {
+    long long key[2];
+    int id;
+    int index;
+} FrameFaceKey;
+
+static int compare_face_position(const FrameFaceKey* a, const FrameFaceKey* b) {
+    for (int k = 0; k < 2; k++) {
+        if (a->key[k] != b->key[k]) return (a->key[k] < b->key[k]) ? -1 : 1;
+    }
+    return 0;
+}
+
+static int compare_face_key(const void* a, const void* b) {
+    const FrameFaceKey* p = (const FrameFaceKey*)a;
+    const FrameFaceKey* q = (const FrameFaceKey*)b;
+    int c = compare_face_position(p, q);
+    if (c != 0) return c;
+    return (p->id > q->id) - (p->id < q->id);
+}
+
+static int round_up_offset(int max_id) {
+    return (max_id + 999) / 1000 * 1000;
+}
+
+/**
+ * 接合部の大きさと番号の範囲から架構の配置を決める
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE (数が不正、または番号が5桁に収まらない)
+ */
+int plan_frame_layout(const MeshModel* joint, int bay_num, int story_num, FrameLayout* layout) {
+    if (joint == NULL || layout == NULL || joint->node_num == 0) {
+        fprintf(stderr, "Error: Invalid argument passed to plan_frame_layout\n");
+        return EXIT_FAILURE;
+    }
+    if (bay_num < 1 || story_num < 1) {
+        fprintf(stderr, "Error: invalid frame size %d x %d\n", bay_num, story_num);
+        return EXIT_FAILURE;
+    }
+    double min[2] = {joint->x[0], joint->z[0]};
+    double max[2] = {joint->x[0], joint->z[0]};
+    int max_node = 0;
+    for (int n = 0; n < joint->node_num; n++) {
+        min[0] = fmin(min[0], joint->x[n]);
+        max[0] = fmax(max[0], joint->x[n]);
+        min[1] = fmin(min[1], joint->z[n]);
+        max[1] = fmax(max[1], joint->z[n]);
+        if (joint->node_id[n] > max_node) max_node = joint->node_id[n];
+    }
+    int max_element = 0;
+    for (int e = 0; e < joint->element_num; e++) {
+        if (joint->element_id[e] > max_element) max_element = joint->element_id[e];
+    }
+
+    *layout = (FrameLayout){0};
+    layout->bay_num = bay_num;
+    layout->story_num = story_num;
+    layout->pitch[0] = max[0] - min[0];
+    layout->pitch[1] = max[1] - min[1];
+    layout->node_offset = round_up_offset(max_node);
+    layout->element_offset = round_up_offset(max_element);
+
+    long long instance_num = (long long)bay_num * story_num;
+    long long last_node = max_node + (instance_num - 1) * layout->node_offset;
+    long long last_element = max_element + (instance_num - 1) * layout->element_offset;
+    if (last_node > ID_BUDGET_MAX || last_element > ID_BUDGET_MAX) {
+        fprintf(stderr, "Error: %d x %d joints need node %lld, element %lld (limit %d)\n",
+                bay_num, story_num, last_node, last_element, ID_BUDGET_MAX);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * low の面と high の面の同じ位置の節点を組にする(同じ位置に複数ある場合は番号順)
+ *
+ * @param axis 面内の2つの座標(0:x, 1:y, 2:z)
+ * @param slave, master 組の low、high の面の節点の配列番号
+ * @return 組の数
+ */
+static int match_face_nodes(const MeshModel* joint, const unsigned char face[], int low, int high, const int axis[2],
+                            int slave[], int master[], int* unmatched) {
+    FrameFaceKey* low_key = (FrameFaceKey*)malloc(((size_t)joint->node_num + 1) * sizeof(FrameFaceKey));
+    FrameFaceKey* high_key = (FrameFaceKey*)malloc(((size_t)joint->node_num + 1) * sizeof(FrameFaceKey));
+    if (low_key == NULL || high_key == NULL) {
+        fprintf(stderr, "Error: Memory allocation for assemble_frame failed\n");
+        free(low_key);
+        free(high_key);
+        return -1;
+    }
+    const double* coordinate[3] = {joint->x, joint->y, joint->z};
+    int low_num = 0;
+    int high_num = 0;
+    for (int n = 0; n < joint->node_num; n++) {
+        FrameFaceKey key = {
+            {llround(coordinate[axis[0]][n] * 100.0), llround(coordinate[axis[1]][n] * 100.0)},
+            joint->node_id[n], n
+        };
+        if (face[n] & low) low_key[low_num++] = key;
+        if (face[n] & high) high_key[high_num++] = key;
+    }
+    qsort(low_key, (size_t)low_num, sizeof(FrameFaceKey), compare_face_key);
+    qsort(high_key, (size_t)high_num, sizeof(FrameFaceKey), compare_face_key);
+
+    int pair_num = 0;
+    int j = 0;
+    for (int i = 0; i < low_num; i++) {
+        while (j < high_num && compare_face_position(&high_key[j], &low_key[i]) < 0) {
+            j++;
+        }
+        if (j < high_num && compare_face_position(&high_key[j], &low_key[i]) == 0) {
+            slave[pair_num] = low_key[i].index;
+            master[pair_num] = high_key[j++].index;
+            pair_num++;
+        }
+    }
+    *unmatched += (low_num - pair_num) + (high_num - pair_num);
+    free(low_key);
+    free(high_key);
+    return pair_num;
+}
+
+// 拘束条件の桁(xyz)ごとの論理積
+static int intersect_rc(int a, int b) {
+    int rc = 0;
+    for (int digit = 100; digit > 0; digit /= 10) {
+        if ((a / digit) % 10 != 0 && (b / digit) % 10 != 0) {
+            rc += digit;
+        }
+    }
+    return rc;
+}
+
+/**
+ * 接合部 (i, k) で、端部の面 face が架構の内側(隣の接合部と結ぶ面)か
+ *
+ * @return 1: low の面(従属節点の側), 2: high の面(主節点の側), 0: 外側、または端部ではない
+ */
+static int interior_side(const FrameLayout* layout, unsigned char face, int i, int k) {
+    if (((face & FRAME_FACE_X_LOW) && i > 0) || ((face & FRAME_FACE_Z_LOW) && k > 0)) {
+        return 1;
+    }
+    if (((face & FRAME_FACE_X_HIGH) && i < layout->bay_num - 1) || ((face & FRAME_FACE_Z_HIGH) && k < layout->story_num - 1)) {
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * 境界条件(REST、SUB1)と STEPデータ(FN、UE)を接合部ごとに付け直す
+ */
+static int instance_boundary(MeshModel* joint, const FrameLayout* layout, const unsigned char face[], const unsigned char element_face[],
+                             int interface_rc) {
+    int restraint_num = joint->restraint_num;
+    int constraint_num = joint->constraint_num;
+    int step_card_num = joint->step_card_num;
+    MeshRestraint* restraint = (MeshRestraint*)malloc(((size_t)restraint_num + 1) * sizeof(MeshRestraint));
+    MeshConstraint* constraint = (MeshConstraint*)malloc(((size_t)constraint_num + 1) * sizeof(MeshConstraint));
+    StepCard* step_card = joint->step_card;
+    if (restraint == NULL || constraint == NULL) {
+        fprintf(stderr, "Error: Memory allocation for assemble_frame failed\n");
+        free(restraint);
+        free(constraint);
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < restraint_num; r++) restraint[r] = joint->restraint[r];
+    for (int c = 0; c < constraint_num; c++) constraint[c] = joint->constraint[c];
+    joint->restraint_num = 0;
+    joint->constraint_num = 0;
+    joint->step_card = NULL;
+    joint->step_card_num = 0;
+    joint->step_card_capacity = 0;
+
+    int result = EXIT_SUCCESS;
+    for (int k = 0; k < layout->story_num && result == EXIT_SUCCESS; k++) {
+        for (int i = 0; i < layout->bay_num && result == EXIT_SUCCESS; i++) {
+            int t = k * layout->bay_num + i;
+            int node_shift = t * layout->node_offset;
+            for (int r = 0; r < restraint_num && result == EXIT_SUCCESS; r++) {
+                int n = find_mesh_node(joint, restraint[r].node);
+                int side = (n < 0) ? 0 : interior_side(layout, face[n], i, k);
+                int rc = (side == 0) ? restraint[r].rc : (side == 2) ? intersect_rc(restraint[r].rc, interface_rc) : 0;
+                if (rc != 0) {
+                    result = add_mesh_restraint(joint, restraint[r].node + node_shift, rc);
+                }
+            }
+            for (int c = 0; c < constraint_num && result == EXIT_SUCCESS; c++) {
+                int n = find_mesh_node(joint, constraint[c].node);
+                int m = find_mesh_node(joint, constraint[c].master);
+                if ((n >= 0 && interior_side(layout, face[n], i, k)) || (m >= 0 && interior_side(layout, face[m], i, k))) {
+                    continue;
+                }
+                result = add_mesh_constraint(joint, constraint[c].node + node_shift, constraint[c].dir,
+                                             constraint[c].master + node_shift, constraint[c].master_dir);
+            }
+        }
+    }
+
+    // STEPデータ: FN、UE は元のカードの位置に全ての接合部の分を並べる
+    for (int s = 0; s < step_card_num && result == EXIT_SUCCESS; s++) {
+        StepCard card = step_card[s];
+        if (card.kind != STEP_CARD_FN && card.kind != STEP_CARD_UE) {
+            result = add_mesh_step_card(joint, card.kind, card.id, card.value[0], card.value[1], card.value[2], card.real);
+            continue;
+        }
+        int index = (card.kind == STEP_CARD_FN) ? find_mesh_node(joint, card.id) : find_mesh_element(joint, card.id);
+        unsigned char card_face = (index < 0) ? 0 : (card.kind == STEP_CARD_FN) ? face[index] : element_face[index];
+        int offset = (card.kind == STEP_CARD_FN) ? layout->node_offset : layout->element_offset;
+        for (int k = 0; k < layout->story_num && result == EXIT_SUCCESS; k++) {
+            for (int i = 0; i < layout->bay_num && result == EXIT_SUCCESS; i++) {
+                if (interior_side(layout, card_face, i, k)) {
+                    continue;
+                }
+                int t = k * layout->bay_num + i;
+                result = add_mesh_step_card(joint, card.kind, card.id + t * offset, card.value[0], card.value[1], card.value[2], card.real);
+            }
+        }
+    }
+    free(step_card);
+    free(restraint);
+    free(constraint);
+    return result;
+}
+
+static int find_stitch_root(int parent[], int id) {
+    while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+    return id;
+}
+
+/**
+ * 隣り合う接合部の端部の節点の組を同じ位置の節点のグループにまとめる
+ *
+ * 梁端と柱端の両方にある節点は x、z 方向の両方で組になるため、
+ * グループの根(最小の番号)を SUB1 の master にして、従属節点が2重、連鎖にならないようにする。
+ *
+ * @param parent 節点番号 -> 同じグループの節点番号(0: 端部の節点でない)
+ * @param step_i, step_k 隣の接合部への (i, k) の増分
+ */
+static void group_stitch_nodes(const MeshModel* joint, const FrameLayout* layout, const int slave[], const int master[], int pair_num,
+                               int step_i, int step_k, int parent[]) {
+    for (int k = 0; k + step_k < layout->story_num; k++) {
+        for (int i = 0; i + step_i < layout->bay_num; i++) {
+            int master_shift = (k * layout->bay_num + i) * layout->node_offset;
+            int slave_shift = ((k + step_k) * layout->bay_num + i + step_i) * layout->node_offset;
+            for (int p = 0; p < pair_num; p++) {
+                int a = joint->node_id[slave[p]] + slave_shift;
+                int b = joint->node_id[master[p]] + master_shift;
+                if (parent[a] == 0) parent[a] = a;
+                if (parent[b] == 0) parent[b] = b;
+                a = find_stitch_root(parent, a);
+                b = find_stitch_root(parent, b);
+                if (a < b) {
+                    parent[b] = a;
+                } else {
+                    parent[a] = b;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * グループの根以外の節点を根に SUB1 (x、y、z方向)で結ぶ
+ */
+static int stitch_groups(MeshModel* joint, int parent[]) {
+    for (int id = 1; id <= ID_BUDGET_MAX; id++) {
+        if (parent[id] == 0) {
+            continue;
+        }
+        int root = find_stitch_root(parent, id);
+        for (int dir = 1; dir <= 3 && root != id; dir++) {
+            if (add_mesh_constraint(joint, id, dir, root, dir) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 番号の範囲ごとに x 方向、z 方向の COPY を登録する
+ *
+ * @param element 0: COPY :NODE, 1: COPY :ELM
+ */
+static int add_instance_copies(MeshModel* joint, const FrameLayout* layout, int element) {
+    int num = element ? joint->element_num : joint->node_num;
+    const int* id_array = element ? joint->element_id : joint->node_id;
+    int offset = element ? layout->element_offset : layout->node_offset;
+    RangeSetList* list = create_range_set_list();
+    if (list == NULL || encode_range_set(id_array, num, 0, list) != EXIT_SUCCESS) {
+        free_range_set_list(list);
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_SUCCESS;
+    for (int r = 0; r < list->range_num && result == EXIT_SUCCESS; r++) {
+        const RangeSet* range = &list->range[r];
+        MeshInstanceCopy copy = {element, range->start, range->end, range->interval, offset,
+                                 layout->node_offset, 0, layout->pitch[0], layout->bay_num - 1};
+        if (layout->bay_num > 1) {
+            result = add_mesh_instance_copy(joint, &copy);
+        }
+    }
+    for (int r = 0; r < list->range_num && result == EXIT_SUCCESS; r++) {
+        const RangeSet* range = &list->range[r];
+        for (int i = 0; i < layout->bay_num && layout->story_num > 1 && result == EXIT_SUCCESS; i++) {
+            MeshInstanceCopy copy = {element, range->start + i * offset, range->end + i * offset, range->interval,
+                                     layout->bay_num * offset, layout->bay_num * layout->node_offset, 2, layout->pitch[1], layout->story_num - 1};
+            result = add_mesh_instance_copy(joint, &copy);
+        }
+    }
+    free_range_set_list(list);
+    return result;
+}
+
+/**
+ * 接合部のモデルを架構に組み立てる
+ *
+ * joint の節点、要素はそのまま(接合部 (0, 0))とし、他の接合部は instance_copy に登録する。
+ * 境界条件、STEPデータは全ての接合部の分に書き換え、端部を結ぶ SUB1 を加える。
+ *
+ * @param joint 接合部のモデル(書き換える)
+ * @param layout plan_frame_layout で決めた配置(stitch_num、unmatched_num を書き込む)
+ * @param interface_rc 架構の内側の端部に残す REST の方向(例: 010 はハーフモデルの切断面の y 方向)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int assemble_frame(MeshModel* joint, FrameLayout* layout, int interface_rc) {
+    if (joint == NULL || layout == NULL || layout->bay_num < 1 || layout->story_num < 1) {
+        fprintf(stderr, "Error: Invalid argument passed to assemble_frame\n");
+        return EXIT_FAILURE;
+    }
+    int node_num = joint->node_num;
+    unsigned char* face = (unsigned char*)calloc((size_t)node_num + 1, sizeof(unsigned char));
+    unsigned char* element_face = (unsigned char*)calloc((size_t)joint->element_num + 1, sizeof(unsigned char));
+    int* slave = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* master = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* parent = (int*)calloc((size_t)ID_BUDGET_MAX + 1, sizeof(int));
+    if (face == NULL || element_face == NULL || slave == NULL || master == NULL || parent == NULL) {
+        fprintf(stderr, "Error: Memory allocation for assemble_frame failed\n");
+        free(face);
+        free(element_face);
+        free(slave);
+        free(master);
+        free(parent);
+        return EXIT_FAILURE;
+    }
+
+    // 端部の面(梁端: x の最小、最大、柱端: z の最小、最大)
+    double min_x = joint->x[0], max_x = joint->x[0], min_z = joint->z[0], max_z = joint->z[0];
+    for (int n = 0; n < node_num; n++) {
+        min_x = fmin(min_x, joint->x[n]);
+        max_x = fmax(max_x, joint->x[n]);
+        min_z = fmin(min_z, joint->z[n]);
+        max_z = fmax(max_z, joint->z[n]);
+    }
+    for (int n = 0; n < node_num; n++) {
+        if (fabs(joint->x[n] - min_x) <= FRAME_ASSEMBLY_TOLERANCE) face[n] |= FRAME_FACE_X_LOW;
+        if (fabs(joint->x[n] - max_x) <= FRAME_ASSEMBLY_TOLERANCE) face[n] |= FRAME_FACE_X_HIGH;
+        if (fabs(joint->z[n] - min_z) <= FRAME_ASSEMBLY_TOLERANCE) face[n] |= FRAME_FACE_Z_LOW;
+        if (fabs(joint->z[n] - max_z) <= FRAME_ASSEMBLY_TOLERANCE) face[n] |= FRAME_FACE_Z_HIGH;
+    }
+    for (int e = 0; e < joint->element_num; e++) {
+        for (int k = 0; k < element_node_count(joint->element_kind[e]); k++) {
+            int n = find_mesh_node(joint, joint->connectivity[e * ELEMENT_NODE_MAX + k]);
+            if (n >= 0) element_face[e] |= face[n];
+        }
+    }
+
+    int result = instance_boundary(joint, layout, face, element_face, interface_rc);
+
+    // 梁端(y、z が同じ節点)、柱端(x、y が同じ節点)を結ぶ
+    layout->stitch_num = 0;
+    layout->unmatched_num = 0;
+    const int axis_x[2] = {1, 2};
+    const int axis_z[2] = {0, 1};
+    if (result == EXIT_SUCCESS && layout->bay_num > 1) {
+        int pair_num = match_face_nodes(joint, face, FRAME_FACE_X_LOW, FRAME_FACE_X_HIGH, axis_x, slave, master, &layout->unmatched_num);
+        if (pair_num < 0) {
+            result = EXIT_FAILURE;
+        } else {
+            group_stitch_nodes(joint, layout, slave, master, pair_num, 1, 0, parent);
+        }
+        layout->stitch_num += pair_num * (layout->bay_num - 1) * layout->story_num;
+    }
+    if (result == EXIT_SUCCESS && layout->story_num > 1) {
+        int pair_num = match_face_nodes(joint, face, FRAME_FACE_Z_LOW, FRAME_FACE_Z_HIGH, axis_z, slave, master, &layout->unmatched_num);
+        if (pair_num < 0) {
+            result = EXIT_FAILURE;
+        } else {
+            group_stitch_nodes(joint, layout, slave, master, pair_num, 0, 1, parent);
+        }
+        layout->stitch_num += pair_num * layout->bay_num * (layout->story_num - 1);
+    }
+    if (result == EXIT_SUCCESS) {
+        result = stitch_groups(joint, parent);
+    }
+
+    if (result == EXIT_SUCCESS) {
+        result = add_instance_copies(joint, layout, 0);
+    }
+    if (result == EXIT_SUCCESS) {
+        result = add_instance_copies(joint, layout, 1);
+    }
+    free(face);
+    free(element_face);
+    free(slave);
+    free(master);
+    free(parent);
+    return result;
+}
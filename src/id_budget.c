@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "id_budget.h"
+
+/**
+ * 節点、要素番号の予算
+ *
+ * make_modeling_data の head、occupied_indices から部位ごとの番号の範囲を集め、
+ * 最大の番号が FINAL の %5d に収まるかを ffi を書き込む前に確認する。
+ * 収まらない場合は compact_id_gaps で部位の間の空きを詰め、それでも収まらなければ
+ * coarsen_far_field で接合部から離れた範囲(治具と接合部の間)の要素を2つずつまとめ、
+ * make_modeling_data をやり直す。
+ */
+
+static void set_part(IdBudgetPart* part, const char* name, NodeElement head, int node_num, int element_num) {
+    part->name = name;
+    part->head = head;
+    part->occupied.node = node_num;
+    part->occupied.element = element_num;
+}
+
+/**
+ * ModelingData の番号の割り当てから IdBudget を作る
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE(引数が NULL)
+ */
+int plan_id_budget(const ModelingData* modeling_data, IdBudget* budget) {
+    if (modeling_data == NULL || modeling_data->rebar_fiber == NULL || budget == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to plan_id_budget\n");
+        return EXIT_FAILURE;
+    }
+    NodeElement line_head = modeling_data->rebar_line.head;
+    NodeElement film_head = {0, modeling_data->joint_film.head};
+    set_part(&budget->part[0], "column hexa", modeling_data->column_hexa.head,
+             modeling_data->column_hexa.occupied_indices.node, modeling_data->column_hexa.occupied_indices.element);
+    set_part(&budget->part[1], "rebar fiber", modeling_data->rebar_fiber->head,
+             modeling_data->rebar_fiber->occupied_indices.node, modeling_data->rebar_fiber->occupied_indices.element);
+    set_part(&budget->part[2], "rebar line", line_head,
+             0, modeling_data->rebar_line.occupied_indices.element);
+    set_part(&budget->part[3], "joint quad", modeling_data->joint_quad.head,
+             modeling_data->joint_quad.occupied_indices.node, modeling_data->joint_quad.occupied_indices.element);
+    set_part(&budget->part[4], "joint film", film_head,
+             0, modeling_data->joint_film.occupied_indices);
+    set_part(&budget->part[5], "beam", modeling_data->beam.head,
+             modeling_data->beam.occupied_indices.node, modeling_data->beam.occupied_indices.element);
+
+    budget->max.node = 0;
+    budget->max.element = 0;
+    for (int p = 0; p < ID_BUDGET_PART_NUM; p++) {
+        const IdBudgetPart* part = &budget->part[p];
+        if (part->occupied.node > 0 && part->head.node + part->occupied.node - 1 > budget->max.node) {
+            budget->max.node = part->head.node + part->occupied.node - 1;
+        }
+        if (part->occupied.element > 0 && part->head.element + part->occupied.element - 1 > budget->max.element) {
+            budget->max.element = part->head.element + part->occupied.element - 1;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @return 1: 節点、要素番号とも ID_BUDGET_MAX 以下, 0: 超える
+ */
+int id_budget_fits(const IdBudget* budget) {
+    return budget != NULL && budget->max.node <= ID_BUDGET_MAX && budget->max.element <= ID_BUDGET_MAX;
+}
+
+void print_id_budget(const IdBudget* budget) {
+    if (budget == NULL) {
+        return;
+    }
+    printf("\n-------------------------------- id_budget --------------------------------\n");
+    printf("%-12s %8s %8s %8s %8s\n", "part", "node", "count", "element", "count");
+    for (int p = 0; p < ID_BUDGET_PART_NUM; p++) {
+        const IdBudgetPart* part = &budget->part[p];
+        printf("%-12s %8d %8d %8d %8d\n", part->name,
+               part->occupied.node > 0 ? part->head.node : 0, part->occupied.node,
+               part->head.element, part->occupied.element);
+    }
+    printf("max node %d, max element %d (limit %d)\n", budget->max.node, budget->max.element, ID_BUDGET_MAX);
+    if (!id_budget_fits(budget)) {
+        printf("Warning: node or element numbers exceed %d digits\n", ID_BUDGET_DIGITS);
+    }
+}
+
+/**
+ * 部位の間の空きを詰める
+ *
+ * 主筋の節点番号は柱の節点番号と同じ増分(column_hexa.increment[DIR_Z])で z 方向に並べているため、
+ * 1本当り柱の節点の層の数だけ番号を使う。主筋の節点は付着の相手を座標で探す(mesh_interface.c)ので、
+ * 増分を 1 にして詰め、後ろの部位(接合部鋼板、梁)の先頭の節点番号を前にずらす。
+ *
+ * @return 詰めた節点番号の数
+ */
+int compact_id_gaps(ModelingData* modeling_data) {
+    if (modeling_data == NULL || modeling_data->rebar_fiber == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to compact_id_gaps\n");
+        return 0;
+    }
+    RebarFiber* rebar = modeling_data->rebar_fiber;
+    if (rebar->increment.node <= 1) {
+        return 0;
+    }
+    int layer_num = rebar->occupied_indices_single.node / rebar->increment.node;
+    int freed = rebar->occupied_indices.node - layer_num * rebar->rebar_num;
+    rebar->increment.node = 1;
+    rebar->occupied_indices_single.node = layer_num;
+    rebar->occupied_indices.node = layer_num * rebar->rebar_num;
+    modeling_data->joint_quad.head.node -= freed;
+    modeling_data->beam.head.node -= freed;
+    return freed;
+}
+
+/**
+ * 要素 low ... high - 1 を2つずつ組にする(merge_next[i] = 1 で i と i + 1 をまとめる)。
+ * 治具の側(from_low = 1 なら low、0 なら high)から組にし、数が奇数の場合は接合部の側の要素を残す。
+ *
+ * @return 組の数
+ */
+static int merge_far_field_range(int low, int high, int from_low, char merge_next[]) {
+    int merged = 0;
+    if (from_low) {
+        for (int i = low; i + 1 < high; i += 2) {
+            merge_next[i] = 1;
+            merged++;
+        }
+    } else {
+        for (int i = high - 2; i >= low; i -= 2) {
+            merge_next[i] = 1;
+            merged++;
+        }
+    }
+    return merged;
+}
+
+static int coarsen_mesh(Mesh* mesh, int jig_low, int joint_low, int joint_high, int jig_high) {
+    char* merge_next = (char*)calloc((size_t)mesh->mesh_num, sizeof(char));
+    if (merge_next == NULL) {
+        fprintf(stderr, "Error: Memory allocation for coarsen_far_field failed\n");
+        return -1;
+    }
+    int merged = merge_far_field_range(jig_low, joint_low, 1, merge_next) +
+                 merge_far_field_range(joint_high, jig_high, 0, merge_next);
+    int k = 0;
+    for (int i = 0; i < mesh->mesh_num; i++) {
+        if (merge_next[i]) {
+            mesh->lengths[k++] = mesh->lengths[i] + mesh->lengths[i + 1];
+            i++;
+        } else {
+            mesh->lengths[k++] = mesh->lengths[i];
+        }
+    }
+    mesh->mesh_num = k;
+    free(merge_next);
+    return merged;
+}
+
+/**
+ * 治具と接合部の間(x: 梁、z: 柱)の要素を2つずつまとめ、節点、要素数を減らす。
+ * 境界点と主筋の位置は接合部の中にあるため格子線のまま残る。
+ *
+ * @param source_data mesh_x, mesh_z を書き換える
+ * @param modeling_data source_data から作った境界点(boundary_index)
+ * @return EXIT_SUCCESS: まとめた, EXIT_FAILURE: まとめる要素が無い
+ */
+int coarsen_far_field(JsonData* source_data, const ModelingData* modeling_data) {
+    if (source_data == NULL || modeling_data == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to coarsen_far_field\n");
+        return EXIT_FAILURE;
+    }
+    const int* boundary = modeling_data->boundary_index;
+    int merged_x = coarsen_mesh(&source_data->mesh_x, boundary[JIG_BEAM_X], boundary[BEAM_COLUMN_X], boundary[COLUMN_BEAM_X], boundary[BEAM_JIG_X]);
+    int merged_z = coarsen_mesh(&source_data->mesh_z, boundary[JIG_COLUMN_Z], boundary[COLUMN_BEAM_Z], boundary[BEAM_COLUMN_Z], boundary[COLUMN_JIG_Z]);
+    if (merged_x < 0 || merged_z < 0 || merged_x + merged_z == 0) {
+        return EXIT_FAILURE;
+    }
+    printf("coarsen_far_field: merged %d elements in x, %d in z\n", merged_x, merged_z);
+    return EXIT_SUCCESS;
+}
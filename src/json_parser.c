@@ -170,6 +170,51 @@ JsonParserResult json_parser(const char *file_name, JsonData *jsonData) {
 		jsonData->rebar.rebars[i].y = (double)json_object_get_number(rebar_position_object, "y");
 	}
 
+    // 繰り返し載荷の段を取得 --------------------------------------------------------------------------------
+    JSON_Array* loading_array = json_object_get_array(root_object, "loading");
+    if (loading_array != NULL) {
+        jsonData->loading.level_num = (int)json_array_get_count(loading_array);
+        jsonData->loading.levels = (LoadingLevel *)malloc(((size_t)jsonData->loading.level_num + 1) * sizeof(LoadingLevel));
+        if (jsonData->loading.levels == NULL) {
+            json_value_free(root_value);
+            return JSON_PARSER_ERROR;  // 異常終了
+        }
+        for (int i = 0; i < jsonData->loading.level_num; i++) {
+            JSON_Object* level_object = json_array_get_object(loading_array, i);
+            if (level_object == NULL) {
+                fprintf(stderr, "'loading' level %d is not an object.\n", i);
+                json_value_free(root_value);
+                return JSON_PARSER_ERROR;  // 異常終了
+            }
+            LoadingLevel* level = &jsonData->loading.levels[i];
+            level->drift = (double)json_object_get_number(level_object, "drift");
+            level->cycles = (int)json_object_get_number(level_object, "cycles");
+            level->steps = (int)json_object_get_number(level_object, "steps");
+            if (level->drift <= 0.0 || level->cycles < 1 || level->steps < 1) {
+                fprintf(stderr, "'loading' level %d needs drift > 0, cycles >= 1 and steps >= 1.\n", i);
+                json_value_free(root_value);
+                return JSON_PARSER_ERROR;  // 異常終了
+            }
+        }
+    }
+
+    // auto_meshの条件を取得 --------------------------------------------------------------------------------
+    JSON_Object *auto_mesh_object = json_object_get_object(root_object, "auto_mesh");
+    if (auto_mesh_object != NULL) {
+        jsonData->auto_mesh.enabled = 1;
+        jsonData->auto_mesh.element_size = (double)json_object_get_number(auto_mesh_object, "element_size");
+        jsonData->auto_mesh.growth = json_object_has_value(auto_mesh_object, "growth") ?
+            (double)json_object_get_number(auto_mesh_object, "growth") : AUTO_MESH_DEFAULT_GROWTH;
+        jsonData->auto_mesh.max_aspect = json_object_has_value(auto_mesh_object, "max_aspect") ?
+            (double)json_object_get_number(auto_mesh_object, "max_aspect") : AUTO_MESH_DEFAULT_MAX_ASPECT;
+        jsonData->auto_mesh.jig_x = (double)json_object_get_number(auto_mesh_object, "jig_x");
+        jsonData->auto_mesh.jig_z = (double)json_object_get_number(auto_mesh_object, "jig_z");
+
+        // メッシュ分割は generate_auto_mesh で作るため、mesh_x, mesh_y, mesh_z は読まない
+        json_value_free(root_value);
+        return JSON_PARSER_SUCCESS;
+    }
+
     // mesh_xの配列を取得 --------------------------------------------------------------------------------
     JSON_Array* mesh_x_array = json_object_get_array(root_object, "mesh_x");
     if(mesh_x_array == NULL) {
@@ -268,6 +313,11 @@ void free_json_data(JsonData* json_data) {
         free(json_data->mesh_z.lengths);
     }
 
+    // 繰り返し載荷の段を解放
+    if (json_data->loading.levels != NULL) {
+        free(json_data->loading.levels);
+    }
+
     // JsonData自体のメモリを解放
     free(json_data);
 }
@@ -441,7 +491,46 @@ void print_json_data(const JsonData *data, int indent) {
     printf("]\n");
     level--;
     print_indent(level, indent);
-    printf("}\n");
+    printf((data->auto_mesh.enabled || data->loading.level_num > 0) ? "},\n" : "}\n");
+
+    // auto_meshの内容を表示
+    if (data->auto_mesh.enabled) {
+        print_indent(level, indent);
+        printf("\"Auto_Mesh\": {\n");
+        level++;
+        print_indent(level, indent);
+        printf("\"Element_Size\": %.2lf,\n", data->auto_mesh.element_size);
+        print_indent(level, indent);
+        printf("\"Growth\": %.2lf,\n", data->auto_mesh.growth);
+        print_indent(level, indent);
+        printf("\"Max_Aspect\": %.2lf,\n", data->auto_mesh.max_aspect);
+        print_indent(level, indent);
+        printf("\"Jig_X\": %.2lf,\n", data->auto_mesh.jig_x);
+        print_indent(level, indent);
+        printf("\"Jig_Z\": %.2lf\n", data->auto_mesh.jig_z);
+        level--;
+        print_indent(level, indent);
+        printf(data->loading.level_num > 0 ? "},\n" : "}\n");
+    }
+
+    // loadingの内容を表示
+    if (data->loading.level_num > 0) {
+        print_indent(level, indent);
+        printf("\"Loading\": [\n");
+        level++;
+        for (int i = 0; i < data->loading.level_num; i++) {
+            print_indent(level, indent);
+            printf("{ \"drift\": %g, \"cycles\": %d, \"steps\": %d }", data->loading.levels[i].drift,
+                data->loading.levels[i].cycles, data->loading.levels[i].steps);
+            if (i < data->loading.level_num - 1) {
+                printf(",");
+            }
+            printf("\n");
+        }
+        level--;
+        print_indent(level, indent);
+        printf("]\n");
+    }
 
     level--;
     printf("}\n");
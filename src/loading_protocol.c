@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "loading_protocol.h"
+#include "print_ffi.h"
+#include "output_plan.h"
+
+/**
+ * 繰り返し載荷の変位履歴("loading")
+ *
+ * 段ごとに部材角 R、繰り返し数、0 から最大の変位までのステップ数を与え、柱端の強制変位(FN、1ステップ当りの増分)を
+ * STEP カードの区間にまとめて書き込む。柱の上端、下端に ±R*H/2 (H は柱端の載荷点の間の距離)を与える。
+ * 変位は FN の桁(0.01 mm)の整数で扱い、区間 Δ を n ステップに分けるときは
+ * Δ = q*n + r として |r| ステップを q ± 1、残りを q にする。丸めの誤差が積み重ならず、最大の変位にちょうど戻る。
+ * 区間の数は正負の最大の変位の数の高々2倍で、ステップ数によらない。
+ */
+
+LoadingProtocol* create_loading_protocol() {
+    LoadingProtocol* protocol = (LoadingProtocol*)malloc(sizeof(LoadingProtocol));
+    if (protocol == NULL) {
+        fprintf(stderr, "Error: Memory allocation for LoadingProtocol failed\n");
+        return NULL;
+    }
+    protocol->segment_num = 0;
+    protocol->segment_capacity = 0;
+    protocol->segment = NULL;
+    protocol->first_step = 0;
+    protocol->last_step = 0;
+    protocol->peak_num = 0;
+    return protocol;
+}
+
+int free_loading_protocol(LoadingProtocol* protocol) {
+    if (protocol == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(protocol->segment);
+    free(protocol);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 区間を1つ加えられるよう配列を広げる
+ */
+static int reserve_loading_segment(LoadingProtocol* protocol) {
+    if (protocol->segment_num < protocol->segment_capacity) {
+        return EXIT_SUCCESS;
+    }
+    int capacity = (protocol->segment_capacity == 0) ? 16 : protocol->segment_capacity * 2;
+    LoadingSegment* new_segment = (LoadingSegment*)realloc(protocol->segment, (size_t)capacity * sizeof(LoadingSegment));
+    if (new_segment == NULL) {
+        fprintf(stderr, "Error: Failed to grow LoadingProtocol\n");
+        return EXIT_FAILURE;
+    }
+    protocol->segment = new_segment;
+    protocol->segment_capacity = capacity;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 区間を加える。直前の区間と増分が同じ場合はつなげる
+ */
+static int add_loading_segment(LoadingProtocol* protocol, int step_num, int increment) {
+    if (step_num <= 0) {
+        return EXIT_SUCCESS;
+    }
+    if (protocol->segment_num > 0 && protocol->segment[protocol->segment_num - 1].increment == increment) {
+        protocol->segment[protocol->segment_num - 1].step_num += step_num;
+        return EXIT_SUCCESS;
+    }
+    if (reserve_loading_segment(protocol) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    protocol->segment[protocol->segment_num].step_num = step_num;
+    protocol->segment[protocol->segment_num].increment = increment;
+    protocol->segment_num++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 変位 delta を step_num ステップで与える(増分は q + 符号 と q の2区間)
+ */
+static int add_excursion(LoadingProtocol* protocol, int delta, int step_num) {
+    int quotient = delta / step_num;
+    int remainder = delta - quotient * step_num;
+    int sign = (remainder > 0) - (remainder < 0);
+    if (add_loading_segment(protocol, abs(remainder), quotient + sign) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    return add_loading_segment(protocol, step_num - abs(remainder), quotient);
+}
+
+/**
+ * 段ごとの部材角から変位履歴を作る
+ *
+ * 各段は 0 または前の段の負の最大の変位から +δ、-δ を cycles 回繰り返し、最後に 0 に戻す。
+ * 区間のステップ数は |区間の変位| / δ * steps (四捨五入、1以上)。最後の 0 までは最後の段のステップの大きさにする。
+ *
+ * @param height 柱端の載荷点の間の距離(柱の上端、下端に ±R*height/2 を与える)
+ * @param first_step 最初のステップ番号(軸力導入の次)
+ * @return EXIT_SUCCESS / EXIT_FAILURE (最大の変位が FN の桁で 0 になる、ステップ番号が LOADING_STEP_MAX を超える)
+ */
+int build_loading_protocol(const LoadingLevel levels[], int level_num, double height, int first_step, LoadingProtocol* protocol) {
+    if (levels == NULL || protocol == NULL || level_num <= 0 || height <= 0.0 || first_step < 1) {
+        fprintf(stderr, "Error: invalid arguments passed to build_loading_protocol\n");
+        return EXIT_FAILURE;
+    }
+    protocol->segment_num = 0;
+    protocol->peak_num = 0;
+    protocol->first_step = first_step;
+
+    long long step_total = 0;
+    int position = 0;
+    int peak = 0;
+    int steps = 1;
+    for (int l = 0; l < level_num; l++) {
+        peak = (int)llround(levels[l].drift * height / 2.0 * LOADING_DISP_SCALE);
+        steps = levels[l].steps;
+        if (peak <= 0 || steps < 1 || levels[l].cycles < 1) {
+            fprintf(stderr, "Error: loading level %d (drift %g) is zero at the FN precision\n", l, levels[l].drift);
+            return EXIT_FAILURE;
+        }
+        for (int c = 0; c < 2 * levels[l].cycles; c++) {
+            int target = (c % 2 == 0) ? peak : -peak;
+            int delta = target - position;
+            int step_num = (int)llround((double)abs(delta) / peak * steps);
+            if (step_num < 1) step_num = 1;
+            if (add_excursion(protocol, delta, step_num) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+            step_total += step_num;
+            position = target;
+            protocol->peak_num++;
+        }
+    }
+    // 0 に戻す
+    int step_num = (int)llround((double)abs(position) / peak * steps);
+    if (step_num < 1) step_num = 1;
+    if (add_excursion(protocol, -position, step_num) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    step_total += step_num;
+
+    if (first_step - 1 + step_total > LOADING_STEP_MAX) {
+        fprintf(stderr, "Error: loading needs %lld steps (last step exceeds %d)\n", step_total, LOADING_STEP_MAX);
+        return EXIT_FAILURE;
+    }
+    protocol->last_step = first_step - 1 + (int)step_total;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 柱の主筋が降伏するときの部材角の目安
+ *
+ * 柱を載荷点から接合部の中心までの片持ち柱(長さ L = height / 2)とみなし、降伏曲率 φy = 2.1 εy / D から
+ * δy = φy L^2 / 3、部材角 δy / L を求める。
+ *
+ * @param depth 柱のせい(加力方向の寸法)
+ * @param height 柱端の載荷点の間の距離
+ */
+double estimate_yield_drift(double depth, double height) {
+    if (depth <= 0.0 || height <= 0.0) {
+        return 0.0;
+    }
+    double curvature = 2.1 * LOADING_YIELD_STRAIN / depth;
+    return curvature * (height / 2.0) / 3.0;
+}
+
+/**
+ * 増分を決める目安(変位は 1/LOADING_DISP_SCALE mm)
+ */
+typedef struct {
+    int fine;         // 細かい増分(降伏変位 / LOADING_STEPS_TO_YIELD)
+    int crack;        // ひび割れの変位
+    int yield;        // 降伏の変位
+    int max_reached;  // それまでの最大の |変位|
+} IncrementPlan;
+
+/**
+ * 位置と向きから1ステップの増分を決める
+ *
+ * - 反転の直後(LOADING_REVERSAL_STEPS ステップ)と、初めて通るひび割れ(0.5 - 1.5 倍)、降伏(0.7 - 1.3 倍)の付近は細かくする。
+ * - 除荷(0 に向かう)と、ひび割れより十分小さい弾性の範囲、降伏の3倍を超える範囲は4倍にする。
+ * - それまでに通った範囲の再載荷と、その他は2倍にする。
+ */
+static int plan_increment(const IncrementPlan* plan, int position, int direction, int steps_from_reversal) {
+    int magnitude = abs(position);
+    if (steps_from_reversal < LOADING_REVERSAL_STEPS) {
+        return plan->fine;
+    }
+    if (position * direction < 0) {
+        return 4 * plan->fine;
+    }
+    if (magnitude < plan->max_reached) {
+        return 2 * plan->fine;
+    }
+    if (2 * magnitude < plan->crack) {
+        return 4 * plan->fine;
+    }
+    if (2 * magnitude < 3 * plan->crack) {
+        return plan->fine;
+    }
+    if (10 * magnitude < 7 * plan->yield) {
+        return 2 * plan->fine;
+    }
+    if (10 * magnitude < 13 * plan->yield) {
+        return plan->fine;
+    }
+    if (magnitude < 3 * plan->yield) {
+        return 2 * plan->fine;
+    }
+    return 4 * plan->fine;
+}
+
+/**
+ * 載荷の向きに進むとき plan_increment の増分が変わる |変位| のうち、magnitude より大きい最初のもの(無い場合は 0)
+ *
+ * それまでの最大の |変位| と、その先のひび割れ、降伏の範囲の端。plan_increment の比較と同じ位置になるよう切り上げる。
+ */
+static int next_increment_boundary(const IncrementPlan* plan, int magnitude) {
+    if (magnitude < plan->max_reached) {
+        return plan->max_reached;
+    }
+    int boundary[5] = {
+        (plan->crack + 1) / 2,
+        (3 * plan->crack + 1) / 2,
+        (7 * plan->yield + 9) / 10,
+        (13 * plan->yield + 9) / 10,
+        3 * plan->yield
+    };
+    int next = 0;
+    for (int b = 0; b < 5; b++) {
+        if (boundary[b] > magnitude && (next == 0 || boundary[b] < next)) {
+            next = boundary[b];
+        }
+    }
+    return next;
+}
+
+/**
+ * from から to まで plan_increment の増分で進む
+ *
+ * 1ステップは増分が変わる位置(ひび割れ、降伏の範囲の端、除荷で 0 を通る位置)と to を越えない。
+ * 端数の小さなステップができないよう、区切りまでを増分以下の等しいステップに分ける。
+ * 0 から始める場合も反転の直後とみなす。
+ *
+ * @return 加えたステップ数。失敗した場合は -1
+ */
+static int add_planned_excursion(LoadingProtocol* protocol, IncrementPlan* plan, int from, int to) {
+    int direction = (to > from) ? 1 : -1;
+    int position = from;
+    int step_num = 0;
+    while (position != to) {
+        int increment = plan_increment(plan, position, direction, step_num);
+        int limit = abs(to - position);
+        if (position * direction < 0) {
+            // 除荷は 0 で止める
+            if (abs(position) < limit) limit = abs(position);
+        } else {
+            int boundary = next_increment_boundary(plan, abs(position));
+            if (boundary > 0 && boundary - abs(position) < limit) limit = boundary - abs(position);
+        }
+        int division = (limit + increment - 1) / increment;
+        increment = (limit + division - 1) / division;
+        if (add_loading_segment(protocol, 1, direction * increment) != EXIT_SUCCESS) {
+            return -1;
+        }
+        position += direction * increment;
+        if (abs(position) > plan->max_reached) {
+            plan->max_reached = abs(position);
+        }
+        step_num++;
+    }
+    return step_num;
+}
+
+/**
+ * 段ごとの部材角から、増分を場所に応じて変えた変位履歴を作る
+ *
+ * 最大の変位の並びは build_loading_protocol と同じで、段の steps は使わない。
+ * 増分は降伏変位 / LOADING_STEPS_TO_YIELD の 1、2、4 倍から plan_increment で選ぶ
+ * (同じ増分が続くステップは1枚の STEP にまとまる)。
+ *
+ * @param yield_drift 降伏の部材角(estimate_yield_drift など)。ひび割れは LOADING_CRACK_RATIO 倍とする
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int build_adaptive_loading_protocol(const LoadingLevel levels[], int level_num, double height, double yield_drift,
+                                    int first_step, LoadingProtocol* protocol) {
+    if (levels == NULL || protocol == NULL || level_num <= 0 || height <= 0.0 || yield_drift <= 0.0 || first_step < 1) {
+        fprintf(stderr, "Error: invalid arguments passed to build_adaptive_loading_protocol\n");
+        return EXIT_FAILURE;
+    }
+    protocol->segment_num = 0;
+    protocol->peak_num = 0;
+    protocol->first_step = first_step;
+
+    IncrementPlan plan;
+    plan.yield = (int)llround(yield_drift * height / 2.0 * LOADING_DISP_SCALE);
+    plan.crack = (int)llround(LOADING_CRACK_RATIO * yield_drift * height / 2.0 * LOADING_DISP_SCALE);
+    plan.fine = (int)llround((double)plan.yield / LOADING_STEPS_TO_YIELD);
+    if (plan.fine < 1) plan.fine = 1;
+    plan.max_reached = 0;
+
+    long long step_total = 0;
+    int position = 0;
+    for (int l = 0; l <= level_num; l++) {
+        int peak = 0;
+        int cycles = 1;
+        if (l < level_num) {
+            peak = (int)llround(levels[l].drift * height / 2.0 * LOADING_DISP_SCALE);
+            cycles = levels[l].cycles;
+            if (peak <= 0 || cycles < 1) {
+                fprintf(stderr, "Error: loading level %d (drift %g) is zero at the FN precision\n", l, levels[l].drift);
+                return EXIT_FAILURE;
+            }
+        }
+        // 最後は 0 に戻す
+        for (int c = 0; c < ((l < level_num) ? 2 * cycles : 1); c++) {
+            int target = (c % 2 == 0) ? peak : -peak;
+            int step_num = add_planned_excursion(protocol, &plan, position, target);
+            if (step_num < 0) {
+                return EXIT_FAILURE;
+            }
+            step_total += step_num;
+            if (first_step - 1 + step_total > LOADING_STEP_MAX) {
+                fprintf(stderr, "Error: loading needs more than %d steps\n", LOADING_STEP_MAX);
+                return EXIT_FAILURE;
+            }
+            position = target;
+            if (l < level_num) {
+                protocol->peak_num++;
+            }
+        }
+    }
+    protocol->last_step = first_step - 1 + (int)step_total;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * step で終わる区間が無い場合は、step を含む区間を2つに分ける(増分は同じ)
+ */
+static int split_loading_segment(LoadingProtocol* protocol, int step) {
+    int end = protocol->first_step - 1;
+    for (int s = 0; s < protocol->segment_num; s++) {
+        end += protocol->segment[s].step_num;
+        if (end == step) {
+            return EXIT_SUCCESS;
+        }
+        if (end > step) {
+            if (reserve_loading_segment(protocol) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+            for (int k = protocol->segment_num; k > s; k--) {
+                protocol->segment[k] = protocol->segment[k - 1];
+            }
+            protocol->segment_num++;
+            protocol->segment[s].step_num -= end - step;
+            protocol->segment[s + 1].step_num = end - step;
+            return EXIT_SUCCESS;
+        }
+    }
+    fprintf(stderr, "Error: step %d is outside the loading (%d - %d)\n", step, protocol->first_step, protocol->last_step);
+    return EXIT_FAILURE;
+}
+
+/**
+ * 変位履歴を run_num 回の解析に分ける再開点を決める
+ *
+ * 軸力導入から last_step までを、載荷のステップ数がほぼ等しくなるように分ける。区切りの近く
+ * (1回のステップ数の 1/4 以内)に STEP の区切りがあればそこで分け、無ければ区間を2つに分けて STEP を加える。
+ * 再開点は常に STEP の区切り(UP TO NO.)になる。
+ *
+ * @param run_num 解析の回数(2以上、載荷のステップ数以下)
+ * @param restart_step k 回目の解析の最終ステップ(k = 0 ... run_num - 1。最後は last_step)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int plan_restart_steps(LoadingProtocol* protocol, int run_num, int restart_step[]) {
+    if (protocol == NULL || restart_step == NULL || protocol->segment_num == 0) {
+        fprintf(stderr, "Error: invalid arguments passed to plan_restart_steps\n");
+        return EXIT_FAILURE;
+    }
+    int total = protocol->last_step - protocol->first_step + 1;
+    if (run_num < 2 || run_num > total) {
+        fprintf(stderr, "Error: cannot split %d loading steps into %d runs\n", total, run_num);
+        return EXIT_FAILURE;
+    }
+    int tolerance = total / (4 * run_num);
+    int previous = protocol->first_step - 1;
+    for (int k = 1; k < run_num; k++) {
+        int ideal = protocol->first_step - 1 + (int)(((long long)k * total + run_num / 2) / run_num);
+        // 近い STEP の区切り(前の再開点より後、最終ステップより前)
+        int best = 0;
+        int end = protocol->first_step - 1;
+        for (int s = 0; s < protocol->segment_num; s++) {
+            end += protocol->segment[s].step_num;
+            if (end > previous && end < protocol->last_step && abs(end - ideal) <= tolerance &&
+                (best == 0 || abs(end - ideal) < abs(best - ideal))) {
+                best = end;
+            }
+        }
+        if (best == 0) {
+            best = (ideal > previous) ? ideal : previous + 1;
+            if (split_loading_segment(protocol, best) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+        }
+        restart_step[k - 1] = best;
+        previous = best;
+    }
+    restart_step[run_num - 1] = protocol->last_step;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 変位履歴の STEP、FN、OUT を書き込む(区間ごとに STEP 1枚、柱の下端、上端の FN、OUT)
+ *
+ * @param load_nodes 柱の下端、上端の載荷点(get_load_node)
+ * @param output OUT の計画(plan_output)。区間の中で始まる OUT を書き込む。NULL の場合は全てのステップを LEVEL=(3) で出力する
+ */
+int print_loading_protocol(FILE* f, const LoadingProtocol* protocol, const int load_nodes[], const struct OutputPlan* output) {
+    if (f == NULL || protocol == NULL || load_nodes == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to print_loading_protocol\n");
+        return EXIT_FAILURE;
+    }
+    int step = protocol->first_step - 1;
+    int r = 0;
+    for (int s = 0; s < protocol->segment_num; s++) {
+        const LoadingSegment* segment = &protocol->segment[s];
+        double disp = (double)segment->increment / LOADING_DISP_SCALE;
+        print_STEP(f, step + segment->step_num);
+        print_FN(f, load_nodes[0], 0, 0, (disp == 0.0) ? 0.0 : -disp, 'x');
+        print_FN(f, load_nodes[1], 0, 0, disp, 'x');
+        if (output == NULL) {
+            print_OUT(f, step + 1, step + segment->step_num, 1);
+        }
+        while (output != NULL && r < output->range_num && output->range[r].start <= step + segment->step_num) {
+            const OutputRange* range = &output->range[r++];
+            if (range->end == range->start) {
+                print_OUT_level(f, range->start, 0, 0, range->level);
+            } else {
+                print_OUT_level(f, range->start, range->end, range->interval, range->level);
+            }
+        }
+        step += segment->step_num;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "mesh_bond_zone.h"
+
+/**
+ * 主筋の付着区間(--bond-zone)
+ *
+ * add_interface_elements は主筋(BEAM)の全長にわたって主筋専用の節点とコンクリートの節点を
+ * 付着要素(LINE)で結ぶ。付着区間(接合部など)の外は完全付着とみなし、LINE を削除して
+ * 主筋の節点を LINE の相手のコンクリートの節点に置き換える(BEAM はコンクリートの節点を結ぶ)。
+ * 付着区間の端の節点は区間内の LINE が使うため、主筋専用のまま残る。
+ */
+
+// 付着要素(LINE)の主筋側、コンクリート側の節点の位置
+#define BOND_BAR_NODE 0
+#define BOND_SOLID_NODE 2
+
+/**
+ * 節点番号を置き換える(置き換えない番号はそのまま)
+ */
+static int remap_node(const int merge[], int size, int id) {
+    if (id > 0 && id < size && merge[id] > 0) {
+        return merge[id];
+    }
+    return id;
+}
+
+/**
+ * 付着区間の外の LINE と、共有した主筋の節点を削除し、配列と対応表を詰める
+ */
+static void remove_merged(MeshModel* model, const int merge[], const unsigned char outside[]) {
+    int k = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        if (merge[model->node_id[n]] > 0) {
+            model->node_index[model->node_id[n]] = -1;
+            continue;
+        }
+        model->node_id[k] = model->node_id[n];
+        model->x[k] = model->x[n];
+        model->y[k] = model->y[n];
+        model->z[k] = model->z[n];
+        model->node_index[model->node_id[k]] = k;
+        k++;
+    }
+    model->node_num = k;
+
+    k = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (outside[e]) {
+            model->element_index[model->element_id[e]] = -1;
+            continue;
+        }
+        model->element_id[k] = model->element_id[e];
+        model->element_kind[k] = model->element_kind[e];
+        model->element_type[k] = model->element_type[e];
+        for (int m = 0; m < ELEMENT_NODE_MAX; m++) {
+            model->connectivity[k * ELEMENT_NODE_MAX + m] =
+                remap_node(merge, model->node_index_size, model->connectivity[e * ELEMENT_NODE_MAX + m]);
+        }
+        model->element_index[model->element_id[k]] = k;
+        k++;
+    }
+    model->element_num = k;
+}
+
+/**
+ * 共有した節点の REST、SUB1、FN と監視節点をコンクリートの節点に置き換える
+ */
+static void remap_cards(MeshModel* model, const int merge[], BondZoneStatistics* statistics) {
+    int size = model->node_index_size;
+    for (int r = 0; r < model->restraint_num; r++) {
+        int id = remap_node(merge, size, model->restraint[r].node);
+        if (id != model->restraint[r].node) {
+            model->restraint[r].node = id;
+            statistics->remapped_card_num++;
+        }
+    }
+    for (int c = 0; c < model->constraint_num; c++) {
+        int node = remap_node(merge, size, model->constraint[c].node);
+        int master = remap_node(merge, size, model->constraint[c].master);
+        if (node != model->constraint[c].node || master != model->constraint[c].master) {
+            model->constraint[c].node = node;
+            model->constraint[c].master = master;
+            statistics->remapped_card_num++;
+        }
+    }
+    for (int s = 0; s < model->step_card_num; s++) {
+        StepCard* card = &model->step_card[s];
+        if (card->kind == STEP_CARD_FN && remap_node(merge, size, card->id) != card->id) {
+            card->id = remap_node(merge, size, card->id);
+            statistics->remapped_card_num++;
+        }
+    }
+    model->disp_node = remap_node(merge, size, model->disp_node);
+    model->load_node = remap_node(merge, size, model->load_node);
+}
+
+/**
+ * 付着要素(LINE)を付着区間の中だけに限る
+ *
+ * - 重心の z 座標が z_min ... z_max の外にある LINE を削除する。
+ * - 残した LINE が使わなくなった主筋の節点を、LINE の相手のコンクリートの節点に置き換えて削除する
+ *   (BEAM の節点と、REST、SUB1、FN、監視節点の番号を替える)。
+ * 番号は付け替えない。
+ *
+ * @param model 付着要素を持つモデル(書き換える)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int restrict_bond_zone(MeshModel* model, double z_min, double z_max, BondZoneStatistics* statistics) {
+    if (model == NULL || statistics == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to restrict_bond_zone\n");
+        return EXIT_FAILURE;
+    }
+    *statistics = (BondZoneStatistics){0};
+
+    int size = model->node_index_size;
+    int* merge = (int*)calloc((size_t)size + 1, sizeof(int));
+    unsigned char* bonded = (unsigned char*)calloc((size_t)size + 1, sizeof(unsigned char));
+    unsigned char* outside = (unsigned char*)calloc((size_t)model->element_num + 1, sizeof(unsigned char));
+    if (merge == NULL || bonded == NULL || outside == NULL) {
+        fprintf(stderr, "Error: Memory allocation for restrict_bond_zone failed\n");
+        free(merge);
+        free(bonded);
+        free(outside);
+        return EXIT_FAILURE;
+    }
+
+    // 主筋の節点 -> LINE の相手のコンクリートの節点と、区間内の LINE が使う主筋の節点
+    for (int e = 0; e < model->element_num; e++) {
+        if (model->element_kind[e] != ELEMENT_LINE) {
+            continue;
+        }
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        double z = 0.0;
+        for (int m = 0; m < element_node_count(ELEMENT_LINE); m++) {
+            z += model->z[find_mesh_node(model, node[m])];
+        }
+        z /= element_node_count(ELEMENT_LINE);
+        outside[e] = z < z_min || z > z_max;
+        for (int m = 0; m < 2; m++) {
+            merge[node[BOND_BAR_NODE + m]] = node[BOND_SOLID_NODE + m];
+            if (!outside[e]) {
+                bonded[node[BOND_BAR_NODE + m]] = 1;
+            }
+        }
+        if (outside[e]) {
+            statistics->removed_line_num++;
+        } else {
+            statistics->line_num++;
+        }
+    }
+    for (int id = 1; id < size; id++) {
+        if (bonded[id]) {
+            merge[id] = 0;
+        } else if (merge[id] > 0) {
+            statistics->merged_node_num++;
+        }
+    }
+
+    remove_merged(model, merge, outside);
+    remap_cards(model, merge, statistics);
+    free(merge);
+    free(bonded);
+    free(outside);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 付着区間を限った結果を表示する
+ */
+void print_bond_zone_statistics(const BondZoneStatistics* statistics) {
+    if (statistics == NULL) {
+        return;
+    }
+    printf("bond zone: %d LINE kept, -%d LINE, -%d rebar nodes (shared with concrete), %d cards remapped\n",
+           statistics->line_num, statistics->removed_line_num, statistics->merged_node_num, statistics->remapped_card_num);
+}
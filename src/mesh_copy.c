@@ -0,0 +1,921 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "mesh_copy.h"
+#include "print_ffi.h"
+#include "range_set.h"
+
+/**
+ * 陽な節点、要素から、NODE、要素のカードとCOPYカードの組を作る。
+ *
+ * 番号が等差で並び、座標(要素は節点番号)が1方向にずれた節点(要素)を格子(CopyLattice)にまとめる。
+ * ずれの量は等間隔でなくてよく、等間隔の区間ごとに1枚のCOPYカードで複写する(plot_nodeと同じ書き方)。
+ *   1回目: 1個ずつの節点(要素)を並べて行にする
+ *   2回目: 同じ形の行を並べて面にする
+ *   3回目: 同じ形の面を並べてブロックにする
+ * 各回は貪欲法で、番号順に近い同じ形の候補のうち最も長く続くものを選び、カードが減る場合だけまとめる。
+ * 要素はタイプを除いた形でまとめ、格子ごとに最も多いタイプで書き込み、異なるものはETYP(range_set.c)で変更する。
+ * 貪欲法の結果はまとめ方に左右されるため、等間隔に限る場合と限らない場合の両方を作り、少ない方を使う。
+ * 格子のカードは、複写する方向の順番(最大6通り)のうちCOPYカードが最も少ないもので書き込む。
+ * 座標は 0.01 単位の整数で比べるため、書き込み(%.2f)後の値が一致する。
+ */
+
+/**
+ * CopyLattice構造体
+ *
+ * 基準の節点(要素)を dim_num 方向に複写した格子。
+ * 番号は start + Σ t[d] * increment[d] (t[d] = 0 ... count[d] - 1) で、
+ * t[d] 番目は基準から offset[d][t[d]] だけずれる(節点は axis[d] 方向の座標(0.01単位)、要素は節点番号)。
+ * offset[d] は CopyContext の offset_pool[offset_index[d]] から count[d] 個。
+ */
+typedef struct {
+    int start;                              // 基準の番号
+    int base;                               // 基準の節点(要素)の配列番号
+    int shape;                              // 要素の形(種類、節点番号の差)の分類。節点は 0
+    int dim_num;
+    int count[MESH_COPY_DIM_MAX];           // 個数
+    int increment[MESH_COPY_DIM_MAX];       // 番号の増分
+    int axis[MESH_COPY_DIM_MAX];            // 座標をずらす方向(節点)
+    int offset_index[MESH_COPY_DIM_MAX];    // ずれの量の位置
+    unsigned long long offset_hash;         // ずれの量のハッシュ値(並べ替え用)
+    int cost;                               // カード数
+} CopyLattice;
+
+/**
+ * 作成中のデータ
+ */
+typedef struct {
+    const MeshModel* model;
+    int is_node;               // 1: 節点, 0: 要素
+    int uniform_only;          // 1: 等間隔のずれだけまとめる
+    long long* coordinate;     // 節点の座標(0.01単位)。サイズは 3 * node_num。
+    long long* offset_pool;    // 格子のずれの量
+    int offset_num;
+    int offset_capacity;
+    int* assigned_type;        // 要素のカードと複写で付くタイプ。サイズは element_num。
+} CopyContext;
+
+// 複写する方向の順番
+static const int copy_order[6][MESH_COPY_DIM_MAX] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+// メモリ確保、解放 ----------------------------------------------------------------------------
+CopyCardList* create_copy_card_list() {
+    CopyCardList* list = (CopyCardList*)malloc(sizeof(CopyCardList));
+    if (list == NULL) {
+        fprintf(stderr, "Error: Memory allocation for CopyCardList failed\n");
+        return NULL;
+    }
+    list->card_num = 0;
+    list->card_capacity = 0;
+    list->card = NULL;
+    return list;
+}
+
+int free_copy_card_list(CopyCardList* list) {
+    if (list == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(list->card);
+    free(list);
+    return EXIT_SUCCESS;
+}
+
+static int add_copy_card(CopyCardList* list, const CopyCard* card) {
+    if (list->card_num >= list->card_capacity) {
+        int capacity = (list->card_capacity == 0) ? 64 : list->card_capacity * 2;
+        CopyCard* new_card = (CopyCard*)realloc(list->card, (size_t)capacity * sizeof(CopyCard));
+        if (new_card == NULL) {
+            fprintf(stderr, "Error: Failed to grow CopyCardList\n");
+            return EXIT_FAILURE;
+        }
+        list->card = new_card;
+        list->card_capacity = capacity;
+    }
+    list->card[list->card_num++] = *card;
+    return EXIT_SUCCESS;
+}
+
+// 格子 ----------------------------------------------------------------------------
+static int compare_int(const void* a, const void* b) {
+    int p = *(const int*)a;
+    int q = *(const int*)b;
+    return (p > q) - (p < q);
+}
+
+/**
+ * 番号、始点以外を比べる(ずれの量はハッシュ値で比べる)
+ */
+static int compare_lattice_key(const CopyLattice* a, const CopyLattice* b) {
+    if (a->shape != b->shape) return (a->shape < b->shape) ? -1 : 1;
+    if (a->dim_num != b->dim_num) return (a->dim_num < b->dim_num) ? -1 : 1;
+    for (int d = 0; d < a->dim_num; d++) {
+        if (a->count[d] != b->count[d]) return (a->count[d] < b->count[d]) ? -1 : 1;
+        if (a->increment[d] != b->increment[d]) return (a->increment[d] < b->increment[d]) ? -1 : 1;
+        if (a->axis[d] != b->axis[d]) return (a->axis[d] < b->axis[d]) ? -1 : 1;
+    }
+    if (a->offset_hash != b->offset_hash) return (a->offset_hash < b->offset_hash) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * 平行移動で重なる形か調べる
+ */
+static int same_lattice_shape(const CopyContext* context, const CopyLattice* a, const CopyLattice* b) {
+    if (compare_lattice_key(a, b) != 0) {
+        return 0;
+    }
+    for (int d = 0; d < a->dim_num; d++) {
+        const long long* p = &context->offset_pool[a->offset_index[d]];
+        const long long* q = &context->offset_pool[b->offset_index[d]];
+        if (p != q && memcmp(p, q, (size_t)a->count[d] * sizeof(long long)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int compare_lattice(const void* a, const void* b) {
+    const CopyLattice* p = (const CopyLattice*)a;
+    const CopyLattice* q = (const CopyLattice*)b;
+    int key = compare_lattice_key(p, q);
+    if (key != 0) {
+        return key;
+    }
+    return (p->start > q->start) - (p->start < q->start);
+}
+
+static int compare_lattice_start(const void* a, const void* b) {
+    const CopyLattice* p = (const CopyLattice*)a;
+    const CopyLattice* q = (const CopyLattice*)b;
+    return (p->start > q->start) - (p->start < q->start);
+}
+
+/**
+ * 格子の order[0] ... order[use - 1] 方向の番号を昇順に求める
+ *
+ * @return 番号の数
+ */
+static int lattice_ids(const CopyLattice* lattice, const int order[], int use, int ids[]) {
+    int n = 1;
+    ids[0] = lattice->start;
+    for (int j = 0; j < use; j++) {
+        int d = order[j];
+        for (int t = 1; t < lattice->count[d]; t++) {
+            for (int i = 0; i < n; i++) {
+                ids[t * n + i] = ids[i] + t * lattice->increment[d];
+            }
+        }
+        n *= lattice->count[d];
+    }
+    qsort(ids, n, sizeof(int), compare_int);
+    return n;
+}
+
+/**
+ * 昇順の番号を S-E-I に分ける(mesh_model.c の split_arithmetic_runs と同じ分け方)
+ *
+ * @return S-E-I の数
+ */
+static int split_runs(const int ids[], int n, int start[], int end[], int interval[]) {
+    int run = 0;
+    int i = 0;
+    while (i < n) {
+        int j = i;
+        int d = 0;
+        if (i + 1 < n) {
+            d = ids[i + 1] - ids[i];
+            j = i + 1;
+            while (j + 1 < n && ids[j + 1] - ids[j] == d) {
+                j++;
+            }
+        }
+        if (start != NULL) {
+            start[run] = ids[i];
+            end[run] = (j == i) ? 0 : ids[j];
+            interval[run] = (j == i) ? 0 : d;
+        }
+        i = j + 1;
+        run++;
+    }
+    return run;
+}
+
+/**
+ * ずれの量を等間隔の区間に分ける
+ *
+ * @param from, to 区間の最初と最後の位置(NULL可)
+ * @return 区間の数
+ */
+static int split_segments(const long long offset[], int count, int from[], int to[]) {
+    int segment = 0;
+    int t = 0;
+    while (t + 1 < count) {
+        long long step = offset[t + 1] - offset[t];
+        int u = t + 1;
+        while (u + 1 < count && offset[u + 1] - offset[u] == step) {
+            u++;
+        }
+        if (from != NULL) {
+            from[segment] = t;
+            to[segment] = u;
+        }
+        segment++;
+        t = u;
+    }
+    return segment;
+}
+
+static int lattice_size(const CopyLattice* lattice) {
+    int size = 1;
+    for (int d = 0; d < lattice->dim_num; d++) {
+        size *= lattice->count[d];
+    }
+    return size;
+}
+
+/**
+ * 格子のカード数(基準のカード + COPYカード)の最小値と、その時の複写の順番を求める
+ *
+ * @param work 作業配列(サイズは格子の個数以上)
+ * @param best_order 複写の順番(NULL可)
+ */
+static int lattice_cost(const CopyContext* context, const CopyLattice* lattice, int work[], int best_order[]) {
+    int best = -1;
+    for (int p = 0; p < 6; p++) {
+        int valid = 1;
+        for (int j = 0; j < lattice->dim_num; j++) {
+            if (copy_order[p][j] >= lattice->dim_num) valid = 0;
+        }
+        if (!valid) {
+            continue;
+        }
+        int cost = 1;
+        for (int j = 0; j < lattice->dim_num; j++) {
+            int d = copy_order[p][j];
+            int n = lattice_ids(lattice, copy_order[p], j, work);
+            int segment = split_segments(&context->offset_pool[lattice->offset_index[d]], lattice->count[d], NULL, NULL);
+            cost += segment * split_runs(work, n, NULL, NULL, NULL);
+        }
+        if (best < 0 || cost < best) {
+            best = cost;
+            if (best_order != NULL) {
+                for (int j = 0; j < MESH_COPY_DIM_MAX; j++) best_order[j] = copy_order[p][j];
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * 格子 a から格子 b へのずれを求める。節点は1方向だけの移動(移動なしの場合は axis = -1)に限る。
+ *
+ * @param axis 移動の方向(節点)
+ * @param offset 移動量(節点、0.01単位)または節点番号の差(要素)
+ * @return 平行移動で重なる場合は 1
+ */
+static int lattice_translation(const CopyContext* context, const CopyLattice* a, const CopyLattice* b,
+                               int* axis, long long* offset) {
+    *axis = -1;
+    *offset = 0;
+    if (context->is_node) {
+        int moved = 0;
+        for (int k = 0; k < 3; k++) {
+            long long delta = context->coordinate[3 * b->base + k] - context->coordinate[3 * a->base + k];
+            if (delta != 0) {
+                *axis = k;
+                *offset = delta;
+                moved++;
+            }
+        }
+        return moved <= 1;
+    }
+    const int* connectivity = context->model->connectivity;
+    *offset = connectivity[b->base * ELEMENT_NODE_MAX] - connectivity[a->base * ELEMENT_NODE_MAX];
+    return 1;
+}
+
+/**
+ * head から番号を increment ずつずらした同じ形の格子を、移動の方向が変わるまでたどる
+ *
+ * @param offset 各格子の移動量の格納先(NULL可)
+ * @param axis 移動の方向の格納先
+ * @return 格子の数
+ */
+static int follow_chain(const CopyContext* context, const CopyLattice* lattice, const int start_map[], const char used[],
+                        int max_id, int head, int increment, long long offset[], int* axis) {
+    *axis = -1;
+    int length = 0;
+    long long first_offset = 0;
+    for (;;) {
+        long long id = lattice[head].start + (long long)length * increment;
+        if (id > max_id) {
+            break;
+        }
+        int next = start_map[id];
+        if (next < 0 || used[next] || !same_lattice_shape(context, &lattice[head], &lattice[next])) {
+            break;
+        }
+        int next_axis;
+        long long next_offset;
+        if (!lattice_translation(context, &lattice[head], &lattice[next], &next_axis, &next_offset)) {
+            break;
+        }
+        if (next_axis >= 0) {
+            if (*axis >= 0 && next_axis != *axis) {
+                break;
+            }
+            *axis = next_axis;
+        }
+        if (length == 1) {
+            first_offset = next_offset;
+        } else if (context->uniform_only && next_offset != length * first_offset) {
+            break;
+        }
+        if (offset != NULL) {
+            offset[length] = next_offset;
+        }
+        length++;
+    }
+    return length;
+}
+
+static unsigned long long hash_offsets(unsigned long long hash, const long long offset[], int count) {
+    for (int t = 0; t < count; t++) {
+        hash = (hash ^ (unsigned long long)offset[t]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * 同じ形の格子を等差に並べてまとめる(1回分)
+ *
+ * @param lattice 格子(並べ替える)
+ * @param lattice_num 格子の数(まとめた後の数に更新する)
+ * @param max_id 番号の最大値
+ */
+static int merge_lattices(CopyContext* context, CopyLattice* lattice, int* lattice_num, int max_id, int work[]) {
+    int num = *lattice_num;
+    qsort(lattice, num, sizeof(CopyLattice), compare_lattice);
+    int* start_map = (int*)malloc(((size_t)max_id + 2) * sizeof(int));
+    char* used = (char*)calloc((size_t)num + 1, sizeof(char));
+    CopyLattice* merged = (CopyLattice*)malloc(((size_t)num + 1) * sizeof(CopyLattice));
+    if (start_map == NULL || used == NULL || merged == NULL) {
+        fprintf(stderr, "Error: Memory allocation for merge_lattices failed\n");
+        free(start_map);
+        free(used);
+        free(merged);
+        return EXIT_FAILURE;
+    }
+    for (int id = 0; id <= max_id + 1; id++) {
+        start_map[id] = -1;
+    }
+    for (int i = 0; i < num; i++) {
+        start_map[lattice[i].start] = i;
+    }
+
+    int merged_num = 0;
+    for (int i = 0; i < num; i++) {
+        if (used[i]) {
+            continue;
+        }
+        const CopyLattice* head = &lattice[i];
+        if (head->dim_num >= MESH_COPY_DIM_MAX) {
+            continue;
+        }
+
+        // 番号順に近い同じ形の候補から、最も長く続くものを選ぶ
+        int best_length = 1;
+        int best_increment = 0;
+        int candidate = 0;
+        for (int c = i + 1; c < num && candidate < MESH_COPY_CANDIDATE_NUM; c++) {
+            if (compare_lattice_key(head, &lattice[c]) != 0) {
+                break;
+            }
+            if (used[c] || !same_lattice_shape(context, head, &lattice[c])) {
+                continue;
+            }
+            candidate++;
+            int axis;
+            int increment = lattice[c].start - head->start;
+            int length = follow_chain(context, lattice, start_map, used, max_id, i, increment, NULL, &axis);
+            if (length > best_length) {
+                best_length = length;
+                best_increment = increment;
+            }
+        }
+        if (best_length < 2 || context->offset_num + best_length > context->offset_capacity) {
+            continue;
+        }
+
+        // カードが減る場合だけまとめる
+        CopyLattice joined = *head;
+        int d = joined.dim_num++;
+        long long* offset = &context->offset_pool[context->offset_num];
+        int axis;
+        follow_chain(context, lattice, start_map, used, max_id, i, best_increment, offset, &axis);
+        joined.count[d] = best_length;
+        joined.increment[d] = best_increment;
+        joined.axis[d] = (axis < 0) ? 0 : axis;
+        joined.offset_index[d] = context->offset_num;
+        joined.offset_hash = hash_offsets(head->offset_hash * 31 + (unsigned long long)joined.axis[d], offset, best_length);
+        joined.cost = lattice_cost(context, &joined, work, NULL);
+        if (joined.cost > best_length * head->cost) {
+            continue;
+        }
+        context->offset_num += best_length;
+        for (int k = 0; k < best_length; k++) {
+            used[start_map[head->start + k * best_increment]] = 1;
+        }
+        merged[merged_num++] = joined;
+    }
+
+    // まとめなかった格子を加える
+    for (int i = 0; i < num; i++) {
+        if (!used[i]) {
+            merged[merged_num++] = lattice[i];
+        }
+    }
+    memcpy(lattice, merged, (size_t)merged_num * sizeof(CopyLattice));
+    *lattice_num = merged_num;
+
+    free(start_map);
+    free(used);
+    free(merged);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素の格子で最も多いタイプを求め、格子の要素に付くタイプとして記録する
+ *
+ * LINEはTYPL(1)でしか書き込めないため 1 とする。
+ */
+static int lattice_type(const CopyContext* context, const CopyLattice* lattice, int ids[], int types[]) {
+    const MeshModel* model = context->model;
+    int order[MESH_COPY_DIM_MAX] = {0, 1, 2};
+    int n = lattice_ids(lattice, order, lattice->dim_num, ids);
+    for (int i = 0; i < n; i++) {
+        ids[i] = find_mesh_element(model, ids[i]);
+        types[i] = model->element_type[ids[i]];
+    }
+    int type = 1;
+    if (model->element_kind[lattice->base] != ELEMENT_LINE) {
+        qsort(types, n, sizeof(int), compare_int);
+        int best = 0;
+        for (int i = 0; i < n;) {
+            int j = i;
+            while (j < n && types[j] == types[i]) j++;
+            if (j - i > best) {
+                best = j - i;
+                type = types[i];
+            }
+            i = j;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        context->assigned_type[ids[i]] = type;
+    }
+    return type;
+}
+
+/**
+ * 格子を基準のカードとCOPYカードにする
+ */
+static int emit_lattice(const CopyContext* context, const CopyLattice* lattice, CopyCardList* list,
+                        int work[], int start[], int end[], int interval[]) {
+    int order[MESH_COPY_DIM_MAX];
+    CopyCard card;
+    memset(&card, 0, sizeof(CopyCard));
+    card.kind = context->is_node ? COPY_CARD_NODE : COPY_CARD_ELEMENT;
+    card.start = lattice->start;
+    if (!context->is_node) {
+        card.type = lattice_type(context, lattice, work, start);
+    }
+    if (add_copy_card(list, &card) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    int max_count = 1;
+    for (int d = 0; d < lattice->dim_num; d++) {
+        if (lattice->count[d] > max_count) max_count = lattice->count[d];
+    }
+    int* from = (int*)malloc((size_t)max_count * sizeof(int));
+    int* to = (int*)malloc((size_t)max_count * sizeof(int));
+    if (from == NULL || to == NULL) {
+        fprintf(stderr, "Error: Memory allocation for emit_lattice failed\n");
+        free(from);
+        free(to);
+        return EXIT_FAILURE;
+    }
+    lattice_cost(context, lattice, work, order);
+    int result = EXIT_SUCCESS;
+    for (int j = 0; j < lattice->dim_num && result == EXIT_SUCCESS; j++) {
+        int d = order[j];
+        const long long* offset = &context->offset_pool[lattice->offset_index[d]];
+        int n = lattice_ids(lattice, order, j, work);
+        int run = split_runs(work, n, start, end, interval);
+        int segment = split_segments(offset, lattice->count[d], from, to);
+        // 等間隔の区間ごとに、区間の最初の層を複写する
+        for (int g = 0; g < segment; g++) {
+            int shift = from[g] * lattice->increment[d];
+            long long step = offset[from[g] + 1] - offset[from[g]];
+            for (int r = 0; r < run; r++) {
+                memset(&card, 0, sizeof(CopyCard));
+                card.kind = context->is_node ? COPY_CARD_COPY_NODE : COPY_CARD_COPY_ELEMENT;
+                card.start = start[r] + shift;
+                card.end = (end[r] == 0) ? 0 : end[r] + shift;
+                card.interval = interval[r];
+                card.increment = lattice->increment[d];
+                if (context->is_node) {
+                    card.axis = lattice->axis[d];
+                    card.distance = step / 100.0;
+                } else {
+                    card.node_increment = (int)step;
+                }
+                card.set = to[g] - from[g];
+                if (add_copy_card(list, &card) != EXIT_SUCCESS) {
+                    result = EXIT_FAILURE;
+                }
+            }
+        }
+    }
+    free(from);
+    free(to);
+    return result;
+}
+
+/**
+ * 付いたタイプと異なる要素をタイプごとに範囲の組(range_set.c)にまとめ、ETYPカードにする
+ */
+static int emit_element_types(const CopyContext* context, CopyCardList* list, int ids[]) {
+    const MeshModel* model = context->model;
+    int* done = (int*)calloc((size_t)model->element_num + 1, sizeof(int));
+    RangeSetList* range_list = create_range_set_list();
+    if (done == NULL || range_list == NULL) {
+        fprintf(stderr, "Error: Memory allocation for emit_element_types failed\n");
+        free(done);
+        free_range_set_list(range_list);
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_SUCCESS;
+    for (int e = 0; e < model->element_num && result == EXIT_SUCCESS; e++) {
+        if (done[e] || model->element_type[e] == context->assigned_type[e]) {
+            continue;
+        }
+        int type = model->element_type[e];
+        int n = 0;
+        for (int other = e; other < model->element_num; other++) {
+            if (!done[other] && model->element_type[other] == type && context->assigned_type[other] != type) {
+                ids[n++] = model->element_id[other];
+                done[other] = 1;
+            }
+        }
+        range_list->range_num = 0;
+        result = encode_range_set(ids, n, 1, range_list);
+        for (int r = 0; r < range_list->range_num && result == EXIT_SUCCESS; r++) {
+            const RangeSet* range = &range_list->range[r];
+            CopyCard card;
+            memset(&card, 0, sizeof(CopyCard));
+            card.kind = COPY_CARD_ETYP;
+            card.start = range->start;
+            card.end = range->end;
+            card.interval = range->interval;
+            card.increment = range->increment;
+            card.set = range->set;
+            card.type = type;
+            result = add_copy_card(list, &card);
+        }
+    }
+    free(done);
+    free_range_set_list(range_list);
+    return result;
+}
+
+// 要素の形の分類 ----------------------------------------------------------------------------
+typedef struct {
+    int kind;
+    int offset[ELEMENT_NODE_MAX];
+    int index;
+} ElementShape;
+
+static int compare_element_shape(const void* a, const void* b) {
+    const ElementShape* p = (const ElementShape*)a;
+    const ElementShape* q = (const ElementShape*)b;
+    if (p->kind != q->kind) return (p->kind < q->kind) ? -1 : 1;
+    for (int i = 0; i < ELEMENT_NODE_MAX; i++) {
+        if (p->offset[i] != q->offset[i]) return (p->offset[i] < q->offset[i]) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * 種類、節点番号の差(1番目の節点から)が同じ要素に同じ分類番号を付ける
+ */
+static int classify_element_shapes(const MeshModel* model, int shape[]) {
+    ElementShape* element = (ElementShape*)malloc(((size_t)model->element_num + 1) * sizeof(ElementShape));
+    if (element == NULL) {
+        fprintf(stderr, "Error: Memory allocation for classify_element_shapes failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int count = element_node_count(model->element_kind[e]);
+        element[e].kind = model->element_kind[e];
+        for (int i = 0; i < ELEMENT_NODE_MAX; i++) {
+            element[e].offset[i] = (i < count) ? node[i] - node[0] : 0;
+        }
+        element[e].index = e;
+    }
+    qsort(element, model->element_num, sizeof(ElementShape), compare_element_shape);
+    int class_num = 0;
+    for (int i = 0; i < model->element_num; i++) {
+        if (i > 0 && compare_element_shape(&element[i - 1], &element[i]) != 0) {
+            class_num++;
+        }
+        shape[element[i].index] = class_num;
+    }
+    free(element);
+    return EXIT_SUCCESS;
+}
+
+// カードの作成 ----------------------------------------------------------------------------
+static int synthesize_cards(const MeshModel* model, int is_node, int uniform_only, CopyCardList* list) {
+    if (model == NULL || list == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to synthesize_cards\n");
+        return EXIT_FAILURE;
+    }
+    int num = is_node ? model->node_num : model->element_num;
+    const int* id = is_node ? model->node_id : model->element_id;
+    int max_id = 0;
+    for (int i = 0; i < num; i++) {
+        if (id[i] > max_id) max_id = id[i];
+    }
+
+    CopyContext context;
+    context.model = model;
+    context.is_node = is_node;
+    context.uniform_only = uniform_only;
+    context.coordinate = NULL;
+    context.offset_num = 0;
+    context.offset_capacity = MESH_COPY_DIM_MAX * (num + 1);
+    context.offset_pool = (long long*)malloc((size_t)context.offset_capacity * sizeof(long long));
+    context.assigned_type = NULL;
+    CopyLattice* lattice = (CopyLattice*)malloc(((size_t)num + 1) * sizeof(CopyLattice));
+    int* shape = (int*)calloc((size_t)num + 1, sizeof(int));
+    int* work = (int*)malloc(((size_t)num + 1) * sizeof(int));
+    int* start = (int*)malloc(((size_t)num + 1) * sizeof(int));
+    int* end = (int*)malloc(((size_t)num + 1) * sizeof(int));
+    int* interval = (int*)malloc(((size_t)num + 1) * sizeof(int));
+    if (is_node) {
+        context.coordinate = (long long*)malloc(3 * ((size_t)num + 1) * sizeof(long long));
+    } else {
+        context.assigned_type = (int*)malloc(((size_t)num + 1) * sizeof(int));
+    }
+    int result = EXIT_SUCCESS;
+    if (lattice == NULL || shape == NULL || work == NULL || start == NULL || end == NULL || interval == NULL || context.offset_pool == NULL ||
+        (is_node && context.coordinate == NULL) || (!is_node && context.assigned_type == NULL)) {
+        fprintf(stderr, "Error: Memory allocation for synthesize_cards failed\n");
+        result = EXIT_FAILURE;
+    }
+    if (result == EXIT_SUCCESS && !is_node) {
+        result = classify_element_shapes(model, shape);
+    }
+
+    if (result == EXIT_SUCCESS) {
+        for (int i = 0; i < num; i++) {
+            if (is_node) {
+                context.coordinate[3 * i] = llround(model->x[i] * 100.0);
+                context.coordinate[3 * i + 1] = llround(model->y[i] * 100.0);
+                context.coordinate[3 * i + 2] = llround(model->z[i] * 100.0);
+            }
+            memset(&lattice[i], 0, sizeof(CopyLattice));
+            lattice[i].start = id[i];
+            lattice[i].base = i;
+            lattice[i].shape = shape[i];
+            lattice[i].offset_hash = 14695981039346656037ULL;
+            lattice[i].cost = 1;
+        }
+        int lattice_num = num;
+        for (int round = 0; round < MESH_COPY_DIM_MAX && result == EXIT_SUCCESS; round++) {
+            result = merge_lattices(&context, lattice, &lattice_num, max_id, work);
+        }
+        if (result == EXIT_SUCCESS) {
+            qsort(lattice, lattice_num, sizeof(CopyLattice), compare_lattice_start);
+            for (int i = 0; i < lattice_num && result == EXIT_SUCCESS; i++) {
+                if (lattice_size(&lattice[i]) > num) {
+                    result = EXIT_FAILURE;
+                    break;
+                }
+                result = emit_lattice(&context, &lattice[i], list, work, start, end, interval);
+            }
+            if (result == EXIT_SUCCESS && !is_node) {
+                result = emit_element_types(&context, list, work);
+            }
+        }
+    }
+
+    free(lattice);
+    free(shape);
+    free(work);
+    free(start);
+    free(end);
+    free(interval);
+    free(context.coordinate);
+    free(context.offset_pool);
+    free(context.assigned_type);
+    return result;
+}
+
+/**
+ * 等間隔に限る場合と限らない場合のうち、カードが少ない方を list に加える
+ */
+static int synthesize_best_cards(const MeshModel* model, int is_node, CopyCardList* list) {
+    CopyCardList* uniform = create_copy_card_list();
+    CopyCardList* general = create_copy_card_list();
+    int result = EXIT_FAILURE;
+    if (uniform != NULL && general != NULL &&
+        synthesize_cards(model, is_node, 1, uniform) == EXIT_SUCCESS &&
+        synthesize_cards(model, is_node, 0, general) == EXIT_SUCCESS) {
+        const CopyCardList* best = (general->card_num < uniform->card_num) ? general : uniform;
+        result = EXIT_SUCCESS;
+        for (int i = 0; i < best->card_num && result == EXIT_SUCCESS; i++) {
+            result = add_copy_card(list, &best->card[i]);
+        }
+    }
+    free_copy_card_list(uniform);
+    free_copy_card_list(general);
+    return result;
+}
+
+/**
+ * 節点をNODEカードとCOPY :NODEカードにする
+ */
+int synthesize_node_cards(const MeshModel* model, CopyCardList* list) {
+    return synthesize_best_cards(model, 1, list);
+}
+
+/**
+ * 要素を要素のカードとCOPY :ELMカードにする
+ */
+int synthesize_element_cards(const MeshModel* model, CopyCardList* list) {
+    return synthesize_best_cards(model, 0, list);
+}
+
+// 確認 ----------------------------------------------------------------------------
+/**
+ * COPYカードの複写元(S-E-I)が全て定義済みか調べる
+ */
+static int copy_source_defined(const MeshModel* model, const CopyCard* card, int is_node) {
+    int end = (card->end == 0) ? card->start : card->end;
+    int interval = (card->interval == 0) ? 1 : card->interval;
+    for (int id = card->start; id <= end; id += interval) {
+        if ((is_node ? find_mesh_node(model, id) : find_mesh_element(model, id)) < 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * カードを展開し、元の節点、要素(番号、座標、種類、タイプ、節点番号)と一致するか確かめる
+ *
+ * @param node_cards 節点のカード(NULL可)
+ * @param element_cards 要素のカード(NULL可)
+ */
+int verify_copy_cards(const MeshModel* model, const CopyCardList* node_cards, const CopyCardList* element_cards) {
+    MeshModel* copy = create_mesh_model();
+    if (copy == NULL) {
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_SUCCESS;
+    const CopyCardList* lists[2] = {node_cards, element_cards};
+    for (int l = 0; l < 2 && result == EXIT_SUCCESS; l++) {
+        if (lists[l] == NULL) {
+            continue;
+        }
+        for (int i = 0; i < lists[l]->card_num && result == EXIT_SUCCESS; i++) {
+            const CopyCard* card = &lists[l]->card[i];
+            int index;
+            switch (card->kind) {
+                case COPY_CARD_NODE:
+                    index = find_mesh_node(model, card->start);
+                    if (index < 0 || add_mesh_node(copy, card->start, model->x[index], model->y[index], model->z[index]) < 0) {
+                        result = EXIT_FAILURE;
+                    }
+                    break;
+                case COPY_CARD_ELEMENT:
+                    index = find_mesh_element(model, card->start);
+                    if (index < 0 || add_mesh_element(copy, card->start, model->element_kind[index], card->type,
+                                                      &model->connectivity[index * ELEMENT_NODE_MAX]) < 0) {
+                        result = EXIT_FAILURE;
+                    }
+                    break;
+                case COPY_CARD_COPY_NODE: {
+                    int values[5] = {card->start, card->end, card->interval, card->increment, card->set};
+                    if (!copy_source_defined(copy, card, 1)) {
+                        result = EXIT_FAILURE;
+                    } else {
+                        // 書き込む値(%.2f)で展開する
+                        expand_copy_node(copy, values, round(card->distance * 100.0) / 100.0, card->axis);
+                    }
+                    break;
+                }
+                case COPY_CARD_COPY_ELEMENT: {
+                    int values[6] = {card->start, card->end, card->interval, card->increment, card->node_increment, card->set};
+                    if (!copy_source_defined(copy, card, 0)) {
+                        result = EXIT_FAILURE;
+                    } else {
+                        expand_copy_element(copy, values);
+                    }
+                    break;
+                }
+                case COPY_CARD_ETYP:
+                    break;
+                default:
+                    result = EXIT_FAILURE;
+                    break;
+            }
+        }
+    }
+    // ETYPは読み込みと同じく全ての要素を作った後に変更する
+    if (result == EXIT_SUCCESS && element_cards != NULL) {
+        for (int i = 0; i < element_cards->card_num; i++) {
+            const CopyCard* card = &element_cards->card[i];
+            if (card->kind != COPY_CARD_ETYP) {
+                continue;
+            }
+            int end = (card->end == 0) ? card->start : card->end;
+            int interval = (card->interval == 0) ? 1 : card->interval;
+            for (int k = 0; k <= card->set; k++) {
+                for (int id = card->start; id <= end; id += interval) {
+                    int index = find_mesh_element(copy, id + k * card->increment);
+                    if (index >= 0) {
+                        copy->element_type[index] = card->type;
+                    }
+                }
+            }
+        }
+    }
+
+    // 節点の比較
+    if (result == EXIT_SUCCESS && node_cards != NULL) {
+        if (copy->node_num != model->node_num) {
+            result = EXIT_FAILURE;
+        }
+        for (int n = 0; n < model->node_num && result == EXIT_SUCCESS; n++) {
+            int c = find_mesh_node(copy, model->node_id[n]);
+            if (c < 0 || llround(copy->x[c] * 100.0) != llround(model->x[n] * 100.0) ||
+                llround(copy->y[c] * 100.0) != llround(model->y[n] * 100.0) ||
+                llround(copy->z[c] * 100.0) != llround(model->z[n] * 100.0)) {
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+    // 要素の比較
+    if (result == EXIT_SUCCESS && element_cards != NULL) {
+        if (copy->element_num != model->element_num) {
+            result = EXIT_FAILURE;
+        }
+        for (int e = 0; e < model->element_num && result == EXIT_SUCCESS; e++) {
+            int c = find_mesh_element(copy, model->element_id[e]);
+            if (c < 0 || copy->element_kind[c] != model->element_kind[e] || copy->element_type[c] != model->element_type[e] ||
+                memcmp(&copy->connectivity[c * ELEMENT_NODE_MAX], &model->connectivity[e * ELEMENT_NODE_MAX],
+                       (size_t)element_node_count(model->element_kind[e]) * sizeof(int)) != 0) {
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+
+    free_mesh_model(copy);
+    return result;
+}
+
+// 書き込み ----------------------------------------------------------------------------
+void print_copy_cards(FILE* f, const MeshModel* model, const CopyCardList* list) {
+    for (int i = 0; i < list->card_num; i++) {
+        const CopyCard* card = &list->card[i];
+        int index;
+        switch (card->kind) {
+            case COPY_CARD_NODE:
+                index = find_mesh_node(model, card->start);
+                print_NODE(f, card->start, model->x[index], model->y[index], model->z[index]);
+                break;
+            case COPY_CARD_ELEMENT:
+                print_mesh_element(f, model, find_mesh_element(model, card->start), card->type);
+                break;
+            case COPY_CARD_COPY_NODE:
+                print_COPYNODE(f, card->start, card->end, card->interval, card->distance, card->increment, card->set, card->axis);
+                break;
+            case COPY_CARD_COPY_ELEMENT:
+                print_COPYELM(f, card->start, card->end, card->interval, card->increment, card->node_increment, card->set);
+                break;
+            case COPY_CARD_ETYP:
+                print_ETYP(f, card->start, card->end, card->interval, card->type, card->increment, card->set);
+                break;
+            default:
+                break;
+        }
+    }
+}
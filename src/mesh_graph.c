@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "mesh_graph.h"
+
+/**
+ * MeshModelの節点 -> 要素、要素 -> 要素、節点 -> 節点の隣接関係をCSR形式で作成する。
+ *
+ * 数え上げ(counting sort)で作成するため、計算量は O(要素数 x 節点数/要素) 程度。
+ * -fopenmp でコンパイルした場合は数え上げ、書き込み、行の整列を並列に行う。
+ */
+
+#ifdef _OPENMP
+#define MESH_GRAPH_PRAGMA(x) _Pragma(#x)
+#else
+#define MESH_GRAPH_PRAGMA(x)
+#endif
+
+// メモリ確保、解放 ----------------------------------------------------------------------------
+CsrGraph* allocate_csr_graph(int row_num, int column_num, uint32_t nnz) {
+    if (row_num < 0) {
+        fprintf(stderr, "Error: Invalid row_num (%d)\n", row_num);
+        return NULL;
+    }
+    CsrGraph* graph = (CsrGraph*)malloc(sizeof(CsrGraph));
+    if (graph == NULL) {
+        fprintf(stderr, "Error: Memory allocation for CsrGraph failed\n");
+        return NULL;
+    }
+    graph->row_num = row_num;
+    graph->column_num = column_num;
+    graph->offset = (uint32_t*)calloc((size_t)row_num + 1, sizeof(uint32_t));
+    graph->index = (uint32_t*)malloc(((size_t)nnz > 0 ? (size_t)nnz : 1) * sizeof(uint32_t));
+    if (graph->offset == NULL || graph->index == NULL) {
+        fprintf(stderr, "Error: Memory allocation for CsrGraph arrays failed\n");
+        free(graph->offset);
+        free(graph->index);
+        free(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+int free_csr_graph(CsrGraph* graph) {
+    if (graph == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to free_csr_graph\n");
+        return EXIT_FAILURE;
+    }
+    free(graph->offset);
+    graph->offset = NULL;
+    free(graph->index);
+    graph->index = NULL;
+    free(graph);
+    return EXIT_SUCCESS;
+}
+
+// 補助関数 ----------------------------------------------------------------------------
+/**
+ * count[0 ... n-1] を累積して offset[0 ... n] にする
+ */
+static uint32_t exclusive_scan(const uint32_t count[], uint32_t offset[], int n) {
+    uint32_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        offset[i] = sum;
+        sum += count[i];
+    }
+    offset[n] = sum;
+    return sum;
+}
+
+/**
+ * 行ごとに昇順に並べる。行は短いため挿入ソートとする。
+ */
+static void sort_rows(CsrGraph* graph) {
+    MESH_GRAPH_PRAGMA(omp parallel for schedule(dynamic, 256))
+    for (int r = 0; r < graph->row_num; r++) {
+        uint32_t* row = &graph->index[graph->offset[r]];
+        uint32_t length = graph->offset[r + 1] - graph->offset[r];
+        for (uint32_t i = 1; i < length; i++) {
+            uint32_t value = row[i];
+            uint32_t j = i;
+            while (j > 0 && row[j - 1] > value) {
+                row[j] = row[j - 1];
+                j--;
+            }
+            row[j] = value;
+        }
+    }
+}
+
+/**
+ * 要素 e の k 番目の節点が、それより前に同じ節点として現れているかを判定する
+ */
+static int is_repeated_node(const int* node, int k) {
+    for (int i = 0; i < k; i++) {
+        if (node[i] == node[k]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 節点 -> 要素 ----------------------------------------------------------------------------
+/**
+ * 節点 -> 要素の隣接関係を作成する。
+ * 行は節点の配列番号、隣接先はその節点を含む要素の配列番号。
+ * MeshModelに存在しない節点番号は無視する。
+ */
+CsrGraph* build_node_element_graph(const MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_node_element_graph\n");
+        return NULL;
+    }
+    int node_num = model->node_num;
+    int element_num = model->element_num;
+
+    // 節点ごとの要素数を数える
+    uint32_t* count = (uint32_t*)calloc((size_t)node_num + 1, sizeof(uint32_t));
+    if (count == NULL) {
+        fprintf(stderr, "Error: Memory allocation for count failed\n");
+        return NULL;
+    }
+    MESH_GRAPH_PRAGMA(omp parallel for)
+    for (int e = 0; e < element_num; e++) {
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int k = 0; k < node_count; k++) {
+            int n = find_mesh_node(model, node[k]);
+            if (n < 0 || is_repeated_node(node, k)) {
+                continue;
+            }
+            MESH_GRAPH_PRAGMA(omp atomic)
+            count[n]++;
+        }
+    }
+
+    uint32_t nnz = 0;
+    for (int n = 0; n < node_num; n++) {
+        nnz += count[n];
+    }
+    CsrGraph* graph = allocate_csr_graph(node_num, element_num, nnz);
+    if (graph == NULL) {
+        free(count);
+        return NULL;
+    }
+    exclusive_scan(count, graph->offset, node_num);
+
+    // 書き込み - countを書き込み位置として使い回す
+    for (int n = 0; n < node_num; n++) {
+        count[n] = graph->offset[n];
+    }
+    MESH_GRAPH_PRAGMA(omp parallel for)
+    for (int e = 0; e < element_num; e++) {
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int k = 0; k < node_count; k++) {
+            int n = find_mesh_node(model, node[k]);
+            if (n < 0 || is_repeated_node(node, k)) {
+                continue;
+            }
+            uint32_t position;
+            MESH_GRAPH_PRAGMA(omp atomic capture)
+            position = count[n]++;
+            graph->index[position] = (uint32_t)e;
+        }
+    }
+    free(count);
+
+    // 並列の場合は書き込み順が不定のため整列する
+    sort_rows(graph);
+    return graph;
+}
+
+// 要素 -> 要素、節点 -> 節点 ----------------------------------------------------------------------------
+/**
+ * 要素 e と節点を共有する要素を集める。
+ *
+ * @param shared 作業配列(要素数分、0で初期化済み)。終了時に0に戻す。
+ * @param touched 作業配列(要素数分)
+ * @param out 隣接要素の書き込み先。NULLの場合は数えるだけ。
+ * @return 隣接要素の数
+ */
+static uint32_t collect_element_neighbors(const MeshModel* model, const CsrGraph* node_element, int e, int min_shared_nodes,
+                                          int shared[], uint32_t touched[], uint32_t out[]) {
+    const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+    int node_count = element_node_count(model->element_kind[e]);
+    uint32_t touched_num = 0;
+    for (int k = 0; k < node_count; k++) {
+        int n = find_mesh_node(model, node[k]);
+        if (n < 0 || is_repeated_node(node, k)) {
+            continue;
+        }
+        for (uint32_t p = node_element->offset[n]; p < node_element->offset[n + 1]; p++) {
+            uint32_t other = node_element->index[p];
+            if ((int)other == e) {
+                continue;
+            }
+            if (shared[other] == 0) {
+                touched[touched_num++] = other;
+            }
+            shared[other]++;
+        }
+    }
+
+    uint32_t degree = 0;
+    for (uint32_t t = 0; t < touched_num; t++) {
+        uint32_t other = touched[t];
+        if (shared[other] >= min_shared_nodes) {
+            if (out != NULL) {
+                out[degree] = other;
+            }
+            degree++;
+        }
+        shared[other] = 0;
+    }
+    return degree;
+}
+
+/**
+ * 要素 -> 要素の隣接関係(双対グラフ)を作成する。
+ *
+ * @param node_element build_node_element_graph()の結果
+ * @param min_shared_nodes 隣接とみなす共有節点数の下限(1: 節点共有、2: 辺共有、3以上: 面共有)
+ */
+CsrGraph* build_element_graph(const MeshModel* model, const CsrGraph* node_element, int min_shared_nodes) {
+    if (model == NULL || node_element == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_element_graph\n");
+        return NULL;
+    }
+    if (min_shared_nodes < 1) {
+        min_shared_nodes = 1;
+    }
+    int element_num = model->element_num;
+    uint32_t* count = (uint32_t*)calloc((size_t)element_num + 1, sizeof(uint32_t));
+    if (count == NULL) {
+        fprintf(stderr, "Error: Memory allocation for count failed\n");
+        return NULL;
+    }
+
+    // 1回目: 数える
+    int failed = 0;
+    MESH_GRAPH_PRAGMA(omp parallel)
+    {
+        int* shared = (int*)calloc((size_t)element_num + 1, sizeof(int));
+        uint32_t* touched = (uint32_t*)malloc(((size_t)element_num + 1) * sizeof(uint32_t));
+        if (shared == NULL || touched == NULL) {
+            MESH_GRAPH_PRAGMA(omp atomic write)
+            failed = 1;
+        } else {
+            MESH_GRAPH_PRAGMA(omp for schedule(dynamic, 256))
+            for (int e = 0; e < element_num; e++) {
+                count[e] = collect_element_neighbors(model, node_element, e, min_shared_nodes, shared, touched, NULL);
+            }
+        }
+        free(shared);
+        free(touched);
+    }
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation for element graph work arrays failed\n");
+        free(count);
+        return NULL;
+    }
+
+    uint32_t nnz = 0;
+    for (int e = 0; e < element_num; e++) {
+        nnz += count[e];
+    }
+    CsrGraph* graph = allocate_csr_graph(element_num, element_num, nnz);
+    if (graph == NULL) {
+        free(count);
+        return NULL;
+    }
+    exclusive_scan(count, graph->offset, element_num);
+    free(count);
+
+    // 2回目: 書き込み
+    MESH_GRAPH_PRAGMA(omp parallel)
+    {
+        int* shared = (int*)calloc((size_t)element_num + 1, sizeof(int));
+        uint32_t* touched = (uint32_t*)malloc(((size_t)element_num + 1) * sizeof(uint32_t));
+        if (shared == NULL || touched == NULL) {
+            MESH_GRAPH_PRAGMA(omp atomic write)
+            failed = 1;
+        } else {
+            MESH_GRAPH_PRAGMA(omp for schedule(dynamic, 256))
+            for (int e = 0; e < element_num; e++) {
+                collect_element_neighbors(model, node_element, e, min_shared_nodes, shared, touched, &graph->index[graph->offset[e]]);
+            }
+        }
+        free(shared);
+        free(touched);
+    }
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation for element graph work arrays failed\n");
+        free_csr_graph(graph);
+        return NULL;
+    }
+
+    sort_rows(graph);
+    return graph;
+}
+
+/**
+ * 節点 e と要素を共有する節点を集める(collect_element_neighbors の節点版)
+ */
+static uint32_t collect_node_neighbors(const MeshModel* model, const CsrGraph* node_element, int n,
+                                       char mark[], uint32_t touched[], uint32_t out[]) {
+    uint32_t degree = 0;
+    for (uint32_t p = node_element->offset[n]; p < node_element->offset[n + 1]; p++) {
+        int e = (int)node_element->index[p];
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int k = 0; k < node_count; k++) {
+            int other = find_mesh_node(model, node[k]);
+            if (other < 0 || other == n || mark[other]) {
+                continue;
+            }
+            mark[other] = 1;
+            touched[degree] = (uint32_t)other;
+            if (out != NULL) {
+                out[degree] = (uint32_t)other;
+            }
+            degree++;
+        }
+    }
+    for (uint32_t t = 0; t < degree; t++) {
+        mark[touched[t]] = 0;
+    }
+    return degree;
+}
+
+/**
+ * 節点 -> 節点の隣接関係(同じ要素に含まれる節点同士)を作成する。
+ * 剛性行列の非零パターンに相当する。
+ *
+ * @param node_element build_node_element_graph()の結果
+ */
+CsrGraph* build_node_graph(const MeshModel* model, const CsrGraph* node_element) {
+    if (model == NULL || node_element == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_node_graph\n");
+        return NULL;
+    }
+    int node_num = model->node_num;
+    uint32_t* count = (uint32_t*)calloc((size_t)node_num + 1, sizeof(uint32_t));
+    if (count == NULL) {
+        fprintf(stderr, "Error: Memory allocation for count failed\n");
+        return NULL;
+    }
+
+    int failed = 0;
+    MESH_GRAPH_PRAGMA(omp parallel)
+    {
+        char* mark = (char*)calloc((size_t)node_num + 1, sizeof(char));
+        uint32_t* touched = (uint32_t*)malloc(((size_t)node_num + 1) * sizeof(uint32_t));
+        if (mark == NULL || touched == NULL) {
+            MESH_GRAPH_PRAGMA(omp atomic write)
+            failed = 1;
+        } else {
+            MESH_GRAPH_PRAGMA(omp for schedule(dynamic, 256))
+            for (int n = 0; n < node_num; n++) {
+                count[n] = collect_node_neighbors(model, node_element, n, mark, touched, NULL);
+            }
+        }
+        free(mark);
+        free(touched);
+    }
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation for node graph work arrays failed\n");
+        free(count);
+        return NULL;
+    }
+
+    uint32_t nnz = 0;
+    for (int n = 0; n < node_num; n++) {
+        nnz += count[n];
+    }
+    CsrGraph* graph = allocate_csr_graph(node_num, node_num, nnz);
+    if (graph == NULL) {
+        free(count);
+        return NULL;
+    }
+    exclusive_scan(count, graph->offset, node_num);
+    free(count);
+
+    MESH_GRAPH_PRAGMA(omp parallel)
+    {
+        char* mark = (char*)calloc((size_t)node_num + 1, sizeof(char));
+        uint32_t* touched = (uint32_t*)malloc(((size_t)node_num + 1) * sizeof(uint32_t));
+        if (mark == NULL || touched == NULL) {
+            MESH_GRAPH_PRAGMA(omp atomic write)
+            failed = 1;
+        } else {
+            MESH_GRAPH_PRAGMA(omp for schedule(dynamic, 256))
+            for (int n = 0; n < node_num; n++) {
+                collect_node_neighbors(model, node_element, n, mark, touched, &graph->index[graph->offset[n]]);
+            }
+        }
+        free(mark);
+        free(touched);
+    }
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation for node graph work arrays failed\n");
+        free_csr_graph(graph);
+        return NULL;
+    }
+
+    sort_rows(graph);
+    return graph;
+}
+
+// 表示関数 ----------------------------------------------------------------------------
+/**
+ * CsrGraphの概要と先頭 max_rows 行を表示する
+ */
+void print_csr_graph(const char* name, const CsrGraph* graph, int max_rows) {
+    if (graph == NULL) {
+        printf("\"%s\": null\n", name);
+        return;
+    }
+    uint32_t nnz = graph->offset[graph->row_num];
+    uint32_t max_degree = 0;
+    for (int r = 0; r < graph->row_num; r++) {
+        uint32_t degree = graph->offset[r + 1] - graph->offset[r];
+        if (degree > max_degree) max_degree = degree;
+    }
+    printf("\"%s\": {\n", name);
+    print_indent_mm(1);
+    printf("\"row_num\": %d, \"nnz\": %u, \"max_degree\": %u, \"bytes\": %zu,\n",
+        graph->row_num, nnz, max_degree, ((size_t)graph->row_num + 1 + nnz) * sizeof(uint32_t));
+    print_indent_mm(1);
+    printf("\"rows\": [\n");
+    int rows = (max_rows < graph->row_num) ? max_rows : graph->row_num;
+    for (int r = 0; r < rows; r++) {
+        print_indent_mm(2);
+        printf("[");
+        for (uint32_t p = graph->offset[r]; p < graph->offset[r + 1]; p++) {
+            printf("%u", graph->index[p]);
+            if (p + 1 < graph->offset[r + 1]) printf(", ");
+        }
+        printf("]%s\n", (r < rows - 1) ? "," : "");
+    }
+    print_indent_mm(1);
+    printf("]\n");
+    printf("}\n");
+}
@@ -0,0 +1,418 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "mesh_interface.h"
+#include "mesh_copy.h"
+
+/**
+ * 部品の境界面で同じ座標にある節点の組を探し、FILM要素(鋼板とコンクリートの面)と
+ * LINE要素(主筋とコンクリートの付着)を作る。
+ *
+ * 同じ座標の節点は座標のハッシュ(CoincidentHash)で探す。同じ座標に節点が複数ある場合
+ * (柱と接合部の境界面のように二重にした面)は、相手の要素(HEXA)の1つに全て含まれる組を選ぶ。
+ * FILMの面1は面の要素(QUAD)の節点の順番で、法線(右ねじ)が相手の要素の側を向くように
+ * 向きを決める(逆向きの場合は1番目の節点を残して逆順)。面2は面1と同じ座標の節点を同じ順番で並べる。
+ *   例: 接合部の鋼板 → generate_interface_films → print_interface_elements
+ */
+
+// 座標のハッシュ ----------------------------------------------------------------------------
+static long long coordinate_key(double value) {
+    return llround(value * 100.0);
+}
+
+static int bucket_of(const CoincidentHash* hash, long long x, long long y, long long z) {
+    unsigned long long h = (unsigned long long)x * 73856093ULL ^ (unsigned long long)y * 19349663ULL ^ (unsigned long long)z * 83492791ULL;
+    return (int)(h & (unsigned long long)(hash->bucket_num - 1));
+}
+
+static int node_bucket(const CoincidentHash* hash, const MeshModel* model, int n) {
+    return bucket_of(hash, coordinate_key(model->x[n]), coordinate_key(model->y[n]), coordinate_key(model->z[n]));
+}
+
+/**
+ * 節点の座標のハッシュを作る。区画の数は 2 の累乗で、節点数の MESH_INTERFACE_HASH_LOAD 倍以上。
+ *
+ * @return CoincidentHash。失敗した場合はNULL
+ */
+CoincidentHash* build_coincident_hash(const MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_coincident_hash\n");
+        return NULL;
+    }
+    CoincidentHash* hash = (CoincidentHash*)calloc(1, sizeof(CoincidentHash));
+    if (hash == NULL) {
+        fprintf(stderr, "Error: Memory allocation for CoincidentHash failed\n");
+        return NULL;
+    }
+    hash->bucket_num = 1;
+    while (hash->bucket_num < MESH_INTERFACE_HASH_LOAD * model->node_num) {
+        hash->bucket_num *= 2;
+    }
+    hash->bucket_start = (int*)calloc((size_t)hash->bucket_num + 1, sizeof(int));
+    hash->item = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+    if (hash->bucket_start == NULL || hash->item == NULL) {
+        fprintf(stderr, "Error: Memory allocation for coincident hash failed\n");
+        free_coincident_hash(hash);
+        return NULL;
+    }
+
+    for (int n = 0; n < model->node_num; n++) {
+        hash->bucket_start[node_bucket(hash, model, n) + 1]++;
+    }
+    for (int b = 0; b < hash->bucket_num; b++) {
+        hash->bucket_start[b + 1] += hash->bucket_start[b];
+    }
+    int* position = (int*)malloc((size_t)hash->bucket_num * sizeof(int));
+    if (position == NULL) {
+        fprintf(stderr, "Error: Memory allocation for coincident hash failed\n");
+        free_coincident_hash(hash);
+        return NULL;
+    }
+    memcpy(position, hash->bucket_start, (size_t)hash->bucket_num * sizeof(int));
+    for (int n = 0; n < model->node_num; n++) {
+        hash->item[position[node_bucket(hash, model, n)]++] = n;
+    }
+    free(position);
+    return hash;
+}
+
+int free_coincident_hash(CoincidentHash* hash) {
+    if (hash == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(hash->bucket_start);
+    free(hash->item);
+    free(hash);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点 n (配列番号)と同じ座標にある他の節点を探す
+ *
+ * @param coincident 見つけた節点の配列番号(最大 max 個)
+ * @return 見つけた数
+ */
+int find_coincident_nodes(const CoincidentHash* hash, const MeshModel* model, int n, int coincident[], int max) {
+    long long x = coordinate_key(model->x[n]);
+    long long y = coordinate_key(model->y[n]);
+    long long z = coordinate_key(model->z[n]);
+    int b = bucket_of(hash, x, y, z);
+    int count = 0;
+    for (int i = hash->bucket_start[b]; i < hash->bucket_start[b + 1] && count < max; i++) {
+        int m = hash->item[i];
+        if (m != n && coordinate_key(model->x[m]) == x && coordinate_key(model->y[m]) == y && coordinate_key(model->z[m]) == z) {
+            coincident[count++] = m;
+        }
+    }
+    return count;
+}
+
+// 境界面 ----------------------------------------------------------------------------
+MeshInterface* create_mesh_interface(const MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to create_mesh_interface\n");
+        return NULL;
+    }
+    MeshInterface* mesh_interface = (MeshInterface*)calloc(1, sizeof(MeshInterface));
+    if (mesh_interface == NULL) {
+        fprintf(stderr, "Error: Memory allocation for MeshInterface failed\n");
+        return NULL;
+    }
+    mesh_interface->model = model;
+    mesh_interface->hash = build_coincident_hash(model);
+    mesh_interface->node_element = build_node_element_graph(model);
+    if (mesh_interface->hash == NULL || mesh_interface->node_element == NULL) {
+        free_mesh_interface(mesh_interface);
+        return NULL;
+    }
+    return mesh_interface;
+}
+
+int free_mesh_interface(MeshInterface* mesh_interface) {
+    if (mesh_interface == NULL) {
+        return EXIT_FAILURE;
+    }
+    free_coincident_hash(mesh_interface->hash);
+    free_csr_graph(mesh_interface->node_element);
+    free(mesh_interface);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点 candidate (配列番号)のいずれかを含む、選んだ要素を番号順に集める
+ *
+ * @return 要素の数(最大 max 個)
+ */
+static int collect_solids(const MeshInterface* mesh_interface, const MeshSelection* solids, const int candidate[], int candidate_num,
+                          int solid[], int max) {
+    const CsrGraph* graph = mesh_interface->node_element;
+    int count = 0;
+    for (int c = 0; c < candidate_num; c++) {
+        for (uint32_t i = graph->offset[candidate[c]]; i < graph->offset[candidate[c] + 1]; i++) {
+            int e = (int)graph->index[i];
+            if (!solids->flag[e]) {
+                continue;
+            }
+            int seen = 0;
+            for (int s = 0; s < count; s++) {
+                if (solid[s] == e) seen = 1;
+            }
+            if (!seen && count < max) {
+                solid[count++] = e;
+            }
+        }
+    }
+    // 挿入整列(要素番号順)
+    for (int i = 1; i < count; i++) {
+        for (int j = i; j > 0 && mesh_interface->model->element_id[solid[j]] < mesh_interface->model->element_id[solid[j - 1]]; j--) {
+            int t = solid[j];
+            solid[j] = solid[j - 1];
+            solid[j - 1] = t;
+        }
+    }
+    return count;
+}
+
+/**
+ * 要素 e の節点のうち candidate (配列番号)のいずれかの節点番号。無い場合は0
+ */
+static int node_in_element(const MeshModel* model, int e, const int candidate[], int candidate_num) {
+    const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+    int node_count = element_node_count(model->element_kind[e]);
+    for (int k = 0; k < node_count; k++) {
+        for (int c = 0; c < candidate_num; c++) {
+            if (model->node_id[candidate[c]] == node[k]) {
+                return node[k];
+            }
+        }
+    }
+    return 0;
+}
+
+static void element_centroid(const MeshModel* model, int e, double centroid[3]) {
+    const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+    int node_count = element_node_count(model->element_kind[e]);
+    centroid[0] = centroid[1] = centroid[2] = 0.0;
+    for (int k = 0; k < node_count; k++) {
+        int n = find_mesh_node(model, node[k]);
+        centroid[0] += model->x[n] / node_count;
+        centroid[1] += model->y[n] / node_count;
+        centroid[2] += model->z[n] / node_count;
+    }
+}
+
+/**
+ * 面の法線(対角線の外積)が要素 solid の重心の側を向くか
+ */
+static int faces_toward(const MeshModel* model, const int p[4], int solid) {
+    double u[3] = {model->x[p[2]] - model->x[p[0]], model->y[p[2]] - model->y[p[0]], model->z[p[2]] - model->z[p[0]]};
+    double v[3] = {model->x[p[3]] - model->x[p[1]], model->y[p[3]] - model->y[p[1]], model->z[p[3]] - model->z[p[1]]};
+    double normal[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+    double centroid[3];
+    element_centroid(model, solid, centroid);
+    double dot = 0.0;
+    for (int k = 0; k < 4; k++) {
+        dot += normal[0] * (centroid[0] - model->x[p[k]]) + normal[1] * (centroid[1] - model->y[p[k]]) + normal[2] * (centroid[2] - model->z[p[k]]);
+    }
+    return dot > 0.0;
+}
+
+/**
+ * FilmRecord構造体
+ *
+ * 番号を付ける前のFILM要素。type は面の要素のタイプ、forward は面の要素の向きのままか、
+ * face、solid は面の要素と相手の要素の番号。
+ */
+typedef struct {
+    int type;
+    int forward;
+    int face;
+    int solid;
+    int node[ELEMENT_NODE_MAX];
+} FilmRecord;
+
+static int compare_film_record(const void* a, const void* b) {
+    const FilmRecord* p = (const FilmRecord*)a;
+    const FilmRecord* q = (const FilmRecord*)b;
+    if (p->type != q->type) return (p->type > q->type) - (p->type < q->type);
+    if (p->forward != q->forward) return (p->forward < q->forward) - (p->forward > q->forward);
+    if (p->face != q->face) return (p->face > q->face) - (p->face < q->face);
+    return (p->solid > q->solid) - (p->solid < q->solid);
+}
+
+/**
+ * 面の要素(QUAD)と同じ座標の面を持つ相手の要素ごとにFILM要素を作る。
+ * 両側に相手の要素がある面(直交梁ウェブなど)は2つ作る。
+ *
+ * @param faces 面の要素の選択
+ * @param solids 相手の要素の選択
+ * @param typf FILMのタイプ
+ * @param film_id 次のFILMの要素番号。作った数だけ進める
+ * @param out 作ったFILMを加えるMeshModel
+ * @return 作った数。失敗した場合は-1
+ */
+int generate_interface_films(const MeshInterface* mesh_interface, const MeshSelection* faces, const MeshSelection* solids,
+                             int typf, int* film_id, MeshModel* out) {
+    if (mesh_interface == NULL || faces == NULL || solids == NULL || film_id == NULL || out == NULL ||
+        faces->target != SELECT_ELEMENT || solids->target != SELECT_ELEMENT) {
+        fprintf(stderr, "Error: invalid arguments passed to generate_interface_films\n");
+        return -1;
+    }
+    const MeshModel* model = mesh_interface->model;
+    int film_num = 0;
+    int film_capacity = 16;
+    FilmRecord* film = (FilmRecord*)malloc((size_t)film_capacity * sizeof(FilmRecord));
+    if (film == NULL) {
+        fprintf(stderr, "Error: Memory allocation for film records failed\n");
+        return -1;
+    }
+    for (int id = 1; id < model->element_index_size; id++) {
+        int q = model->element_index[id];
+        if (q < 0 || !faces->flag[q] || model->element_kind[q] != ELEMENT_QUAD) {
+            continue;
+        }
+        const int* face = &model->connectivity[q * ELEMENT_NODE_MAX];
+        int p[4];
+        int candidate[4][MESH_INTERFACE_COINCIDENT_MAX];
+        int candidate_num[4];
+        int found = 1;
+        for (int k = 0; k < 4; k++) {
+            p[k] = find_mesh_node(model, face[k]);
+            candidate_num[k] = (p[k] < 0) ? 0 : find_coincident_nodes(mesh_interface->hash, model, p[k], candidate[k], MESH_INTERFACE_COINCIDENT_MAX);
+            if (candidate_num[k] == 0) found = 0;
+        }
+        if (!found) {
+            continue;
+        }
+
+        int solid[MESH_INTERFACE_COINCIDENT_MAX * 8];
+        int solid_num = collect_solids(mesh_interface, solids, candidate[0], candidate_num[0], solid, MESH_INTERFACE_COINCIDENT_MAX * 8);
+        for (int s = 0; s < solid_num; s++) {
+            int match[4];
+            int complete = 1;
+            for (int k = 0; k < 4; k++) {
+                match[k] = node_in_element(model, solid[s], candidate[k], candidate_num[k]);
+                if (match[k] == 0) complete = 0;
+            }
+            if (!complete) {
+                continue;
+            }
+            if (film_num >= film_capacity) {
+                film_capacity *= 2;
+                FilmRecord* film_new = (FilmRecord*)realloc(film, (size_t)film_capacity * sizeof(FilmRecord));
+                if (film_new == NULL) {
+                    fprintf(stderr, "Error: Memory allocation for film records failed\n");
+                    free(film);
+                    return -1;
+                }
+                film = film_new;
+            }
+            // 1番目の節点を残して向きをそろえる
+            static const int forward[4] = {0, 1, 2, 3};
+            static const int backward[4] = {0, 3, 2, 1};
+            FilmRecord* record = &film[film_num++];
+            record->type = model->element_type[q];
+            record->forward = faces_toward(model, p, solid[s]);
+            record->face = id;
+            record->solid = model->element_id[solid[s]];
+            const int* order = record->forward ? forward : backward;
+            for (int k = 0; k < 4; k++) {
+                record->node[k] = face[order[k]];
+                record->node[4 + k] = match[order[k]];
+            }
+        }
+    }
+
+    // 同じ向きの同じ部品(面の要素のタイプ)の面を続けて番号を付ける
+    qsort(film, film_num, sizeof(FilmRecord), compare_film_record);
+    for (int i = 0; i < film_num; i++) {
+        if (add_mesh_element(out, *film_id, ELEMENT_FILM, typf, film[i].node) < 0) {
+            free(film);
+            return -1;
+        }
+        (*film_id)++;
+    }
+    free(film);
+    return film_num;
+}
+
+/**
+ * 線の要素(BEAM)の両端と同じ座標の節点を持つ相手の要素を探し、付着のLINE要素を作る。
+ * LINEの節点は (線の要素の節点1, 節点2, 相手の節点1, 節点2) の順。
+ *
+ * @param bars 線の要素の選択
+ * @param solids 相手の要素の選択
+ * @param offset LINEの要素番号 = 線の要素の番号 + offset
+ * @param out 作ったLINEを加えるMeshModel
+ * @return 作った数。失敗した場合は-1
+ */
+int generate_bond_lines(const MeshInterface* mesh_interface, const MeshSelection* bars, const MeshSelection* solids,
+                        int offset, MeshModel* out) {
+    if (mesh_interface == NULL || bars == NULL || solids == NULL || out == NULL ||
+        bars->target != SELECT_ELEMENT || solids->target != SELECT_ELEMENT) {
+        fprintf(stderr, "Error: invalid arguments passed to generate_bond_lines\n");
+        return -1;
+    }
+    const MeshModel* model = mesh_interface->model;
+    int count = 0;
+    for (int id = 1; id < model->element_index_size; id++) {
+        int b = model->element_index[id];
+        if (b < 0 || !bars->flag[b] || model->element_kind[b] != ELEMENT_BEAM) {
+            continue;
+        }
+        const int* bar = &model->connectivity[b * ELEMENT_NODE_MAX];
+        int candidate[2][MESH_INTERFACE_COINCIDENT_MAX];
+        int candidate_num[2];
+        for (int k = 0; k < 2; k++) {
+            int p = find_mesh_node(model, bar[k]);
+            candidate_num[k] = (p < 0) ? 0 : find_coincident_nodes(mesh_interface->hash, model, p, candidate[k], MESH_INTERFACE_COINCIDENT_MAX);
+        }
+        if (candidate_num[0] == 0 || candidate_num[1] == 0) {
+            continue;
+        }
+
+        int solid[MESH_INTERFACE_COINCIDENT_MAX * 8];
+        int solid_num = collect_solids(mesh_interface, solids, candidate[0], candidate_num[0], solid, MESH_INTERFACE_COINCIDENT_MAX * 8);
+        for (int s = 0; s < solid_num; s++) {
+            int node[ELEMENT_NODE_MAX] = {bar[0], bar[1], 0, 0};
+            node[2] = node_in_element(model, solid[s], candidate[0], candidate_num[0]);
+            node[3] = node_in_element(model, solid[s], candidate[1], candidate_num[1]);
+            if (node[2] == 0 || node[3] == 0) {
+                continue;
+            }
+            if (add_mesh_element(out, id + offset, ELEMENT_LINE, 1, node) < 0) {
+                return -1;
+            }
+            count++;
+            break;
+        }
+    }
+    return count;
+}
+
+/**
+ * 作った要素をCOPYカードでまとめて書き込む。COPYカードが展開後に一致しない場合は1行ずつ書き込む。
+ */
+int print_interface_elements(FILE* f, const MeshModel* out) {
+    if (f == NULL || out == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to print_interface_elements\n");
+        return EXIT_FAILURE;
+    }
+    CopyCardList* cards = create_copy_card_list();
+    int compressed = cards != NULL &&
+                     synthesize_element_cards(out, cards) == EXIT_SUCCESS &&
+                     verify_copy_cards(out, NULL, cards) == EXIT_SUCCESS;
+    if (compressed) {
+        print_copy_cards(f, out, cards);
+    } else {
+        for (int id = 1; id < out->element_index_size; id++) {
+            int e = out->element_index[id];
+            if (e >= 0) {
+                print_mesh_element(f, out, e, out->element_type[e]);
+            }
+        }
+    }
+    free_copy_card_list(cards);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,768 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "mesh_mirror.h"
+#include "id_budget.h"
+#include "simd.h"
+
+/**
+ * ハーフモデルの鏡映(フルモデル)
+ *
+ * 対称面(dir 方向の座標 = plane)で切断したハーフモデルの節点、要素、境界条件、STEPデータを
+ * 対称面について複製する。
+ * - 対称面上の節点は元の節点を共有し、それ以外の節点は番号をずらして複製する。
+ *   座標は複製した節点の配列に対してまとめて 2 * plane - x を計算する(simd.h)。
+ * - 鏡映で要素の向き(右手系)が逆になるため、HEXA、FILM は各面の 2 と 4 番目、QUAD は 2 と 4 番目の節点を入れ替える。
+ *   全ての節点が対称面上にある要素(梁芯のウェブなど)は複製しない。
+ * - 対称面上の節点の法線方向の拘束(切断面の拘束)を外し、それ以外の拘束、SUB1 は鏡像の節点にも付ける。
+ *   法線方向の剛体移動を止めるため、1つの節点(柱脚のピンなど)だけは法線方向の拘束を残す。
+ * - FN、UE は鏡像の節点、要素にも付け、法線方向の値は符号を反転する。UEの面 1、2(下面、上面)は入れ替えで変わらない。
+ *
+ * 対称面での切断(1/4モデル)
+ *
+ * 逆に、対称な試験体のモデルを対称面で切断して片側だけを残し、対称面に対称または逆対称の拘束を付ける。
+ * 残した節点、要素と削除した側の同じ位置の節点、要素の対応は、対称面からの距離と面内の座標で並べ替えて求める。
+ */
+
+static double* coordinate_array(MeshModel* model, int dir) {
+    switch (dir) {
+        case 1: return model->x;
+        case 2: return model->y;
+        case 3: return model->z;
+        default: return NULL;
+    }
+}
+
+/**
+ * 鏡像の番号をずらす量。最大の番号を 1000 単位に切り上げ、5桁に収まらない場合は 0 (詰めて付ける)
+ */
+static int mirror_offset(int max_id) {
+    int offset = (max_id + 999) / 1000 * 1000;
+    return (max_id + offset <= ID_BUDGET_MAX) ? offset : 0;
+}
+
+static void reverse_orientation(ElementKind kind, int node[]) {
+    int tmp;
+    switch (kind) {
+        case ELEMENT_HEXA:
+        case ELEMENT_FILM:
+            tmp = node[5]; node[5] = node[7]; node[7] = tmp;
+            // fall through
+        case ELEMENT_QUAD:
+            tmp = node[1]; node[1] = node[3]; node[3] = tmp;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * 鏡像の節点を追加する
+ *
+ * @param mirror_id 節点の配列番号 -> 鏡像の節点番号(対称面上の節点は元の番号)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+static int mirror_nodes(MeshModel* model, int dir, double plane, int mirror_id[], MirrorStatistics* statistics) {
+    int node_num = model->node_num;
+    int max_id = 0;
+    for (int n = 0; n < node_num; n++) {
+        if (model->node_id[n] > max_id) max_id = model->node_id[n];
+    }
+    statistics->node_offset = mirror_offset(max_id);
+
+    int next_id = max_id + 1;
+    for (int n = 0; n < node_num; n++) {
+        double* c = coordinate_array(model, dir);
+        if (fabs(c[n] - plane) <= MESH_MIRROR_TOLERANCE) {
+            mirror_id[n] = model->node_id[n];
+            statistics->plane_node_num++;
+            continue;
+        }
+        mirror_id[n] = statistics->node_offset > 0 ? model->node_id[n] + statistics->node_offset : next_id++;
+        if (add_mesh_node(model, mirror_id[n], model->x[n], model->y[n], model->z[n]) < 0) {
+            return EXIT_FAILURE;
+        }
+    }
+    statistics->node_num = model->node_num - node_num;
+
+    // 追加した節点の座標の変換
+    double* c = coordinate_array(model, dir) + node_num;
+    int count = statistics->node_num;
+    simd_double twice = simd_set1(2.0 * plane);
+    int i = 0;
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+        simd_store(&c[i], simd_sub(twice, simd_load(&c[i])));
+    }
+    for (; i < count; i++) {
+        c[i] = 2.0 * plane - c[i];
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 鏡像の要素を追加する
+ *
+ * @param mirror_node 節点の配列番号 -> 鏡像の節点番号
+ * @param mirror_id 要素の配列番号 -> 鏡像の要素番号(複製しない要素は 0)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+static int mirror_elements(MeshModel* model, const int mirror_node[], int mirror_id[], MirrorStatistics* statistics) {
+    int element_num = model->element_num;
+    int max_id = 0;
+    for (int e = 0; e < element_num; e++) {
+        if (model->element_id[e] > max_id) max_id = model->element_id[e];
+    }
+    statistics->element_offset = mirror_offset(max_id);
+
+    int next_id = max_id + 1;
+    for (int e = 0; e < element_num; e++) {
+        int node_count = element_node_count(model->element_kind[e]);
+        int node[ELEMENT_NODE_MAX] = {0};
+        int moved = 0;
+        for (int k = 0; k < node_count; k++) {
+            int id = model->connectivity[e * ELEMENT_NODE_MAX + k];
+            int index = find_mesh_node(model, id);
+            node[k] = index < 0 ? id : mirror_node[index];
+            if (node[k] != id) moved = 1;
+        }
+        if (!moved) {
+            mirror_id[e] = 0;
+            statistics->plane_element_num++;
+            continue;
+        }
+        reverse_orientation(model->element_kind[e], node);
+        mirror_id[e] = statistics->element_offset > 0 ? model->element_id[e] + statistics->element_offset : next_id++;
+        if (add_mesh_element(model, mirror_id[e], model->element_kind[e], model->element_type[e], node) < 0) {
+            return EXIT_FAILURE;
+        }
+    }
+    statistics->element_num = model->element_num - element_num;
+    return EXIT_SUCCESS;
+}
+
+static int mirrored_node(const MeshModel* model, const int mirror_node[], int id) {
+    int index = find_mesh_node(model, id);
+    return index < 0 ? id : mirror_node[index];
+}
+
+/**
+ * 法線方向の拘束を残す対称面上の節点
+ *
+ * 対称面の拘束を全て外すと法線方向の剛体移動が止まらないため、1つの節点だけ元の拘束を残す。
+ * 他の方向も拘束した節点(柱脚のピンなどの支点)を優先し、無ければ最初の節点にする。
+ */
+static int symmetry_anchor_node(const MeshModel* model, int normal, const int mirror_node[]) {
+    int anchor = 0;
+    for (int r = 0; r < model->restraint_num; r++) {
+        const MeshRestraint* restraint = &model->restraint[r];
+        if ((restraint->rc / normal) % 10 == 0 || mirrored_node(model, mirror_node, restraint->node) != restraint->node) {
+            continue;
+        }
+        if (anchor == 0) {
+            anchor = restraint->node;
+        }
+        for (int other = 0; other < model->restraint_num; other++) {
+            int rc = model->restraint[other].rc;
+            if (model->restraint[other].node == restraint->node && rc - (rc / normal) % 10 * normal != 0) {
+                return restraint->node;
+            }
+        }
+    }
+    return anchor;
+}
+
+/**
+ * 境界条件(REST、SUB1)の複製と、対称面の拘束の解除
+ */
+static int mirror_boundary(MeshModel* model, int dir, const int mirror_node[], MirrorStatistics* statistics) {
+    int normal = (dir == 1) ? 100 : (dir == 2) ? 10 : 1;
+    statistics->anchor_node = symmetry_anchor_node(model, normal, mirror_node);
+    int restraint_num = model->restraint_num;
+    int kept = 0;
+    for (int r = 0; r < restraint_num; r++) {
+        MeshRestraint restraint = model->restraint[r];
+        int mirror = mirrored_node(model, mirror_node, restraint.node);
+        if (mirror == restraint.node && restraint.node != statistics->anchor_node) {
+            if ((restraint.rc / normal) % 10 != 0) {
+                restraint.rc -= normal;
+                statistics->released_restraint_num++;
+            }
+            if (restraint.rc == 0) {
+                continue;
+            }
+        }
+        model->restraint[kept++] = restraint;
+    }
+    model->restraint_num = kept;
+    for (int r = 0; r < kept; r++) {
+        int mirror = mirrored_node(model, mirror_node, model->restraint[r].node);
+        if (mirror != model->restraint[r].node && add_mesh_restraint(model, mirror, model->restraint[r].rc) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 従属節点が対称面上にある場合は元の条件だけで足りる
+    int constraint_num = model->constraint_num;
+    for (int c = 0; c < constraint_num; c++) {
+        MeshConstraint constraint = model->constraint[c];
+        int mirror = mirrored_node(model, mirror_node, constraint.node);
+        if (mirror == constraint.node) {
+            continue;
+        }
+        if (add_mesh_constraint(model, mirror, constraint.dir, mirrored_node(model, mirror_node, constraint.master), constraint.master_dir) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * STEPデータの FN、UE を鏡像の節点、要素にも付ける(元のカードの直後に追加する)
+ */
+static int mirror_step_cards(MeshModel* model, int dir, const int mirror_node[], const int mirror_element[]) {
+    int capacity = model->step_card_num * 2 + 1;
+    StepCard* cards = (StepCard*)malloc((size_t)capacity * sizeof(StepCard));
+    if (cards == NULL) {
+        fprintf(stderr, "Error: Memory allocation for mirror_step_cards failed\n");
+        return EXIT_FAILURE;
+    }
+    int card_num = 0;
+    for (int s = 0; s < model->step_card_num; s++) {
+        StepCard card = model->step_card[s];
+        cards[card_num++] = card;
+        int mirror = 0;
+        if (card.kind == STEP_CARD_FN) {
+            mirror = mirrored_node(model, mirror_node, card.id);
+            if (mirror == card.id) mirror = 0;
+        } else if (card.kind == STEP_CARD_UE) {
+            int index = find_mesh_element(model, card.id);
+            mirror = index < 0 ? 0 : mirror_element[index];
+        }
+        if (mirror > 0) {
+            card.id = mirror;
+            if (card.value[0] == dir) card.real = -card.real;
+            cards[card_num++] = card;
+        }
+    }
+    free(model->step_card);
+    model->step_card = cards;
+    model->step_card_num = card_num;
+    model->step_card_capacity = capacity;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 対称面で切断したモデルを、対称面について鏡映したモデルを加えた全体のモデルにする
+ *
+ * @param model 切断したモデル(書き換える)
+ * @param dir 対称面の法線方向(1:x, 2:y, 3:z)
+ * @param plane 対称面の座標
+ * @param statistics 追加、変更したものの数
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int mirror_mesh_model(MeshModel* model, int dir, double plane, MirrorStatistics* statistics) {
+    if (model == NULL || statistics == NULL || coordinate_array(model, dir) == NULL) {
+        fprintf(stderr, "Error: Invalid argument passed to mirror_mesh_model\n");
+        return EXIT_FAILURE;
+    }
+    *statistics = (MirrorStatistics){0};
+    int* mirror_node = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+    int* mirror_element = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+    if (mirror_node == NULL || mirror_element == NULL) {
+        fprintf(stderr, "Error: Memory allocation for mirror_mesh_model failed\n");
+        free(mirror_node);
+        free(mirror_element);
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_FAILURE;
+    if (mirror_nodes(model, dir, plane, mirror_node, statistics) == EXIT_SUCCESS &&
+        mirror_elements(model, mirror_node, mirror_element, statistics) == EXIT_SUCCESS &&
+        mirror_boundary(model, dir, mirror_node, statistics) == EXIT_SUCCESS &&
+        mirror_step_cards(model, dir, mirror_node, mirror_element) == EXIT_SUCCESS) {
+        result = EXIT_SUCCESS;
+    }
+    free(mirror_node);
+    free(mirror_element);
+    return result;
+}
+
+// 対称面での切断 ----------------------------------------------------------------------------
+/**
+ * 鏡像を探すための並べ替えのキー。座標は 0.01 単位に丸める。
+ * key[0] は対称面からの距離、key[1]、key[2] は面内の座標。同じ位置、種類の節点、要素は番号順に対応させる。
+ * タイプ番号は対称面の両側で異なる場合がある(ふさぎ板 TYPQ 8 と 10)ため比べない。
+ */
+typedef struct {
+    long long key[3];
+    int kind;
+    int id;
+    int index;
+} SymmetryKey;
+
+static int compare_symmetry_position(const SymmetryKey* a, const SymmetryKey* b) {
+    for (int k = 0; k < 3; k++) {
+        if (a->key[k] != b->key[k]) return (a->key[k] < b->key[k]) ? -1 : 1;
+    }
+    if (a->kind != b->kind) return (a->kind < b->kind) ? -1 : 1;
+    return 0;
+}
+
+static int compare_symmetry_key(const void* a, const void* b) {
+    const SymmetryKey* p = (const SymmetryKey*)a;
+    const SymmetryKey* q = (const SymmetryKey*)b;
+    int c = compare_symmetry_position(p, q);
+    if (c != 0) return c;
+    return (p->id > q->id) - (p->id < q->id);
+}
+
+static void set_symmetry_key(SymmetryKey* key, int dir, double plane, const double point[3], int kind, int id, int index) {
+    int k = 1;
+    for (int axis = 0; axis < 3; axis++) {
+        if (axis == dir - 1) {
+            key->key[0] = llround(fabs(point[axis] - plane) * 100.0);
+        } else {
+            key->key[k++] = llround(point[axis] * 100.0);
+        }
+    }
+    key->kind = kind;
+    key->id = id;
+    key->index = index;
+}
+
+/**
+ * 残す側(keep)の各点に、削除する側(removed)の同じ位置の点の番号を対応させる
+ *
+ * @param mirror_id keep[i].index -> 鏡像の番号(見つからない場合は 0)
+ * @return 見つからなかった点の数
+ */
+static int match_symmetry_keys(SymmetryKey keep[], int keep_num, SymmetryKey removed[], int removed_num, int mirror_id[]) {
+    qsort(keep, (size_t)keep_num, sizeof(SymmetryKey), compare_symmetry_key);
+    qsort(removed, (size_t)removed_num, sizeof(SymmetryKey), compare_symmetry_key);
+    int unmatched = 0;
+    int j = 0;
+    for (int i = 0; i < keep_num; i++) {
+        while (j < removed_num && compare_symmetry_position(&removed[j], &keep[i]) < 0) {
+            j++;
+        }
+        if (j < removed_num && compare_symmetry_position(&removed[j], &keep[i]) == 0) {
+            mirror_id[keep[i].index] = removed[j++].id;
+        } else {
+            mirror_id[keep[i].index] = 0;
+            unmatched++;
+        }
+    }
+    return unmatched;
+}
+
+// 拘束条件の桁(xyz)ごとの論理和
+static int merge_rc(int a, int b) {
+    int rc = 0;
+    for (int digit = 100; digit > 0; digit /= 10) {
+        if ((a / digit) % 10 != 0 || (b / digit) % 10 != 0) {
+            rc += digit;
+        }
+    }
+    return rc;
+}
+
+/**
+ * 節点、要素の鏡像の対応を求める(削除する前のモデルで行う)
+ *
+ * @param side 節点の配列番号 -> 0: 残す側, 1: 対称面上, 2: 削除する側
+ * @param removed_element 要素の配列番号 -> 1: 削除する
+ */
+static int match_mirror_images(const MeshModel* model, int dir, double plane, const char side[], const char removed_element[],
+                               int mirror_node[], int mirror_element[], SymmetryCutStatistics* statistics) {
+    int size = (model->node_num > model->element_num ? model->node_num : model->element_num) + 1;
+    SymmetryKey* keep = (SymmetryKey*)malloc((size_t)size * sizeof(SymmetryKey));
+    SymmetryKey* removed = (SymmetryKey*)malloc((size_t)size * sizeof(SymmetryKey));
+    if (keep == NULL || removed == NULL) {
+        fprintf(stderr, "Error: Memory allocation for cut_mesh_model failed\n");
+        free(keep);
+        free(removed);
+        return EXIT_FAILURE;
+    }
+
+    int keep_num = 0;
+    int removed_num = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        double point[3] = {model->x[n], model->y[n], model->z[n]};
+        if (side[n] == 1) {
+            mirror_node[n] = model->node_id[n];
+        } else if (side[n] == 0) {
+            set_symmetry_key(&keep[keep_num++], dir, plane, point, 0, model->node_id[n], n);
+        } else {
+            set_symmetry_key(&removed[removed_num++], dir, plane, point, 0, model->node_id[n], n);
+        }
+    }
+    statistics->unmatched_node_num = match_symmetry_keys(keep, keep_num, removed, removed_num, mirror_node);
+
+    // 要素は節点の重心の位置で対応させる
+    keep_num = 0;
+    removed_num = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        int node_count = element_node_count(model->element_kind[e]);
+        double point[3] = {0.0, 0.0, 0.0};
+        int on_plane = 1;
+        for (int k = 0; k < node_count; k++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + k]);
+            if (n < 0) continue;
+            point[0] += model->x[n] / node_count;
+            point[1] += model->y[n] / node_count;
+            point[2] += model->z[n] / node_count;
+            if (side[n] != 1) on_plane = 0;
+        }
+        if (on_plane) {
+            mirror_element[e] = model->element_id[e];
+        } else if (removed_element[e]) {
+            set_symmetry_key(&removed[removed_num++], dir, plane, point, model->element_kind[e], model->element_id[e], e);
+        } else {
+            set_symmetry_key(&keep[keep_num++], dir, plane, point, model->element_kind[e], model->element_id[e], e);
+        }
+    }
+    statistics->unmatched_element_num = match_symmetry_keys(keep, keep_num, removed, removed_num, mirror_element);
+    free(keep);
+    free(removed);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 対称面の反対側の節点、要素を削除し、節点、要素の配列と対応表を詰める
+ */
+static void remove_mirror_side(MeshModel* model, const char side[], const char removed_element[],
+                               int mirror_node[], int mirror_element[], SymmetryCutStatistics* statistics) {
+    int k = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        if (side[n] == 2) {
+            model->node_index[model->node_id[n]] = -1;
+            continue;
+        }
+        model->node_id[k] = model->node_id[n];
+        model->x[k] = model->x[n];
+        model->y[k] = model->y[n];
+        model->z[k] = model->z[n];
+        mirror_node[k] = mirror_node[n];
+        model->node_index[model->node_id[k]] = k;
+        k++;
+    }
+    statistics->removed_node_num = model->node_num - k;
+    model->node_num = k;
+
+    k = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (removed_element[e]) {
+            model->element_index[model->element_id[e]] = -1;
+            continue;
+        }
+        model->element_id[k] = model->element_id[e];
+        model->element_kind[k] = model->element_kind[e];
+        model->element_type[k] = model->element_type[e];
+        for (int m = 0; m < ELEMENT_NODE_MAX; m++) {
+            model->connectivity[k * ELEMENT_NODE_MAX + m] = model->connectivity[e * ELEMENT_NODE_MAX + m];
+        }
+        mirror_element[k] = mirror_element[e];
+        model->element_index[model->element_id[k]] = k;
+        k++;
+    }
+    statistics->removed_element_num = model->element_num - k;
+    model->element_num = k;
+}
+
+/**
+ * 削除した節点の REST、SUB1 を除き、対称面上の節点に拘束を付ける。
+ * 拘束した方向の SUB1(従属節点が対称面上)は重なるため除く。
+ */
+static int restrain_symmetry_plane(MeshModel* model, const char plane_flag[], int plane_rc, SymmetryCutStatistics* statistics) {
+    int kept = 0;
+    for (int r = 0; r < model->restraint_num; r++) {
+        if (find_mesh_node(model, model->restraint[r].node) >= 0) {
+            model->restraint[kept++] = model->restraint[r];
+        }
+    }
+    model->restraint_num = kept;
+
+    int* restraint_of = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+    if (restraint_of == NULL) {
+        fprintf(stderr, "Error: Memory allocation for cut_mesh_model failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        restraint_of[n] = -1;
+    }
+    for (int r = 0; r < model->restraint_num; r++) {
+        int n = find_mesh_node(model, model->restraint[r].node);
+        if (restraint_of[n] < 0) restraint_of[n] = r;
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        if (!plane_flag[n]) {
+            continue;
+        }
+        if (restraint_of[n] >= 0) {
+            MeshRestraint* restraint = &model->restraint[restraint_of[n]];
+            restraint->rc = merge_rc(restraint->rc, plane_rc);
+        } else if (add_mesh_restraint(model, model->node_id[n], plane_rc) != EXIT_SUCCESS) {
+            free(restraint_of);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 拘束した方向の桁 (1:x -> 100, 2:y -> 10, 3:z -> 1)
+    kept = 0;
+    for (int c = 0; c < model->constraint_num; c++) {
+        MeshConstraint constraint = model->constraint[c];
+        int n = find_mesh_node(model, constraint.node);
+        if (n < 0 || find_mesh_node(model, constraint.master) < 0) {
+            continue;
+        }
+        int digit = (constraint.dir == 1) ? 100 : (constraint.dir == 2) ? 10 : 1;
+        if (plane_flag[n] && (plane_rc / digit) % 10 != 0) {
+            statistics->conflict_num++;
+            continue;
+        }
+        model->constraint[kept++] = constraint;
+    }
+    model->constraint_num = kept;
+    free(restraint_of);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * FN、UE を切断の種類と同じ対称性を持つ成分にする(削除した側の節点、要素を詰めた後、カードを除く前に行う)
+ *
+ * STEP ごとに、残した側のカード(値 a)と削除した側の鏡像のカード(同じ種類、方向。値 b、無い場合は 0)を比べる。
+ * 鏡像の値の係数 s は、対称では面内の方向が 1、法線方向が -1、逆対称ではその逆。対称面上の節点、要素は b = a。
+ * - UE(荷重)は切断の種類の成分 (a + s * b) / 2 に置き換える(0 の場合は除く)
+ * - FN(強制変位)は成分に分けられないため、b = s * a の場合だけ残し、それ以外は除く
+ * - 削除した側だけにある値が 0 でないカードは除く
+ * 変えたカードは adjusted_load に記録する(対称では水平方向の強制変位、逆対称では軸力が除かれる)。
+ */
+static int adjust_symmetry_loads(MeshModel* model, int dir, SymmetryKind kind, const int mirror_node[], const int mirror_element[],
+                                 SymmetryLoad adjusted_load[], SymmetryCutStatistics* statistics) {
+    char* matched = (char*)calloc((size_t)model->step_card_num + 1, sizeof(char));
+    char* dropped = (char*)calloc((size_t)model->step_card_num + 1, sizeof(char));
+    if (matched == NULL || dropped == NULL) {
+        fprintf(stderr, "Error: Memory allocation for cut_mesh_model failed\n");
+        free(matched);
+        free(dropped);
+        return EXIT_FAILURE;
+    }
+    int first = 0;
+    while (first < model->step_card_num) {
+        int step = (model->step_card[first].kind == STEP_CARD_STEP) ? model->step_card[first].id : 0;
+        int last = first + 1;
+        while (last < model->step_card_num && model->step_card[last].kind != STEP_CARD_STEP) {
+            last++;
+        }
+        for (int s = first; s < last; s++) {
+            StepCard* card = &model->step_card[s];
+            int index;
+            if (card->kind == STEP_CARD_FN) {
+                index = find_mesh_node(model, card->id);
+            } else if (card->kind == STEP_CARD_UE) {
+                index = find_mesh_element(model, card->id);
+            } else {
+                continue;
+            }
+            if (index < 0) {
+                continue;
+            }
+            int mirror = (card->kind == STEP_CARD_FN) ? mirror_node[index] : mirror_element[index];
+            if (mirror == 0) {
+                continue;
+            }
+            int sign = (card->value[0] == dir) ? -1 : 1;
+            if (kind == SYMMETRY_ANTISYMMETRIC) sign = -sign;
+            double mirror_value = 0.0;
+            if (mirror == card->id) {
+                mirror_value = card->real;
+            } else {
+                for (int t = first; t < last; t++) {
+                    const StepCard* other = &model->step_card[t];
+                    if (!matched[t] && other->kind == card->kind && other->id == mirror && other->value[0] == card->value[0]) {
+                        matched[t] = 1;
+                        mirror_value = other->real;
+                        break;
+                    }
+                }
+            }
+            double used;
+            if (card->kind == STEP_CARD_UE) {
+                used = (card->real + sign * mirror_value) / 2.0;
+            } else {
+                used = (fabs(mirror_value - sign * card->real) <= 1e-9 * fmax(1.0, fabs(card->real))) ? card->real : 0.0;
+            }
+            if (fabs(used - card->real) <= 1e-9 * fmax(1.0, fabs(card->real))) {
+                continue;
+            }
+            adjusted_load[statistics->adjusted_load_num++] = (SymmetryLoad){step, card->kind, card->id, mirror, card->value[0], card->real, used};
+            if (fabs(used) <= 1e-9 * fmax(1.0, fabs(card->real))) {
+                dropped[s] = 1;
+                statistics->removed_load_num++;
+            } else {
+                card->real = used;
+            }
+        }
+        // 削除した側だけにあるカード
+        for (int s = first; s < last; s++) {
+            const StepCard* card = &model->step_card[s];
+            int removed = (card->kind == STEP_CARD_FN && find_mesh_node(model, card->id) < 0)
+                       || (card->kind == STEP_CARD_UE && find_mesh_element(model, card->id) < 0);
+            if (removed && !matched[s] && card->real != 0.0) {
+                adjusted_load[statistics->adjusted_load_num++] = (SymmetryLoad){step, card->kind, card->id, 0, card->value[0], card->real, 0.0};
+                statistics->removed_load_num++;
+            }
+        }
+        first = last;
+    }
+    int kept = 0;
+    for (int s = 0; s < model->step_card_num; s++) {
+        if (!dropped[s]) {
+            model->step_card[kept++] = model->step_card[s];
+        }
+    }
+    model->step_card_num = kept;
+    free(matched);
+    free(dropped);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 削除した節点、要素の FN、UE と、対称面の拘束と重なる FN(check_symmetry_loads で値が 0 のもの)を除く
+ */
+static void remove_mirror_side_cards(MeshModel* model, const char plane_flag[], int plane_rc, SymmetryCutStatistics* statistics) {
+    int kept = 0;
+    for (int s = 0; s < model->step_card_num; s++) {
+        StepCard card = model->step_card[s];
+        if (card.kind == STEP_CARD_FN) {
+            int n = find_mesh_node(model, card.id);
+            if (n < 0) continue;
+            int digit = (card.value[0] == 1) ? 100 : (card.value[0] == 2) ? 10 : 1;
+            if (plane_flag[n] && (plane_rc / digit) % 10 != 0) {
+                statistics->conflict_num++;
+                continue;
+            }
+        } else if (card.kind == STEP_CARD_UE && find_mesh_element(model, card.id) < 0) {
+            continue;
+        }
+        model->step_card[kept++] = card;
+    }
+    model->step_card_num = kept;
+}
+
+/**
+ * 対称な試験体のモデルを対称面で切断し、片側(対称面の座標より小さい側)だけを残す
+ *
+ * - 対称面の反対側の節点と、それを含む要素を削除する。対称面上の要素は残す。
+ * - 対称面上の節点に、対称(kind = SYMMETRY_SYMMETRIC)では法線方向、逆対称では面内の2方向の拘束を付ける。
+ * - 削除した節点、要素の REST、SUB1、FN、UE を除く。対称面の拘束と重なる SUB1 と値が 0 の FN も除く(conflict_num)。
+ * - 残した側の FN、UE は切断の種類と同じ対称性を持つものはそのまま使う(FN は強制変位、UE は要素の面の荷重のため、
+ *   半分にしない)。対称性が異なる成分(対称では水平方向の強制変位、逆対称では軸力)は片側では表せないため、
+ *   UE は同じ対称性の成分に置き換え、FN は除き、adjusted_load に記録する(adjust_symmetry_loads)。
+ * - 残した節点、要素ごとに、削除した側の同じ位置の節点、要素の番号を mirror_node、mirror_element に返す
+ *   (結果を削除した側に写すための対応表。対称面上のものは自身の番号)。
+ *
+ * @param model 切断するモデル(書き換える)
+ * @param dir 対称面の法線方向(1:x, 2:y, 3:z)
+ * @param plane 対称面の座標
+ * @param kind 対称面の境界条件
+ * @param mirror_node 節点の配列番号 -> 鏡像の節点番号(サイズは切断前の node_num + 1 以上)
+ * @param mirror_element 要素の配列番号 -> 鏡像の要素番号(サイズは切断前の element_num + 1 以上)
+ * @param adjusted_load 値を変えた、除いた FN、UE(サイズは切断前の step_card_num + 1 以上)。数は statistics->adjusted_load_num
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int cut_mesh_model(MeshModel* model, int dir, double plane, SymmetryKind kind,
+                   int mirror_node[], int mirror_element[], SymmetryLoad adjusted_load[], SymmetryCutStatistics* statistics) {
+    if (model == NULL || mirror_node == NULL || mirror_element == NULL || adjusted_load == NULL || statistics == NULL
+        || coordinate_array(model, dir) == NULL) {
+        fprintf(stderr, "Error: Invalid argument passed to cut_mesh_model\n");
+        return EXIT_FAILURE;
+    }
+    *statistics = (SymmetryCutStatistics){0};
+    int normal = (dir == 1) ? 100 : (dir == 2) ? 10 : 1;
+    int plane_rc = (kind == SYMMETRY_SYMMETRIC) ? normal : 111 - normal;
+
+    char* side = (char*)malloc((size_t)model->node_num + 1);
+    char* removed_element = (char*)calloc((size_t)model->element_num + 1, sizeof(char));
+    if (side == NULL || removed_element == NULL) {
+        fprintf(stderr, "Error: Memory allocation for cut_mesh_model failed\n");
+        free(side);
+        free(removed_element);
+        return EXIT_FAILURE;
+    }
+    const double* c = coordinate_array(model, dir);
+    for (int n = 0; n < model->node_num; n++) {
+        if (fabs(c[n] - plane) <= MESH_MIRROR_TOLERANCE) {
+            side[n] = 1;
+            statistics->plane_node_num++;
+        } else {
+            side[n] = (c[n] < plane) ? 0 : 2;
+        }
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int k = 0; k < node_count; k++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + k]);
+            if (n >= 0 && side[n] == 2) {
+                removed_element[e] = 1;
+                break;
+            }
+        }
+    }
+
+    int result = match_mirror_images(model, dir, plane, side, removed_element, mirror_node, mirror_element, statistics);
+    if (result == EXIT_SUCCESS) {
+        remove_mirror_side(model, side, removed_element, mirror_node, mirror_element, statistics);
+        // 詰めた後の配列番号で対称面上の節点の印を付け直す
+        for (int n = 0; n < model->node_num; n++) {
+            side[n] = (fabs(coordinate_array(model, dir)[n] - plane) <= MESH_MIRROR_TOLERANCE);
+        }
+        result = adjust_symmetry_loads(model, dir, kind, mirror_node, mirror_element, adjusted_load, statistics);
+    }
+    if (result == EXIT_SUCCESS) {
+        remove_mirror_side_cards(model, side, plane_rc, statistics);
+        result = restrain_symmetry_plane(model, side, plane_rc, statistics);
+    }
+    free(side);
+    free(removed_element);
+    return result;
+}
+
+/**
+ * 切断したモデルの結果を削除した側に写すための対応表(CSV)を書き込む
+ *
+ * 1行は kind(node / element), id, mirror_id, sign_x, sign_y, sign_z。
+ * sign は鏡像の変位(要素はベクトル量)を求める係数で、対称では法線方向が -1、逆対称では面内の2方向が -1。
+ * 続けて、値を変えた、除いた荷重を kind(fn / ue), id, mirror_id, , , , step, dir, value(元の値), used(使った値。
+ * 除いた場合は 0)の行で書き込む(写した結果には含まれない成分)。
+ */
+int write_symmetry_map(const char* file_name, const MeshModel* model, int dir, SymmetryKind kind,
+                       const int mirror_node[], const int mirror_element[], const SymmetryLoad adjusted_load[], int adjusted_load_num) {
+    if (file_name == NULL || model == NULL || mirror_node == NULL || mirror_element == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to write_symmetry_map\n");
+        return EXIT_FAILURE;
+    }
+    FILE* f = fopen(file_name, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return EXIT_FAILURE;
+    }
+    int sign[3];
+    for (int axis = 0; axis < 3; axis++) {
+        int normal = (axis == dir - 1);
+        sign[axis] = (normal == (kind == SYMMETRY_SYMMETRIC)) ? -1 : 1;
+    }
+    fprintf(f, "kind,id,mirror_id,sign_x,sign_y,sign_z,step,dir,value,used\n");
+    for (int n = 0; n < model->node_num; n++) {
+        fprintf(f, "node,%d,%d,%d,%d,%d,,,,\n", model->node_id[n], mirror_node[n], sign[0], sign[1], sign[2]);
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        fprintf(f, "element,%d,%d,%d,%d,%d,,,,\n", model->element_id[e], mirror_element[e], sign[0], sign[1], sign[2]);
+    }
+    for (int i = 0; i < adjusted_load_num && adjusted_load != NULL; i++) {
+        const SymmetryLoad* load = &adjusted_load[i];
+        fprintf(f, "%s,%d,%d,,,,%d,%d,%g,%g\n", (load->kind == STEP_CARD_FN) ? "fn" : "ue", load->id, load->mirror_id,
+                load->step, load->dir, load->value, load->used);
+    }
+    fclose(f);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1096 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mesh_model.h"
+#include "print_ffi.h"
+#include "mesh_copy.h"
+#include "range_set.h"
+
+/**
+ * .ffiを読み込み、COPYカードを展開した陽な節点、要素データ(MeshModel)を作成する。
+ *
+ * メモリの確保と初期化は分離して行う方針(modeling_data.cと同じ)
+ */
+
+// メモリ確保関数 ----------------------------------------------------------------------------
+MeshModel* allocate_mesh_model(int node_capacity, int element_capacity) {
+    if (node_capacity <= 0) node_capacity = 1;
+    if (element_capacity <= 0) element_capacity = 1;
+
+    MeshModel* model = (MeshModel*)malloc(sizeof(MeshModel));
+    if (model == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for MeshModel structure\n");
+        return NULL;
+    }
+
+    model->node_capacity = node_capacity;
+    model->node_id = (int*)malloc(node_capacity * sizeof(int));
+    model->x = (double*)malloc(node_capacity * sizeof(double));
+    model->y = (double*)malloc(node_capacity * sizeof(double));
+    model->z = (double*)malloc(node_capacity * sizeof(double));
+
+    model->element_capacity = element_capacity;
+    model->element_id = (int*)malloc(element_capacity * sizeof(int));
+    model->element_kind = (ElementKind*)malloc(element_capacity * sizeof(ElementKind));
+    model->element_type = (int*)malloc(element_capacity * sizeof(int));
+    model->connectivity = (int*)malloc(element_capacity * ELEMENT_NODE_MAX * sizeof(int));
+
+    model->node_index = NULL;
+    model->node_index_size = 0;
+    model->element_index = NULL;
+    model->element_index_size = 0;
+
+    model->restraint_num = 0;
+    model->restraint_capacity = 0;
+    model->restraint = NULL;
+    model->constraint_num = 0;
+    model->constraint_capacity = 0;
+    model->constraint = NULL;
+    model->instance_copy_num = 0;
+    model->instance_copy_capacity = 0;
+    model->instance_copy = NULL;
+    model->table_line_num = 0;
+    model->table_line_capacity = 0;
+    model->table_line = NULL;
+    model->step_card_num = 0;
+    model->step_card_capacity = 0;
+    model->step_card = NULL;
+
+    if (model->node_id == NULL || model->x == NULL || model->y == NULL || model->z == NULL ||
+        model->element_id == NULL || model->element_kind == NULL || model->element_type == NULL || model->connectivity == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for MeshModel arrays\n");
+        free(model->node_id);
+        free(model->x);
+        free(model->y);
+        free(model->z);
+        free(model->element_id);
+        free(model->element_kind);
+        free(model->element_type);
+        free(model->connectivity);
+        free(model);
+        return NULL;
+    }
+
+    return model;
+}
+
+// 初期化関数 ----------------------------------------------------------------------------
+void initialize_mesh_model(MeshModel* model) {
+    if (model == NULL) return;
+
+    model->node_num = 0;
+    model->element_num = 0;
+    for (int i = 0; i < model->node_index_size; i++) {
+        model->node_index[i] = -1;
+    }
+    for (int i = 0; i < model->element_index_size; i++) {
+        model->element_index[i] = -1;
+    }
+
+    model->last_step = 0;
+    model->disp_node = 0;
+    model->disp_dir = 1;
+    model->load_node = 0;
+    model->load_dir = 1;
+
+    model->restraint_num = 0;
+    model->constraint_num = 0;
+    model->instance_copy_num = 0;
+    for (int i = 0; i < model->table_line_num; i++) {
+        free(model->table_line[i]);
+        model->table_line[i] = NULL;
+    }
+    model->table_line_num = 0;
+    model->step_card_num = 0;
+}
+
+// メモリ解放関数 ----------------------------------------------------------------------------
+int free_mesh_model(MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to free_mesh_model\n");
+        return EXIT_FAILURE;
+    }
+
+    free(model->node_id);
+    model->node_id = NULL;
+    free(model->x);
+    model->x = NULL;
+    free(model->y);
+    model->y = NULL;
+    free(model->z);
+    model->z = NULL;
+    free(model->node_index);
+    model->node_index = NULL;
+
+    free(model->element_id);
+    model->element_id = NULL;
+    free(model->element_kind);
+    model->element_kind = NULL;
+    free(model->element_type);
+    model->element_type = NULL;
+    free(model->connectivity);
+    model->connectivity = NULL;
+    free(model->element_index);
+    model->element_index = NULL;
+
+    free(model->restraint);
+    model->restraint = NULL;
+    free(model->constraint);
+    model->constraint = NULL;
+    free(model->instance_copy);
+    model->instance_copy = NULL;
+    for (int i = 0; i < model->table_line_num; i++) {
+        free(model->table_line[i]);
+    }
+    free(model->table_line);
+    model->table_line = NULL;
+    free(model->step_card);
+    model->step_card = NULL;
+
+    free(model);
+
+    return EXIT_SUCCESS;
+}
+
+// MeshModelを作成する関数（メモリ確保 + 初期化）
+MeshModel* create_mesh_model() {
+    MeshModel* model = allocate_mesh_model(1024, 1024);
+    if (model == NULL) {
+        fprintf(stderr, "Failed to allocate MeshModel\n");
+        return NULL;
+    }
+    initialize_mesh_model(model);
+    return model;
+}
+
+// 要素の種類 ----------------------------------------------------------------------------
+/**
+ * 要素の種類ごとの節点数を返す
+ */
+int element_node_count(ElementKind kind) {
+    switch (kind) {
+        case ELEMENT_HEXA: return 8;
+        case ELEMENT_QUAD: return 4;
+        case ELEMENT_FILM: return 8;
+        case ELEMENT_LINE: return 4;
+        case ELEMENT_BEAM: return 2;
+        default: return 0;
+    }
+}
+
+/**
+ * 要素の種類のカード名を返す
+ */
+const char* element_kind_name(ElementKind kind) {
+    switch (kind) {
+        case ELEMENT_HEXA: return "HEXA";
+        case ELEMENT_QUAD: return "QUAD";
+        case ELEMENT_FILM: return "FILM";
+        case ELEMENT_LINE: return "LINE";
+        case ELEMENT_BEAM: return "BEAM";
+        default: return "----";
+    }
+}
+
+// 節点、要素の登録 ----------------------------------------------------------------------------
+/**
+ * 番号 -> 配列番号の対応表を id が入る大きさまで拡張する。拡張した分は -1 で埋める。
+ */
+static int grow_index_table(int** table, int* size, int id) {
+    if (id < *size) {
+        return EXIT_SUCCESS;
+    }
+    int new_size = (*size > 0) ? *size : 1024;
+    while (new_size <= id) {
+        new_size *= 2;
+    }
+    int* new_table = (int*)realloc(*table, new_size * sizeof(int));
+    if (new_table == NULL) {
+        fprintf(stderr, "Error: Failed to grow index table\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = *size; i < new_size; i++) {
+        new_table[i] = -1;
+    }
+    *table = new_table;
+    *size = new_size;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点番号から配列番号を探す。存在しない場合は -1。
+ */
+int find_mesh_node(const MeshModel* model, int node_id) {
+    if (node_id <= 0 || node_id >= model->node_index_size) {
+        return -1;
+    }
+    return model->node_index[node_id];
+}
+
+/**
+ * 要素番号から配列番号を探す。存在しない場合は -1。
+ */
+int find_mesh_element(const MeshModel* model, int element_id) {
+    if (element_id <= 0 || element_id >= model->element_index_size) {
+        return -1;
+    }
+    return model->element_index[element_id];
+}
+
+/**
+ * 節点を登録する。既に同じ番号がある場合は座標を上書きする。
+ *
+ * @return 登録した節点の配列番号、失敗した場合は -1
+ */
+int add_mesh_node(MeshModel* model, int node_id, double x, double y, double z) {
+    if (model == NULL || node_id <= 0) {
+        fprintf(stderr, "Error: Invalid node number (%d)\n", node_id);
+        return -1;
+    }
+
+    int index = find_mesh_node(model, node_id);
+    if (index < 0) {
+        if (grow_index_table(&model->node_index, &model->node_index_size, node_id) != EXIT_SUCCESS) {
+            return -1;
+        }
+        // 容量が足りない場合は倍に拡張
+        if (model->node_num >= model->node_capacity) {
+            int capacity = model->node_capacity * 2;
+            int* node_id_new = (int*)realloc(model->node_id, capacity * sizeof(int));
+            if (node_id_new != NULL) model->node_id = node_id_new;
+            double* x_new = (double*)realloc(model->x, capacity * sizeof(double));
+            if (x_new != NULL) model->x = x_new;
+            double* y_new = (double*)realloc(model->y, capacity * sizeof(double));
+            if (y_new != NULL) model->y = y_new;
+            double* z_new = (double*)realloc(model->z, capacity * sizeof(double));
+            if (z_new != NULL) model->z = z_new;
+            if (node_id_new == NULL || x_new == NULL || y_new == NULL || z_new == NULL) {
+                fprintf(stderr, "Error: Failed to grow MeshModel node arrays\n");
+                return -1;
+            }
+            model->node_capacity = capacity;
+        }
+        index = model->node_num;
+        model->node_num++;
+        model->node_id[index] = node_id;
+        model->node_index[node_id] = index;
+    }
+
+    model->x[index] = x;
+    model->y[index] = y;
+    model->z[index] = z;
+    return index;
+}
+
+/**
+ * 要素を登録する。既に同じ番号がある場合は上書きする。
+ *
+ * @param node 要素の節点番号(element_node_count(kind) 個)
+ * @return 登録した要素の配列番号、失敗した場合は -1
+ */
+int add_mesh_element(MeshModel* model, int element_id, ElementKind kind, int type, const int node[]) {
+    if (model == NULL || element_id <= 0) {
+        fprintf(stderr, "Error: Invalid element number (%d)\n", element_id);
+        return -1;
+    }
+
+    int index = find_mesh_element(model, element_id);
+    if (index < 0) {
+        if (grow_index_table(&model->element_index, &model->element_index_size, element_id) != EXIT_SUCCESS) {
+            return -1;
+        }
+        if (model->element_num >= model->element_capacity) {
+            int capacity = model->element_capacity * 2;
+            int* element_id_new = (int*)realloc(model->element_id, capacity * sizeof(int));
+            if (element_id_new != NULL) model->element_id = element_id_new;
+            ElementKind* kind_new = (ElementKind*)realloc(model->element_kind, capacity * sizeof(ElementKind));
+            if (kind_new != NULL) model->element_kind = kind_new;
+            int* type_new = (int*)realloc(model->element_type, capacity * sizeof(int));
+            if (type_new != NULL) model->element_type = type_new;
+            int* connectivity_new = (int*)realloc(model->connectivity, capacity * ELEMENT_NODE_MAX * sizeof(int));
+            if (connectivity_new != NULL) model->connectivity = connectivity_new;
+            if (element_id_new == NULL || kind_new == NULL || type_new == NULL || connectivity_new == NULL) {
+                fprintf(stderr, "Error: Failed to grow MeshModel element arrays\n");
+                return -1;
+            }
+            model->element_capacity = capacity;
+        }
+        index = model->element_num;
+        model->element_num++;
+        model->element_id[index] = element_id;
+        model->element_index[element_id] = index;
+    }
+
+    model->element_kind[index] = kind;
+    model->element_type[index] = type;
+    int count = element_node_count(kind);
+    for (int i = 0; i < ELEMENT_NODE_MAX; i++) {
+        model->connectivity[index * ELEMENT_NODE_MAX + i] = (i < count) ? node[i] : 0;
+    }
+    return index;
+}
+
+/**
+ * 配列の容量が足りない場合は倍に拡張する
+ *
+ * @param array 配列へのポインタ
+ * @param capacity 現在の容量
+ * @param need 必要な要素数
+ * @param size 要素1つ当りのサイズ
+ */
+static int grow_array(void** array, int* capacity, int need, size_t size) {
+    if (need <= *capacity) {
+        return EXIT_SUCCESS;
+    }
+    int new_capacity = (*capacity > 0) ? *capacity : 64;
+    while (new_capacity < need) {
+        new_capacity *= 2;
+    }
+    void* new_array = realloc(*array, (size_t)new_capacity * size);
+    if (new_array == NULL) {
+        fprintf(stderr, "Error: Failed to grow MeshModel array\n");
+        return EXIT_FAILURE;
+    }
+    *array = new_array;
+    *capacity = new_capacity;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点1つ分の拘束条件(REST)を登録する
+ */
+int add_mesh_restraint(MeshModel* model, int node, int rc) {
+    if (grow_array((void**)&model->restraint, &model->restraint_capacity, model->restraint_num + 1, sizeof(MeshRestraint)) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    model->restraint[model->restraint_num].node = node;
+    model->restraint[model->restraint_num].rc = rc;
+    model->restraint_num++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点1つ分の従属条件(SUB1)を登録する
+ */
+int add_mesh_constraint(MeshModel* model, int node, int dir, int master, int master_dir) {
+    if (grow_array((void**)&model->constraint, &model->constraint_capacity, model->constraint_num + 1, sizeof(MeshConstraint)) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    MeshConstraint* c = &model->constraint[model->constraint_num];
+    c->node = node;
+    c->dir = dir;
+    c->master = master;
+    c->master_dir = master_dir;
+    model->constraint_num++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 部品の複写(COPY :NODE、COPY :ELM)を1枚登録する
+ */
+int add_mesh_instance_copy(MeshModel* model, const MeshInstanceCopy* copy) {
+    if (grow_array((void**)&model->instance_copy, &model->instance_copy_capacity, model->instance_copy_num + 1, sizeof(MeshInstanceCopy)) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    model->instance_copy[model->instance_copy_num++] = *copy;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素タイプ、材料モデルのカード1行を登録する(改行は含めない)
+ */
+int add_mesh_table_line(MeshModel* model, const char* line) {
+    if (grow_array((void**)&model->table_line, &model->table_line_capacity, model->table_line_num + 1, sizeof(char*)) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    size_t length = strcspn(line, "\r\n");
+    char* copy = (char*)malloc(length + 1);
+    if (copy == NULL) {
+        fprintf(stderr, "Error: Memory allocation for table line failed\n");
+        return EXIT_FAILURE;
+    }
+    memcpy(copy, line, length);
+    copy[length] = '\0';
+    model->table_line[model->table_line_num++] = copy;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * STEPデータのカードを1つ登録する(StepCardの説明を参照)
+ */
+int add_mesh_step_card(MeshModel* model, StepCardKind kind, int id, int value0, int value1, int value2, double real) {
+    if (grow_array((void**)&model->step_card, &model->step_card_capacity, model->step_card_num + 1, sizeof(StepCard)) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    StepCard* card = &model->step_card[model->step_card_num];
+    card->kind = kind;
+    card->id = id;
+    card->value[0] = value0;
+    card->value[1] = value1;
+    card->value[2] = value2;
+    card->real = real;
+    model->step_card_num++;
+    return EXIT_SUCCESS;
+}
+
+// ffiの読み込み ----------------------------------------------------------------------------
+/**
+ * カードの括弧内の整数を順番に取り出す。
+ * 括弧内が ':' で区切られている場合はそれぞれを1つの値とし、空白のみの場合は 0 とする。
+ *
+ * 例: "HEXA :(  220)(  434:  435: ...) TYPH(  3)" -> 220, 434, 435, ..., 3
+ *
+ * @param line カード1行
+ * @param values 取り出した値の格納先
+ * @param max_values valuesの要素数
+ * @return 取り出した値の個数
+ */
+int parse_card_fields(const char* line, int values[], int max_values) {
+    int count = 0;
+    const char* p = line;
+    int in_paren = 0;
+    while (*p != '\0' && *p != '\n') {
+        if (*p == '(') {
+            in_paren = 1;
+            p++;
+        } else if (in_paren) {
+            // 区切り(':' または ')')までを1つの値とする
+            const char* start = p;
+            while (*p != ':' && *p != ')' && *p != '\0' && *p != '\n') {
+                p++;
+            }
+            if (count < max_values) {
+                values[count] = (int)strtol(start, NULL, 10);
+            }
+            count++;
+            if (*p == ')') {
+                in_paren = 0;
+            }
+            if (*p != '\0' && *p != '\n') {
+                p++;
+            }
+        } else {
+            p++;
+        }
+    }
+    return count;
+}
+
+/**
+ * "key=" に続く実数を読み取る。keyが無い場合は 0.0。
+ */
+static double parse_card_real(const char* line, const char* key) {
+    const char* p = strstr(line, key);
+    if (p == NULL) {
+        return 0.0;
+    }
+    return strtod(p + strlen(key), NULL);
+}
+
+/**
+ * カード名が一致するかを判定する。先頭の空白は無視する。
+ */
+static int is_card(const char* line, const char* name) {
+    while (*line == ' ') {
+        line++;
+    }
+    return strncmp(line, name, strlen(name)) == 0;
+}
+
+// ETYPは要素が揃ってから適用するため一時的に保存する
+typedef struct {
+    int start;
+    int end;
+    int interval;
+    int type;
+    int increment;
+    int set;
+} EtypCard;
+
+/**
+ * COPY :NODE
+ * S-E-I の節点を、番号は k*INC、座標は k*D ずらして SET 回複写する。
+ */
+void expand_copy_node(MeshModel* model, const int values[], double length, int dir) {
+    int start = values[0];
+    int end = (values[1] == 0) ? start : values[1];
+    int interval = (values[2] == 0) ? 1 : values[2];
+    int increment = values[3];
+    int set = values[4];
+
+    for (int id = start; id <= end; id += interval) {
+        int index = find_mesh_node(model, id);
+        if (index < 0) {
+            continue;
+        }
+        for (int k = 1; k <= set; k++) {
+            // add_mesh_nodeで配列が再確保されるため毎回読み直す
+            index = find_mesh_node(model, id);
+            double coordinate[3] = {model->x[index], model->y[index], model->z[index]};
+            coordinate[dir] += k * length;
+            add_mesh_node(model, id + k * increment, coordinate[0], coordinate[1], coordinate[2]);
+        }
+    }
+}
+
+/**
+ * COPY :ELM
+ * S-E-I の要素を、要素番号は k*INC、節点番号は k*NINC ずらして SET 回複写する。
+ */
+void expand_copy_element(MeshModel* model, const int values[]) {
+    int start = values[0];
+    int end = (values[1] == 0) ? start : values[1];
+    int interval = (values[2] == 0) ? 1 : values[2];
+    int increment = values[3];
+    int node_increment = values[4];
+    int set = values[5];
+
+    for (int id = start; id <= end; id += interval) {
+        int index = find_mesh_element(model, id);
+        if (index < 0) {
+            continue;
+        }
+        ElementKind kind = model->element_kind[index];
+        int type = model->element_type[index];
+        int count = element_node_count(kind);
+        int base[ELEMENT_NODE_MAX];
+        for (int i = 0; i < count; i++) {
+            base[i] = model->connectivity[index * ELEMENT_NODE_MAX + i];
+        }
+        for (int k = 1; k <= set; k++) {
+            int node[ELEMENT_NODE_MAX];
+            for (int i = 0; i < count; i++) {
+                node[i] = base[i] + k * node_increment;
+            }
+            add_mesh_element(model, id + k * increment, kind, type, node);
+        }
+    }
+}
+
+/**
+ * ETYP
+ * S-E-I の要素と、それを k*INC (k = 1 ... SET) ずらした要素のタイプを変更する。
+ */
+static void apply_etyp(MeshModel* model, const EtypCard* card) {
+    int end = (card->end < card->start) ? card->start : card->end;
+    int interval = (card->interval == 0) ? 1 : card->interval;
+    for (int k = 0; k <= card->set; k++) {
+        for (int id = card->start; id <= end; id += interval) {
+            int index = find_mesh_element(model, id + k * card->increment);
+            if (index >= 0) {
+                model->element_type[index] = card->type;
+            }
+        }
+    }
+}
+
+/**
+ * .ffiを読み込みMeshModelに格納する。
+ * NODE, HEXA, QUAD, FILM, LINE, BEAM, COPY :NODE, COPY :ELM, ETYP を解釈し、
+ * COPYカードは陽な節点、要素に展開する。
+ * 解析制御データ、REST、SUB1、要素タイプ、材料モデル、STEPデータも読み込む。
+ *
+ * @param file_name 読み込む.ffiのファイル名
+ * @param model 格納先(create_mesh_model()で作成したもの)
+ */
+MeshModelResult read_mesh_model(const char* file_name, MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to read_mesh_model\n");
+        return MESH_MODEL_ERROR;
+    }
+
+    FILE* fin = fopen(file_name, "r");
+    if (fin == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return MESH_MODEL_ERROR;
+    }
+
+    int etyp_num = 0;
+    int etyp_capacity = 64;
+    EtypCard* etyp = (EtypCard*)malloc(etyp_capacity * sizeof(EtypCard));
+    if (etyp == NULL) {
+        fprintf(stderr, "Error: Memory allocation for ETYP cards failed\n");
+        fclose(fin);
+        return MESH_MODEL_ERROR;
+    }
+
+    char line[512];
+    int values[16];
+    MeshModelResult result = MESH_MODEL_SUCCESS;
+    while (fgets(line, sizeof(line), fin) != NULL) {
+        if (is_card(line, "NODE :")) {
+            parse_card_fields(line, values, 16);
+            if (add_mesh_node(model, values[0], parse_card_real(line, "X="), parse_card_real(line, "Y="), parse_card_real(line, "Z=")) < 0) {
+                result = MESH_MODEL_ERROR;
+            }
+        } else if (is_card(line, "COPY :NODE")) {
+            parse_card_fields(line, values, 16);
+            int dir = 0;
+            double length = 0.0;
+            if (strstr(line, "DX=") != NULL) {
+                dir = 0;
+                length = parse_card_real(line, "DX=");
+            } else if (strstr(line, "DY=") != NULL) {
+                dir = 1;
+                length = parse_card_real(line, "DY=");
+            } else if (strstr(line, "DZ=") != NULL) {
+                dir = 2;
+                length = parse_card_real(line, "DZ=");
+            }
+            expand_copy_node(model, values, length, dir);
+        } else if (is_card(line, "COPY :ELM")) {
+            parse_card_fields(line, values, 16);
+            expand_copy_element(model, values);
+        } else if (is_card(line, "HEXA :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_element(model, values[0], ELEMENT_HEXA, values[9], &values[1]);
+        } else if (is_card(line, "QUAD :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_element(model, values[0], ELEMENT_QUAD, values[5], &values[1]);
+        } else if (is_card(line, "FILM :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_element(model, values[0], ELEMENT_FILM, values[9], &values[1]);
+        } else if (is_card(line, "LINE :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_element(model, values[0], ELEMENT_LINE, values[5], &values[1]);
+        } else if (is_card(line, "BEAM :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_element(model, values[0], ELEMENT_BEAM, values[3], &values[1]);
+        } else if (is_card(line, "EXEC :")) {
+            parse_card_fields(line, values, 16);
+            model->last_step = values[1];
+        } else if (is_card(line, "DISP :")) {
+            parse_card_fields(line, values, 16);
+            model->disp_node = values[0];
+            model->disp_dir = values[1];
+        } else if (is_card(line, "LOAD :")) {
+            parse_card_fields(line, values, 16);
+            model->load_node = values[0];
+            model->load_dir = values[1];
+        } else if (is_card(line, "REST :")) {
+            // S-E-I と、それを k*INC (k = 1 ... SET) ずらした節点
+            parse_card_fields(line, values, 16);
+            int end = (values[1] < values[0]) ? values[0] : values[1];
+            int interval = (values[2] == 0) ? 1 : values[2];
+            for (int k = 0; k <= values[5]; k++) {
+                for (int id = values[0]; id <= end; id += interval) {
+                    add_mesh_restraint(model, id + k * values[4], values[3] / 1000);
+                }
+            }
+        } else if (is_card(line, "SUB1 :")) {
+            parse_card_fields(line, values, 16);
+            int end = (values[1] < values[0]) ? values[0] : values[1];
+            int interval = (values[2] == 0) ? 1 : values[2];
+            for (int id = values[0]; id <= end; id += interval) {
+                add_mesh_constraint(model, id, values[3], values[4], values[5]);
+            }
+        } else if (is_card(line, "TYPH :") || is_card(line, "TYPB :") || is_card(line, "TYPL :") ||
+                   is_card(line, "TYPQ :") || is_card(line, "TYPF :") || is_card(line, "AXIS :") ||
+                   is_card(line, "MATC :") || is_card(line, "MATS :") || is_card(line, "MATJ :")) {
+            add_mesh_table_line(model, line);
+        } else if (is_card(line, "STEP :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_step_card(model, STEP_CARD_STEP, values[0], 0, 0, 0, parse_card_real(line, "INCREMENT="));
+        } else if (is_card(line, "FN :")) {
+            parse_card_fields(line, values, 16);
+            int end = (values[1] < values[0]) ? values[0] : values[1];
+            int interval = (values[2] == 0) ? 1 : values[2];
+            for (int id = values[0]; id <= end; id += interval) {
+                add_mesh_step_card(model, STEP_CARD_FN, id, values[3], 0, 0, parse_card_real(line, "DISP="));
+            }
+        } else if (is_card(line, "UE :")) {
+            parse_card_fields(line, values, 16);
+            int end = (values[1] < values[0]) ? values[0] : values[1];
+            int interval = (values[2] == 0) ? 1 : values[2];
+            for (int id = values[0]; id <= end; id += interval) {
+                add_mesh_step_card(model, STEP_CARD_UE, id, values[3], values[4], 0, parse_card_real(line, "UNIT="));
+            }
+        } else if (is_card(line, "OUT :")) {
+            parse_card_fields(line, values, 16);
+            add_mesh_step_card(model, STEP_CARD_OUT, values[0], values[1], values[2], values[3], 0.0);
+        } else if (is_card(line, "ETYP :")) {
+            parse_card_fields(line, values, 16);
+            if (etyp_num >= etyp_capacity) {
+                etyp_capacity *= 2;
+                EtypCard* etyp_new = (EtypCard*)realloc(etyp, etyp_capacity * sizeof(EtypCard));
+                if (etyp_new == NULL) {
+                    fprintf(stderr, "Error: Memory allocation for ETYP cards failed\n");
+                    result = MESH_MODEL_ERROR;
+                    break;
+                }
+                etyp = etyp_new;
+            }
+            EtypCard card = {values[0], values[1], values[2], values[3], values[4], values[5]};
+            etyp[etyp_num++] = card;
+        }
+    }
+    fclose(fin);
+
+    // ETYPの適用
+    for (int i = 0; i < etyp_num; i++) {
+        apply_etyp(model, &etyp[i]);
+    }
+    free(etyp);
+
+    return result;
+}
+
+// ffiの書き込み ----------------------------------------------------------------------------
+/**
+ * 昇順に並んだ番号を等差数列(S-E-I)の並びに分割する。1つだけの場合は interval = 0。
+ *
+ * @return 分割した数
+ */
+static int split_arithmetic_runs(const int ids[], int n, int start[], int end[], int interval[]) {
+    int run = 0;
+    int i = 0;
+    while (i < n) {
+        if (i + 1 < n) {
+            int d = ids[i + 1] - ids[i];
+            int j = i + 1;
+            while (j + 1 < n && ids[j + 1] - ids[j] == d) {
+                j++;
+            }
+            start[run] = ids[i];
+            end[run] = ids[j];
+            interval[run] = d;
+            i = j + 1;
+        } else {
+            start[run] = ids[i];
+            end[run] = ids[i];
+            interval[run] = 0;
+            i++;
+        }
+        run++;
+    }
+    return run;
+}
+
+static int compare_restraint(const void* a, const void* b) {
+    const MeshRestraint* p = (const MeshRestraint*)a;
+    const MeshRestraint* q = (const MeshRestraint*)b;
+    if (p->rc != q->rc) return (p->rc < q->rc) ? -1 : 1;
+    return (p->node > q->node) - (p->node < q->node);
+}
+
+static int compare_constraint(const void* a, const void* b) {
+    const MeshConstraint* p = (const MeshConstraint*)a;
+    const MeshConstraint* q = (const MeshConstraint*)b;
+    if (p->master != q->master) return (p->master < q->master) ? -1 : 1;
+    if (p->master_dir != q->master_dir) return (p->master_dir < q->master_dir) ? -1 : 1;
+    if (p->dir != q->dir) return (p->dir < q->dir) ? -1 : 1;
+    return (p->node > q->node) - (p->node < q->node);
+}
+
+static int compare_step_card(const void* a, const void* b) {
+    const StepCard* p = (const StepCard*)a;
+    const StepCard* q = (const StepCard*)b;
+    for (int i = 0; i < 3; i++) {
+        if (p->value[i] != q->value[i]) return (p->value[i] < q->value[i]) ? -1 : 1;
+    }
+    if (p->real != q->real) return (p->real < q->real) ? -1 : 1;
+    return (p->id > q->id) - (p->id < q->id);
+}
+
+/**
+ * 番号の並び(昇順、重複あり)を S-E-I にまとめる。重複は取り除く。
+ *
+ * @return S-E-I の数
+ */
+static int make_runs(int ids[], int n, int start[], int end[], int interval[]) {
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        if (unique == 0 || ids[unique - 1] != ids[i]) {
+            ids[unique++] = ids[i];
+        }
+    }
+    return split_arithmetic_runs(ids, unique, start, end, interval);
+}
+
+/**
+ * 要素を1行(HEXA、QUAD、FILM、LINE、BEAM)で書き込む
+ *
+ * @param e 要素の配列番号
+ * @param type 書き込むタイプ番号(LINEはTYPL(1)で固定)
+ */
+void print_mesh_element(FILE* f, const MeshModel* model, int e, int type) {
+    int id = model->element_id[e];
+    int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+    switch (model->element_kind[e]) {
+        case ELEMENT_HEXA: print_HEXA_node(f, id, node, type); break;
+        case ELEMENT_QUAD: print_QUAD_node(f, id, node, type); break;
+        case ELEMENT_FILM: print_FILM_node(f, id, &node[0], &node[4], type); break;
+        case ELEMENT_LINE: print_LINE_node(f, id, node); break;
+        case ELEMENT_BEAM: print_BEAM(f, id, node[0], node[1] - node[0], type); break;
+        default: break;
+    }
+}
+
+static char direction_char(int dir) {
+    switch (dir) {
+        case 2: return 'y';
+        case 3: return 'z';
+        default: return 'x';
+    }
+}
+
+/**
+ * 連続するFNまたはUEカード(同じSTEP内)をまとめて書き込む
+ */
+static void write_step_load_cards(FILE* f, const StepCard* cards, int n, int work[], int start[], int end[], int interval[]) {
+    StepCard* sorted = (StepCard*)malloc((size_t)n * sizeof(StepCard));
+    if (sorted == NULL) {
+        fprintf(stderr, "Error: Memory allocation for step cards failed\n");
+        return;
+    }
+    memcpy(sorted, cards, (size_t)n * sizeof(StepCard));
+    qsort(sorted, n, sizeof(StepCard), compare_step_card);
+
+    int head = 0;
+    while (head < n) {
+        int tail = head;
+        while (tail < n && sorted[tail].value[0] == sorted[head].value[0] && sorted[tail].value[1] == sorted[head].value[1] && sorted[tail].real == sorted[head].real) {
+            work[tail - head] = sorted[tail].id;
+            tail++;
+        }
+        if (sorted[head].kind == STEP_CARD_FN) {
+            int run = make_runs(work, tail - head, start, end, interval);
+            for (int r = 0; r < run; r++) {
+                print_FN(f, start[r], (interval[r] == 0) ? 0 : end[r], interval[r], sorted[head].real, direction_char(sorted[head].value[0]));
+            }
+        } else {
+            print_UE_set(f, work, tail - head, sorted[head].real, direction_char(sorted[head].value[0]), sorted[head].value[1]);
+        }
+        head = tail;
+    }
+    free(sorted);
+}
+
+/**
+ * 部品の複写を書き込む
+ *
+ * @param element 0: COPY :NODE, 1: COPY :ELM
+ */
+static void print_instance_copies(FILE* f, const MeshModel* model, int element) {
+    for (int i = 0; i < model->instance_copy_num; i++) {
+        const MeshInstanceCopy* copy = &model->instance_copy[i];
+        if (copy->element != element) {
+            continue;
+        }
+        int end = (copy->end == copy->start) ? 0 : copy->end;
+        int interval = (end == 0) ? 0 : copy->interval;
+        if (element) {
+            print_COPYELM(f, copy->start, end, interval, copy->increment, copy->node_increment, copy->set);
+        } else {
+            print_COPYNODE(f, copy->start, end, interval, copy->distance, copy->increment, copy->set, copy->axis);
+        }
+    }
+}
+
+/**
+ * MeshModelを.ffiとして書き込む。
+ * 節点、要素はNODE、要素のカードとCOPYカードにまとめ(mesh_copy.c)、REST、SUB1、UEは範囲の組にまとめ(range_set.c)、
+ * FNは等差数列ごとにまとめる。
+ *
+ * @param file_name 書き込む.ffiのファイル名
+ * @param model 書き込むモデル
+ */
+MeshModelResult write_mesh_model(const char* file_name, const MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to write_mesh_model\n");
+        return MESH_MODEL_ERROR;
+    }
+
+    FILE* f = fopen(file_name, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return MESH_MODEL_ERROR;
+    }
+
+    // 作業配列
+    int work_size = model->node_num;
+    if (model->element_num > work_size) work_size = model->element_num;
+    if (model->restraint_num > work_size) work_size = model->restraint_num;
+    if (model->constraint_num > work_size) work_size = model->constraint_num;
+    if (model->step_card_num > work_size) work_size = model->step_card_num;
+    work_size++;
+    int* work = (int*)malloc((size_t)work_size * sizeof(int));
+    int* start = (int*)malloc((size_t)work_size * sizeof(int));
+    int* end = (int*)malloc((size_t)work_size * sizeof(int));
+    int* interval = (int*)malloc((size_t)work_size * sizeof(int));
+    if (work == NULL || start == NULL || end == NULL || interval == NULL) {
+        fprintf(stderr, "Error: Memory allocation for write_mesh_model failed\n");
+        free(work);
+        free(start);
+        free(end);
+        free(interval);
+        fclose(f);
+        return MESH_MODEL_ERROR;
+    }
+
+    // 解析制御データ
+    MeshModelResult result = MESH_MODEL_SUCCESS;
+    if (print_head_template(f, model->last_step, model->disp_node, direction_char(model->disp_dir), model->load_node, direction_char(model->load_dir)) != EXIT_SUCCESS) {
+        result = MESH_MODEL_ERROR;
+    }
+
+    // 節点、要素(COPYカードにまとめ、展開して一致しない場合は1行ずつ書き込む)
+    CopyCardList* node_cards = create_copy_card_list();
+    CopyCardList* element_cards = create_copy_card_list();
+    int compressed = node_cards != NULL && element_cards != NULL &&
+                     synthesize_node_cards(model, node_cards) == EXIT_SUCCESS &&
+                     synthesize_element_cards(model, element_cards) == EXIT_SUCCESS &&
+                     verify_copy_cards(model, node_cards, element_cards) == EXIT_SUCCESS;
+
+    fprintf(f, "---- NODE ----\n");
+    if (compressed) {
+        print_copy_cards(f, model, node_cards);
+    } else {
+        for (int id = 1; id < model->node_index_size; id++) {
+            int n = model->node_index[id];
+            if (n >= 0) {
+                print_NODE(f, id, model->x[n], model->y[n], model->z[n]);
+            }
+        }
+    }
+    print_instance_copies(f, model, 0);
+    fprintf(f, "\n");
+
+    fprintf(f, "---- ELEMENT ----\n");
+    if (compressed) {
+        print_copy_cards(f, model, element_cards);
+    } else {
+        for (int id = 1; id < model->element_index_size; id++) {
+            int e = model->element_index[id];
+            if (e >= 0) {
+                print_mesh_element(f, model, e, model->element_type[e]);
+            }
+        }
+    }
+    print_instance_copies(f, model, 1);
+    fprintf(f, "\n");
+    free_copy_card_list(node_cards);
+    free_copy_card_list(element_cards);
+
+    // REST
+    if (model->restraint_num > 0) {
+        fprintf(f, "---- REST ----\n");
+        MeshRestraint* restraint = (MeshRestraint*)malloc((size_t)model->restraint_num * sizeof(MeshRestraint));
+        if (restraint != NULL) {
+            memcpy(restraint, model->restraint, (size_t)model->restraint_num * sizeof(MeshRestraint));
+            qsort(restraint, model->restraint_num, sizeof(MeshRestraint), compare_restraint);
+            int head = 0;
+            while (head < model->restraint_num) {
+                int tail = head;
+                while (tail < model->restraint_num && restraint[tail].rc == restraint[head].rc) {
+                    work[tail - head] = restraint[tail].node;
+                    tail++;
+                }
+                if (print_REST_set(f, work, tail - head, restraint[head].rc) != EXIT_SUCCESS) {
+                    result = MESH_MODEL_ERROR;
+                }
+                head = tail;
+            }
+            free(restraint);
+        } else {
+            result = MESH_MODEL_ERROR;
+        }
+        fprintf(f, "\n");
+    }
+
+    // SUB1
+    if (model->constraint_num > 0) {
+        fprintf(f, "---- SUB1 ----\n");
+        MeshConstraint* constraint = (MeshConstraint*)malloc((size_t)model->constraint_num * sizeof(MeshConstraint));
+        if (constraint != NULL) {
+            memcpy(constraint, model->constraint, (size_t)model->constraint_num * sizeof(MeshConstraint));
+            qsort(constraint, model->constraint_num, sizeof(MeshConstraint), compare_constraint);
+            int head = 0;
+            while (head < model->constraint_num) {
+                int tail = head;
+                while (tail < model->constraint_num && constraint[tail].master == constraint[head].master &&
+                       constraint[tail].master_dir == constraint[head].master_dir && constraint[tail].dir == constraint[head].dir) {
+                    work[tail - head] = constraint[tail].node;
+                    tail++;
+                }
+                if (print_SUB1_set(f, work, tail - head, constraint[head].dir, constraint[head].master, constraint[head].master_dir) != EXIT_SUCCESS) {
+                    result = MESH_MODEL_ERROR;
+                }
+                head = tail;
+            }
+            free(constraint);
+        } else {
+            result = MESH_MODEL_ERROR;
+        }
+        fprintf(f, "\n");
+    }
+
+    // 要素タイプ、材料モデル
+    for (int i = 0; i < model->table_line_num; i++) {
+        fprintf(f, "%s\n", model->table_line[i]);
+    }
+    fprintf(f, "\n");
+
+    // STEPデータ
+    int head = 0;
+    while (head < model->step_card_num) {
+        const StepCard* card = &model->step_card[head];
+        if (card->kind == STEP_CARD_FN || card->kind == STEP_CARD_UE) {
+            int tail = head;
+            while (tail < model->step_card_num && model->step_card[tail].kind == card->kind) {
+                tail++;
+            }
+            write_step_load_cards(f, card, tail - head, work, start, end, interval);
+            head = tail;
+            continue;
+        }
+        if (card->kind == STEP_CARD_STEP) {
+            print_STEP(f, card->id);
+        } else if (card->kind == STEP_CARD_OUT) {
+            print_OUT_level(f, card->id, card->value[0], card->value[1], (card->value[2] > 0) ? card->value[2] : 3);
+            fprintf(f, "\n");
+        }
+        head++;
+    }
+
+    fprintf(f, "\nEND\n");
+    fclose(f);
+
+    free(work);
+    free(start);
+    free(end);
+    free(interval);
+    return result;
+}
+
+// 表示関数 ----------------------------------------------------------------------------
+// JSONのインデント用のスペースを出力
+void print_indent_mm(int level) {
+    for (int i = 0; i < level; i++) {
+        printf("    "); // 4スペースのインデント
+    }
+}
+
+/**
+ * MeshModelの概要(節点数、種類ごとの要素数)を表示する
+ */
+void print_mesh_model(const MeshModel* model) {
+    if (model == NULL) {
+        printf("\"mesh_model\": null\n");
+        return;
+    }
+    int count[ELEMENT_KIND_MAX] = {0};
+    for (int i = 0; i < model->element_num; i++) {
+        count[model->element_kind[i]]++;
+    }
+    printf("\"mesh_model\": {\n");
+    print_indent_mm(1);
+    printf("\"node_num\": %d,\n", model->node_num);
+    print_indent_mm(1);
+    printf("\"element_num\": %d,\n", model->element_num);
+    for (int kind = 0; kind < ELEMENT_KIND_MAX; kind++) {
+        print_indent_mm(1);
+        printf("\"%s\": %d%s\n", element_kind_name((ElementKind)kind), count[kind], (kind < ELEMENT_KIND_MAX - 1) ? "," : "");
+    }
+    printf("}\n");
+}
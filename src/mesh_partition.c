@@ -0,0 +1,848 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include "mesh_partition.h"
+
+/**
+ * 要素の分割(マルチレベル法)
+ *
+ * 要素 -> 要素の隣接関係(辺または面を共有)を、共有する節点の数を辺の重みとしたグラフにし、
+ *   1. 粗視化: 重い辺のマッチングで頂点をまとめたグラフを順に作る
+ *   2. 初期分割: 最も粗いグラフを貪欲な領域成長で2分割する
+ *   3. 改善: 細かいグラフへ戻しながら境界の頂点をFM法で移動する
+ * で2分割し、これを再帰的に繰り返して part_num 個に分ける。頂点の重みは要素数。
+ * 重みの超過は再帰の段数で重なるため、1回の2分割で許す超過は段数で割り振る。
+ * 乱数は固定の種を使うため、同じモデルからは同じ分割が得られる。
+ */
+
+/**
+ * PartitionGraph構造体
+ *
+ * 重み付きのグラフ。頂点 v の隣接先は index[offset[v]] ... index[offset[v + 1] - 1]。
+ */
+typedef struct {
+    int vertex_num;
+    int total_weight;
+    int* offset;
+    int* index;
+    int* edge_weight;
+    int* vertex_weight;
+} PartitionGraph;
+
+/**
+ * GainHeap構造体
+ *
+ * 移動したときに切断される辺の重みが減る量(gain)を鍵とした最大ヒープ。
+ * position[v] はヒープ内の位置で、ヒープにない場合は -1。
+ */
+typedef struct {
+    int size;
+    int* vertex;
+    int* key;
+    int* position;
+} GainHeap;
+
+// メモリ確保、解放 ----------------------------------------------------------------------------
+static PartitionGraph* allocate_partition_graph(int vertex_num, int edge_num) {
+    PartitionGraph* graph = (PartitionGraph*)malloc(sizeof(PartitionGraph));
+    if (graph == NULL) {
+        fprintf(stderr, "Error: Memory allocation for PartitionGraph failed\n");
+        return NULL;
+    }
+    graph->vertex_num = vertex_num;
+    graph->total_weight = 0;
+    graph->offset = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    graph->index = (int*)malloc(((size_t)edge_num + 1) * sizeof(int));
+    graph->edge_weight = (int*)malloc(((size_t)edge_num + 1) * sizeof(int));
+    graph->vertex_weight = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    if (graph->offset == NULL || graph->index == NULL || graph->edge_weight == NULL || graph->vertex_weight == NULL) {
+        fprintf(stderr, "Error: Memory allocation for PartitionGraph members failed\n");
+        free(graph->offset);
+        free(graph->index);
+        free(graph->edge_weight);
+        free(graph->vertex_weight);
+        free(graph);
+        return NULL;
+    }
+    graph->offset[0] = 0;
+    return graph;
+}
+
+static void free_partition_graph(PartitionGraph* graph) {
+    if (graph == NULL) {
+        return;
+    }
+    free(graph->offset);
+    free(graph->index);
+    free(graph->edge_weight);
+    free(graph->vertex_weight);
+    free(graph);
+}
+
+static int initialize_gain_heap(GainHeap* heap, int vertex_num) {
+    heap->size = 0;
+    heap->vertex = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    heap->key = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    heap->position = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    if (heap->vertex == NULL || heap->key == NULL || heap->position == NULL) {
+        fprintf(stderr, "Error: Memory allocation for GainHeap failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int v = 0; v < vertex_num; v++) {
+        heap->position[v] = -1;
+    }
+    return EXIT_SUCCESS;
+}
+
+static void free_gain_heap(GainHeap* heap) {
+    free(heap->vertex);
+    free(heap->key);
+    free(heap->position);
+}
+
+// ヒープ ----------------------------------------------------------------------------
+static void heap_swap(GainHeap* heap, int i, int j) {
+    int v = heap->vertex[i];
+    int k = heap->key[i];
+    heap->vertex[i] = heap->vertex[j];
+    heap->key[i] = heap->key[j];
+    heap->vertex[j] = v;
+    heap->key[j] = k;
+    heap->position[heap->vertex[i]] = i;
+    heap->position[heap->vertex[j]] = j;
+}
+
+static void heap_sift(GainHeap* heap, int i) {
+    while (i > 0 && heap->key[(i - 1) / 2] < heap->key[i]) {
+        heap_swap(heap, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    for (;;) {
+        int largest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < heap->size && heap->key[left] > heap->key[largest]) largest = left;
+        if (right < heap->size && heap->key[right] > heap->key[largest]) largest = right;
+        if (largest == i) {
+            break;
+        }
+        heap_swap(heap, i, largest);
+        i = largest;
+    }
+}
+
+static void heap_set(GainHeap* heap, int v, int key) {
+    int i = heap->position[v];
+    if (i < 0) {
+        i = heap->size++;
+        heap->vertex[i] = v;
+        heap->position[v] = i;
+    }
+    heap->key[i] = key;
+    heap_sift(heap, i);
+}
+
+static void heap_remove(GainHeap* heap, int v) {
+    int i = heap->position[v];
+    if (i < 0) {
+        return;
+    }
+    heap->size--;
+    if (i != heap->size) {
+        heap_swap(heap, i, heap->size);
+        heap->position[v] = -1;
+        heap_sift(heap, i);
+    } else {
+        heap->position[v] = -1;
+    }
+}
+
+static void heap_clear(GainHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        heap->position[heap->vertex[i]] = -1;
+    }
+    heap->size = 0;
+}
+
+static unsigned int next_random(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+// グラフの作成 ----------------------------------------------------------------------------
+static int count_shared_nodes(const MeshModel* model, int a, int b) {
+    int count_a = element_node_count(model->element_kind[a]);
+    int count_b = element_node_count(model->element_kind[b]);
+    const int* node_a = &model->connectivity[a * ELEMENT_NODE_MAX];
+    const int* node_b = &model->connectivity[b * ELEMENT_NODE_MAX];
+    int shared = 0;
+    for (int i = 0; i < count_a; i++) {
+        for (int j = 0; j < count_b; j++) {
+            if (node_a[i] == node_b[j]) {
+                shared++;
+                break;
+            }
+        }
+    }
+    return shared;
+}
+
+/**
+ * 要素 -> 要素の隣接関係(2節点以上を共有)から重み付きのグラフを作成する
+ */
+static PartitionGraph* build_partition_graph(const MeshModel* model) {
+    CsrGraph* node_element = build_node_element_graph(model);
+    if (node_element == NULL) {
+        return NULL;
+    }
+    CsrGraph* element_graph = build_element_graph(model, node_element, 2);
+    free_csr_graph(node_element);
+    if (element_graph == NULL) {
+        return NULL;
+    }
+    int element_num = model->element_num;
+    PartitionGraph* graph = allocate_partition_graph(element_num, (int)element_graph->offset[element_num]);
+    if (graph != NULL) {
+        for (int e = 0; e < element_num; e++) {
+            graph->offset[e + 1] = (int)element_graph->offset[e + 1];
+            graph->vertex_weight[e] = 1;
+            for (uint32_t p = element_graph->offset[e]; p < element_graph->offset[e + 1]; p++) {
+                graph->index[p] = (int)element_graph->index[p];
+                graph->edge_weight[p] = count_shared_nodes(model, e, graph->index[p]);
+            }
+        }
+        graph->total_weight = element_num;
+    }
+    free_csr_graph(element_graph);
+    return graph;
+}
+
+/**
+ * side[v] == selected の頂点からなる部分グラフを作成する
+ *
+ * @param vertex_id 元のグラフの頂点の番号(要素の配列番号)
+ * @param sub_vertex_id 部分グラフの頂点の番号(要素の配列番号)の格納先
+ */
+static PartitionGraph* extract_partition_graph(const PartitionGraph* graph, const char side[], char selected,
+                                               const int vertex_id[], int sub_vertex_id[]) {
+    int* local = (int*)malloc(((size_t)graph->vertex_num + 1) * sizeof(int));
+    if (local == NULL) {
+        fprintf(stderr, "Error: Memory allocation for extract_partition_graph failed\n");
+        return NULL;
+    }
+    int vertex_num = 0;
+    int edge_num = 0;
+    for (int v = 0; v < graph->vertex_num; v++) {
+        local[v] = -1;
+        if (side[v] == selected) {
+            local[v] = vertex_num++;
+            edge_num += graph->offset[v + 1] - graph->offset[v];
+        }
+    }
+    PartitionGraph* sub = allocate_partition_graph(vertex_num, edge_num);
+    if (sub == NULL) {
+        free(local);
+        return NULL;
+    }
+    int edge = 0;
+    for (int v = 0; v < graph->vertex_num; v++) {
+        int u = local[v];
+        if (u < 0) {
+            continue;
+        }
+        sub_vertex_id[u] = vertex_id[v];
+        sub->vertex_weight[u] = graph->vertex_weight[v];
+        sub->total_weight += graph->vertex_weight[v];
+        for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+            if (local[graph->index[p]] >= 0) {
+                sub->index[edge] = local[graph->index[p]];
+                sub->edge_weight[edge] = graph->edge_weight[p];
+                edge++;
+            }
+        }
+        sub->offset[u + 1] = edge;
+    }
+    free(local);
+    return sub;
+}
+
+// 粗視化 ----------------------------------------------------------------------------
+/**
+ * 重い辺のマッチングで頂点を2個ずつまとめたグラフを作成する
+ *
+ * @param coarse_map 頂点 -> 粗いグラフの頂点の格納先
+ */
+static PartitionGraph* coarsen_partition_graph(const PartitionGraph* graph, int coarse_map[], unsigned int* seed) {
+    int vertex_num = graph->vertex_num;
+    int* match = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    int* visit = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    int* member = (int*)malloc(2 * ((size_t)vertex_num + 1) * sizeof(int));
+    if (match == NULL || visit == NULL || member == NULL) {
+        fprintf(stderr, "Error: Memory allocation for coarsen_partition_graph failed\n");
+        free(match);
+        free(visit);
+        free(member);
+        return NULL;
+    }
+
+    // 無作為な順に、まだ組になっていない隣接先のうち最も重い辺でつながるものと組にする
+    for (int v = 0; v < vertex_num; v++) {
+        match[v] = -1;
+        visit[v] = v;
+    }
+    for (int i = vertex_num - 1; i > 0; i--) {
+        int j = (int)(next_random(seed) % (unsigned int)(i + 1));
+        int t = visit[i];
+        visit[i] = visit[j];
+        visit[j] = t;
+    }
+    int max_vertex_weight = (int)(1.5 * graph->total_weight / MESH_PARTITION_COARSEN_LIMIT);
+    if (max_vertex_weight < 2) {
+        max_vertex_weight = 2;
+    }
+    for (int i = 0; i < vertex_num; i++) {
+        int v = visit[i];
+        if (match[v] >= 0) {
+            continue;
+        }
+        int best = -1;
+        int best_weight = -1;
+        for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+            int u = graph->index[p];
+            if (match[u] >= 0 || u == v || graph->vertex_weight[v] + graph->vertex_weight[u] > max_vertex_weight) {
+                continue;
+            }
+            if (graph->edge_weight[p] > best_weight) {
+                best = u;
+                best_weight = graph->edge_weight[p];
+            }
+        }
+        if (best >= 0) {
+            match[v] = best;
+            match[best] = v;
+        } else {
+            match[v] = v;
+        }
+    }
+
+    // 粗いグラフの頂点番号
+    int coarse_num = 0;
+    for (int v = 0; v < vertex_num; v++) {
+        coarse_map[v] = -1;
+    }
+    for (int v = 0; v < vertex_num; v++) {
+        if (coarse_map[v] >= 0) {
+            continue;
+        }
+        coarse_map[v] = coarse_num;
+        coarse_map[match[v]] = coarse_num;
+        member[2 * coarse_num] = v;
+        member[2 * coarse_num + 1] = match[v];
+        coarse_num++;
+    }
+    free(match);
+
+    PartitionGraph* coarse = allocate_partition_graph(coarse_num, graph->offset[vertex_num]);
+    if (coarse == NULL) {
+        free(visit);
+        free(member);
+        return NULL;
+    }
+    // 隣接先をまとめる(visit を書き込み位置の表に使う)
+    int* slot = visit;
+    for (int c = 0; c < coarse_num; c++) {
+        slot[c] = -1;
+    }
+    int edge = 0;
+    for (int c = 0; c < coarse_num; c++) {
+        int start = edge;
+        int v0 = member[2 * c];
+        int v1 = member[2 * c + 1];
+        coarse->vertex_weight[c] = graph->vertex_weight[v0] + (v1 != v0 ? graph->vertex_weight[v1] : 0);
+        for (int m = 0; m < 2; m++) {
+            int v = member[2 * c + m];
+            if (m == 1 && v == v0) {
+                break;
+            }
+            for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+                int cu = coarse_map[graph->index[p]];
+                if (cu == c) {
+                    continue;
+                }
+                if (slot[cu] >= start) {
+                    coarse->edge_weight[slot[cu]] += graph->edge_weight[p];
+                } else {
+                    slot[cu] = edge;
+                    coarse->index[edge] = cu;
+                    coarse->edge_weight[edge] = graph->edge_weight[p];
+                    edge++;
+                }
+            }
+        }
+        coarse->offset[c + 1] = edge;
+    }
+    coarse->total_weight = graph->total_weight;
+    free(visit);
+    free(member);
+    return coarse;
+}
+
+// 2分割 ----------------------------------------------------------------------------
+static int compute_cut(const PartitionGraph* graph, const char side[]) {
+    int cut = 0;
+    for (int v = 0; v < graph->vertex_num; v++) {
+        for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+            if (side[graph->index[p]] != side[v]) {
+                cut += graph->edge_weight[p];
+            }
+        }
+    }
+    return cut / 2;
+}
+
+static int overweight(const int weight[2], const int max_weight[2]) {
+    int over = 0;
+    for (int s = 0; s < 2; s++) {
+        if (weight[s] > max_weight[s]) over += weight[s] - max_weight[s];
+    }
+    return over;
+}
+
+/**
+ * 2分割の境界をFM法で改善する
+ *
+ * 移動で切断される辺の重みが最も減る頂点を、重みの上限を超えない範囲で1個ずつ移動し、
+ * (重みの超過, 切断される辺の重み) が最小になった時点まで戻す。
+ *
+ * @param max_weight 各側の重みの上限
+ */
+static int refine_bisection(const PartitionGraph* graph, char side[], const int max_weight[2]) {
+    int vertex_num = graph->vertex_num;
+    int* gain = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    int* moved = (int*)malloc(((size_t)vertex_num + 1) * sizeof(int));
+    char* locked = (char*)malloc(((size_t)vertex_num + 1) * sizeof(char));
+    GainHeap heap[2];
+    int heap_result = initialize_gain_heap(&heap[0], vertex_num);
+    heap_result |= initialize_gain_heap(&heap[1], vertex_num);
+    if (gain == NULL || moved == NULL || locked == NULL || heap_result != EXIT_SUCCESS) {
+        fprintf(stderr, "Error: Memory allocation for refine_bisection failed\n");
+        free(gain);
+        free(moved);
+        free(locked);
+        free_gain_heap(&heap[0]);
+        free_gain_heap(&heap[1]);
+        return EXIT_FAILURE;
+    }
+
+    int weight[2] = {0, 0};
+    for (int v = 0; v < vertex_num; v++) {
+        weight[(int)side[v]] += graph->vertex_weight[v];
+    }
+    int cut = compute_cut(graph, side);
+
+    for (int pass = 0; pass < MESH_PARTITION_REFINE_PASSES; pass++) {
+        for (int v = 0; v < vertex_num; v++) {
+            int external = 0;
+            int internal = 0;
+            for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+                if (side[graph->index[p]] != side[v]) external += graph->edge_weight[p];
+                else internal += graph->edge_weight[p];
+            }
+            gain[v] = external - internal;
+            locked[v] = 0;
+            // 重みが超過している側は全ての頂点、それ以外は境界の頂点を候補にする
+            if (external > 0 || weight[(int)side[v]] > max_weight[(int)side[v]]) {
+                heap_set(&heap[(int)side[v]], v, gain[v]);
+            }
+        }
+
+        int best_over = overweight(weight, max_weight);
+        int best_cut = cut;
+        int best_length = 0;
+        int length = 0;
+        int stall = 0;
+        while (stall < MESH_PARTITION_REFINE_STALL) {
+            // 移動元の側を選ぶ
+            int from = -1;
+            for (int s = 0; s < 2; s++) {
+                if (heap[s].size == 0) {
+                    continue;
+                }
+                int v = heap[s].vertex[0];
+                int allowed = weight[1 - s] + graph->vertex_weight[v] <= max_weight[1 - s] || weight[s] > max_weight[s];
+                if (!allowed) {
+                    continue;
+                }
+                if (from < 0 || weight[s] > max_weight[s] || (weight[from] <= max_weight[from] &&
+                    (heap[s].key[0] > heap[from].key[0] || (heap[s].key[0] == heap[from].key[0] && weight[s] > weight[from])))) {
+                    from = s;
+                }
+            }
+            if (from < 0) {
+                break;
+            }
+
+            int v = heap[from].vertex[0];
+            heap_remove(&heap[from], v);
+            locked[v] = 1;
+            side[v] = (char)(1 - from);
+            weight[from] -= graph->vertex_weight[v];
+            weight[1 - from] += graph->vertex_weight[v];
+            cut -= gain[v];
+            moved[length++] = v;
+            for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+                int u = graph->index[p];
+                if (locked[u]) {
+                    continue;
+                }
+                gain[u] += (side[u] == side[v]) ? -2 * graph->edge_weight[p] : 2 * graph->edge_weight[p];
+                heap_set(&heap[(int)side[u]], u, gain[u]);
+            }
+
+            int over = overweight(weight, max_weight);
+            if (over < best_over || (over == best_over && cut < best_cut)) {
+                best_over = over;
+                best_cut = cut;
+                best_length = length;
+                stall = 0;
+            } else {
+                stall++;
+            }
+        }
+
+        // 最良の時点まで戻す
+        for (int i = length - 1; i >= best_length; i--) {
+            int v = moved[i];
+            int to = side[v];
+            side[v] = (char)(1 - to);
+            weight[to] -= graph->vertex_weight[v];
+            weight[1 - to] += graph->vertex_weight[v];
+        }
+        cut = best_cut;
+        heap_clear(&heap[0]);
+        heap_clear(&heap[1]);
+        if (best_length == 0) {
+            break;
+        }
+    }
+
+    free(gain);
+    free(moved);
+    free(locked);
+    free_gain_heap(&heap[0]);
+    free_gain_heap(&heap[1]);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * seed から領域を広げ、側0の重みが target に達するまで頂点を加える
+ */
+static void grow_bisection(const PartitionGraph* graph, int seed_vertex, int target, char side[], GainHeap* heap) {
+    for (int v = 0; v < graph->vertex_num; v++) {
+        side[v] = 1;
+    }
+    int weight = 0;
+    int next = 0;
+    heap_set(heap, seed_vertex, 0);
+    while (weight < target) {
+        int v;
+        if (heap->size > 0) {
+            v = heap->vertex[0];
+            heap_remove(heap, v);
+        } else {
+            // 連結でない場合は次の未選択の頂点から広げる
+            while (next < graph->vertex_num && side[next] == 0) next++;
+            if (next >= graph->vertex_num) {
+                break;
+            }
+            v = next;
+        }
+        side[v] = 0;
+        weight += graph->vertex_weight[v];
+        for (int p = graph->offset[v]; p < graph->offset[v + 1]; p++) {
+            int u = graph->index[p];
+            if (side[u] == 0) {
+                continue;
+            }
+            int key = 0;
+            for (int q = graph->offset[u]; q < graph->offset[u + 1]; q++) {
+                key += (side[graph->index[q]] == 0) ? graph->edge_weight[q] : -graph->edge_weight[q];
+            }
+            heap_set(heap, u, key);
+        }
+    }
+    heap_clear(heap);
+}
+
+/**
+ * 重みの比が fraction : 1 - fraction になるようマルチレベル法で2分割する
+ *
+ * @param imbalance 許容する重みの超過(目標の重みに対する比)
+ * @param side 各頂点の側(0 または 1)の格納先
+ */
+static int multilevel_bisection(const PartitionGraph* graph, double fraction, double imbalance, char side[], unsigned int* seed) {
+    enum { LEVEL_MAX = 64 };
+    const PartitionGraph* level_graph[LEVEL_MAX];
+    int* coarse_map[LEVEL_MAX];
+    int level = 0;
+    int result = EXIT_SUCCESS;
+    level_graph[0] = graph;
+
+    // 粗視化
+    while (level + 1 < LEVEL_MAX && level_graph[level]->vertex_num > MESH_PARTITION_COARSEN_LIMIT) {
+        int* map = (int*)malloc(((size_t)level_graph[level]->vertex_num + 1) * sizeof(int));
+        PartitionGraph* coarse = (map != NULL) ? coarsen_partition_graph(level_graph[level], map, seed) : NULL;
+        if (coarse == NULL) {
+            free(map);
+            result = EXIT_FAILURE;
+            break;
+        }
+        if (coarse->vertex_num > 0.95 * level_graph[level]->vertex_num) {
+            // ほとんど縮まない場合はやめる
+            free(map);
+            free_partition_graph(coarse);
+            break;
+        }
+        coarse_map[level] = map;
+        level_graph[++level] = coarse;
+    }
+
+    char* level_side = NULL;
+    char* trial_side = NULL;
+    GainHeap heap;
+    heap.vertex = heap.key = heap.position = NULL;
+    int target[2];
+    target[0] = (int)(fraction * graph->total_weight + 0.5);
+    target[1] = graph->total_weight - target[0];
+    if (result == EXIT_SUCCESS) {
+        int coarse_num = level_graph[level]->vertex_num;
+        level_side = (char*)malloc(((size_t)coarse_num + 1) * sizeof(char));
+        trial_side = (char*)malloc(((size_t)coarse_num + 1) * sizeof(char));
+        if (level_side == NULL || trial_side == NULL || initialize_gain_heap(&heap, coarse_num) != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: Memory allocation for multilevel_bisection failed\n");
+            result = EXIT_FAILURE;
+        }
+    }
+
+    // 重みの上限(粗いグラフでは頂点が重いため、最大の頂点の重みまで許す)
+    int max_weight[2];
+    for (int l = level; l >= 0 && result == EXIT_SUCCESS; l--) {
+        const PartitionGraph* g = level_graph[l];
+        int heaviest = 0;
+        for (int v = 0; v < g->vertex_num; v++) {
+            if (g->vertex_weight[v] > heaviest) heaviest = g->vertex_weight[v];
+        }
+        for (int s = 0; s < 2; s++) {
+            int slack = (int)(imbalance * target[s]);
+            max_weight[s] = target[s] + (slack > heaviest ? slack : heaviest);
+        }
+
+        if (l == level) {
+            // 初期分割: 何個かの始点から領域を広げ、最良のものを選ぶ
+            int best_over = INT_MAX;
+            int best_cut = INT_MAX;
+            int trials = (g->vertex_num < MESH_PARTITION_INITIAL_TRIALS) ? g->vertex_num : MESH_PARTITION_INITIAL_TRIALS;
+            for (int t = 0; t < trials && result == EXIT_SUCCESS; t++) {
+                int seed_vertex = (int)(next_random(seed) % (unsigned int)g->vertex_num);
+                grow_bisection(g, seed_vertex, target[0], trial_side, &heap);
+                result = refine_bisection(g, trial_side, max_weight);
+                int weight[2] = {0, 0};
+                for (int v = 0; v < g->vertex_num; v++) {
+                    weight[(int)trial_side[v]] += g->vertex_weight[v];
+                }
+                int over = overweight(weight, max_weight);
+                int cut = compute_cut(g, trial_side);
+                if (over < best_over || (over == best_over && cut < best_cut)) {
+                    best_over = over;
+                    best_cut = cut;
+                    for (int v = 0; v < g->vertex_num; v++) level_side[v] = trial_side[v];
+                }
+            }
+        } else {
+            // 粗いグラフの分割を写して改善する
+            char* fine_side = (l == 0) ? side : (char*)malloc(((size_t)g->vertex_num + 1) * sizeof(char));
+            if (fine_side == NULL) {
+                fprintf(stderr, "Error: Memory allocation for multilevel_bisection failed\n");
+                result = EXIT_FAILURE;
+                break;
+            }
+            for (int v = 0; v < g->vertex_num; v++) {
+                fine_side[v] = level_side[coarse_map[l][v]];
+            }
+            free(level_side);
+            level_side = fine_side;
+            result = refine_bisection(g, level_side, max_weight);
+        }
+    }
+    if (result == EXIT_SUCCESS && level == 0) {
+        for (int v = 0; v < graph->vertex_num; v++) {
+            side[v] = level_side[v];
+        }
+    }
+
+    if (level_side != side) {
+        free(level_side);
+    }
+    free(trial_side);
+    free_gain_heap(&heap);
+    for (int l = 1; l <= level; l++) {
+        free_partition_graph((PartitionGraph*)level_graph[l]);
+    }
+    for (int l = 0; l < level; l++) {
+        free(coarse_map[l]);
+    }
+    return result;
+}
+
+/**
+ * 再帰2分割で part_num 個に分ける
+ *
+ * @param vertex_id 頂点の番号(要素の配列番号)
+ * @param first_part 最初の部分の番号
+ * @param imbalance 1回の2分割で許容する重みの超過
+ */
+static int partition_recursive(const PartitionGraph* graph, const int vertex_id[], int part_num, int first_part,
+                               double imbalance, int part[], unsigned int* seed) {
+    if (part_num <= 1 || graph->vertex_num <= 1) {
+        for (int v = 0; v < graph->vertex_num; v++) {
+            part[vertex_id[v]] = first_part;
+        }
+        return EXIT_SUCCESS;
+    }
+    int left = part_num / 2;
+    char* side = (char*)malloc(((size_t)graph->vertex_num + 1) * sizeof(char));
+    int* sub_vertex_id = (int*)malloc(((size_t)graph->vertex_num + 1) * sizeof(int));
+    if (side == NULL || sub_vertex_id == NULL) {
+        fprintf(stderr, "Error: Memory allocation for partition_recursive failed\n");
+        free(side);
+        free(sub_vertex_id);
+        return EXIT_FAILURE;
+    }
+    int result = multilevel_bisection(graph, (double)left / part_num, imbalance, side, seed);
+    for (int s = 0; s < 2 && result == EXIT_SUCCESS; s++) {
+        PartitionGraph* sub = extract_partition_graph(graph, side, (char)s, vertex_id, sub_vertex_id);
+        if (sub == NULL) {
+            result = EXIT_FAILURE;
+            break;
+        }
+        if (s == 0) {
+            result = partition_recursive(sub, sub_vertex_id, left, first_part, imbalance, part, seed);
+        } else {
+            result = partition_recursive(sub, sub_vertex_id, part_num - left, first_part + left, imbalance, part, seed);
+        }
+        free_partition_graph(sub);
+    }
+    free(side);
+    free(sub_vertex_id);
+    return result;
+}
+
+/**
+ * 要素を part_num 個に分割する
+ *
+ * @param part 要素の配列番号 -> 部分の番号(0 から part_num - 1)の格納先
+ */
+int partition_mesh_elements(const MeshModel* model, int part_num, int part[]) {
+    if (model == NULL || part == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to partition_mesh_elements\n");
+        return EXIT_FAILURE;
+    }
+    if (part_num < 1 || (model->element_num > 0 && part_num > model->element_num)) {
+        fprintf(stderr, "Error: Invalid part_num (%d) for %d elements\n", part_num, model->element_num);
+        return EXIT_FAILURE;
+    }
+    PartitionGraph* graph = build_partition_graph(model);
+    int* vertex_id = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+    if (graph == NULL || vertex_id == NULL) {
+        free_partition_graph(graph);
+        free(vertex_id);
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        vertex_id[e] = e;
+    }
+    int depth = 0;
+    while ((1 << depth) < part_num) depth++;
+    double imbalance = (depth > 0) ? pow(1.0 + MESH_PARTITION_IMBALANCE, 1.0 / depth) - 1.0 : MESH_PARTITION_IMBALANCE;
+    unsigned int seed = 1;
+    int result = partition_recursive(graph, vertex_id, part_num, 0, imbalance, part, &seed);
+    free_partition_graph(graph);
+    free(vertex_id);
+    return result;
+}
+
+/**
+ * 分割の切断数、境界の節点数、要素数の偏りを求める
+ */
+int compute_partition_statistics(const MeshModel* model, int part_num, const int part[], PartitionStatistics* statistics) {
+    statistics->part_num = part_num;
+    statistics->edge_cut = 0;
+    statistics->interface_node_num = 0;
+    statistics->min_part_size = 0;
+    statistics->max_part_size = 0;
+    statistics->imbalance = 0.0;
+
+    CsrGraph* node_element = build_node_element_graph(model);
+    if (node_element == NULL) {
+        return EXIT_FAILURE;
+    }
+    CsrGraph* element_graph = build_element_graph(model, node_element, 2);
+    int* size = (int*)calloc((size_t)part_num + 1, sizeof(int));
+    if (element_graph == NULL || size == NULL) {
+        free_csr_graph(node_element);
+        free_csr_graph(element_graph);
+        free(size);
+        return EXIT_FAILURE;
+    }
+
+    for (int e = 0; e < model->element_num; e++) {
+        size[part[e]]++;
+        for (uint32_t p = element_graph->offset[e]; p < element_graph->offset[e + 1]; p++) {
+            if ((int)element_graph->index[p] > e && part[element_graph->index[p]] != part[e]) {
+                statistics->edge_cut++;
+            }
+        }
+    }
+    for (int n = 0; n < node_element->row_num; n++) {
+        for (uint32_t p = node_element->offset[n] + 1; p < node_element->offset[n + 1]; p++) {
+            if (part[node_element->index[p]] != part[node_element->index[node_element->offset[n]]]) {
+                statistics->interface_node_num++;
+                break;
+            }
+        }
+    }
+    statistics->min_part_size = size[0];
+    for (int k = 0; k < part_num; k++) {
+        if (size[k] < statistics->min_part_size) statistics->min_part_size = size[k];
+        if (size[k] > statistics->max_part_size) statistics->max_part_size = size[k];
+    }
+    if (model->element_num > 0) {
+        statistics->imbalance = (double)statistics->max_part_size * part_num / model->element_num;
+    }
+
+    free_csr_graph(node_element);
+    free_csr_graph(element_graph);
+    free(size);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素番号 -> 部分の番号(0 から)をCSVで書き込む
+ */
+int write_element_partition(const char* file_name, const MeshModel* model, const int part[]) {
+    FILE* f = fopen(file_name, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return EXIT_FAILURE;
+    }
+    fprintf(f, "element_id,part\n");
+    for (int id = 1; id < model->element_index_size; id++) {
+        int e = model->element_index[id];
+        if (e >= 0) {
+            fprintf(f, "%d,%d\n", id, part[e]);
+        }
+    }
+    fclose(f);
+    return EXIT_SUCCESS;
+}
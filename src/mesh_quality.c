@@ -0,0 +1,526 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "mesh_quality.h"
+#include "simd.h"
+
+/**
+ * HEXA、QUAD要素の形状チェック
+ *
+ * 要素の節点座標を MESH_QUALITY_BLOCK 個ずつSoA形式の作業配列に集め、
+ * simd.h の関数で SIMD_WIDTH 個の要素を同時に計算する。
+ * 作業配列の端数はブロック内の最後の要素で埋めて計算し、結果は捨てる。
+ */
+
+// 0除算防止用
+#define MESH_QUALITY_TINY 1.0e-300
+
+// タイプ番号の上限(%3d)
+#define MESH_QUALITY_TYPE_MAX 1000
+
+// ヒストグラムの区間の境界
+static const double aspect_bin_edge[MESH_QUALITY_BIN_NUM - 1] = {2.0, 3.0, 5.0, 10.0};
+static const double skew_bin_edge[MESH_QUALITY_BIN_NUM - 1] = {0.1, 0.25, 0.5, 0.75};
+
+// HEXAの角点と隣接する3節点(右手系)
+static const int hexa_corner[8][4] = {
+    {0, 1, 3, 4}, {1, 2, 0, 5}, {2, 3, 1, 6}, {3, 0, 2, 7},
+    {4, 7, 5, 0}, {5, 4, 6, 1}, {6, 5, 7, 2}, {7, 6, 4, 3}
+};
+
+// HEXAの辺
+static const int hexa_edge[12][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0},
+    {4, 5}, {5, 6}, {6, 7}, {7, 4},
+    {0, 4}, {1, 5}, {2, 6}, {3, 7}
+};
+
+// HEXAの各節点の自然座標(ξ, η, ζ)の符号
+static const double hexa_sign[8][3] = {
+    {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1},
+    {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}
+};
+
+// 作業配列
+typedef struct {
+    double x[ELEMENT_NODE_MAX][MESH_QUALITY_BLOCK];
+    double y[ELEMENT_NODE_MAX][MESH_QUALITY_BLOCK];
+    double z[ELEMENT_NODE_MAX][MESH_QUALITY_BLOCK];
+    int element[MESH_QUALITY_BLOCK];
+    double volume[MESH_QUALITY_BLOCK];
+    double min_jacobian[MESH_QUALITY_BLOCK];
+    double scaled_jacobian[MESH_QUALITY_BLOCK];
+    double aspect_ratio[MESH_QUALITY_BLOCK];
+    double skew[MESH_QUALITY_BLOCK];
+} QualityBlock;
+
+// メモリ確保、解放 ----------------------------------------------------------------------------
+MeshQuality* create_mesh_quality(int element_num) {
+    if (element_num < 0) {
+        fprintf(stderr, "Error: Invalid element_num (%d)\n", element_num);
+        return NULL;
+    }
+    MeshQuality* quality = (MeshQuality*)malloc(sizeof(MeshQuality));
+    if (quality == NULL) {
+        fprintf(stderr, "Error: Memory allocation for MeshQuality failed\n");
+        return NULL;
+    }
+    int size = (element_num > 0) ? element_num : 1;
+    quality->element_num = element_num;
+    quality->evaluated = (char*)calloc(size, sizeof(char));
+    quality->volume = (double*)calloc(size, sizeof(double));
+    quality->min_jacobian = (double*)calloc(size, sizeof(double));
+    quality->scaled_jacobian = (double*)calloc(size, sizeof(double));
+    quality->aspect_ratio = (double*)calloc(size, sizeof(double));
+    quality->skew = (double*)calloc(size, sizeof(double));
+    if (quality->evaluated == NULL || quality->volume == NULL || quality->min_jacobian == NULL ||
+        quality->scaled_jacobian == NULL || quality->aspect_ratio == NULL || quality->skew == NULL) {
+        fprintf(stderr, "Error: Memory allocation for MeshQuality arrays failed\n");
+        free_mesh_quality(quality);
+        return NULL;
+    }
+    return quality;
+}
+
+int free_mesh_quality(MeshQuality* quality) {
+    if (quality == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to free_mesh_quality\n");
+        return EXIT_FAILURE;
+    }
+    free(quality->evaluated);
+    quality->evaluated = NULL;
+    free(quality->volume);
+    quality->volume = NULL;
+    free(quality->min_jacobian);
+    quality->min_jacobian = NULL;
+    free(quality->scaled_jacobian);
+    quality->scaled_jacobian = NULL;
+    free(quality->aspect_ratio);
+    quality->aspect_ratio = NULL;
+    free(quality->skew);
+    quality->skew = NULL;
+    free(quality);
+    return EXIT_SUCCESS;
+}
+
+// 計算カーネル ----------------------------------------------------------------------------
+/**
+ * 単位ベクトルにする。長さ0の場合は0ベクトルのまま。
+ */
+static inline simd_vec3 simd_vec3_normalize(simd_vec3 a) {
+    simd_double length = simd_max(simd_sqrt(simd_vec3_dot(a, a)), simd_set1(MESH_QUALITY_TINY));
+    return simd_vec3_scale(a, simd_div(simd_set1(1.0), length));
+}
+
+/**
+ * HEXA要素 SIMD_WIDTH 個分を計算する
+ *
+ * 体積は3重線形写像のヤコビアンを2x2x2点のガウス積分で求める。
+ * ゆがみは要素の主軸(ξ, η, ζ方向の平均ベクトル)同士のなす角の余弦の最大値とする。
+ */
+static void hexa_quality_kernel(QualityBlock* block, int i) {
+    simd_vec3 p[8];
+    for (int n = 0; n < 8; n++) {
+        p[n] = simd_vec3_load(&block->x[n][i], &block->y[n][i], &block->z[n][i]);
+    }
+
+    // 角点ヤコビアン
+    simd_double min_jacobian = simd_set1(INFINITY);
+    simd_double scaled_jacobian = simd_set1(INFINITY);
+    for (int c = 0; c < 8; c++) {
+        simd_vec3 a = simd_vec3_sub(p[hexa_corner[c][1]], p[hexa_corner[c][0]]);
+        simd_vec3 b = simd_vec3_sub(p[hexa_corner[c][2]], p[hexa_corner[c][0]]);
+        simd_vec3 d = simd_vec3_sub(p[hexa_corner[c][3]], p[hexa_corner[c][0]]);
+        simd_double det = simd_vec3_triple(a, b, d);
+        simd_double length = simd_sqrt(simd_mul(simd_mul(simd_vec3_dot(a, a), simd_vec3_dot(b, b)), simd_vec3_dot(d, d)));
+        min_jacobian = simd_min(min_jacobian, det);
+        scaled_jacobian = simd_min(scaled_jacobian, simd_div(det, simd_max(length, simd_set1(MESH_QUALITY_TINY))));
+    }
+
+    // 3重線形写像の係数 x = e0 + e1 ξ + e2 η + e3 ζ + e12 ξη + e23 ηζ + e31 ζξ + e123 ξηζ
+    simd_vec3 zero = {simd_set1(0.0), simd_set1(0.0), simd_set1(0.0)};
+    simd_vec3 e1 = zero, e2 = zero, e3 = zero, e12 = zero, e23 = zero, e31 = zero, e123 = zero;
+    for (int n = 0; n < 8; n++) {
+        const double* s = hexa_sign[n];
+        e1 = (s[0] > 0) ? simd_vec3_add(e1, p[n]) : simd_vec3_sub(e1, p[n]);
+        e2 = (s[1] > 0) ? simd_vec3_add(e2, p[n]) : simd_vec3_sub(e2, p[n]);
+        e3 = (s[2] > 0) ? simd_vec3_add(e3, p[n]) : simd_vec3_sub(e3, p[n]);
+        e12 = (s[0] * s[1] > 0) ? simd_vec3_add(e12, p[n]) : simd_vec3_sub(e12, p[n]);
+        e23 = (s[1] * s[2] > 0) ? simd_vec3_add(e23, p[n]) : simd_vec3_sub(e23, p[n]);
+        e31 = (s[2] * s[0] > 0) ? simd_vec3_add(e31, p[n]) : simd_vec3_sub(e31, p[n]);
+        e123 = (s[0] * s[1] * s[2] > 0) ? simd_vec3_add(e123, p[n]) : simd_vec3_sub(e123, p[n]);
+    }
+    simd_double eighth = simd_set1(0.125);
+    e1 = simd_vec3_scale(e1, eighth);
+    e2 = simd_vec3_scale(e2, eighth);
+    e3 = simd_vec3_scale(e3, eighth);
+    e12 = simd_vec3_scale(e12, eighth);
+    e23 = simd_vec3_scale(e23, eighth);
+    e31 = simd_vec3_scale(e31, eighth);
+    e123 = simd_vec3_scale(e123, eighth);
+
+    // 体積 - 2x2x2点ガウス積分(重み1)
+    const double g = 1.0 / sqrt(3.0);
+    simd_double volume = simd_set1(0.0);
+    for (int n = 0; n < 8; n++) {
+        simd_double xi = simd_set1(hexa_sign[n][0] * g);
+        simd_double eta = simd_set1(hexa_sign[n][1] * g);
+        simd_double zeta = simd_set1(hexa_sign[n][2] * g);
+        simd_vec3 d_xi = simd_vec3_add(simd_vec3_add(e1, simd_vec3_scale(e12, eta)), simd_vec3_add(simd_vec3_scale(e31, zeta), simd_vec3_scale(e123, simd_mul(eta, zeta))));
+        simd_vec3 d_eta = simd_vec3_add(simd_vec3_add(e2, simd_vec3_scale(e12, xi)), simd_vec3_add(simd_vec3_scale(e23, zeta), simd_vec3_scale(e123, simd_mul(xi, zeta))));
+        simd_vec3 d_zeta = simd_vec3_add(simd_vec3_add(e3, simd_vec3_scale(e23, eta)), simd_vec3_add(simd_vec3_scale(e31, xi), simd_vec3_scale(e123, simd_mul(xi, eta))));
+        volume = simd_add(volume, simd_vec3_triple(d_xi, d_eta, d_zeta));
+    }
+
+    // 辺長比
+    simd_double min_edge = simd_set1(INFINITY);
+    simd_double max_edge = simd_set1(0.0);
+    for (int e = 0; e < 12; e++) {
+        simd_vec3 a = simd_vec3_sub(p[hexa_edge[e][1]], p[hexa_edge[e][0]]);
+        simd_double length2 = simd_vec3_dot(a, a);
+        min_edge = simd_min(min_edge, length2);
+        max_edge = simd_max(max_edge, length2);
+    }
+    simd_double aspect = simd_sqrt(simd_div(max_edge, simd_max(min_edge, simd_set1(MESH_QUALITY_TINY))));
+
+    // ゆがみ
+    simd_vec3 axis1 = simd_vec3_normalize(e1);
+    simd_vec3 axis2 = simd_vec3_normalize(e2);
+    simd_vec3 axis3 = simd_vec3_normalize(e3);
+    simd_double skew = simd_max(simd_abs(simd_vec3_dot(axis1, axis2)),
+                                simd_max(simd_abs(simd_vec3_dot(axis1, axis3)), simd_abs(simd_vec3_dot(axis2, axis3))));
+
+    simd_store(&block->volume[i], volume);
+    simd_store(&block->min_jacobian[i], min_jacobian);
+    simd_store(&block->scaled_jacobian[i], scaled_jacobian);
+    simd_store(&block->aspect_ratio[i], aspect);
+    simd_store(&block->skew[i], skew);
+}
+
+/**
+ * QUAD要素 SIMD_WIDTH 個分を計算する
+ *
+ * 角点ヤコビアンは対角線の外積から求めた要素の平均法線方向の成分とする。
+ */
+static void quad_quality_kernel(QualityBlock* block, int i) {
+    simd_vec3 p[4];
+    for (int n = 0; n < 4; n++) {
+        p[n] = simd_vec3_load(&block->x[n][i], &block->y[n][i], &block->z[n][i]);
+    }
+
+    // 面積、法線
+    simd_vec3 normal = simd_vec3_cross(simd_vec3_sub(p[2], p[0]), simd_vec3_sub(p[3], p[1]));
+    simd_double normal_length = simd_sqrt(simd_vec3_dot(normal, normal));
+    simd_double area = simd_mul(simd_set1(0.5), normal_length);
+    normal = simd_vec3_scale(normal, simd_div(simd_set1(1.0), simd_max(normal_length, simd_set1(MESH_QUALITY_TINY))));
+
+    // 角点ヤコビアン、辺長比
+    simd_double min_jacobian = simd_set1(INFINITY);
+    simd_double scaled_jacobian = simd_set1(INFINITY);
+    simd_double min_edge = simd_set1(INFINITY);
+    simd_double max_edge = simd_set1(0.0);
+    for (int c = 0; c < 4; c++) {
+        simd_vec3 a = simd_vec3_sub(p[(c + 1) % 4], p[c]);
+        simd_vec3 b = simd_vec3_sub(p[(c + 3) % 4], p[c]);
+        simd_double det = simd_vec3_triple(a, b, normal);
+        simd_double a2 = simd_vec3_dot(a, a);
+        simd_double length = simd_sqrt(simd_mul(a2, simd_vec3_dot(b, b)));
+        min_jacobian = simd_min(min_jacobian, det);
+        scaled_jacobian = simd_min(scaled_jacobian, simd_div(det, simd_max(length, simd_set1(MESH_QUALITY_TINY))));
+        min_edge = simd_min(min_edge, a2);
+        max_edge = simd_max(max_edge, a2);
+    }
+    simd_double aspect = simd_sqrt(simd_div(max_edge, simd_max(min_edge, simd_set1(MESH_QUALITY_TINY))));
+
+    // ゆがみ
+    simd_vec3 axis1 = simd_vec3_normalize(simd_vec3_add(simd_vec3_sub(p[1], p[0]), simd_vec3_sub(p[2], p[3])));
+    simd_vec3 axis2 = simd_vec3_normalize(simd_vec3_add(simd_vec3_sub(p[3], p[0]), simd_vec3_sub(p[2], p[1])));
+    simd_double skew = simd_abs(simd_vec3_dot(axis1, axis2));
+
+    simd_store(&block->volume[i], area);
+    simd_store(&block->min_jacobian[i], min_jacobian);
+    simd_store(&block->scaled_jacobian[i], scaled_jacobian);
+    simd_store(&block->aspect_ratio[i], aspect);
+    simd_store(&block->skew[i], skew);
+}
+
+/**
+ * 作業配列に集めた要素を計算し、結果をMeshQualityに書き戻す
+ */
+static void flush_quality_block(QualityBlock* block, int count, ElementKind kind, MeshQuality* quality) {
+    if (count == 0) {
+        return;
+    }
+    // 端数は最後の要素で埋める
+    int padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    for (int j = count; j < padded; j++) {
+        for (int n = 0; n < ELEMENT_NODE_MAX; n++) {
+            block->x[n][j] = block->x[n][count - 1];
+            block->y[n][j] = block->y[n][count - 1];
+            block->z[n][j] = block->z[n][count - 1];
+        }
+    }
+
+    for (int i = 0; i < padded; i += SIMD_WIDTH) {
+        if (kind == ELEMENT_HEXA) {
+            hexa_quality_kernel(block, i);
+        } else {
+            quad_quality_kernel(block, i);
+        }
+    }
+
+    for (int j = 0; j < count; j++) {
+        int e = block->element[j];
+        quality->evaluated[e] = 1;
+        quality->volume[e] = block->volume[j];
+        quality->min_jacobian[e] = block->min_jacobian[j];
+        quality->scaled_jacobian[e] = block->scaled_jacobian[j];
+        quality->aspect_ratio[e] = block->aspect_ratio[j];
+        quality->skew[e] = block->skew[j];
+    }
+}
+
+/**
+ * 全てのHEXA、QUAD要素の形状指標を計算する。
+ * 節点が見つからない要素は計算しない(evaluated = 0)。
+ *
+ * @param model 対象のモデル
+ * @param quality 結果の格納先(create_mesh_quality(model->element_num)で作成したもの)
+ */
+int compute_mesh_quality(const MeshModel* model, MeshQuality* quality) {
+    if (model == NULL || quality == NULL || quality->element_num < model->element_num) {
+        fprintf(stderr, "Error: Invalid argument passed to compute_mesh_quality\n");
+        return EXIT_FAILURE;
+    }
+
+    QualityBlock* block = (QualityBlock*)malloc(sizeof(QualityBlock));
+    if (block == NULL) {
+        fprintf(stderr, "Error: Memory allocation for QualityBlock failed\n");
+        return EXIT_FAILURE;
+    }
+
+    const ElementKind kinds[2] = {ELEMENT_HEXA, ELEMENT_QUAD};
+    for (int k = 0; k < 2; k++) {
+        ElementKind kind = kinds[k];
+        int node_count = element_node_count(kind);
+        int count = 0;
+        for (int e = 0; e < model->element_num; e++) {
+            quality->evaluated[e] = (model->element_kind[e] == kind) ? 0 : quality->evaluated[e];
+            if (model->element_kind[e] != kind) {
+                continue;
+            }
+
+            // 座標を作業配列に集める
+            const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+            int missing = 0;
+            for (int n = 0; n < node_count; n++) {
+                int index = find_mesh_node(model, node[n]);
+                if (index < 0) {
+                    missing = 1;
+                    break;
+                }
+                block->x[n][count] = model->x[index];
+                block->y[n][count] = model->y[index];
+                block->z[n][count] = model->z[index];
+            }
+            if (missing) {
+                continue;
+            }
+            for (int n = node_count; n < ELEMENT_NODE_MAX; n++) {
+                block->x[n][count] = 0.0;
+                block->y[n][count] = 0.0;
+                block->z[n][count] = 0.0;
+            }
+            block->element[count] = e;
+            count++;
+
+            if (count == MESH_QUALITY_BLOCK) {
+                flush_quality_block(block, count, kind, quality);
+                count = 0;
+            }
+        }
+        flush_quality_block(block, count, kind, quality);
+    }
+
+    free(block);
+    return EXIT_SUCCESS;
+}
+
+// 集計、表示 ----------------------------------------------------------------------------
+// タイプ番号ごとの集計
+typedef struct {
+    int count;
+    int inverted;
+    int aspect_warning;
+    int scaled_jacobian_warning;
+    int skew_warning;
+    double volume_min;
+    double volume_max;
+    double volume_sum;
+    double min_jacobian;
+    double min_scaled_jacobian;
+    double max_aspect_ratio;
+    double max_skew;
+    int aspect_histogram[MESH_QUALITY_BIN_NUM];
+    int skew_histogram[MESH_QUALITY_BIN_NUM];
+} QualityGroup;
+
+static int find_bin(const double edge[], double value) {
+    int bin = 0;
+    while (bin < MESH_QUALITY_BIN_NUM - 1 && value >= edge[bin]) {
+        bin++;
+    }
+    return bin;
+}
+
+static void print_histogram(const char* name, const double edge[], const int histogram[], double lower) {
+    print_indent_mm(2);
+    printf("\"%s\": {", name);
+    for (int b = 0; b < MESH_QUALITY_BIN_NUM; b++) {
+        double from = (b == 0) ? lower : edge[b - 1];
+        if (b < MESH_QUALITY_BIN_NUM - 1) {
+            printf("\"[%.2f,%.2f)\": %d, ", from, edge[b], histogram[b]);
+        } else {
+            printf("\"[%.2f,-)\": %d", from, histogram[b]);
+        }
+    }
+    printf("}");
+}
+
+/**
+ * HEXAはTYPH、QUADはTYPQごとに形状指標を集計し、ヒストグラムと警告を表示する。
+ *
+ * @return 裏返った要素(ヤコビアンが0以下)がある場合は EXIT_FAILURE
+ */
+int print_mesh_quality_summary(const MeshModel* model, const MeshQuality* quality) {
+    if (model == NULL || quality == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to print_mesh_quality_summary\n");
+        return EXIT_FAILURE;
+    }
+
+    QualityGroup* group = (QualityGroup*)calloc(2 * MESH_QUALITY_TYPE_MAX, sizeof(QualityGroup));
+    if (group == NULL) {
+        fprintf(stderr, "Error: Memory allocation for QualityGroup failed\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int e = 0; e < model->element_num; e++) {
+        if (!quality->evaluated[e]) {
+            continue;
+        }
+        int type = model->element_type[e];
+        if (type < 0 || type >= MESH_QUALITY_TYPE_MAX) {
+            continue;
+        }
+        QualityGroup* g = &group[(model->element_kind[e] == ELEMENT_HEXA ? 0 : MESH_QUALITY_TYPE_MAX) + type];
+        if (g->count == 0) {
+            g->volume_min = quality->volume[e];
+            g->volume_max = quality->volume[e];
+            g->min_jacobian = quality->min_jacobian[e];
+            g->min_scaled_jacobian = quality->scaled_jacobian[e];
+        }
+        g->count++;
+        g->volume_sum += quality->volume[e];
+        g->volume_min = fmin(g->volume_min, quality->volume[e]);
+        g->volume_max = fmax(g->volume_max, quality->volume[e]);
+        g->min_jacobian = fmin(g->min_jacobian, quality->min_jacobian[e]);
+        g->min_scaled_jacobian = fmin(g->min_scaled_jacobian, quality->scaled_jacobian[e]);
+        g->max_aspect_ratio = fmax(g->max_aspect_ratio, quality->aspect_ratio[e]);
+        g->max_skew = fmax(g->max_skew, quality->skew[e]);
+        g->aspect_histogram[find_bin(aspect_bin_edge, quality->aspect_ratio[e])]++;
+        g->skew_histogram[find_bin(skew_bin_edge, quality->skew[e])]++;
+        if (quality->min_jacobian[e] <= 0.0) g->inverted++;
+        if (quality->aspect_ratio[e] >= MESH_QUALITY_ASPECT_WARNING) g->aspect_warning++;
+        if (quality->scaled_jacobian[e] < MESH_QUALITY_SCALED_JACOBIAN_WARNING) g->scaled_jacobian_warning++;
+        if (quality->skew[e] >= MESH_QUALITY_SKEW_WARNING) g->skew_warning++;
+    }
+
+    printf("\n-------------------------------- mesh_quality --------------------------------\n");
+    printf("{\n");
+    int inverted = 0;
+    for (int k = 0; k < 2; k++) {
+        const char* name = (k == 0) ? "HEXA TYPH" : "QUAD TYPQ";
+        const char* size_name = (k == 0) ? "volume" : "area";
+        for (int type = 0; type < MESH_QUALITY_TYPE_MAX; type++) {
+            QualityGroup* g = &group[k * MESH_QUALITY_TYPE_MAX + type];
+            if (g->count == 0) {
+                continue;
+            }
+            inverted += g->inverted;
+            print_indent_mm(1);
+            printf("\"%s(%3d)\": {\n", name, type);
+            print_indent_mm(2);
+            printf("\"count\": %d, \"%s\": { \"min\": %.4g, \"max\": %.4g, \"sum\": %.6g },\n", g->count, size_name, g->volume_min, g->volume_max, g->volume_sum);
+            print_indent_mm(2);
+            printf("\"min_jacobian\": %.4g, \"min_scaled_jacobian\": %.4f, \"max_aspect_ratio\": %.3f, \"max_skew\": %.4f,\n",
+                g->min_jacobian, g->min_scaled_jacobian, g->max_aspect_ratio, g->max_skew);
+            print_histogram("aspect_ratio", aspect_bin_edge, g->aspect_histogram, 1.0);
+            printf(",\n");
+            print_histogram("skew", skew_bin_edge, g->skew_histogram, 0.0);
+            printf("\n");
+            print_indent_mm(1);
+            printf("},\n");
+        }
+    }
+    printf("}\n");
+
+    // 警告
+    for (int k = 0; k < 2; k++) {
+        const char* name = (k == 0) ? "HEXA TYPH" : "QUAD TYPQ";
+        for (int type = 0; type < MESH_QUALITY_TYPE_MAX; type++) {
+            QualityGroup* g = &group[k * MESH_QUALITY_TYPE_MAX + type];
+            if (g->inverted > 0) {
+                printf("Warning: %s(%3d) %d elements have non-positive jacobian\n", name, type, g->inverted);
+            }
+            if (g->aspect_warning > 0) {
+                printf("Warning: %s(%3d) %d elements have aspect ratio >= %.1f\n", name, type, g->aspect_warning, MESH_QUALITY_ASPECT_WARNING);
+            }
+            if (g->scaled_jacobian_warning > 0) {
+                printf("Warning: %s(%3d) %d elements have scaled jacobian < %.2f\n", name, type, g->scaled_jacobian_warning, MESH_QUALITY_SCALED_JACOBIAN_WARNING);
+            }
+            if (g->skew_warning > 0) {
+                printf("Warning: %s(%3d) %d elements have skew >= %.2f\n", name, type, g->skew_warning, MESH_QUALITY_SKEW_WARNING);
+            }
+        }
+    }
+
+    free(group);
+    return (inverted > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * .ffiを読み込み、HEXA、QUAD要素の形状チェックの結果を表示する。
+ *
+ * @param file_name 対象の.ffi
+ * @return 読み込みに失敗した場合、裏返った要素がある場合は EXIT_FAILURE
+ */
+int check_mesh_quality(const char* file_name) {
+    MeshModel* model = create_mesh_model();
+    if (model == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (read_mesh_model(file_name, model) != MESH_MODEL_SUCCESS) {
+        fprintf(stderr, "Failed to read %s\n", file_name);
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+
+    MeshQuality* quality = create_mesh_quality(model->element_num);
+    if (quality == NULL) {
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+
+    clock_t start = clock();
+    int result = compute_mesh_quality(model, quality);
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+    if (result == EXIT_SUCCESS) {
+        result = print_mesh_quality_summary(model, quality);
+        printf("mesh_quality: %d nodes, %d elements, SIMD_WIDTH %d, %.3f ms\n", model->node_num, model->element_num, SIMD_WIDTH, elapsed);
+    }
+
+    free_mesh_quality(quality);
+    free_mesh_model(model);
+    return result;
+}
@@ -0,0 +1,689 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "mesh_renumber.h"
+
+/**
+ * 節点番号の付け替え(Reverse Cuthill-McKee)
+ *
+ * 節点 -> 節点の隣接関係(同じ要素、同じSUB1に含まれる節点)から、連結成分ごとに
+ * 擬似周辺節点を始点とした幅優先探索で並べ、最後に全体を逆順にする。
+ * 付け替え後の番号は 1 から詰めて付ける。
+ *
+ * 要素番号の付け替え
+ *
+ * 要素を含む節点の最小、最大の番号順に並べ、フロント(組み立て中の節点)が
+ * 試験体を一方向に掃くようにする。節点番号をRCMで付け替えた後に使う。
+ */
+
+// 隣接関係 ----------------------------------------------------------------------------
+/**
+ * 節点 -> 節点の隣接関係に、SUB1の従属節点 <-> 主節点を加えたものを作成する。
+ */
+CsrGraph* build_renumber_graph(const MeshModel* model) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_renumber_graph\n");
+        return NULL;
+    }
+    CsrGraph* node_element = build_node_element_graph(model);
+    if (node_element == NULL) {
+        return NULL;
+    }
+    CsrGraph* node_graph = build_node_graph(model, node_element);
+    free_csr_graph(node_element);
+    if (node_graph == NULL || model->constraint_num == 0) {
+        return node_graph;
+    }
+
+    // SUB1の分を数える
+    int node_num = model->node_num;
+    uint32_t* count = (uint32_t*)calloc((size_t)node_num + 1, sizeof(uint32_t));
+    if (count == NULL) {
+        fprintf(stderr, "Error: Memory allocation for count failed\n");
+        free_csr_graph(node_graph);
+        return NULL;
+    }
+    for (int n = 0; n < node_num; n++) {
+        count[n] = node_graph->offset[n + 1] - node_graph->offset[n];
+    }
+    for (int c = 0; c < model->constraint_num; c++) {
+        int slave = find_mesh_node(model, model->constraint[c].node);
+        int master = find_mesh_node(model, model->constraint[c].master);
+        if (slave < 0 || master < 0 || slave == master) {
+            continue;
+        }
+        count[slave]++;
+        count[master]++;
+    }
+    uint32_t nnz = 0;
+    for (int n = 0; n < node_num; n++) {
+        nnz += count[n];
+    }
+    CsrGraph* graph = allocate_csr_graph(node_num, node_num, nnz);
+    if (graph == NULL) {
+        free(count);
+        free_csr_graph(node_graph);
+        return NULL;
+    }
+
+    // 書き込み
+    uint32_t sum = 0;
+    for (int n = 0; n < node_num; n++) {
+        graph->offset[n] = sum;
+        sum += count[n];
+        uint32_t length = node_graph->offset[n + 1] - node_graph->offset[n];
+        for (uint32_t p = 0; p < length; p++) {
+            graph->index[graph->offset[n] + p] = node_graph->index[node_graph->offset[n] + p];
+        }
+        count[n] = graph->offset[n] + length;
+    }
+    graph->offset[node_num] = sum;
+    for (int c = 0; c < model->constraint_num; c++) {
+        int slave = find_mesh_node(model, model->constraint[c].node);
+        int master = find_mesh_node(model, model->constraint[c].master);
+        if (slave < 0 || master < 0 || slave == master) {
+            continue;
+        }
+        graph->index[count[slave]++] = (uint32_t)master;
+        graph->index[count[master]++] = (uint32_t)slave;
+    }
+    free(count);
+    free_csr_graph(node_graph);
+
+    // 行ごとに整列して重複を取り除き、詰める
+    uint32_t write = 0;
+    for (int n = 0; n < node_num; n++) {
+        uint32_t from = graph->offset[n];
+        uint32_t to = graph->offset[n + 1];
+        for (uint32_t i = from + 1; i < to; i++) {
+            uint32_t value = graph->index[i];
+            uint32_t j = i;
+            while (j > from && graph->index[j - 1] > value) {
+                graph->index[j] = graph->index[j - 1];
+                j--;
+            }
+            graph->index[j] = value;
+        }
+        graph->offset[n] = write;
+        for (uint32_t i = from; i < to; i++) {
+            if (i == from || graph->index[i] != graph->index[i - 1]) {
+                graph->index[write++] = graph->index[i];
+            }
+        }
+    }
+    graph->offset[node_num] = write;
+    return graph;
+}
+
+// RCM ----------------------------------------------------------------------------
+static uint32_t degree_of(const CsrGraph* graph, int n) {
+    return graph->offset[n + 1] - graph->offset[n];
+}
+
+/**
+ * root から未訪問の節点を幅優先探索し、離心数(最大レベル)と最終レベルで次数が最小の節点を返す
+ *
+ * @param stamp 探索済みの印(同じ値の場合は探索済み)
+ * @param stamp_value 今回の探索で使う印
+ * @param queue 作業配列
+ */
+static int level_structure(const CsrGraph* graph, int root, const char visited[], int stamp[], int stamp_value,
+                           int level[], int queue[], int* last_node) {
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = root;
+    stamp[root] = stamp_value;
+    level[root] = 0;
+    int eccentricity = 0;
+    while (head < tail) {
+        int n = queue[head++];
+        if (level[n] > eccentricity) {
+            eccentricity = level[n];
+        }
+        for (uint32_t p = graph->offset[n]; p < graph->offset[n + 1]; p++) {
+            int m = (int)graph->index[p];
+            if (visited[m] || stamp[m] == stamp_value) {
+                continue;
+            }
+            stamp[m] = stamp_value;
+            level[m] = level[n] + 1;
+            queue[tail++] = m;
+        }
+    }
+    // 最終レベルで次数が最小の節点
+    int best = -1;
+    for (int i = tail - 1; i >= 0 && level[queue[i]] == eccentricity; i--) {
+        if (best < 0 || degree_of(graph, queue[i]) < degree_of(graph, best)) {
+            best = queue[i];
+        }
+    }
+    *last_node = best;
+    return eccentricity;
+}
+
+/**
+ * Reverse Cuthill-McKee で節点の並びを求める。
+ *
+ * @param graph 節点 -> 節点の隣接関係
+ * @param order 並び(order[k] = k番目の節点の配列番号)。サイズは row_num。
+ * @param component_num 連結成分の数(NULL可)
+ */
+int compute_rcm_order(const CsrGraph* graph, int order[], int* component_num) {
+    if (graph == NULL || order == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to compute_rcm_order\n");
+        return EXIT_FAILURE;
+    }
+    int node_num = graph->row_num;
+    char* visited = (char*)calloc((size_t)node_num + 1, sizeof(char));
+    int* stamp = (int*)calloc((size_t)node_num + 1, sizeof(int));
+    int* level = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* queue = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* by_degree = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    if (visited == NULL || stamp == NULL || level == NULL || queue == NULL || by_degree == NULL) {
+        fprintf(stderr, "Error: Memory allocation for compute_rcm_order failed\n");
+        free(visited);
+        free(stamp);
+        free(level);
+        free(queue);
+        free(by_degree);
+        return EXIT_FAILURE;
+    }
+
+    // 次数の小さい順(数え上げ)に始点の候補を並べる
+    uint32_t max_degree = 0;
+    for (int n = 0; n < node_num; n++) {
+        if (degree_of(graph, n) > max_degree) max_degree = degree_of(graph, n);
+    }
+    int* bucket = (int*)calloc((size_t)max_degree + 2, sizeof(int));
+    if (bucket == NULL) {
+        fprintf(stderr, "Error: Memory allocation for compute_rcm_order failed\n");
+        free(visited);
+        free(stamp);
+        free(level);
+        free(queue);
+        free(by_degree);
+        return EXIT_FAILURE;
+    }
+    for (int n = 0; n < node_num; n++) bucket[degree_of(graph, n) + 1]++;
+    for (uint32_t d = 0; d <= max_degree; d++) bucket[d + 1] += bucket[d];
+    for (int n = 0; n < node_num; n++) by_degree[bucket[degree_of(graph, n)]++] = n;
+    free(bucket);
+
+    int count = 0;
+    int components = 0;
+    int stamp_value = 0;
+    for (int s = 0; s < node_num; s++) {
+        int seed = by_degree[s];
+        if (visited[seed]) {
+            continue;
+        }
+        components++;
+
+        // 擬似周辺節点(George-Liu)
+        int root = seed;
+        int candidate;
+        int eccentricity = level_structure(graph, root, visited, stamp, ++stamp_value, level, queue, &candidate);
+        while (candidate >= 0 && candidate != root) {
+            int next_candidate;
+            int next_eccentricity = level_structure(graph, candidate, visited, stamp, ++stamp_value, level, queue, &next_candidate);
+            if (next_eccentricity <= eccentricity) {
+                break;
+            }
+            root = candidate;
+            eccentricity = next_eccentricity;
+            candidate = next_candidate;
+        }
+
+        // Cuthill-McKee - 隣接節点は次数の小さい順に追加
+        int head = count;
+        order[count++] = root;
+        visited[root] = 1;
+        while (head < count) {
+            int n = order[head++];
+            int first = count;
+            for (uint32_t p = graph->offset[n]; p < graph->offset[n + 1]; p++) {
+                int m = (int)graph->index[p];
+                if (visited[m]) {
+                    continue;
+                }
+                visited[m] = 1;
+                // 挿入ソート
+                int j = count++;
+                while (j > first && (degree_of(graph, order[j - 1]) > degree_of(graph, m) ||
+                                     (degree_of(graph, order[j - 1]) == degree_of(graph, m) && order[j - 1] > m))) {
+                    order[j] = order[j - 1];
+                    j--;
+                }
+                order[j] = m;
+            }
+        }
+    }
+
+    // 逆順
+    for (int i = 0; i < node_num / 2; i++) {
+        int tmp = order[i];
+        order[i] = order[node_num - 1 - i];
+        order[node_num - 1 - i] = tmp;
+    }
+
+    if (component_num != NULL) {
+        *component_num = components;
+    }
+    free(visited);
+    free(stamp);
+    free(level);
+    free(queue);
+    free(by_degree);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 帯幅とプロファイルを求める
+ *
+ * @param position 節点の配列番号 -> 並びの位置(0から)
+ */
+void compute_renumber_statistics(const CsrGraph* graph, const int position[], RenumberStatistics* statistics) {
+    statistics->bandwidth = 0;
+    statistics->profile = 0;
+    for (int n = 0; n < graph->row_num; n++) {
+        int row = position[n];
+        int first = row;
+        for (uint32_t p = graph->offset[n]; p < graph->offset[n + 1]; p++) {
+            int column = position[graph->index[p]];
+            int distance = abs(row - column);
+            if (distance > statistics->bandwidth) {
+                statistics->bandwidth = distance;
+            }
+            if (column < first) {
+                first = column;
+            }
+        }
+        statistics->profile += row - first;
+    }
+}
+
+// 番号の付け替え ----------------------------------------------------------------------------
+static int map_node_id(const MeshModel* model, const int new_id[], int id) {
+    int n = find_mesh_node(model, id);
+    return (n < 0) ? id : new_id[n];
+}
+
+/**
+ * 節点番号を付け替える。要素、REST、SUB1、FN、解析制御データの節点番号も付け替える。
+ *
+ * @param new_id 節点の配列番号 -> 新しい節点番号(重複不可)
+ */
+int apply_node_renumbering(MeshModel* model, const int new_id[]) {
+    if (model == NULL || new_id == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to apply_node_renumbering\n");
+        return EXIT_FAILURE;
+    }
+
+    // 参照の付け替え(古い対応表を使う)
+    int missing = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int k = 0; k < node_count; k++) {
+            int* node = &model->connectivity[e * ELEMENT_NODE_MAX + k];
+            if (find_mesh_node(model, *node) < 0) {
+                missing++;
+            }
+            *node = map_node_id(model, new_id, *node);
+        }
+    }
+    if (missing > 0) {
+        fprintf(stderr, "Warning: %d element nodes are not defined and were not renumbered\n", missing);
+    }
+    for (int r = 0; r < model->restraint_num; r++) {
+        model->restraint[r].node = map_node_id(model, new_id, model->restraint[r].node);
+    }
+    for (int c = 0; c < model->constraint_num; c++) {
+        model->constraint[c].node = map_node_id(model, new_id, model->constraint[c].node);
+        model->constraint[c].master = map_node_id(model, new_id, model->constraint[c].master);
+    }
+    for (int s = 0; s < model->step_card_num; s++) {
+        if (model->step_card[s].kind == STEP_CARD_FN) {
+            model->step_card[s].id = map_node_id(model, new_id, model->step_card[s].id);
+        }
+    }
+    model->disp_node = map_node_id(model, new_id, model->disp_node);
+    model->load_node = map_node_id(model, new_id, model->load_node);
+
+    // 対応表の作り直し
+    int max_id = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        if (new_id[n] > max_id) max_id = new_id[n];
+    }
+    if (max_id >= model->node_index_size) {
+        int* table = (int*)realloc(model->node_index, ((size_t)max_id + 1) * sizeof(int));
+        if (table == NULL) {
+            fprintf(stderr, "Error: Failed to grow node index table\n");
+            return EXIT_FAILURE;
+        }
+        model->node_index = table;
+        model->node_index_size = max_id + 1;
+    }
+    for (int i = 0; i < model->node_index_size; i++) {
+        model->node_index[i] = -1;
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        model->node_id[n] = new_id[n];
+        model->node_index[new_id[n]] = n;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * RCMで節点番号を 1 から付け替える。
+ *
+ * @param original_id 付け替え前の節点番号の格納先(節点の配列番号ごと、NULL可)
+ * @param before, after 付け替え前後の帯幅、プロファイル(NULL可)
+ */
+int renumber_nodes_rcm(MeshModel* model, int original_id[], RenumberStatistics* before, RenumberStatistics* after) {
+    CsrGraph* graph = build_renumber_graph(model);
+    if (graph == NULL) {
+        return EXIT_FAILURE;
+    }
+    int node_num = model->node_num;
+    int* order = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* position = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    int* new_id = (int*)malloc(((size_t)node_num + 1) * sizeof(int));
+    if (order == NULL || position == NULL || new_id == NULL) {
+        fprintf(stderr, "Error: Memory allocation for renumber_nodes_rcm failed\n");
+        free(order);
+        free(position);
+        free(new_id);
+        free_csr_graph(graph);
+        return EXIT_FAILURE;
+    }
+
+    // 付け替え前 - 節点番号順の位置
+    if (before != NULL) {
+        int k = 0;
+        for (int id = 1; id < model->node_index_size; id++) {
+            if (model->node_index[id] >= 0) {
+                position[model->node_index[id]] = k++;
+            }
+        }
+        compute_renumber_statistics(graph, position, before);
+        before->component_num = 0;
+    }
+
+    int component_num = 0;
+    int result = compute_rcm_order(graph, order, &component_num);
+    if (result == EXIT_SUCCESS) {
+        for (int k = 0; k < node_num; k++) {
+            position[order[k]] = k;
+            new_id[order[k]] = k + 1;
+        }
+        if (before != NULL) {
+            before->component_num = component_num;
+        }
+        if (after != NULL) {
+            compute_renumber_statistics(graph, position, after);
+            after->component_num = component_num;
+        }
+        if (original_id != NULL) {
+            for (int n = 0; n < node_num; n++) {
+                original_id[n] = model->node_id[n];
+            }
+        }
+        result = apply_node_renumbering(model, new_id);
+    }
+
+    free(order);
+    free(position);
+    free(new_id);
+    free_csr_graph(graph);
+    return result;
+}
+
+/**
+ * 新しい節点番号 -> 元の節点番号の対応表をCSVで書き込む
+ *
+ * @param original_id renumber_nodes_rcm()で得た元の節点番号
+ */
+int write_node_map(const char* file_name, const MeshModel* model, const int original_id[]) {
+    FILE* f = fopen(file_name, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return EXIT_FAILURE;
+    }
+    fprintf(f, "new_id,original_id\n");
+    for (int id = 1; id < model->node_index_size; id++) {
+        int n = model->node_index[id];
+        if (n >= 0) {
+            fprintf(f, "%d,%d\n", id, original_id[n]);
+        }
+    }
+    fclose(f);
+    return EXIT_SUCCESS;
+}
+
+// 要素番号の付け替え ----------------------------------------------------------------------------
+/**
+ * 要素を order の順に組み立てた場合のフロント幅を求める
+ *
+ * @param order 要素の配列番号の並び(NULLの場合は要素番号順)
+ */
+void compute_front_statistics(const MeshModel* model, const int order[], FrontStatistics* statistics) {
+    statistics->max_front = 0;
+    statistics->mean_front = 0.0;
+    int element_num = model->element_num;
+    if (element_num == 0) {
+        return;
+    }
+
+    int* sequence = (int*)malloc((size_t)element_num * sizeof(int));
+    int* last_use = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+    char* active = (char*)calloc((size_t)model->node_num + 1, sizeof(char));
+    if (sequence == NULL || last_use == NULL || active == NULL) {
+        fprintf(stderr, "Error: Memory allocation for compute_front_statistics failed\n");
+        free(sequence);
+        free(last_use);
+        free(active);
+        return;
+    }
+    if (order != NULL) {
+        for (int k = 0; k < element_num; k++) sequence[k] = order[k];
+    } else {
+        int k = 0;
+        for (int id = 1; id < model->element_index_size; id++) {
+            if (model->element_index[id] >= 0) sequence[k++] = model->element_index[id];
+        }
+    }
+
+    // 各節点が最後に現れる位置
+    for (int n = 0; n < model->node_num; n++) last_use[n] = -1;
+    for (int k = 0; k < element_num; k++) {
+        int e = sequence[k];
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int i = 0; i < node_count; i++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + i]);
+            if (n >= 0) last_use[n] = k;
+        }
+    }
+
+    int front = 0;
+    double sum = 0.0;
+    for (int k = 0; k < element_num; k++) {
+        int e = sequence[k];
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int i = 0; i < node_count; i++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + i]);
+            if (n >= 0 && !active[n]) {
+                active[n] = 1;
+                front++;
+            }
+        }
+        if (front > statistics->max_front) {
+            statistics->max_front = front;
+        }
+        sum += front;
+        // 最後の要素を組み立てた節点を消去
+        for (int i = 0; i < node_count; i++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + i]);
+            if (n >= 0 && active[n] && last_use[n] == k) {
+                active[n] = 0;
+                front--;
+            }
+        }
+    }
+    statistics->mean_front = sum / element_num;
+
+    free(sequence);
+    free(last_use);
+    free(active);
+}
+
+// 並べ替えのキー
+typedef struct {
+    int first;    // 要素の節点番号の最小値
+    int last;     // 要素の節点番号の最大値
+    int id;       // 元の要素番号
+    int index;    // 要素の配列番号
+} ElementOrderKey;
+
+static int compare_element_order_key(const void* a, const void* b) {
+    const ElementOrderKey* p = (const ElementOrderKey*)a;
+    const ElementOrderKey* q = (const ElementOrderKey*)b;
+    if (p->first != q->first) return (p->first < q->first) ? -1 : 1;
+    if (p->last != q->last) return (p->last < q->last) ? -1 : 1;
+    return (p->id > q->id) - (p->id < q->id);
+}
+
+/**
+ * 要素を節点番号の最小値、最大値の順に並べる
+ *
+ * @param order 並び(order[k] = k番目の要素の配列番号)。サイズは element_num。
+ */
+int compute_element_order(const MeshModel* model, int order[]) {
+    int element_num = model->element_num;
+    ElementOrderKey* key = (ElementOrderKey*)malloc(((size_t)element_num + 1) * sizeof(ElementOrderKey));
+    if (key == NULL) {
+        fprintf(stderr, "Error: Memory allocation for compute_element_order failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < element_num; e++) {
+        int node_count = element_node_count(model->element_kind[e]);
+        key[e].first = model->connectivity[e * ELEMENT_NODE_MAX];
+        key[e].last = key[e].first;
+        for (int i = 1; i < node_count; i++) {
+            int node = model->connectivity[e * ELEMENT_NODE_MAX + i];
+            if (node < key[e].first) key[e].first = node;
+            if (node > key[e].last) key[e].last = node;
+        }
+        key[e].id = model->element_id[e];
+        key[e].index = e;
+    }
+    qsort(key, element_num, sizeof(ElementOrderKey), compare_element_order_key);
+    for (int k = 0; k < element_num; k++) {
+        order[k] = key[k].index;
+    }
+    free(key);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素番号を付け替える。UEの要素番号も付け替える。
+ *
+ * @param new_id 要素の配列番号 -> 新しい要素番号(重複不可)
+ */
+int apply_element_renumbering(MeshModel* model, const int new_id[]) {
+    if (model == NULL || new_id == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to apply_element_renumbering\n");
+        return EXIT_FAILURE;
+    }
+    for (int s = 0; s < model->step_card_num; s++) {
+        if (model->step_card[s].kind == STEP_CARD_UE) {
+            int e = find_mesh_element(model, model->step_card[s].id);
+            if (e >= 0) {
+                model->step_card[s].id = new_id[e];
+            }
+        }
+    }
+
+    int max_id = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (new_id[e] > max_id) max_id = new_id[e];
+    }
+    if (max_id >= model->element_index_size) {
+        int* table = (int*)realloc(model->element_index, ((size_t)max_id + 1) * sizeof(int));
+        if (table == NULL) {
+            fprintf(stderr, "Error: Failed to grow element index table\n");
+            return EXIT_FAILURE;
+        }
+        model->element_index = table;
+        model->element_index_size = max_id + 1;
+    }
+    for (int i = 0; i < model->element_index_size; i++) {
+        model->element_index[i] = -1;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        model->element_id[e] = new_id[e];
+        model->element_index[new_id[e]] = e;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素番号をフロント幅が小さくなる順に 1 から付け替える。
+ *
+ * @param original_id 付け替え前の要素番号の格納先(要素の配列番号ごと、NULL可)
+ * @param before, after 付け替え前後のフロント幅(NULL可)
+ */
+int renumber_elements_front(MeshModel* model, int original_id[], FrontStatistics* before, FrontStatistics* after) {
+    int element_num = model->element_num;
+    int* order = (int*)malloc(((size_t)element_num + 1) * sizeof(int));
+    int* new_id = (int*)malloc(((size_t)element_num + 1) * sizeof(int));
+    if (order == NULL || new_id == NULL) {
+        fprintf(stderr, "Error: Memory allocation for renumber_elements_front failed\n");
+        free(order);
+        free(new_id);
+        return EXIT_FAILURE;
+    }
+
+    if (before != NULL) {
+        compute_front_statistics(model, NULL, before);
+    }
+    int result = compute_element_order(model, order);
+    if (result == EXIT_SUCCESS) {
+        for (int k = 0; k < element_num; k++) {
+            new_id[order[k]] = k + 1;
+        }
+        if (original_id != NULL) {
+            for (int e = 0; e < element_num; e++) {
+                original_id[e] = model->element_id[e];
+            }
+        }
+        result = apply_element_renumbering(model, new_id);
+        if (after != NULL) {
+            compute_front_statistics(model, NULL, after);
+        }
+    }
+
+    free(order);
+    free(new_id);
+    return result;
+}
+
+/**
+ * 新しい要素番号 -> 元の要素番号の対応表をCSVで書き込む。部位を判別できるよう種類、タイプ番号も書き込む。
+ *
+ * @param original_id renumber_elements_front()で得た元の要素番号
+ */
+int write_element_map(const char* file_name, const MeshModel* model, const int original_id[]) {
+    FILE* f = fopen(file_name, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Could not open file %s\n", file_name);
+        return EXIT_FAILURE;
+    }
+    fprintf(f, "new_id,original_id,kind,type\n");
+    for (int id = 1; id < model->element_index_size; id++) {
+        int e = model->element_index[id];
+        if (e >= 0) {
+            fprintf(f, "%d,%d,%s,%d\n", id, original_id[e], element_kind_name(model->element_kind[e]), model->element_type[e]);
+        }
+    }
+    fclose(f);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "mesh_rigid_jig.h"
+
+/**
+ * 治具の剛体化(--rigid-jig)
+ *
+ * 柱端、梁端の治具(TYPH 5 の六面体要素)は荷重を伝えるだけの鋼材で、解析には自由度を増やすだけになる。
+ * modeling_rcs は --rigid-jig の場合、治具とコンクリート、鋼板の境界面の節点を SUB1 で載荷点(主節点)に
+ * 従属させて書き込むため、ここでは治具の要素と、治具の要素だけが使う節点を削除する。
+ */
+
+// 節点を使う要素の種類
+#define USED_BY_JIG 1
+#define USED_BY_OTHER 2
+
+/**
+ * 治具の要素、節点を削除し、配列と対応表を詰める
+ */
+static void remove_jig(MeshModel* model, const unsigned char used[], int jig_type) {
+    int k = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        if (used[n] == USED_BY_JIG) {
+            model->node_index[model->node_id[n]] = -1;
+            continue;
+        }
+        model->node_id[k] = model->node_id[n];
+        model->x[k] = model->x[n];
+        model->y[k] = model->y[n];
+        model->z[k] = model->z[n];
+        model->node_index[model->node_id[k]] = k;
+        k++;
+    }
+    model->node_num = k;
+
+    k = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (model->element_kind[e] == ELEMENT_HEXA && model->element_type[e] == jig_type) {
+            model->element_index[model->element_id[e]] = -1;
+            continue;
+        }
+        model->element_id[k] = model->element_id[e];
+        model->element_kind[k] = model->element_kind[e];
+        model->element_type[k] = model->element_type[e];
+        for (int m = 0; m < ELEMENT_NODE_MAX; m++) {
+            model->connectivity[k * ELEMENT_NODE_MAX + m] = model->connectivity[e * ELEMENT_NODE_MAX + m];
+        }
+        model->element_index[model->element_id[k]] = k;
+        k++;
+    }
+    model->element_num = k;
+}
+
+/**
+ * 削除した節点、要素の REST、SUB1、FN、UE を除く。
+ * 従属節点が残り主節点を削除した SUB1 は、載荷点が治具の中にあるためエラーにする。
+ */
+static int remove_jig_cards(MeshModel* model, RigidJigStatistics* statistics) {
+    int kept = 0;
+    for (int c = 0; c < model->constraint_num; c++) {
+        MeshConstraint constraint = model->constraint[c];
+        if (find_mesh_node(model, constraint.node) < 0) {
+            statistics->removed_card_num++;
+            continue;
+        }
+        if (find_mesh_node(model, constraint.master) < 0) {
+            fprintf(stderr, "Error: Master node %d of SUB1 (node %d) is inside the jig\n", constraint.master, constraint.node);
+            return EXIT_FAILURE;
+        }
+        model->constraint[kept++] = constraint;
+    }
+    model->constraint_num = kept;
+
+    kept = 0;
+    for (int r = 0; r < model->restraint_num; r++) {
+        if (find_mesh_node(model, model->restraint[r].node) < 0) {
+            statistics->removed_card_num++;
+            continue;
+        }
+        model->restraint[kept++] = model->restraint[r];
+    }
+    model->restraint_num = kept;
+
+    kept = 0;
+    for (int s = 0; s < model->step_card_num; s++) {
+        StepCard card = model->step_card[s];
+        if ((card.kind == STEP_CARD_FN && find_mesh_node(model, card.id) < 0) ||
+            (card.kind == STEP_CARD_UE && find_mesh_element(model, card.id) < 0)) {
+            statistics->removed_card_num++;
+            continue;
+        }
+        model->step_card[kept++] = card;
+    }
+    model->step_card_num = kept;
+
+    if (find_mesh_node(model, model->disp_node) < 0) model->disp_node = 0;
+    if (find_mesh_node(model, model->load_node) < 0) model->load_node = 0;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 治具の六面体要素を削除する
+ *
+ * - 種類が HEXA でタイプが jig_type の要素を削除し、それらの要素だけが使う節点を削除する。
+ * - 削除した節点、要素の REST、SUB1、FN、UE を除く。監視節点(DISP、LOAD)を削除した場合は 0 にする。
+ * - 他の要素と共有していた節点(境界面)のうち SUB1 で結ばれていないものを数える
+ *   (modeling_rcs が書き込んだ従属条件と治具の範囲が合っているかの確認)。
+ * 番号は付け替えない。
+ *
+ * @param model 治具を削除するモデル(書き換える)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int remove_jig_elements(MeshModel* model, int jig_type, RigidJigStatistics* statistics) {
+    if (model == NULL || statistics == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to remove_jig_elements\n");
+        return EXIT_FAILURE;
+    }
+    *statistics = (RigidJigStatistics){0};
+
+    unsigned char* used = (unsigned char*)calloc((size_t)model->node_num + 1, sizeof(unsigned char));
+    unsigned char* tied = (unsigned char*)calloc((size_t)model->node_num + 1, sizeof(unsigned char));
+    if (used == NULL || tied == NULL) {
+        fprintf(stderr, "Error: Memory allocation for remove_jig_elements failed\n");
+        free(used);
+        free(tied);
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        int jig = model->element_kind[e] == ELEMENT_HEXA && model->element_type[e] == jig_type;
+        if (jig) {
+            statistics->removed_element_num++;
+        }
+        int node_count = element_node_count(model->element_kind[e]);
+        for (int m = 0; m < node_count; m++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + m]);
+            if (n >= 0) {
+                used[n] |= jig ? USED_BY_JIG : USED_BY_OTHER;
+            }
+        }
+    }
+    if (statistics->removed_element_num == 0) {
+        fprintf(stderr, "Error: No HEXA element of TYPH %d (jig) in the model\n", jig_type);
+        free(used);
+        free(tied);
+        return EXIT_FAILURE;
+    }
+    for (int c = 0; c < model->constraint_num; c++) {
+        int slave = find_mesh_node(model, model->constraint[c].node);
+        int master = find_mesh_node(model, model->constraint[c].master);
+        if (slave >= 0) tied[slave] = 1;
+        if (master >= 0) tied[master] = 1;
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        if (used[n] == USED_BY_JIG) {
+            statistics->removed_node_num++;
+        } else if (used[n] == (USED_BY_JIG | USED_BY_OTHER)) {
+            statistics->interface_node_num++;
+            if (!tied[n]) {
+                statistics->untied_node_num++;
+            }
+        }
+    }
+
+    remove_jig(model, used, jig_type);
+    int result = remove_jig_cards(model, statistics);
+    free(used);
+    free(tied);
+    return result;
+}
+
+/**
+ * 削除した結果を表示する
+ */
+void print_rigid_jig_statistics(const RigidJigStatistics* statistics) {
+    if (statistics == NULL) {
+        return;
+    }
+    printf("rigid jig: -%d nodes (-%d dof), -%d elements, %d interface nodes, %d cards removed\n",
+           statistics->removed_node_num, 3 * statistics->removed_node_num, statistics->removed_element_num,
+           statistics->interface_node_num, statistics->removed_card_num);
+    if (statistics->untied_node_num > 0) {
+        printf("Warning: %d interface nodes are not tied to a load node by SUB1\n", statistics->untied_node_num);
+    }
+}
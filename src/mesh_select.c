@@ -0,0 +1,499 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "mesh_select.h"
+
+/**
+ * 節点、要素を座標の範囲、平面、格子番号の範囲、要素タイプで選び、集合演算で組み合わせる。
+ *
+ * 座標の検索は一様格子(SpatialIndex)で行い、範囲に掛かるセルの点だけを調べる。
+ * 選んだ集合は selection_ids で番号の配列にし、print_REST_set などの範囲の組の書き込み(range_set.c)に渡す。
+ *   例: 柱下端の面の節点 → select_on_plane(index, 2, z0, nodes) → selection_ids → print_REST_set
+ */
+
+// 一様格子 ----------------------------------------------------------------------------
+static int compare_double(const void* a, const void* b) {
+    double p = *(const double*)a;
+    double q = *(const double*)b;
+    return (p > q) - (p < q);
+}
+
+/**
+ * 座標を含むセルの番号(軸ごと)。範囲外は端のセルにする。
+ */
+static int cell_coordinate(const SpatialIndex* index, int axis, double value) {
+    double c = floor((value - index->origin[axis]) / index->cell_size[axis]);
+    if (!(c > 0.0)) return 0;
+    if (c > index->cell_num[axis] - 1) return index->cell_num[axis] - 1;
+    return (int)c;
+}
+
+static int cell_of_point(const SpatialIndex* index, const double* point) {
+    int i = cell_coordinate(index, 0, point[0]);
+    int j = cell_coordinate(index, 1, point[1]);
+    int k = cell_coordinate(index, 2, point[2]);
+    return (k * index->cell_num[1] + j) * index->cell_num[0] + i;
+}
+
+/**
+ * 軸ごとに座標の異なる値(0.01単位に丸めたもの)を昇順に求める
+ */
+static int build_grid_lines(SpatialIndex* index) {
+    int n = index->point_num;
+    for (int axis = 0; axis < 3; axis++) {
+        double* line = (double*)malloc(((size_t)n + 1) * sizeof(double));
+        if (line == NULL) {
+            fprintf(stderr, "Error: Memory allocation for grid lines failed\n");
+            return EXIT_FAILURE;
+        }
+        for (int p = 0; p < n; p++) {
+            line[p] = round(index->point[3 * p + axis] * 100.0) / 100.0;
+        }
+        qsort(line, n, sizeof(double), compare_double);
+        int unique = 0;
+        for (int p = 0; p < n; p++) {
+            if (unique == 0 || line[p] - line[unique - 1] > MESH_SELECT_TOLERANCE) {
+                line[unique++] = line[p];
+            }
+        }
+        index->line[axis] = line;
+        index->line_num[axis] = unique;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 節点(要素は重心)の一様格子を作る。
+ * セルの大きさは、1セル当りの点数が MESH_SELECT_CELL_POINTS 程度になる立方体(幅の無い方向は1セル)とする。
+ *
+ * @param target SELECT_NODE または SELECT_ELEMENT
+ * @return SpatialIndex。失敗した場合はNULL
+ */
+SpatialIndex* build_spatial_index(const MeshModel* model, SelectTarget target) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to build_spatial_index\n");
+        return NULL;
+    }
+    SpatialIndex* index = (SpatialIndex*)calloc(1, sizeof(SpatialIndex));
+    if (index == NULL) {
+        fprintf(stderr, "Error: Memory allocation for SpatialIndex failed\n");
+        return NULL;
+    }
+    int n = (target == SELECT_NODE) ? model->node_num : model->element_num;
+    index->target = target;
+    index->point_num = n;
+    index->point = (double*)malloc(3 * ((size_t)n + 1) * sizeof(double));
+    index->item = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (index->point == NULL || index->item == NULL) {
+        fprintf(stderr, "Error: Memory allocation for SpatialIndex failed\n");
+        free_spatial_index(index);
+        return NULL;
+    }
+
+    // 点の座標
+    for (int p = 0; p < n; p++) {
+        if (target == SELECT_NODE) {
+            index->point[3 * p] = model->x[p];
+            index->point[3 * p + 1] = model->y[p];
+            index->point[3 * p + 2] = model->z[p];
+        } else {
+            const int* node = &model->connectivity[p * ELEMENT_NODE_MAX];
+            int count = element_node_count(model->element_kind[p]);
+            double sum[3] = {0.0, 0.0, 0.0};
+            int found = 0;
+            for (int i = 0; i < count; i++) {
+                int v = find_mesh_node(model, node[i]);
+                if (v >= 0) {
+                    sum[0] += model->x[v];
+                    sum[1] += model->y[v];
+                    sum[2] += model->z[v];
+                    found++;
+                }
+            }
+            for (int axis = 0; axis < 3; axis++) {
+                index->point[3 * p + axis] = (found > 0) ? sum[axis] / found : 0.0;
+            }
+        }
+    }
+
+    // 格子の大きさ
+    double min[3] = {0.0, 0.0, 0.0};
+    double max[3] = {0.0, 0.0, 0.0};
+    for (int p = 0; p < n; p++) {
+        for (int axis = 0; axis < 3; axis++) {
+            double v = index->point[3 * p + axis];
+            if (p == 0 || v < min[axis]) min[axis] = v;
+            if (p == 0 || v > max[axis]) max[axis] = v;
+        }
+    }
+    double volume = 1.0;
+    int dim = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        if (max[axis] - min[axis] > MESH_SELECT_TOLERANCE) {
+            volume *= max[axis] - min[axis];
+            dim++;
+        }
+    }
+    int target_cells = n / MESH_SELECT_CELL_POINTS + 1;
+    double size = (dim > 0) ? pow(volume / target_cells, 1.0 / dim) : 1.0;
+    // 薄い方向があるとセル数が増えるため、目安の数倍に収まるまでセルを大きくする
+    for (;;) {
+        double cell_total = 1.0;
+        for (int axis = 0; axis < 3; axis++) {
+            double extent = max[axis] - min[axis];
+            index->origin[axis] = min[axis];
+            if (extent > MESH_SELECT_TOLERANCE) {
+                index->cell_num[axis] = (int)ceil(extent / size);
+                if (index->cell_num[axis] < 1) index->cell_num[axis] = 1;
+                index->cell_size[axis] = extent / index->cell_num[axis] * (1.0 + 1e-9);
+            } else {
+                index->cell_num[axis] = 1;
+                index->cell_size[axis] = 1.0;
+            }
+            cell_total *= index->cell_num[axis];
+        }
+        if (cell_total <= 4.0 * target_cells) {
+            break;
+        }
+        size *= 1.25;
+    }
+
+    // セルごとに並べる(数え上げソート)
+    int cell_total = index->cell_num[0] * index->cell_num[1] * index->cell_num[2];
+    index->cell_start = (int*)calloc((size_t)cell_total + 1, sizeof(int));
+    if (index->cell_start == NULL) {
+        fprintf(stderr, "Error: Memory allocation for SpatialIndex failed\n");
+        free_spatial_index(index);
+        return NULL;
+    }
+    for (int p = 0; p < n; p++) {
+        index->cell_start[cell_of_point(index, &index->point[3 * p]) + 1]++;
+    }
+    for (int c = 0; c < cell_total; c++) {
+        index->cell_start[c + 1] += index->cell_start[c];
+    }
+    int* position = (int*)malloc(((size_t)cell_total + 1) * sizeof(int));
+    if (position == NULL) {
+        fprintf(stderr, "Error: Memory allocation for SpatialIndex failed\n");
+        free_spatial_index(index);
+        return NULL;
+    }
+    memcpy(position, index->cell_start, (size_t)cell_total * sizeof(int));
+    for (int p = 0; p < n; p++) {
+        index->item[position[cell_of_point(index, &index->point[3 * p])]++] = p;
+    }
+    free(position);
+
+    if (build_grid_lines(index) != EXIT_SUCCESS) {
+        free_spatial_index(index);
+        return NULL;
+    }
+    return index;
+}
+
+int free_spatial_index(SpatialIndex* index) {
+    if (index == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(index->point);
+    free(index->cell_start);
+    free(index->item);
+    for (int axis = 0; axis < 3; axis++) {
+        free(index->line[axis]);
+    }
+    free(index);
+    return EXIT_SUCCESS;
+}
+
+// 選択 ----------------------------------------------------------------------------
+MeshSelection* create_mesh_selection(const MeshModel* model, SelectTarget target) {
+    if (model == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to create_mesh_selection\n");
+        return NULL;
+    }
+    MeshSelection* selection = (MeshSelection*)malloc(sizeof(MeshSelection));
+    if (selection == NULL) {
+        fprintf(stderr, "Error: Memory allocation for MeshSelection failed\n");
+        return NULL;
+    }
+    selection->target = target;
+    selection->size = (target == SELECT_NODE) ? model->node_num : model->element_num;
+    selection->count = 0;
+    selection->flag = (unsigned char*)calloc((size_t)selection->size + 1, sizeof(unsigned char));
+    if (selection->flag == NULL) {
+        fprintf(stderr, "Error: Memory allocation for MeshSelection failed\n");
+        free(selection);
+        return NULL;
+    }
+    return selection;
+}
+
+int free_mesh_selection(MeshSelection* selection) {
+    if (selection == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(selection->flag);
+    free(selection);
+    return EXIT_SUCCESS;
+}
+
+void clear_mesh_selection(MeshSelection* selection) {
+    if (selection == NULL) {
+        return;
+    }
+    memset(selection->flag, 0, (size_t)selection->size);
+    selection->count = 0;
+}
+
+static void select_item(MeshSelection* selection, int i) {
+    if (!selection->flag[i]) {
+        selection->flag[i] = 1;
+        selection->count++;
+    }
+}
+
+/**
+ * 範囲(許容差 MESH_SELECT_TOLERANCE を含む)にある点を選択に加える
+ */
+int select_in_box(const SpatialIndex* index, const SelectBox* box, MeshSelection* selection) {
+    if (index == NULL || box == NULL || selection == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to select_in_box\n");
+        return EXIT_FAILURE;
+    }
+    if (index->target != selection->target || index->point_num != selection->size) {
+        fprintf(stderr, "Error: SpatialIndex and MeshSelection do not match\n");
+        return EXIT_FAILURE;
+    }
+    double min[3];
+    double max[3];
+    int low[3];
+    int high[3];
+    for (int axis = 0; axis < 3; axis++) {
+        min[axis] = box->min[axis] - MESH_SELECT_TOLERANCE;
+        max[axis] = box->max[axis] + MESH_SELECT_TOLERANCE;
+        if (min[axis] > max[axis]) {
+            return EXIT_SUCCESS;
+        }
+        low[axis] = cell_coordinate(index, axis, min[axis]);
+        high[axis] = cell_coordinate(index, axis, max[axis]);
+    }
+    for (int k = low[2]; k <= high[2]; k++) {
+        for (int j = low[1]; j <= high[1]; j++) {
+            for (int i = low[0]; i <= high[0]; i++) {
+                int c = (k * index->cell_num[1] + j) * index->cell_num[0] + i;
+                for (int q = index->cell_start[c]; q < index->cell_start[c + 1]; q++) {
+                    int p = index->item[q];
+                    const double* point = &index->point[3 * p];
+                    if (point[0] >= min[0] && point[0] <= max[0] && point[1] >= min[1] && point[1] <= max[1] &&
+                        point[2] >= min[2] && point[2] <= max[2]) {
+                        select_item(selection, p);
+                    }
+                }
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 座標の axis 成分が value の平面上にある点を選択に加える
+ *
+ * @param axis 0:x, 1:y, 2:z
+ */
+int select_on_plane(const SpatialIndex* index, int axis, double value, MeshSelection* selection) {
+    if (axis < 0 || axis > 2) {
+        fprintf(stderr, "Error: invalid axis %d\n", axis);
+        return EXIT_FAILURE;
+    }
+    SelectBox box = {{-DBL_MAX, -DBL_MAX, -DBL_MAX}, {DBL_MAX, DBL_MAX, DBL_MAX}};
+    box.min[axis] = value;
+    box.max[axis] = value;
+    return select_in_box(index, &box, selection);
+}
+
+/**
+ * 格子番号(軸ごとの座標の異なる値の何番目か、0から)の範囲 low ... high にある点を選択に加える。
+ * 負の番号は後ろから数える(-1 は最後の線)。
+ */
+int select_grid_range(const SpatialIndex* index, const int low[3], const int high[3], MeshSelection* selection) {
+    if (index == NULL || low == NULL || high == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to select_grid_range\n");
+        return EXIT_FAILURE;
+    }
+    SelectBox box;
+    for (int axis = 0; axis < 3; axis++) {
+        int l = (low[axis] < 0) ? index->line_num[axis] + low[axis] : low[axis];
+        int h = (high[axis] < 0) ? index->line_num[axis] + high[axis] : high[axis];
+        if (l < 0) l = 0;
+        if (h > index->line_num[axis] - 1) h = index->line_num[axis] - 1;
+        if (l > h) {
+            return EXIT_SUCCESS;
+        }
+        box.min[axis] = index->line[axis][l];
+        box.max[axis] = index->line[axis][h];
+    }
+    return select_in_box(index, &box, selection);
+}
+
+/**
+ * 種類とタイプ番号(TYPH、TYPQ、TYPF ...)が一致する要素を選択に加える。type が負の場合は種類だけで選ぶ。
+ */
+int select_elements_by_type(const MeshModel* model, ElementKind kind, int type, MeshSelection* selection) {
+    if (model == NULL || selection == NULL || selection->target != SELECT_ELEMENT || selection->size != model->element_num) {
+        fprintf(stderr, "Error: invalid arguments passed to select_elements_by_type\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        if (model->element_kind[e] == kind && (type < 0 || model->element_type[e] == type)) {
+            select_item(selection, e);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 選んだ節点を含む要素を選択に加える
+ *
+ * @param require_all 1: 全ての節点が選ばれている要素、0: いずれかの節点が選ばれている要素
+ */
+int select_elements_of_nodes(const MeshModel* model, const MeshSelection* nodes, int require_all, MeshSelection* selection) {
+    if (model == NULL || nodes == NULL || selection == NULL || nodes->target != SELECT_NODE || nodes->size != model->node_num ||
+        selection->target != SELECT_ELEMENT || selection->size != model->element_num) {
+        fprintf(stderr, "Error: invalid arguments passed to select_elements_of_nodes\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int count = element_node_count(model->element_kind[e]);
+        int selected = 0;
+        for (int i = 0; i < count; i++) {
+            int v = find_mesh_node(model, node[i]);
+            if (v >= 0 && nodes->flag[v]) {
+                selected++;
+            }
+        }
+        if (require_all ? (selected == count) : (selected > 0)) {
+            select_item(selection, e);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 選んだ要素の節点を選択に加える
+ */
+int select_nodes_of_elements(const MeshModel* model, const MeshSelection* elements, MeshSelection* selection) {
+    if (model == NULL || elements == NULL || selection == NULL || elements->target != SELECT_ELEMENT || elements->size != model->element_num ||
+        selection->target != SELECT_NODE || selection->size != model->node_num) {
+        fprintf(stderr, "Error: invalid arguments passed to select_nodes_of_elements\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        if (!elements->flag[e]) {
+            continue;
+        }
+        const int* node = &model->connectivity[e * ELEMENT_NODE_MAX];
+        int count = element_node_count(model->element_kind[e]);
+        for (int i = 0; i < count; i++) {
+            int v = find_mesh_node(model, node[i]);
+            if (v >= 0) {
+                select_item(selection, v);
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// 集合演算 ----------------------------------------------------------------------------
+static int same_target(const MeshSelection* selection, const MeshSelection* other) {
+    if (selection == NULL || other == NULL || selection->target != other->target || selection->size != other->size) {
+        fprintf(stderr, "Error: MeshSelection targets do not match\n");
+        return 0;
+    }
+    return 1;
+}
+
+static void recount(MeshSelection* selection) {
+    selection->count = 0;
+    for (int i = 0; i < selection->size; i++) {
+        selection->count += selection->flag[i];
+    }
+}
+
+/**
+ * selection = selection ∩ other
+ */
+int selection_and(MeshSelection* selection, const MeshSelection* other) {
+    if (!same_target(selection, other)) {
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < selection->size; i++) {
+        selection->flag[i] &= other->flag[i];
+    }
+    recount(selection);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * selection = selection ∪ other
+ */
+int selection_or(MeshSelection* selection, const MeshSelection* other) {
+    if (!same_target(selection, other)) {
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < selection->size; i++) {
+        selection->flag[i] |= other->flag[i];
+    }
+    recount(selection);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * selection = selection - other
+ */
+int selection_minus(MeshSelection* selection, const MeshSelection* other) {
+    if (!same_target(selection, other)) {
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < selection->size; i++) {
+        selection->flag[i] &= (unsigned char)!other->flag[i];
+    }
+    recount(selection);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * selection = 全体 - selection
+ */
+int selection_invert(MeshSelection* selection) {
+    if (selection == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < selection->size; i++) {
+        selection->flag[i] = (unsigned char)!selection->flag[i];
+    }
+    selection->count = selection->size - selection->count;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 選んだ節点番号、要素番号を ids に書き込む(配列番号の順)
+ *
+ * @param ids サイズは selection->count 以上
+ * @return 番号の数
+ */
+int selection_ids(const MeshModel* model, const MeshSelection* selection, int ids[]) {
+    if (model == NULL || selection == NULL || ids == NULL) {
+        return 0;
+    }
+    const int* id = (selection->target == SELECT_NODE) ? model->node_id : model->element_id;
+    int n = 0;
+    for (int i = 0; i < selection->size; i++) {
+        if (selection->flag[i]) {
+            ids[n++] = id[i];
+        }
+    }
+    return n;
+}
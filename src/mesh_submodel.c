@@ -0,0 +1,625 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "mesh_submodel.h"
+#include "mesh_renumber.h"
+
+/**
+ * 部分モデルの切り出し(--submodel)
+ *
+ * 要素の重心の空間索引(build_spatial_index)で範囲内の要素を選び、その節点を残す。
+ * 残した節点のうち削除した要素とも共有していたもの(切断面)は拘束し、切断面の外側にあった
+ * 載荷点の FN と治具の UE は切断面に移す(柱頭の切断面を SUB1 で主節点に従属させて FN を与えるなど)。
+ * 走査は索引のセルと残す要素、節点の配列に限られるため、大きなモデルでも数ミリ秒で終わる。
+ */
+
+// 箱の面の数(軸 * 2 + 0: 最小側、1: 最大側)
+#define SUBMODEL_FACE_NUM 6
+
+/**
+ * 切断面(箱の面)1つに移す荷重
+ *
+ * - tied: 移す FN の方向のビット(1:x, 2:y, 4:z)。面の節点を主節点に SUB1 で従属させる
+ * - loaded: 移す UE の方向のビット。面の六面体要素に与え、その方向は拘束しない
+ * - point: 最初に移す FN の節点の座標(主節点を選ぶ)
+ * - master: FN を与える主節点の配列番号(-1: 無し)
+ * - low, high: 面の節点の座標の範囲(UE を与える要素の面を選ぶ)
+ */
+typedef struct {
+    int tied;
+    int loaded;
+    int has_point;
+    double point[3];
+    int master;
+    double low[3];
+    double high[3];
+} SubmodelCutFace;
+
+static int compare_id_index(const void* a, const void* b) {
+    const int* p = (const int*)a;
+    const int* q = (const int*)b;
+    return (p[0] > q[0]) - (p[0] < q[0]);
+}
+
+/**
+ * 選ばなかった節点、要素を削除し、配列と対応表を詰める
+ */
+static void remove_unselected(MeshModel* model, const MeshSelection* nodes, const MeshSelection* elements,
+                              unsigned char cut[], int original_node[], int original_element[]) {
+    int k = 0;
+    for (int n = 0; n < model->node_num; n++) {
+        if (!nodes->flag[n]) {
+            model->node_index[model->node_id[n]] = -1;
+            continue;
+        }
+        model->node_id[k] = model->node_id[n];
+        model->x[k] = model->x[n];
+        model->y[k] = model->y[n];
+        model->z[k] = model->z[n];
+        cut[k] = cut[n];
+        model->node_index[model->node_id[k]] = k;
+        k++;
+    }
+    model->node_num = k;
+
+    k = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (!elements->flag[e]) {
+            model->element_index[model->element_id[e]] = -1;
+            continue;
+        }
+        model->element_id[k] = model->element_id[e];
+        model->element_kind[k] = model->element_kind[e];
+        model->element_type[k] = model->element_type[e];
+        for (int m = 0; m < ELEMENT_NODE_MAX; m++) {
+            model->connectivity[k * ELEMENT_NODE_MAX + m] = model->connectivity[e * ELEMENT_NODE_MAX + m];
+        }
+        model->element_index[model->element_id[k]] = k;
+        k++;
+    }
+    model->element_num = k;
+
+    for (int n = 0; n < model->node_num; n++) {
+        if (original_node != NULL) original_node[n] = model->node_id[n];
+    }
+    for (int e = 0; e < model->element_num; e++) {
+        if (original_element != NULL) original_element[e] = model->element_id[e];
+    }
+}
+
+/**
+ * 点に最も近い箱の面(箱の外にある場合は最も外側に離れている面)
+ *
+ * 面からの距離(外向きを正)が最大の面を選ぶ。差が許容差以内の面は prefer に含まれる面を優先する
+ * (接合部の角の節点を、荷重を移す柱の切断面に含めるため)。
+ *
+ * @param prefer 優先する面のビット(1 << 面)
+ * @return 面(軸 * 2 + 0: 最小側、1: 最大側)。範囲を限る面が無い場合は -1
+ */
+static int nearest_box_face(const SelectBox* box, const double point[3], int prefer) {
+    int best = -1;
+    double best_distance = 0.0;
+    for (int face = 0; face < SUBMODEL_FACE_NUM; face++) {
+        int axis = face / 2;
+        double bound = (face % 2 == 0) ? box->min[axis] : box->max[axis];
+        if (fabs(bound) >= SUBMODEL_UNBOUNDED) {
+            continue;
+        }
+        double distance = (face % 2 == 0) ? bound - point[axis] : point[axis] - bound;
+        if (best < 0 || distance > best_distance + MESH_SELECT_TOLERANCE
+            || (distance > best_distance - MESH_SELECT_TOLERANCE && (prefer & (1 << face)) && !(prefer & (1 << best)))) {
+            best = face;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+// 方向(1:x, 2:y, 3:z)のビット
+static int direction_bit(int dir) {
+    return (dir >= 1 && dir <= 3) ? 1 << (dir - 1) : 0;
+}
+
+// RC=(xyz000) の xyz と方向のビットの変換
+static int rc_to_bits(int rc) {
+    return ((rc / 100) % 10 ? 1 : 0) | ((rc / 10) % 10 ? 2 : 0) | (rc % 10 ? 4 : 0);
+}
+
+static int bits_to_rc(int bits) {
+    return ((bits & 1) ? 100 : 0) + ((bits & 2) ? 10 : 0) + ((bits & 4) ? 1 : 0);
+}
+
+/**
+ * 削除する節点、要素の FN、UE と、切断面の節点の FN が、どの切断面の外側にあるかを調べる。
+ * 削除する前の座標を使うため、remove_unselected の前に呼ぶ。
+ *
+ * UE の面は下面(1)、上面(2)だけのため、z 方向の切断面の外側にある UE だけを移す。
+ *
+ * @param card_face STEP のカードごとの移す先の面(-1: 移さない)
+ * @param face 面ごとの移す FN、UE の方向と、最初の FN の節点の座標
+ */
+static void locate_removed_loads(const MeshModel* model, const SpatialIndex* index, const SelectBox* box,
+                                 const MeshSelection* nodes, const MeshSelection* elements, const unsigned char cut[],
+                                 int card_face[], SubmodelCutFace face[]) {
+    for (int s = 0; s < model->step_card_num; s++) {
+        StepCard card = model->step_card[s];
+        card_face[s] = -1;
+        if (card.kind == STEP_CARD_FN) {
+            int n = find_mesh_node(model, card.id);
+            if (n < 0 || (nodes->flag[n] && !cut[n])) {
+                continue;
+            }
+            double point[3] = {model->x[n], model->y[n], model->z[n]};
+            int f = nearest_box_face(box, point, 0);
+            card_face[s] = f;
+            if (f >= 0) {
+                face[f].tied |= direction_bit(card.value[0]);
+                if (!face[f].has_point) {
+                    face[f].has_point = 1;
+                    for (int axis = 0; axis < 3; axis++) {
+                        face[f].point[axis] = point[axis];
+                    }
+                }
+            }
+        } else if (card.kind == STEP_CARD_UE) {
+            int e = find_mesh_element(model, card.id);
+            if (e < 0 || elements->flag[e]) {
+                continue;
+            }
+            int f = nearest_box_face(box, &index->point[3 * e], 0);
+            if (f / 2 == 2) {
+                card_face[s] = f;
+                face[f].loaded |= direction_bit(card.value[0]);
+            }
+        }
+    }
+}
+
+/**
+ * 切断面の面ごとに節点の座標の範囲を求め、FN を移す主節点を選ぶ(最初に移す FN の節点に面内で最も近い節点)
+ */
+static void choose_cut_masters(const MeshModel* model, const signed char node_face[], SubmodelCutFace face[]) {
+    double best_distance[SUBMODEL_FACE_NUM];
+    for (int f = 0; f < SUBMODEL_FACE_NUM; f++) {
+        face[f].master = -1;
+        best_distance[f] = 0.0;
+        for (int axis = 0; axis < 3; axis++) {
+            face[f].low[axis] = SUBMODEL_UNBOUNDED;
+            face[f].high[axis] = -SUBMODEL_UNBOUNDED;
+        }
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        int f = node_face[n];
+        if (f < 0) {
+            continue;
+        }
+        double point[3] = {model->x[n], model->y[n], model->z[n]};
+        for (int axis = 0; axis < 3; axis++) {
+            if (point[axis] < face[f].low[axis]) face[f].low[axis] = point[axis];
+            if (point[axis] > face[f].high[axis]) face[f].high[axis] = point[axis];
+        }
+        if (!face[f].tied) {
+            continue;
+        }
+        double distance = 0.0;
+        for (int axis = 0; axis < 3; axis++) {
+            if (axis != f / 2) {
+                distance += (point[axis] - face[f].point[axis]) * (point[axis] - face[f].point[axis]);
+            }
+        }
+        if (face[f].master < 0 || distance < best_distance[f]) {
+            face[f].master = n;
+            best_distance[f] = distance;
+        }
+    }
+}
+
+/**
+ * 切断面の外側の UE を、切断面にある六面体要素の面(最小側は下面、最大側は上面)に与える
+ *
+ * 要素の面の節点が全て切断面の節点の座標の範囲にあるものを選ぶ(FILM を挟んで切断面と
+ * 同じ位置にある、切断面ではない節点の面を含める)。
+ *
+ * @return 与えた UE の数
+ */
+static int add_cut_face_ue(MeshModel* model, const SubmodelCutFace* face, int f, const StepCard* card) {
+    int hexa_face = (f % 2 == 0) ? 1 : 2;
+    int added = 0;
+    for (int e = 0; e < model->element_num; e++) {
+        if (model->element_kind[e] != ELEMENT_HEXA) {
+            continue;
+        }
+        int on_face = 1;
+        for (int m = 0; m < 4 && on_face; m++) {
+            int n = find_mesh_node(model, model->connectivity[e * ELEMENT_NODE_MAX + (hexa_face - 1) * 4 + m]);
+            double point[3] = {n >= 0 ? model->x[n] : 0.0, n >= 0 ? model->y[n] : 0.0, n >= 0 ? model->z[n] : 0.0};
+            on_face = (n >= 0);
+            for (int axis = 0; axis < 3 && on_face; axis++) {
+                on_face = (point[axis] >= face->low[axis] - MESH_SELECT_TOLERANCE && point[axis] <= face->high[axis] + MESH_SELECT_TOLERANCE);
+            }
+        }
+        if (on_face) {
+            if (add_mesh_step_card(model, STEP_CARD_UE, model->element_id[e], card->value[0], hexa_face, 0, card->real) != EXIT_SUCCESS) {
+                return -1;
+            }
+            added++;
+        }
+    }
+    return added;
+}
+
+/**
+ * 削除した節点、要素の FN、UE を切断面に移し、移せないものを除く。
+ * ある STEP の FN、UE が全て除かれた場合は荷重の無い解析になるため、エラーにする。
+ *
+ * - FN: 面の主節点に同じ方向、値で与える(STEP ごとに面と方向ごとに最初の1つ)
+ * - UE: 面の六面体要素の面に同じ方向、値で与える(STEP ごとに面と方向ごとに最初の1つ)
+ */
+static int move_cut_face_loads(MeshModel* model, const unsigned char cut[], const int card_face[],
+                               SubmodelCutFace face[], SubmodelStatistics* statistics) {
+    int card_num = model->step_card_num;
+    StepCard* card = (StepCard*)malloc(((size_t)card_num + 1) * sizeof(StepCard));
+    if (card == NULL) {
+        fprintf(stderr, "Error: Memory allocation for extract_submodel failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int s = 0; s < card_num; s++) {
+        card[s] = model->step_card[s];
+    }
+    model->step_card_num = 0;
+
+    int step = 0;
+    int load_num = 0;
+    int kept_load_num = 0;
+    int unloaded_step_num = 0;
+    int dropped_num = 0;
+    int moved[SUBMODEL_FACE_NUM][2] = {{0}};
+    double moved_value[SUBMODEL_FACE_NUM][2][3];
+    int result = EXIT_SUCCESS;
+    for (int s = 0; s <= card_num && result == EXIT_SUCCESS; s++) {
+        if (s == card_num || card[s].kind == STEP_CARD_STEP) {
+            if (load_num > 0 && kept_load_num == 0) {
+                fprintf(stderr, "Error: All FN/UE of STEP %d act outside the submodel and cannot be moved to a cut face\n", step);
+                unloaded_step_num++;
+            }
+            if (s == card_num) {
+                break;
+            }
+            step = card[s].id;
+            load_num = 0;
+            kept_load_num = 0;
+            memset(moved, 0, sizeof(moved));
+        }
+        StepCard c = card[s];
+        int is_ue = (c.kind == STEP_CARD_UE);
+        if (c.kind != STEP_CARD_FN && !is_ue) {
+            result = add_mesh_step_card(model, c.kind, c.id, c.value[0], c.value[1], c.value[2], c.real);
+            continue;
+        }
+        load_num++;
+        int n = is_ue ? -1 : find_mesh_node(model, c.id);
+        if ((is_ue && find_mesh_element(model, c.id) >= 0) || (!is_ue && n >= 0 && !cut[n])) {
+            kept_load_num++;
+            result = add_mesh_step_card(model, c.kind, c.id, c.value[0], c.value[1], c.value[2], c.real);
+            continue;
+        }
+        statistics->removed_card_num++;
+        int f = card_face[s];
+        int bit = direction_bit(c.value[0]);
+        if (f < 0 || bit == 0 || (!is_ue && face[f].master < 0) || (is_ue && !(face[f].loaded & bit))) {
+            dropped_num++;
+            continue;
+        }
+        if (moved[f][is_ue] & bit) {
+            // 同じ面、方向に移したものと値が異なる場合は最初のものを使う
+            if (fabs(moved_value[f][is_ue][c.value[0] - 1] - c.real) > 1.0e-9) {
+                printf("Warning: %s %d (DIR %d) in STEP %d differs from the load already moved to the cut face (ignored)\n",
+                       is_ue ? "UE" : "FN", c.id, c.value[0], step);
+            }
+            kept_load_num++;
+            continue;
+        }
+        moved[f][is_ue] |= bit;
+        moved_value[f][is_ue][c.value[0] - 1] = c.real;
+        if (is_ue) {
+            int added = add_cut_face_ue(model, &face[f], f, &c);
+            if (added < 0) {
+                result = EXIT_FAILURE;
+            } else if (added == 0) {
+                // 切断面に六面体要素の面が無い場合は、その方向を拘束する
+                face[f].loaded &= ~bit;
+                dropped_num++;
+            } else {
+                statistics->moved_card_num += added;
+                kept_load_num++;
+            }
+        } else {
+            int master = model->node_id[face[f].master];
+            if (c.id == model->disp_node) model->disp_node = master;
+            if (c.id == model->load_node) model->load_node = master;
+            result = add_mesh_step_card(model, STEP_CARD_FN, master, c.value[0], 0, 0, c.real);
+            statistics->moved_card_num++;
+            kept_load_num++;
+        }
+    }
+    free(card);
+    if (dropped_num > 0) {
+        printf("Warning: %d FN/UE act outside the submodel and cannot be moved to a cut face (removed)\n", dropped_num);
+    }
+    return (result == EXIT_SUCCESS && unloaded_step_num == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * 削除した節点、要素の REST、SUB1、FN、UE を除き、切断面の節点を拘束する。
+ * 従属節点が残り master を削除した SUB1 は、従属節点も切断面として拘束する。
+ *
+ * 切断面の外側の FN、UE は切断面に移し(move_cut_face_loads)、FN を移す面の節点は主節点に SUB1 で従属させる。
+ * 切断面の節点は、従属させる方向と UE を与える方向を除いて拘束する。
+ */
+static int restrain_cut_faces(MeshModel* model, const SelectBox* box, unsigned char cut[], const int card_face[],
+                              SubmodelCutFace face[], SubmodelStatistics* statistics) {
+    for (int c = 0; c < model->constraint_num; c++) {
+        int n = find_mesh_node(model, model->constraint[c].node);
+        if (n >= 0 && find_mesh_node(model, model->constraint[c].master) < 0) {
+            cut[n] = 1;
+        }
+    }
+    int kept = 0;
+    for (int c = 0; c < model->constraint_num; c++) {
+        int n = find_mesh_node(model, model->constraint[c].node);
+        if (n >= 0 && !cut[n] && find_mesh_node(model, model->constraint[c].master) >= 0) {
+            model->constraint[kept++] = model->constraint[c];
+        } else {
+            statistics->removed_card_num++;
+        }
+    }
+    model->constraint_num = kept;
+
+    // 切断面の節点の面(荷重を移す面を優先する)
+    signed char* node_face = (signed char*)malloc((size_t)model->node_num + 1);
+    if (node_face == NULL) {
+        fprintf(stderr, "Error: Memory allocation for extract_submodel failed\n");
+        return EXIT_FAILURE;
+    }
+    int prefer = 0;
+    for (int f = 0; f < SUBMODEL_FACE_NUM; f++) {
+        if (face[f].tied || face[f].loaded) {
+            prefer |= 1 << f;
+        }
+    }
+    for (int n = 0; n < model->node_num; n++) {
+        double point[3] = {model->x[n], model->y[n], model->z[n]};
+        node_face[n] = (signed char)(cut[n] ? nearest_box_face(box, point, prefer) : -1);
+    }
+    choose_cut_masters(model, node_face, face);
+    for (int f = 0; f < SUBMODEL_FACE_NUM; f++) {
+        if (face[f].master < 0) {
+            face[f].tied = 0;
+        }
+    }
+
+    int result = move_cut_face_loads(model, cut, card_face, face, statistics);
+
+    // FN を移した面の節点を主節点に従属させる
+    for (int n = 0; n < model->node_num && result == EXIT_SUCCESS; n++) {
+        int f = node_face[n];
+        if (f < 0 || !face[f].tied || n == face[f].master) {
+            continue;
+        }
+        for (int dir = 1; dir <= 3 && result == EXIT_SUCCESS; dir++) {
+            if (face[f].tied & direction_bit(dir)) {
+                result = add_mesh_constraint(model, model->node_id[n], dir, model->node_id[face[f].master], dir);
+            }
+        }
+        statistics->tied_node_num++;
+    }
+
+    kept = 0;
+    for (int r = 0; r < model->restraint_num && result == EXIT_SUCCESS; r++) {
+        int n = find_mesh_node(model, model->restraint[r].node);
+        if (n < 0) {
+            statistics->removed_card_num++;
+        } else if (cut[n]) {
+            // 切断面の拘束を加える(従属させる方向の拘束は外す)
+            int f = node_face[n];
+            int free_bits = (f < 0) ? 0 : (face[f].tied | face[f].loaded);
+            int tied_bits = (f < 0) ? 0 : face[f].tied;
+            cut[n] = 2;
+            model->restraint[r].rc = bits_to_rc((rc_to_bits(model->restraint[r].rc) & ~tied_bits) | (7 & ~free_bits));
+            if (model->restraint[r].rc != 0) {
+                model->restraint[kept++] = model->restraint[r];
+            }
+        } else {
+            model->restraint[kept++] = model->restraint[r];
+        }
+    }
+    model->restraint_num = kept;
+    for (int n = 0; n < model->node_num && result == EXIT_SUCCESS; n++) {
+        if (cut[n]) {
+            statistics->cut_node_num++;
+        }
+        int f = node_face[n];
+        int rc = bits_to_rc(7 & ~((f < 0) ? 0 : (face[f].tied | face[f].loaded)));
+        if (cut[n] == 1 && rc != 0) {
+            result = add_mesh_restraint(model, model->node_id[n], rc);
+        }
+    }
+    free(node_face);
+    return result;
+}
+
+/**
+ * 番号の小さい順に 1 から付け直す
+ *
+ * @param order 作業用(サイズは 2 * (num + 1) 以上)
+ */
+static void compact_ids(const int id[], int num, int order[], int new_id[]) {
+    for (int i = 0; i < num; i++) {
+        order[2 * i] = id[i];
+        order[2 * i + 1] = i;
+    }
+    qsort(order, (size_t)num, 2 * sizeof(int), compare_id_index);
+    for (int i = 0; i < num; i++) {
+        new_id[order[2 * i + 1]] = i + 1;
+    }
+}
+
+/**
+ * 範囲内の要素と、その節点だけを残した部分モデルにする
+ *
+ * - 重心が box にある要素を残し、その節点を残す(他の節点、要素は削除する)。
+ * - 削除した要素と共有していた節点(切断面)を、最も近い箱の面ごとに3方向拘束する。
+ * - 削除した節点、要素の REST、SUB1 と、切断面の拘束と重なる SUB1 を除く。
+ * - 切断面の外側の FN(載荷点の強制変位)は、その面で載荷点に最も近い節点(主節点)に移し、面の他の節点を
+ *   その方向に SUB1 で主節点に従属させる。z 方向の切断面の外側の UE(治具の軸力)は、面にある六面体要素の
+ *   下面(最小側)、上面(最大側)に同じ値で与える。従属させる方向、UE を与える方向は拘束しない。
+ *   STEP ごとに面と方向ごとに最初の FN、UE を移す。移せないものは警告して除き、ある STEP の FN、UE が
+ *   全て除かれた場合は荷重の無い解析になるため、エラーにする。
+ * - 監視節点(DISP、LOAD)の FN を移した場合は主節点に、削除した場合は 0 にする。
+ * - 節点、要素番号を元の番号の順に 1 から付け直す。
+ *
+ * @param model 切り出すモデル(書き換える)
+ * @param original_node, original_element 残した節点、要素の配列番号 -> 元の番号(NULL可。
+ *        サイズは切り出す前の node_num、element_num 以上)。write_node_map、write_element_map に渡せる
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int extract_submodel(MeshModel* model, const SelectBox* box, int original_node[], int original_element[], SubmodelStatistics* statistics) {
+    if (model == NULL || box == NULL || statistics == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to extract_submodel\n");
+        return EXIT_FAILURE;
+    }
+    *statistics = (SubmodelStatistics){0};
+    clock_t start = clock();
+
+    SpatialIndex* index = build_spatial_index(model, SELECT_ELEMENT);
+    MeshSelection* elements = create_mesh_selection(model, SELECT_ELEMENT);
+    MeshSelection* outside = create_mesh_selection(model, SELECT_ELEMENT);
+    MeshSelection* nodes = create_mesh_selection(model, SELECT_NODE);
+    MeshSelection* outside_nodes = create_mesh_selection(model, SELECT_NODE);
+    int capacity = (model->node_num > model->element_num ? model->node_num : model->element_num) + 1;
+    unsigned char* cut = (unsigned char*)calloc((size_t)model->node_num + 1, sizeof(unsigned char));
+    int* order = (int*)malloc(2 * (size_t)capacity * sizeof(int));
+    int* new_id = (int*)malloc((size_t)capacity * sizeof(int));
+    int* card_face = (int*)malloc(((size_t)model->step_card_num + 1) * sizeof(int));
+    SubmodelCutFace face[SUBMODEL_FACE_NUM];
+    memset(face, 0, sizeof(face));
+    int result = EXIT_SUCCESS;
+    if (index == NULL || elements == NULL || outside == NULL || nodes == NULL || outside_nodes == NULL ||
+        cut == NULL || order == NULL || new_id == NULL || card_face == NULL) {
+        fprintf(stderr, "Error: Memory allocation for extract_submodel failed\n");
+        result = EXIT_FAILURE;
+    }
+
+    // 残す要素、節点と切断面
+    if (result == EXIT_SUCCESS) {
+        result = select_in_box(index, box, elements);
+    }
+    if (result == EXIT_SUCCESS && elements->count == 0) {
+        fprintf(stderr, "Error: No element has its centroid in the submodel box\n");
+        result = EXIT_FAILURE;
+    }
+    if (result == EXIT_SUCCESS) {
+        selection_or(outside, elements);
+        selection_invert(outside);
+        result = select_nodes_of_elements(model, elements, nodes);
+    }
+    if (result == EXIT_SUCCESS) {
+        result = select_nodes_of_elements(model, outside, outside_nodes);
+    }
+    if (result == EXIT_SUCCESS) {
+        for (int n = 0; n < model->node_num; n++) {
+            cut[n] = nodes->flag[n] && outside_nodes->flag[n];
+        }
+        locate_removed_loads(model, index, box, nodes, elements, cut, card_face, face);
+        statistics->removed_node_num = model->node_num - nodes->count;
+        statistics->removed_element_num = model->element_num - elements->count;
+        remove_unselected(model, nodes, elements, cut, original_node, original_element);
+        result = restrain_cut_faces(model, box, cut, card_face, face, statistics);
+    }
+    if (result == EXIT_SUCCESS) {
+        if (find_mesh_node(model, model->disp_node) < 0) model->disp_node = 0;
+        if (find_mesh_node(model, model->load_node) < 0) model->load_node = 0;
+        compact_ids(model->node_id, model->node_num, order, new_id);
+        result = apply_node_renumbering(model, new_id);
+    }
+    if (result == EXIT_SUCCESS) {
+        compact_ids(model->element_id, model->element_num, order, new_id);
+        result = apply_element_renumbering(model, new_id);
+    }
+    statistics->node_num = model->node_num;
+    statistics->element_num = model->element_num;
+    statistics->elapsed_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    if (index != NULL) free_spatial_index(index);
+    if (elements != NULL) free_mesh_selection(elements);
+    if (outside != NULL) free_mesh_selection(outside);
+    if (nodes != NULL) free_mesh_selection(nodes);
+    if (outside_nodes != NULL) free_mesh_selection(outside_nodes);
+    free(cut);
+    free(order);
+    free(new_id);
+    free(card_face);
+    return result;
+}
+
+/**
+ * 切り出した結果を表示する
+ */
+void print_submodel_statistics(const SubmodelStatistics* statistics) {
+    if (statistics == NULL) {
+        return;
+    }
+    printf("submodel: %d nodes (-%d), %d elements (-%d), %d cut nodes (%d tied by SUB1), %d loads moved to the cut faces, %d cards removed, %.3f ms\n",
+           statistics->node_num, statistics->removed_node_num, statistics->element_num, statistics->removed_element_num,
+           statistics->cut_node_num, statistics->tied_node_num, statistics->moved_card_num, statistics->removed_card_num,
+           statistics->elapsed_ms);
+}
+
+/**
+ * 既存の ffi から部分モデルを切り出して書き込む
+ *
+ * @param node_map_file_name, element_map_file_name 新しい番号 -> 元の番号の対応表(CSV)。NULLの場合は書き込まない
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int extract_submodel_file(const char* input_file_name, const char* output_file_name, const SelectBox* box,
+                          const char* node_map_file_name, const char* element_map_file_name) {
+    MeshModel* model = create_mesh_model();
+    if (model == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (read_mesh_model(input_file_name, model) != MESH_MODEL_SUCCESS) {
+        fprintf(stderr, "Error: Failed to read %s\n", input_file_name);
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+    int* original_node = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+    int* original_element = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+    SubmodelStatistics statistics;
+    int result = EXIT_SUCCESS;
+    if (original_node == NULL || original_element == NULL) {
+        fprintf(stderr, "Error: Memory allocation for extract_submodel_file failed\n");
+        result = EXIT_FAILURE;
+    }
+    if (result == EXIT_SUCCESS) {
+        result = extract_submodel(model, box, original_node, original_element, &statistics);
+    }
+    if (result == EXIT_SUCCESS) {
+        print_submodel_statistics(&statistics);
+        if (write_mesh_model(output_file_name, model) != MESH_MODEL_SUCCESS) {
+            fprintf(stderr, "Error: Failed to write %s\n", output_file_name);
+            result = EXIT_FAILURE;
+        }
+    }
+    if (result == EXIT_SUCCESS && node_map_file_name != NULL) {
+        result = write_node_map(node_map_file_name, model, original_node);
+    }
+    if (result == EXIT_SUCCESS && element_map_file_name != NULL) {
+        result = write_element_map(element_map_file_name, model, original_element);
+    }
+    free(original_node);
+    free(original_element);
+    free_mesh_model(model);
+    return result;
+}
@@ -0,0 +1,461 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "model_estimate.h"
+#include "function.h"
+
+/**
+ * 解析モデルの規模の予測(--estimate)
+ *
+ * add_column_hexa、add_rebar_fiber、add_joint_quad、add_beam_hexa、add_beam_quad、
+ * add_interface_elements が作る節点、要素の数を境界点(boundary_index)から数える。
+ * 要素数は各関数の要素の並べ方と同じ式、節点数は部位の格子点(柱と接合部の境界面で
+ * 二重にする節点を含む)の数で、ffiを書き込まずに求まる。
+ */
+
+static void set_part(ModelEstimatePart* part, const char* name, int node_num, int element_num) {
+    part->name = name;
+    part->node_num = node_num;
+    part->element_num = element_num;
+    part->card_num = 0;
+    part->bytes = 0;
+}
+
+// カードの書き方の予測 -----------------------------------------------------------------------
+static void add_cards(ModelEstimatePart* part, long card_num, int card_bytes) {
+    if (card_num > 0) {
+        part->card_num += card_num;
+        part->bytes += card_num * card_bytes;
+    }
+}
+
+// 区切りの行("---- ...")と空行
+static void add_lines(ModelEstimatePart* part, int comment_num, int blank_num) {
+    part->bytes += (long)comment_num * MODEL_ESTIMATE_COMMENT_BYTES + blank_num;
+}
+
+/**
+ * start ... end の間隔が等しい区間の数(plot_node が1方向に書く COPY :NODE の枚数)
+ */
+static int count_spacing_runs(const NodeCoordinate* coordinate, int start, int end) {
+    int run_num = 0;
+    for (int i = start; i < end;) {
+        int count = count_consecutive(i, end, coordinate->coordinate, coordinate->node_num);
+        if (count <= 0) {
+            break;
+        }
+        run_num++;
+        i += count;
+    }
+    return run_num;
+}
+
+/**
+ * plot_node の NODE、COPY :NODE カードと最後の空行
+ */
+static void add_plot_node(ModelEstimatePart* part, const ModelingData* modeling_data, const int start[3], const int end[3]) {
+    const NodeCoordinate* coordinates[3] = {modeling_data->x, modeling_data->y, modeling_data->z};
+    long copy_num = 0;
+    int dir = 0;
+    // 1次元、2次元コピー
+    for (int round = 0; round < 2; round++) {
+        for (; dir < 3; dir++) {
+            if (end[dir] > start[dir]) {
+                copy_num += count_spacing_runs(coordinates[dir], start[dir], end[dir]);
+                dir++;
+                break;
+            }
+        }
+    }
+    // 3次元コピー(y 方向の節点の列ごとに z 方向)
+    if (dir < 3 && end[dir] > start[dir]) {
+        copy_num += (long)(end[DIR_Y] - start[DIR_Y] + 1) * count_spacing_runs(coordinates[DIR_Z], start[DIR_Z], end[DIR_Z]);
+    }
+    add_cards(part, 1, MODEL_ESTIMATE_NODE_CARD_BYTES);
+    add_cards(part, copy_num, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    add_lines(part, 0, 1);
+}
+
+/**
+ * generate_hexa の HEXA、COPY :ELM カード(節点は add_plot_node)
+ */
+static void add_hexa_copy(ModelEstimatePart* part, const int start[3], const int end[3]) {
+    int set_x = end[DIR_X] - start[DIR_X] - 1;
+    int set_y = end[DIR_Y] - start[DIR_Y] - 1;
+    int set_z = end[DIR_Z] - start[DIR_Z] - 1;
+    long copy_num = (set_x > 0) + (set_y > 0);
+    if (set_z > 0) {
+        copy_num += (set_x > 0 && set_y > 0) ? end[DIR_Y] - start[DIR_Y] : 1;
+    }
+    add_cards(part, 1, MODEL_ESTIMATE_HEXA_CARD_BYTES);
+    add_cards(part, copy_num, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    add_lines(part, 0, 1);
+}
+
+static void set_range(int range[3], int x, int y, int z) {
+    range[DIR_X] = x;
+    range[DIR_Y] = y;
+    range[DIR_Z] = z;
+}
+
+/**
+ * add_column_hexa のカード
+ *
+ * 柱の上下は generate_hexa、接合部の内部は plot_node と HEXA 1枚 + COPY、接合部の上下面は
+ * 要素の列ごとの HEXA と COPY、かぶり、治具、接合部外部のタイプは ETYP で書く。
+ */
+static void estimate_column_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    const RebarFiber* rebar = modeling_data->rebar_fiber;
+    int start[3];
+    int end[3];
+
+    // かぶりの要素の列(x 方向は主筋の外側の列ごと、y 方向は1枚)
+    int x_min = b[COLUMN_BEAM_X];
+    int x_max = b[BEAM_COLUMN_X];
+    int y_min = b[CENTER_Y];
+    for (int i = 0; i < rebar->rebar_num; i++) {
+        if (rebar->positions[i].x < x_min) x_min = rebar->positions[i].x;
+        if (rebar->positions[i].x > x_max) x_max = rebar->positions[i].x;
+        if (rebar->positions[i].y < y_min) y_min = rebar->positions[i].y;
+    }
+    int cover_num = (x_min - b[BEAM_COLUMN_X]) + (b[COLUMN_BEAM_X] - x_max) + (y_min > b[COLUMN_SURFACE_START_Y] ? 1 : 0);
+
+    add_lines(part, 1, 0);
+    // 柱の下部、上部
+    const BoundaryType column_z[2][2] = {{COLUMN_START_Z, COLUMN_BEAM_Z}, {BEAM_COLUMN_Z, COLUMN_END_Z}};
+    for (int i = 0; i < 2; i++) {
+        set_range(start, b[BEAM_COLUMN_X], b[COLUMN_SURFACE_START_Y], b[column_z[i][0]]);
+        set_range(end, b[COLUMN_BEAM_X], b[CENTER_Y], b[column_z[i][1]]);
+        add_lines(part, 1, 0);
+        add_plot_node(part, modeling_data, start, end);
+        add_hexa_copy(part, start, end);
+        add_cards(part, 1 + cover_num, MODEL_ESTIMATE_ETYP_CARD_BYTES);
+        add_lines(part, 0, 1);
+    }
+
+    // 接合部の内部の節点(柱芯の左右)
+    add_lines(part, 1, 0);
+    set_range(start, b[BEAM_COLUMN_X], b[COLUMN_SURFACE_START_Y], b[COLUMN_BEAM_Z] + 1);
+    set_range(end, b[COLUMN_CENTER_X], b[CENTER_Y], b[BEAM_COLUMN_Z] - 1);
+    add_plot_node(part, modeling_data, start, end);
+    start[DIR_X] = b[COLUMN_CENTER_X];
+    end[DIR_X] = b[COLUMN_BEAM_X];
+    add_plot_node(part, modeling_data, start, end);
+
+    // 柱と接合部の境界面の節点(直交梁フランジの左右、梁フランジの左右)
+    const BoundaryType boundary_z[2] = {COLUMN_BEAM_Z, BEAM_COLUMN_Z};
+    for (int i = 0; i < 2; i++) {
+        int z = b[boundary_z[i]];
+        add_lines(part, 1, 0);
+        set_range(start, b[COLUMN_ORTHOGONAL_BEAM_X] + 1, b[COLUMN_SURFACE_START_Y], z);
+        set_range(end, b[COLUMN_CENTER_X], b[COLUMN_BEAM_Y], z);
+        add_plot_node(part, modeling_data, start, end);
+        start[DIR_X] = b[COLUMN_CENTER_X];
+        end[DIR_X] = b[ORTHOGONAL_BEAM_COLUMN_X] - 1;
+        add_plot_node(part, modeling_data, start, end);
+        set_range(start, b[BEAM_COLUMN_X], b[COLUMN_BEAM_Y] + 1, z);
+        set_range(end, b[COLUMN_CENTER_X], b[CENTER_Y], z);
+        add_plot_node(part, modeling_data, start, end);
+        start[DIR_X] = b[COLUMN_CENTER_X];
+        end[DIR_X] = b[COLUMN_BEAM_X];
+        add_plot_node(part, modeling_data, start, end);
+    }
+
+    // 接合部の内部の要素(左右に HEXA 1枚、x、y の COPY、y の列ごとに z の COPY)
+    int ny = b[CENTER_Y] - b[COLUMN_SURFACE_START_Y];
+    if (b[BEAM_COLUMN_Z] - b[COLUMN_BEAM_Z] > 2) {
+        add_lines(part, 2, 2);
+        add_cards(part, 2, MODEL_ESTIMATE_HEXA_CARD_BYTES);
+        add_cards(part, 2L * (2 + ny), MODEL_ESTIMATE_COPY_CARD_BYTES);
+    }
+
+    // 接合部の上下面: 直交梁フランジの x の列ごとに HEXA + COPY 2枚、梁フランジの y の列ごとに左右で HEXA + COPY 2枚
+    int orthogonal_num = b[ORTHOGONAL_BEAM_COLUMN_X] - b[COLUMN_ORTHOGONAL_BEAM_X] - 2;
+    int flange_num = b[CENTER_Y] - b[COLUMN_BEAM_Y] - 1;
+    add_lines(part, 2, 1);
+    if (orthogonal_num > 0) {
+        add_cards(part, orthogonal_num, MODEL_ESTIMATE_HEXA_CARD_BYTES);
+        add_cards(part, 2L * orthogonal_num, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    }
+    if (flange_num > 0) {
+        add_cards(part, 2L * flange_num, MODEL_ESTIMATE_HEXA_CARD_BYTES);
+        add_cards(part, 4L * flange_num, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    }
+
+    // 接合部の辺(edge 1 ... 11)と接合部外部の ETYP(直交梁の y の層ごと)
+    add_lines(part, MODEL_ESTIMATE_EDGE_NUM, MODEL_ESTIMATE_EDGE_NUM + 1);
+    add_cards(part, MODEL_ESTIMATE_EDGE_HEXA_NUM, MODEL_ESTIMATE_HEXA_CARD_BYTES);
+    add_cards(part, MODEL_ESTIMATE_EDGE_COPY_NUM, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    add_cards(part, b[COLUMN_BEAM_Y] - b[COLUMN_SURFACE_START_Y] + 1, MODEL_ESTIMATE_ETYP_CARD_BYTES);
+}
+
+/**
+ * add_rebar_fiber のカード(主筋ごとに plot_node、BEAM 1枚 + COPY)
+ */
+static void estimate_rebar_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    const RebarFiber* rebar = modeling_data->rebar_fiber;
+    add_lines(part, 1, 1);
+    for (int i = 0; i < rebar->rebar_num; i++) {
+        int start[3] = {rebar->positions[i].x, rebar->positions[i].y, b[JIG_COLUMN_Z]};
+        int end[3] = {rebar->positions[i].x, rebar->positions[i].y, b[COLUMN_JIG_Z]};
+        add_lines(part, 1, 1);
+        add_plot_node(part, modeling_data, start, end);
+        add_cards(part, 1, MODEL_ESTIMATE_BEAM_CARD_BYTES);
+        add_cards(part, 1, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    }
+}
+
+/**
+ * add_joint_quad のカード(鋼板ごとに plot_node と QUAD 1枚 + COPY 2枚)
+ */
+static void estimate_joint_quad_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    int start[3];
+    int end[3];
+
+    // yz 面: ふさぎ板 2枚と直交梁ウェブ
+    add_lines(part, 2, 0);
+    const BoundaryType yz_x[3] = {BEAM_COLUMN_X, COLUMN_CENTER_X, COLUMN_BEAM_X};
+    for (int i = 0; i < 3; i++) {
+        set_range(start, b[yz_x[i]], b[COLUMN_SURFACE_START_Y], b[COLUMN_BEAM_Z]);
+        set_range(end, b[yz_x[i]], b[CENTER_Y], b[BEAM_COLUMN_Z]);
+        add_plot_node(part, modeling_data, start, end);
+        add_cards(part, 1, MODEL_ESTIMATE_QUAD_CARD_BYTES);
+        add_cards(part, 2, MODEL_ESTIMATE_COPY_CARD_BYTES);
+        add_lines(part, 0, 1);
+    }
+
+    // zx 面: 手前のふさぎ板と梁ウェブ(節点は柱芯の左右)
+    add_lines(part, 1, 0);
+    const BoundaryType zx_y[2] = {COLUMN_SURFACE_START_Y, CENTER_Y};
+    for (int i = 0; i < 2; i++) {
+        set_range(start, b[BEAM_COLUMN_X] + 1, b[zx_y[i]], b[COLUMN_BEAM_Z]);
+        set_range(end, b[COLUMN_CENTER_X] - 1, b[zx_y[i]], b[BEAM_COLUMN_Z]);
+        add_plot_node(part, modeling_data, start, end);
+        start[DIR_X] = b[COLUMN_CENTER_X] + 1;
+        end[DIR_X] = b[COLUMN_BEAM_X] - 1;
+        add_plot_node(part, modeling_data, start, end);
+        add_cards(part, 1, MODEL_ESTIMATE_QUAD_CARD_BYTES);
+        add_cards(part, 2, MODEL_ESTIMATE_COPY_CARD_BYTES);
+        add_lines(part, 0, 1);
+    }
+
+    // xy 面: 上下のフランジ(直交梁フランジ、梁フランジの柱芯の左右)
+    add_lines(part, 1, 1);
+    const BoundaryType xy_z[2] = {COLUMN_BEAM_Z, BEAM_COLUMN_Z};
+    for (int i = 0; i < 2; i++) {
+        int z = b[xy_z[i]];
+        set_range(start, b[COLUMN_ORTHOGONAL_BEAM_X], b[COLUMN_SURFACE_START_Y] + 1, z);
+        set_range(end, b[COLUMN_CENTER_X] - 1, b[COLUMN_BEAM_Y] - 1, z);
+        add_plot_node(part, modeling_data, start, end);
+        start[DIR_X] = b[COLUMN_CENTER_X] + 1;
+        end[DIR_X] = b[ORTHOGONAL_BEAM_COLUMN_X];
+        add_plot_node(part, modeling_data, start, end);
+        set_range(start, b[BEAM_COLUMN_X] + 1, b[COLUMN_BEAM_Y], z);
+        set_range(end, b[COLUMN_CENTER_X] - 1, b[CENTER_Y] - 1, z);
+        add_plot_node(part, modeling_data, start, end);
+        start[DIR_X] = b[COLUMN_CENTER_X] + 1;
+        end[DIR_X] = b[COLUMN_BEAM_X] - 1;
+        add_plot_node(part, modeling_data, start, end);
+        add_cards(part, 4, MODEL_ESTIMATE_QUAD_CARD_BYTES);
+        add_cards(part, 8, MODEL_ESTIMATE_COPY_CARD_BYTES);
+        add_lines(part, 0, 1);
+    }
+}
+
+/**
+ * 主筋の付着(add_interface_elements、mesh_copy.c)のカード
+ *
+ * 主筋とコンクリートの節点番号の増分が同じ場合、柱の下部、接合部の内部、上部の区間はそれぞれ LINE + COPY、
+ * 柱と接合部の境界面をまたぐ2要素は1枚ずつ。compact_id_gaps で主筋の増分を詰めた場合は COPY で複写できず1要素ずつ。
+ */
+static void estimate_line_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    const RebarFiber* rebar = modeling_data->rebar_fiber;
+    add_lines(part, 1, 1);
+    if (rebar->increment.node != modeling_data->column_hexa.increment[DIR_Z].node) {
+        add_cards(part, (long)rebar->rebar_num * (b[COLUMN_JIG_Z] - b[JIG_COLUMN_Z]), MODEL_ESTIMATE_LINE_CARD_BYTES);
+        return;
+    }
+    int run[3] = {
+        b[COLUMN_BEAM_Z] - b[JIG_COLUMN_Z],
+        b[BEAM_COLUMN_Z] - b[COLUMN_BEAM_Z] - 2,
+        b[COLUMN_JIG_Z] - b[BEAM_COLUMN_Z]
+    };
+    long line_num = 2;
+    long copy_num = 0;
+    for (int i = 0; i < 3; i++) {
+        line_num += run[i] > 0;
+        copy_num += run[i] > 1;
+    }
+    add_cards(part, rebar->rebar_num * line_num, MODEL_ESTIMATE_LINE_CARD_BYTES);
+    add_cards(part, rebar->rebar_num * copy_num, MODEL_ESTIMATE_COPY_CARD_BYTES);
+}
+
+/**
+ * 接合部フィルム(add_interface_elements、mesh_copy.c)のカード
+ *
+ * 鋼板の上下のコンクリートの節点番号は直交梁ウェブ、柱と接合部の境界面で揃わないため、FILM + COPY の組は
+ * フランジの y の層ごとにできる。層当りの枚数は生成したモデル(test_min、test1 ... test3)の FILM カードから求めた。
+ */
+static void estimate_film_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    long film_num = (long)MODEL_ESTIMATE_FILM_ORTHOGONAL_ROW_CARD_NUM * (b[COLUMN_BEAM_Y] - b[COLUMN_SURFACE_START_Y]) +
+                    (long)MODEL_ESTIMATE_FILM_BEAM_ROW_CARD_NUM * (b[CENTER_Y] - b[COLUMN_BEAM_Y]) - MODEL_ESTIMATE_FILM_SHARED_CARD_NUM;
+    add_lines(part, 1, 1);
+    add_cards(part, film_num, MODEL_ESTIMATE_FILM_CARD_BYTES);
+}
+
+/**
+ * add_beam_hexa(治具、block_mesh)と add_beam_quad(フランジ、ウェブ)のカード
+ */
+static void estimate_beam_cards(ModelEstimatePart* part, const ModelingData* modeling_data) {
+    const int* b = modeling_data->boundary_index;
+    int start[3];
+    int end[3];
+    int nz_joint = b[BEAM_COLUMN_Z] - b[COLUMN_BEAM_Z];
+    int ny_beam = b[CENTER_Y] - b[COLUMN_BEAM_Y];
+
+    // 治具(mesh_copy.c): 左のブロックを plot_node、generate_hexa と同じ形で書き、右のブロックは x 方向の COPY 1枚とみなす
+    add_lines(part, 1, 0);
+    set_range(start, b[BEAM_START_X], b[COLUMN_BEAM_Y], b[COLUMN_BEAM_Z]);
+    set_range(end, b[JIG_BEAM_X], b[CENTER_Y], b[BEAM_COLUMN_Z]);
+    add_plot_node(part, modeling_data, start, end);
+    add_hexa_copy(part, start, end);
+    add_cards(part, 2, MODEL_ESTIMATE_COPY_CARD_BYTES);
+
+    // フランジ、ウェブ
+    add_lines(part, 1, 1);
+    if (nz_joint > 2) {
+        const BoundaryType beam_x[2][2] = {{JIG_BEAM_X, BEAM_COLUMN_X}, {COLUMN_BEAM_X, BEAM_JIG_X}};
+        for (int i = 0; i < 2; i++) {
+            set_range(start, b[beam_x[i][0]] + 1, b[COLUMN_BEAM_Y], b[COLUMN_BEAM_Z]);
+            set_range(end, b[beam_x[i][1]] - 1, b[CENTER_Y], b[COLUMN_BEAM_Z]);
+            add_plot_node(part, modeling_data, start, end);
+            start[DIR_Z] = end[DIR_Z] = b[BEAM_COLUMN_Z];
+            add_plot_node(part, modeling_data, start, end);
+            set_range(start, b[beam_x[i][0]] + 1, b[CENTER_Y], b[COLUMN_BEAM_Z] + 1);
+            set_range(end, b[beam_x[i][1]] - 1, b[CENTER_Y], b[BEAM_COLUMN_Z] - 1);
+            add_plot_node(part, modeling_data, start, end);
+        }
+        add_cards(part, 2 * 3, MODEL_ESTIMATE_QUAD_CARD_BYTES);
+        add_cards(part, 2 * 6, MODEL_ESTIMATE_COPY_CARD_BYTES);
+    }
+    // 接合部の鋼板と梁をつなぐ要素は1枚ずつ
+    add_cards(part, 4L * ny_beam + 2L * nz_joint, MODEL_ESTIMATE_QUAD_CARD_BYTES);
+}
+
+/**
+ * ModelingData から節点、要素数、自由度、カード数、スカイラインの大きさを予測する
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE(引数が NULL)
+ */
+int estimate_model(const ModelingData* modeling_data, ModelEstimate* estimate) {
+    if (modeling_data == NULL || modeling_data->rebar_fiber == NULL || estimate == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to estimate_model\n");
+        return EXIT_FAILURE;
+    }
+    const int* b = modeling_data->boundary_index;
+
+    // 柱、接合部(y は梁芯まで)
+    int nx = b[COLUMN_BEAM_X] - b[BEAM_COLUMN_X];
+    int ny = b[CENTER_Y] - b[COLUMN_SURFACE_START_Y];
+    int nz = b[COLUMN_END_Z] - b[COLUMN_START_Z];
+    int nz_lower = b[COLUMN_BEAM_Z] - b[COLUMN_START_Z];
+    int nz_upper = b[COLUMN_END_Z] - b[BEAM_COLUMN_Z];
+    int nz_joint = b[BEAM_COLUMN_Z] - b[COLUMN_BEAM_Z];
+    // 直交梁(フランジの幅と、柱の面から梁のフランジまで)
+    int nx_orthogonal = b[ORTHOGONAL_BEAM_COLUMN_X] - b[COLUMN_ORTHOGONAL_BEAM_X];
+    int ny_orthogonal = b[COLUMN_BEAM_Y] - b[COLUMN_SURFACE_START_Y];
+    // 梁(フランジの幅は梁芯まで)
+    int ny_beam = b[CENTER_Y] - b[COLUMN_BEAM_Y];
+    int nx_beam = (b[BEAM_COLUMN_X] - b[JIG_BEAM_X]) + (b[BEAM_JIG_X] - b[COLUMN_BEAM_X]);
+    // 主筋
+    int nz_rebar = b[COLUMN_JIG_Z] - b[JIG_COLUMN_Z];
+    int rebar_num = modeling_data->rebar_fiber->rebar_num;
+
+    // 柱: 下柱、上柱、接合部(直交梁ウェブの面で x 方向に二重)、接合部の上下面のフランジ部分
+    int column_node =
+        (nx + 1) * (ny + 1) * (nz_lower + 1) +
+        (nx + 1) * (ny + 1) * (nz_upper + 1) +
+        (nx + 2) * (ny + 1) * (nz_joint - 1) +
+        2 * (nx_orthogonal * (ny_orthogonal + 1) + (nx + 2) * ny_beam);
+    set_part(&estimate->part[0], "column hexa", column_node, nx * ny * nz);
+    estimate_column_cards(&estimate->part[0], modeling_data);
+
+    set_part(&estimate->part[1], "rebar fiber", rebar_num * (nz_rebar + 1), rebar_num * nz_rebar);
+    estimate_rebar_cards(&estimate->part[1], modeling_data);
+
+    set_part(&estimate->part[2], "rebar line", 0, rebar_num * nz_rebar);
+    estimate_line_cards(&estimate->part[2], modeling_data);
+
+    // 接合部鋼板: 外周(x の2面、y = 0 の面、梁ウェブ)と直交梁ウェブ、上下面のフランジ
+    int perimeter = 2 * (nx + 1) + 2 * (ny + 1) - 4;
+    int layer = perimeter + (ny - 1);
+    int flange_rows = ny_beam - (ny_orthogonal == 0 ? 1 : 0);
+    int orthogonal_columns = nx_orthogonal + 1 - 1 -
+        (b[COLUMN_ORTHOGONAL_BEAM_X] == b[BEAM_COLUMN_X] ? 1 : 0) - (b[ORTHOGONAL_BEAM_COLUMN_X] == b[COLUMN_BEAM_X] ? 1 : 0);
+    int joint_node =
+        (nz_joint - 1) * layer +
+        2 * (layer + flange_rows * (nx - 2) + (ny_orthogonal > 0 ? (ny_orthogonal - 1) * orthogonal_columns : 0));
+    int flange_quad = 2 * nx * ny_beam + 2 * nx_orthogonal * ny_orthogonal;
+    int joint_quad = flange_quad + 2 * nx * nz_joint + 3 * ny * nz_joint;
+    set_part(&estimate->part[3], "joint quad", joint_node, joint_quad);
+    estimate_joint_quad_cards(&estimate->part[3], modeling_data);
+
+    // 接合部フィルム: 両側にコンクリートがある鋼板(フランジ、直交梁ウェブ)は2枚
+    int joint_film = 2 * flange_quad + 2 * nx * nz_joint + 4 * ny * nz_joint;
+    set_part(&estimate->part[4], "joint film", 0, joint_film);
+    estimate_film_cards(&estimate->part[4], modeling_data);
+
+    // 梁: 両端の治具(HEXA)と、上下フランジ、ウェブ(QUAD)
+    int beam_section_node = 2 * (ny_beam + 1) + (nz_joint - 1);
+    int beam_node = 2 * 2 * (ny_beam + 1) * (nz_joint + 1) + (nx_beam - 2) * beam_section_node;
+    int beam_element = 2 * ny_beam * nz_joint + nx_beam * (2 * ny_beam + nz_joint);
+    set_part(&estimate->part[5], "beam", beam_node, beam_element);
+    estimate_beam_cards(&estimate->part[5], modeling_data);
+
+    // 部位の外: 先頭、拘束、材料、荷重のカード(単調載荷)と柱端の SUB1(y の節点の列ごと、載荷点の前後で2枚)
+    estimate->node_num = 0;
+    estimate->element_num = 0;
+    estimate->card_num = MODEL_ESTIMATE_FIXED_CARD_NUM + 2L * (ny + 2);
+    estimate->bytes = MODEL_ESTIMATE_FIXED_BYTES + 2L * (ny + 2) * MODEL_ESTIMATE_SUB1_CARD_BYTES;
+    for (int p = 0; p < MODEL_ESTIMATE_PART_NUM; p++) {
+        estimate->node_num += estimate->part[p].node_num;
+        estimate->element_num += estimate->part[p].element_num;
+        estimate->card_num += estimate->part[p].card_num;
+        estimate->bytes += estimate->part[p].bytes;
+    }
+    estimate->dof = (long)estimate->node_num * MODEL_ESTIMATE_NODE_DOF;
+
+    // フロント幅: 柱は z 方向の1層(接合部の層、主筋、鋼板を含む)、梁は x 方向の1断面
+    long column_front = (long)MODEL_ESTIMATE_NODE_DOF * ((nx + 2) * (ny + 1) + rebar_num + layer);
+    long beam_front = (long)MODEL_ESTIMATE_NODE_DOF * beam_section_node;
+    long column_dof = (long)MODEL_ESTIMATE_NODE_DOF * (column_node + estimate->part[1].node_num + joint_node);
+    estimate->front = column_front > beam_front ? column_front : beam_front;
+    estimate->profile = (double)column_dof * column_front + (double)MODEL_ESTIMATE_NODE_DOF * beam_node * beam_front;
+    estimate->memory = estimate->profile * sizeof(double);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 予測を表示する
+ *
+ * @param elapsed_us 読み込みから予測までの時間(マイクロ秒)
+ */
+void print_model_estimate(const ModelEstimate* estimate, double elapsed_us) {
+    if (estimate == NULL) {
+        return;
+    }
+    printf("%-12s %8s %8s %8s %8s %10s\n", "part", "node", "element", "dof", "cards", "bytes");
+    for (int p = 0; p < MODEL_ESTIMATE_PART_NUM; p++) {
+        const ModelEstimatePart* part = &estimate->part[p];
+        printf("%-12s %8d %8d %8d %8ld %10ld\n", part->name, part->node_num, part->element_num,
+               part->node_num * MODEL_ESTIMATE_NODE_DOF, part->card_num, part->bytes);
+    }
+    printf("%-12s %8d %8d %8ld %8ld %10ld\n", "total", estimate->node_num, estimate->element_num, estimate->dof,
+           estimate->card_num, estimate->bytes);
+    printf("front: %ld dof, profile: %.0f, solver memory: %.1f MB\n", estimate->front, estimate->profile, estimate->memory / (1024.0 * 1024.0));
+    printf("estimate: %.0f us\n", elapsed_us);
+}
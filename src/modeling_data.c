@@ -213,6 +213,14 @@ void initialize_modeling_data(ModelingData* data) {
 /**
  * メモリは解放したらnullを入れる事
  */
+
+// 解放した事を表示するか(--estimate など、表示を結果だけにする場合は0)
+static int free_log_enabled = 1;
+
+void set_modeling_data_free_log(int enabled) {
+    free_log_enabled = enabled;
+}
+
 // NodeCoordinateのメモリ解放
 int free_node_coordinate(NodeCoordinate* node) {
     if (node == NULL) {
@@ -226,7 +234,7 @@ int free_node_coordinate(NodeCoordinate* node) {
     } else {
         free(node->coordinate);
         node->coordinate = NULL; // 解放後にNULLを設定
-        printf("NodeCoordinate->coordinate freed successfully\n");
+        if (free_log_enabled) printf("NodeCoordinate->coordinate freed successfully\n");
     }
 
     free(node);
@@ -245,7 +253,7 @@ int free_rebar_fiber(RebarFiber* rebar) {
     if (rebar->positions != NULL) {
         free(rebar->positions);
         rebar->positions = NULL; // 二重解放防止
-        printf("RebarFiber->positions freed successfully\n");
+        if (free_log_enabled) printf("RebarFiber->positions freed successfully\n");
     } else {
         fprintf(stderr, "Warning: RebarFiber->positions is already NULL\n");
     }
@@ -271,21 +279,21 @@ int free_modeling_data(ModelingData* data) {
         fprintf(stderr, "Error: Failed to free NodeCoordinate x\n");
         result = EXIT_FAILURE;
     } else {
-        printf("NodeCoordinate x freed successfully\n");
+        if (free_log_enabled) printf("NodeCoordinate x freed successfully\n");
     }
 
     if (free_node_coordinate(data->y) != EXIT_SUCCESS) {
         fprintf(stderr, "Error: Failed to free NodeCoordinate y\n");
         result = EXIT_FAILURE;
     } else {
-        printf("NodeCoordinate y freed successfully\n");
+        if (free_log_enabled) printf("NodeCoordinate y freed successfully\n");
     }
 
     if (free_node_coordinate(data->z) != EXIT_SUCCESS) {
         fprintf(stderr, "Error: Failed to free NodeCoordinate z\n");
         result = EXIT_FAILURE;
     } else {
-        printf("NodeCoordinate z freed successfully\n");
+        if (free_log_enabled) printf("NodeCoordinate z freed successfully\n");
     }
 
     // RebarFiberの解放
@@ -293,7 +301,7 @@ int free_modeling_data(ModelingData* data) {
         fprintf(stderr, "Error: Failed to free RebarFiber\n");
         result = EXIT_FAILURE;
     } else {
-        printf("RebarFiber freed successfully\n");
+        if (free_log_enabled) printf("RebarFiber freed successfully\n");
     }
 
     // ModelingData本体の解放
@@ -512,6 +520,10 @@ void print_beam(const char* name, BeamHexaQuad* beam, int indent) {
     }
     printf("\n");
     print_indent_md(indent + 1);
+    printf("\"occupied_indices\": ");
+    print_node_element(&beam->occupied_indices, 0);
+    printf(",\n");
+    print_indent_md(indent + 1);
     printf("\"head\": ");
     print_node_element(&beam->head, 0);
     printf("\n");
@@ -1,10 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include "json_parser.h"
 #include "function.h"
 #include "modeling_rcs.h"
 #include "print_ffi.h"
 #include "modeling_data.h"
+#include "mesh_quality.h"
+#include "mesh_renumber.h"
+#include "mesh_partition.h"
+#include "range_set.h"
+#include "block_mesh.h"
+#include "mesh_interface.h"
+#include "auto_mesh.h"
+#include "id_budget.h"
+#include "model_estimate.h"
+#include "mesh_mirror.h"
+#include "frame_assembly.h"
+#include "mesh_submodel.h"
+#include "mesh_rigid_jig.h"
+#include "mesh_bond_zone.h"
+#include "loading_protocol.h"
+#include "ffi_restart.h"
+#include "output_plan.h"
+#include "fiber_section.h"
 
 /**
  * source_dataからモデリングに必要なデータを作成し、modeling_dayaに格納する
@@ -205,6 +224,13 @@ int make_modeling_data(ModelingData* modeling_data, JsonData *source_data) {
     modeling_data->beam.increment[DIR_Z].element =
         (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] + 1) * modeling_data->beam.increment[DIR_Y].element;
     
+    // 必要節点、要素数(上フランジのQUADは梁せいの1層上の番号)
+    modeling_data->beam.occupied_indices.node =
+        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * modeling_data->beam.increment[DIR_Z].node;
+    modeling_data->beam.occupied_indices.element =
+        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * modeling_data->beam.increment[DIR_Z].element +
+        (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y]) * modeling_data->beam.increment[DIR_Y].element;
+
     modeling_data->beam.head.node = modeling_data->joint_quad.head.node + modeling_data->joint_quad.occupied_indices.node;
     modeling_data->beam.head.element = modeling_data->joint_film.head + modeling_data->joint_film.occupied_indices;
     
@@ -500,6 +526,11 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         modeling_data->column_hexa.increment[DIR_Z].element
     };
 
+    // ETYPでタイプを変える要素番号(範囲の組にまとめて書き込む)
+    int* type_ids = NULL;
+    int type_num = 0;
+    int type_capacity = 0;
+
     // 柱、下部 -----------------------------------------------------
     int start[3] = {
         modeling_data->boundary_index[BEAM_COLUMN_X],
@@ -544,7 +575,7 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_X], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_X], element_increment[DIR_Z], element_set);
     }
 
     // かぶりコンクリート要素番号 y方向
@@ -556,7 +587,7 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[CENTER_Y] - y_min) * element_increment[DIR_Y];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_Y], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_Y], element_increment[DIR_Z], element_set);
     }
     for(int i = x_max - modeling_data->boundary_index[BEAM_COLUMN_X]; i < modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]; i++) {
         start_elmemnt_index = modeling_data->column_hexa.head.element +
@@ -566,8 +597,10 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[CENTER_Y] - y_min) * element_increment[DIR_Y];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_Y], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_Y], element_increment[DIR_Z], element_set);
     }
+    print_ETYP_set(f, type_ids, type_num, typh.column_cover);
+    type_num = 0;
     fprintf(f, "\n");
 
     // 柱、上部 -----------------------------------------------------
@@ -594,7 +627,7 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_X], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_X], element_increment[DIR_Z], element_set);
     }
     // かぶりコンクリート要素番号 y方向
     for(int i = 0; i < x_min - modeling_data->boundary_index[BEAM_COLUMN_X]; i++) {
@@ -605,7 +638,7 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[CENTER_Y] - y_min) * element_increment[DIR_Y];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_Y], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_Y], element_increment[DIR_Z], element_set);
     }
     for(int i = x_max - modeling_data->boundary_index[BEAM_COLUMN_X]; i < modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]; i++) {
         start_elmemnt_index = modeling_data->column_hexa.head.element +
@@ -615,8 +648,10 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[CENTER_Y] - y_min) * element_increment[DIR_Y];
         element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_Y], typh.column_cover, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_Y], element_increment[DIR_Z], element_set);
     }
+    print_ETYP_set(f, type_ids, type_num, typh.column_cover);
+    type_num = 0;
     fprintf(f, "\n");
 
     // 接合部 -----------------------------------------------------
@@ -1104,7 +1139,7 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X];
         element_set = (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_X], typh.joint_outer, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_X], element_increment[DIR_Z], element_set);
     }
     // 右
     for(int i = modeling_data->boundary_index[COLUMN_SURFACE_START_Y]; i < modeling_data->boundary_index[COLUMN_BEAM_Y]; i++) {
@@ -1115,8 +1150,10 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
         end_element_index =
             start_elmemnt_index + (modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - 1) * element_increment[DIR_X];
         element_set = (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-        print_ETYP(f, start_elmemnt_index, end_element_index, element_increment[DIR_X], typh.joint_outer, element_increment[DIR_Z], element_set);
+        append_range_ids(&type_ids, &type_num, &type_capacity, start_elmemnt_index, end_element_index, element_increment[DIR_X], element_increment[DIR_Z], element_set);
     }
+    print_ETYP_set(f, type_ids, type_num, typh.joint_outer);
+    free(type_ids);
     fprintf(f, "\n");
 }
 
@@ -1124,41 +1161,12 @@ void add_column_hexa(FILE *f, ModelingData *modeling_data) {
  * 柱の節点番号を返す.
  * x,y,zは0から始まる
  */
-int search_column_node(int column_head, int increment[], int boundary_index[], int x, int y, int z) {
-    
-    if(x < 0 || y < 0 || z < 0) {
-        printf("error ## < 0\n");
-        return -1;  // 不正な値
-    }
-
-    int x_form_column = x - boundary_index[BEAM_COLUMN_X];
-
-    // z方向、柱、接合部上下面、接合部内か判定
-    if(z <= boundary_index[COLUMN_BEAM_Z]) {
-        // 下柱
-        return column_head + increment[DIR_X] * x_form_column  + increment[DIR_Y] * y  + increment[DIR_Z] * z;
-    } else if(z <= boundary_index[BEAM_COLUMN_Z] + 1) {
-        // 接合部
-        if(x <= boundary_index[COLUMN_CENTER_X]) {
-            return column_head + increment[DIR_X] * x_form_column  + increment[DIR_Y] * y  + increment[DIR_Z] * z;
-        } else {
-            return column_head + increment[DIR_X] * (x_form_column + 1) + increment[DIR_Y] * y + increment[DIR_Z] * z;
-        }
-    }else if(z <= boundary_index[COLUMN_END_Z] + 2) {
-        // 上柱
-        return column_head + increment[DIR_X] * x_form_column  + increment[DIR_Y] * y  + increment[DIR_Z] * z;
-    } else {
-        printf("error\n");
-        return -1;
-    }
-    return -1;
-}
-
 /**
  * 柱主筋
+ * 主筋とコンクリートの付着(LINE要素)は add_interface_elements で作る。
  */
-void add_reber_fiber_line(FILE *f, ModelingData *modeling_data) {
-    fprintf(f, "---- REBAR FIBER LINE ----\n");
+void add_rebar_fiber(FILE *f, ModelingData *modeling_data) {
+    fprintf(f, "---- REBAR FIBER ----\n");
     // ポインタ配列に各方向を格納
     NodeCoordinate* coordinates[3] = {modeling_data->x, modeling_data->y, modeling_data->z};
 
@@ -1189,98 +1197,6 @@ void add_reber_fiber_line(FILE *f, ModelingData *modeling_data) {
         int element_set = (modeling_data->boundary_index[COLUMN_JIG_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
         print_COPYELM(f, start_element, 0, 0, modeling_data->rebar_fiber->increment.element, modeling_data->rebar_fiber->increment.node, element_set);
         fprintf(f, "\n");
-        // ライン要素
-        fprintf(f, "---- line\n");
-        // 下柱部分
-        int column_increment[3] = {
-            modeling_data->column_hexa.increment[DIR_X].node,
-            modeling_data->column_hexa.increment[DIR_Y].node,
-            modeling_data->column_hexa.increment[DIR_Z].node
-        };
-        int line_start_element = modeling_data->rebar_line.head.element + i * modeling_data->rebar_line.occupied_indices_single.element;
-        int column_node = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-        print_LINE_increment(f, line_start_element, start_node, column_node, modeling_data->rebar_fiber->increment.node);
-        element_set = (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1);
-        if(element_set > 0) {
-            print_COPYELM(f, line_start_element, 0, 0, modeling_data->rebar_line.increment.element, modeling_data->rebar_fiber->increment.node, element_set);
-        }
-        // 接合部下境界面
-        start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z];
-        end[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 2;
-        line_start_element =
-            modeling_data->rebar_line.head.element +
-            (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z]) * modeling_data->rebar_line.increment.element +
-            i * modeling_data->rebar_line.occupied_indices_single.element;
-        int line_node[4] = {
-            modeling_data->rebar_fiber->head.node +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z]) * modeling_data->rebar_fiber->increment.node +
-                i * modeling_data->rebar_fiber->occupied_indices_single.node,
-            modeling_data->rebar_fiber->head.node +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] + 1) * modeling_data->rebar_fiber->increment.node +
-                i * modeling_data->rebar_fiber->occupied_indices_single.node,
-            search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]),
-            search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, end[DIR_X], end[DIR_Y], end[DIR_Z])
-        };
-        print_LINE_node(f, line_start_element, line_node);
-        // 接合部内
-        if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2 ) {
-            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 2;
-            end[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 3;
-            line_start_element =
-                modeling_data->rebar_line.head.element +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] + 1) * modeling_data->rebar_line.increment.element +
-                i * modeling_data->rebar_line.occupied_indices_single.element;
-            line_node[0] = modeling_data->rebar_fiber->head.node +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] + 1) * modeling_data->rebar_fiber->increment.node +
-                i * modeling_data->rebar_fiber->occupied_indices_single.node;
-            line_node[1] = modeling_data->rebar_fiber->head.node +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] + 2) * modeling_data->rebar_fiber->increment.node +
-                i * modeling_data->rebar_fiber->occupied_indices_single.node,
-            line_node[2] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            line_node[3] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, end[DIR_X], end[DIR_Y], end[DIR_Z]);
-            print_LINE_node(f, line_start_element, line_node);
-            element_set = (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3);
-            if(element_set > 0) {
-                print_COPYELM(f, line_start_element, 0, 0, modeling_data->rebar_fiber->increment.element, modeling_data->rebar_fiber->increment.node, element_set);
-            }
-        }
-        // 接合部上境界面
-        start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-        end[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z] + 2;
-        line_start_element =
-            modeling_data->rebar_line.head.element +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1) * modeling_data->rebar_line.increment.element +
-            i * modeling_data->rebar_line.occupied_indices_single.element;
-        line_node[0] = modeling_data->rebar_fiber->head.node +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] - 1) * modeling_data->rebar_fiber->increment.node +
-            i * modeling_data->rebar_fiber->occupied_indices_single.node;
-        line_node[1] = modeling_data->rebar_fiber->head.node +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z]) * modeling_data->rebar_fiber->increment.node +
-            i * modeling_data->rebar_fiber->occupied_indices_single.node,
-        line_node[2] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-        line_node[3] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, end[DIR_X], end[DIR_Y], end[DIR_Z]);
-        print_LINE_node(f, line_start_element, line_node);
-        // 上柱
-        start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z] + 2;
-        end[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z] + 3;
-        line_start_element =
-            modeling_data->rebar_line.head.element +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z]) * modeling_data->rebar_line.increment.element +
-            i * modeling_data->rebar_line.occupied_indices_single.element;
-        line_node[0] = modeling_data->rebar_fiber->head.node +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z]) * modeling_data->rebar_fiber->increment.node +
-            i * modeling_data->rebar_fiber->occupied_indices_single.node;
-        line_node[1] = modeling_data->rebar_fiber->head.node +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[JIG_COLUMN_Z] + 1) * modeling_data->rebar_fiber->increment.node +
-            i * modeling_data->rebar_fiber->occupied_indices_single.node,
-        line_node[2] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-        line_node[3] = search_column_node(modeling_data->column_hexa.head.node, column_increment, modeling_data->boundary_index, end[DIR_X], end[DIR_Y], end[DIR_Z]);
-        print_LINE_node(f, line_start_element, line_node);
-        element_set = (modeling_data->boundary_index[COLUMN_JIG_Z] - modeling_data->boundary_index[BEAM_COLUMN_Z] - 1);
-        if(element_set > 0) {
-            print_COPYELM(f, line_start_element, 0, 0, modeling_data->rebar_fiber->increment.element, modeling_data->rebar_fiber->increment.node, element_set);
-        }
-        fprintf(f, "\n");
     }
     fprintf(f, "\n");
 }
@@ -1616,1550 +1532,111 @@ void add_joint_quad(FILE *f, ModelingData *modeling_data) {
     fprintf(f, "\n");
 }
 
-/**
- * 接合部FILM要素
- */
-void add_joint_film(FILE *f, ModelingData *modeling_data) {
-    fprintf(f, "---- JOINT FILM ----\n");
+void add_beam_hexa(FILE *f, ModelingData *modeling_data) {
+    fprintf(f, "---- BEAM HEXA ----\n");
+    double* axis[3] = {modeling_data->x->coordinate, modeling_data->y->coordinate, modeling_data->z->coordinate};
+    int axis_num[3] = {modeling_data->x->node_num, modeling_data->y->node_num, modeling_data->z->node_num};
+    BlockMesh* mesh = create_block_mesh(axis, axis_num);
+    if (mesh == NULL) {
+        return;
+    }
 
     int node_increment[3] = {
-        modeling_data->column_hexa.increment[DIR_X].node,
-        modeling_data->column_hexa.increment[DIR_Y].node,
-        modeling_data->column_hexa.increment[DIR_Z].node
+        modeling_data->beam.increment[0].node,
+        modeling_data->beam.increment[1].node,
+        modeling_data->beam.increment[2].node
     };
     int element_increment[3] = {
-        modeling_data->joint_quad.increment_element[DIR_X],
-        modeling_data->joint_quad.increment_element[DIR_Y],
-        modeling_data->joint_quad.increment_element[DIR_Z]
+        modeling_data->beam.increment[0].element,
+        modeling_data->beam.increment[1].element,
+        modeling_data->beam.increment[2].element
     };
 
-    // yz面 支圧板、ふさぎ板、直交梁ウェブ ---------------------------------------------------------
-    fprintf(f, "---- yz\n");
-    for(int i = 0; i < 3; i++) {
-        BoundaryType boundary_type;
-        switch (i) {
-        case 0:
-            // ふさぎ板
-            boundary_type = BEAM_COLUMN_X;
-            break;
-        case 1:
-            // 直交梁ウェブ
-            boundary_type = COLUMN_CENTER_X;
-            break;
-        case 2:
-            // ふさぎ板
-            boundary_type = COLUMN_BEAM_X;
-            break;
-        default:
-            // 例外
-            boundary_type = -1;
-            break;
-        }
-        int start_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X];
-        int start[3] = {
-            modeling_data->boundary_index[boundary_type],
-            modeling_data->boundary_index[COLUMN_SURFACE_START_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Z]
-        };
+    // 左 -----------------------------------------------------
+    int start[3] = {
+        modeling_data->boundary_index[BEAM_START_X],
+        modeling_data->boundary_index[COLUMN_BEAM_Y],
+        modeling_data->boundary_index[COLUMN_BEAM_Z]
+    };
+    int end[3] = {
+        modeling_data->boundary_index[JIG_BEAM_X],
+        modeling_data->boundary_index[CENTER_Y],
+        modeling_data->boundary_index[BEAM_COLUMN_Z]
+    };
+    add_mesh_block(mesh, start, end, 5);
+    // 番号は左の梁の先頭から(右の梁は治具の分だけ x 方向にずれる)
+    set_block_numbering(mesh, start, modeling_data->beam.head.node, modeling_data->beam.head.element, node_increment, element_increment);
 
-        if(boundary_type == BEAM_COLUMN_X || boundary_type == COLUMN_BEAM_X) {
-            int typf = 1;
-            int element_diff = 0;
-            if(boundary_type == COLUMN_BEAM_X) {
-                element_diff = 3;
-            }
-            // 外部要素
-            // 柱付け根（必須）
-            int film_index =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_COLUMN_X] + element_diff) * element_increment[DIR_X] +
-                element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            int face1[4] = {
-                start_node,
-                start_node + node_increment[DIR_Y],
-                start_node + node_increment[DIR_Z] + node_increment[DIR_Y],
-                start_node + node_increment[DIR_Z]
-            };
-            int face2[4] = {
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z]),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 2),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2)
-            };
-            if(boundary_type == COLUMN_BEAM_X) {
-                // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                reverse_array(face1, 4);
-                reverse_array(face2, 4);
-            }
-            print_FILM_node(f, film_index, face1, face2, typf);
-            int pre_element = film_index;
-            film_index += (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z];
-            for(int j = 0; j < 4; j++) {
-                face1[j] += (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            }
-            start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z]);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 2);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            if(boundary_type == COLUMN_BEAM_X) {
-                // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                reverse_array(face2, 4);
-            }
-            print_FILM_node(f, film_index, face1, face2, typf);
-            print_COPYELM(f, pre_element, film_index, film_index - pre_element, element_increment[DIR_Y], node_increment[DIR_Y], modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1);
-            // 境界 必ずあると仮定
-            start[DIR_Y] = modeling_data->boundary_index[COLUMN_BEAM_Y];
-            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z];
-            film_index =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_COLUMN_X] + element_diff) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            face1[0] = start_node + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            face1[1] = face1[0] + node_increment[DIR_Y];
-            face1[2] = face1[0] + node_increment[DIR_Z] + node_increment[DIR_Y];
-            face1[3] = face1[0] + node_increment[DIR_Z];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 1);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 2);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            if(boundary_type == COLUMN_BEAM_X) {
-                // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                reverse_array(face1, 4);
-                reverse_array(face2, 4);
-            }
-            print_FILM_node(f, film_index, face1, face2, typf);
-            film_index += (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z];
-            for(int j = 0; j < 4; j++) {
-                face1[j] += (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            }
-            start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z]);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 1);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            if(boundary_type == COLUMN_BEAM_X) {
-                // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                reverse_array(face2, 4);
-            }
-            print_FILM_node(f, film_index, face1, face2, typf);
-
-            int element_set = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] - 1;
-            if(element_set > 0) {
-                start[DIR_Y] = modeling_data->boundary_index[COLUMN_BEAM_Y] + 1;
-                start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
-
-                film_index =
-                    modeling_data->joint_film.head +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_COLUMN_X] + element_diff) * element_increment[DIR_X] +
-                    (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 2) * element_increment[DIR_Y] +
-                    2 * element_increment[DIR_Z];
-                face1[0] = start_node + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y];
-                face1[1] = face1[0] + node_increment[DIR_Y];
-                face1[2] = face1[0] + node_increment[DIR_Z] + node_increment[DIR_Y];
-                face1[3] = face1[0] + node_increment[DIR_Z];
-                face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-                face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z]);
-                face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 1);
-                face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 1);
-                if(boundary_type == COLUMN_BEAM_X) {
-                    // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                    reverse_array(face1, 4);
-                    reverse_array(face2, 4);
-                }
-                print_FILM_node(f, film_index, face1, face2, typf);
-                int z_diff = modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1;
-                print_COPYELM(f, film_index, 0, 0, z_diff * element_increment[DIR_Z], z_diff * node_increment[DIR_Z], 1);
-                if(element_set > 1) {
-                    print_COPYELM(f, film_index, film_index + (z_diff * element_increment[DIR_Z]), z_diff * element_increment[DIR_Z], element_increment[DIR_Y], node_increment[DIR_Y], element_set - 1);
-                }
-            }
-            // 中央
-            if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2) {
-                start[DIR_Y] = modeling_data->boundary_index[COLUMN_SURFACE_START_Y];
-                start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 2;
-                film_index =
-                    modeling_data->joint_film.head +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_COLUMN_X] + element_diff) * element_increment[DIR_X] +
-                    element_increment[DIR_Y] +
-                    3 * element_increment[DIR_Z];
-                face1[0] = start_node + node_increment[DIR_Z];
-                face1[1] = face1[0] + node_increment[DIR_Y];
-                face1[2] = face1[0] + node_increment[DIR_Z] + node_increment[DIR_Y];
-                face1[3] = face1[0] + node_increment[DIR_Z];
-                face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-                face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z]);
-                face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 1);
-                face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 1);
-                if(boundary_type == COLUMN_BEAM_X) {
-                    // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-                    reverse_array(face1, 4);
-                    reverse_array(face2, 4);
-                }
-                print_FILM_node(f, film_index, face1, face2, typf);
-                print_COPYELM(f, film_index, 0, 0, element_increment[DIR_Y], node_increment[DIR_Y], modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1);
-                print_COPYELM(f, film_index, film_index + element_increment[DIR_Y] * (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1), element_increment[DIR_Y], element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3);
-            }
-        }
-        // 直交梁ウェブ
-        if(boundary_type == COLUMN_CENTER_X) {
-            start[DIR_Y] = modeling_data->boundary_index[COLUMN_SURFACE_START_Y];
-            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
+    // 右 -----------------------------------------------------
+    start[DIR_X] = modeling_data->boundary_index[BEAM_JIG_X];
+    end[DIR_X] = modeling_data->boundary_index[BEAM_END_X];
+    add_mesh_block(mesh, start, end, 5);
 
-            int film_index =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * element_increment[DIR_X] +
-                element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            int face1[4] = {
-                start_node,
-                start_node + node_increment[DIR_Z],
-                start_node + node_increment[DIR_Z] + node_increment[DIR_Y],
-                start_node + node_increment[DIR_Y]
-            };
-            int face2[4] = {
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 1),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z] + 1),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y] + 1, start[DIR_Z])
-            };
-            print_FILM_node(f, film_index, face1, face2, 2);
-            film_index += element_increment[DIR_X];
-            for(int j = 0; j < 4; j++) {
-                face2[j] += modeling_data->column_hexa.increment[DIR_X].node;
-            }
-            // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-            reverse_array(face1, 4);
-            reverse_array(face2, 4);
-            print_FILM_node(f, film_index, face1, face2, 2);
-            print_COPYELM(f, film_index - element_increment[DIR_X], film_index, element_increment[DIR_X], element_increment[DIR_Y], node_increment[DIR_Y], modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1);
-            print_COPYELM(f, film_index - element_increment[DIR_X], film_index - element_increment[DIR_X] + element_increment[DIR_Y] * (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1), element_increment[DIR_Y], element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-            print_COPYELM(f, film_index, film_index + element_increment[DIR_Y] * (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1), element_increment[DIR_Y], element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-        }
-    }
+    print_block_mesh(f, mesh);
+    free_block_mesh(mesh);
+}
 
-    // xz面 支圧板、ふさぎ板、直交梁ウェブ ---------------------------------------------------------
-    fprintf(f, "---- zx\n");
-    for(int i = 0; i < 2; i++) {
-        /**
-         * 左 -> 右
-         */
-        BoundaryType boundary_type;
-        switch (i) {
-        case 0:
-            // 手前ふさぎ板
-            boundary_type = COLUMN_SURFACE_START_Y;
-            break;
-        case 1:
-            // ウェブ
-            boundary_type = CENTER_Y;
-            break;
-        default:
-            boundary_type = -1;
-            break;
-        }
-        int start_node =
-            modeling_data->joint_quad.head.node +
-            node_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-        int start[3] = {
-            modeling_data->boundary_index[BEAM_COLUMN_X] + 1,
-            modeling_data->boundary_index[boundary_type],
-            modeling_data->boundary_index[COLUMN_BEAM_Z]
-        };
-        start_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-        start[DIR_X] = modeling_data->boundary_index[COLUMN_CENTER_X] + 1;
-        start_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-        int start_element =
-            modeling_data->joint_quad.head.element +
-            element_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + i) * element_increment[DIR_Y] +
-            element_increment[DIR_Z];
-        // 手前ふさぎ板
-        if(boundary_type == COLUMN_SURFACE_START_Y) {
-            int element_diff = 0;
-            // フル対応？
-            if(boundary_type == COLUMN_SURFACE_END_Y) {
-                element_diff = 3;
+void add_beam_quad(FILE *f, ModelingData *modeling_data) {
+
+    fprintf(f, "---- BEAM QUAD ----\n");
+    // ポインタ配列に各方向を格納
+    NodeCoordinate* coordinates[3] = {modeling_data->x, modeling_data->y, modeling_data->z};
+
+    int node_increment[3] = {
+        modeling_data->beam.increment[0].node,
+        modeling_data->beam.increment[1].node,
+        modeling_data->beam.increment[2].node
+    };
+    int element_increment[3] = {
+        modeling_data->beam.increment[0].element,
+        modeling_data->beam.increment[1].element,
+        modeling_data->beam.increment[2].element
+    };
+
+    // 節点定義
+    if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2) {
+        // 0 : 左, 1 : 右
+        for(int i = 0; i < 2; i++) {
+            BoundaryType boundary_type = JIG_BEAM_X;
+            if(i == 1) {
+                boundary_type = COLUMN_BEAM_X;
             }
-            // 左
-            // 外部要素
-            fprintf(f, "---- out\n");
-            start[DIR_X] = modeling_data->boundary_index[BEAM_COLUMN_X];
-            start_element =
-                modeling_data->joint_film.head +
-                element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            int face1[4] = {
-                start_node,
-                start_node + node_increment[DIR_Z],
-                start_node + node_increment[DIR_Z] + node_increment[DIR_X],
-                start_node + node_increment[DIR_X]
+            // 下フランジ
+            int start_node =
+                modeling_data->beam.head.node +
+                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X];
+            int start[3] = {
+                modeling_data->boundary_index[boundary_type] + 1,
+                modeling_data->boundary_index[COLUMN_BEAM_Y],
+                modeling_data->boundary_index[COLUMN_BEAM_Z]
             };
-            int face2[4] = {
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 2),
-                search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z])
+            int end[3] = {
+                modeling_data->boundary_index[boundary_type + 1] - 1,
+                modeling_data->boundary_index[CENTER_Y],
+                modeling_data->boundary_index[COLUMN_BEAM_Z]
             };
-            print_FILM_node(f, start_element, face1, face2, 1);
-            int pre_element = start_element;
-            start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-            start_element =
-                modeling_data->joint_film.head +
-                element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 2);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z]);
-            print_FILM_node(f, start_element, face1, face2, 1);
-            print_COPYELM(f, pre_element, start_element, start_element - pre_element, element_increment[DIR_X], node_increment[DIR_X], modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1);
-            // 境界
-            fprintf(f, "---- bou\n");
-            start[DIR_X] = modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X];
-            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z];
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
+            plot_node(f, coordinates, start_node, start, end, node_increment);
+            // 上フランジ
             start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 2);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 1);
-            print_FILM_node(f, start_element, face1, face2, 1);
+                modeling_data->beam.head.node +
+                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X] +
+                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
             start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-            start_element +=
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-            face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 2);
-            face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 1);
-            face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z]);
-            print_FILM_node(f, start_element, face1, face2, 1);
-            // 内部
-            fprintf(f, "---- inner\n");
-            int element_set = modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - 1;
-            if(element_set > 0) {
-                start[DIR_X] = modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] + 1;
-                start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
-                start_element =
-                    modeling_data->joint_film.head +
-                    (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                    2 * element_increment[DIR_Z];
-                start_node =
-                    modeling_data->joint_quad.head.node +
-                    (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-                face1[0] = start_node;
-                face1[1] = face1[0] + node_increment[DIR_Z];
-                face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-                face1[3] = face1[0] + node_increment[DIR_X];
-                face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-                face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 1);
-                face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 1);
-                face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z]);
-                print_FILM_node(f, start_element, face1, face2, 1);
-                print_COPYELM(f, start_element, 0, 0, (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z], (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z], 1);
-                if(element_set > 1) {
-                    print_COPYELM(
-                        f,
-                        start_element,
-                        start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                        element_increment[DIR_X],
-                        node_increment[DIR_X],
-                        element_set - 1
-                    );
-                }
-            }
-            // 上下端を除いた要素
-            fprintf(f, "---- center\n");
-            if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2) {
-                start[DIR_X] = modeling_data->boundary_index[BEAM_COLUMN_X];
-                start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 2;
-                start_element =
-                    modeling_data->joint_film.head +
-                    element_increment[DIR_X] +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                    3 * element_increment[DIR_Z];
-                start_node =
-                    modeling_data->joint_quad.head.node +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                    node_increment[DIR_Z];
-                face1[0] = start_node;
-                face1[1] = face1[0] + node_increment[DIR_Z];
-                face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-                face1[3] = face1[0] + node_increment[DIR_X];
-                face2[0] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z]);
-                face2[1] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X], start[DIR_Y], start[DIR_Z] + 1);
-                face2[2] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z] + 1);
-                face2[3] = search_column_node(modeling_data->column_hexa.head.node, node_increment, modeling_data->boundary_index, start[DIR_X] + 1, start[DIR_Y], start[DIR_Z]);
-                print_FILM_node(f, start_element, face1, face2, 1);
-                print_COPYELM(f, start_element, 0, 0, element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3);
-                print_COPYELM(
-                    f,
-                    start_element,
-                    start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3) * element_increment[DIR_Z],
-                    element_increment[DIR_Z],
-                    element_increment[DIR_X],
-                    node_increment[DIR_X],
-                    modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-                );
-                // 内部
-                element_set = modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1;
-                if(element_set > 0) {
-                    start_element =
-                        modeling_data->joint_film.head +
-                        (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-                        (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                        2 * element_increment[DIR_Z];
-                    start_node =
-                        modeling_data->joint_quad.head.node +
-                        (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                        (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-                    int column_node =
-                        modeling_data->column_hexa.head.node +
-                        (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-                        (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-                    face1[0] = start_node;
-                    face1[1] = face1[0] + node_increment[DIR_Z];
-                    face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-                    face1[3] = face1[0] + node_increment[DIR_X];
-                    face2[0] = column_node;
-                    face2[1] = column_node + node_increment[DIR_Z];
-                    face2[2] = column_node + node_increment[DIR_X] + node_increment[DIR_Z];
-                    face2[3] = column_node + node_increment[DIR_X];
-                    print_FILM_node(f, start_element, face1, face2, 1);
-                    print_COPYELM(f, start_element, 0, 0, (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z], (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z], 1);
-                    if(element_set > 1) {
-                        print_COPYELM(
-                            f,
-                            start_element,
-                            start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                            element_increment[DIR_X],
-                            node_increment[DIR_X],
-                            element_set - 1
-                        );
-                    }
-                }
-            }
-            // 右
-            // 境界
-            fprintf(f, "---- bou\n");
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            int column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = column_node;
-            face2[1] = column_node + node_increment[DIR_Z];
-            face2[2] = column_node + node_increment[DIR_X] + node_increment[DIR_Z];
-            face2[3] = column_node - node_increment[DIR_Z];
-            print_FILM_node(f, start_element, face1, face2, 1);
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = column_node;
-            face2[1] = column_node + node_increment[DIR_Z];
-            face2[2] = column_node + 2 * node_increment[DIR_Z];
-            face2[3] = column_node + node_increment[DIR_X];
-            print_FILM_node(f, start_element, face1, face2, 1);
-            // 外部
-            fprintf(f, "---- out\n");
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = column_node;
-            face2[1] = column_node + node_increment[DIR_X] + 2 * node_increment[DIR_Z];
-            face2[2] = column_node + 2 * node_increment[DIR_X] + 2 *node_increment[DIR_Z];
-            face2[3] = column_node + node_increment[DIR_X];
-            print_FILM_node(f, start_element, face1, face2, 1);
-            pre_element = start_element;
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * node_increment[DIR_Z];
-            column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = face1[0] + node_increment[DIR_Z];
-            face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = face1[0] + node_increment[DIR_X];
-            face2[0] = column_node;
-            face2[1] = column_node - node_increment[DIR_X] + 2 * node_increment[DIR_Z];
-            face2[2] = column_node + 2 *node_increment[DIR_Z];
-            face2[3] = column_node + node_increment[DIR_X];
-            print_FILM_node(f, start_element, face1, face2, 1);
-            print_COPYELM(f, pre_element, start_element, start_element - pre_element, element_increment[DIR_X], node_increment[DIR_X], modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - 1);
+            end[DIR_Z] = start[DIR_Z];
+            plot_node(f, coordinates, start_node, start, end, node_increment);
             
-            // 中央
-            fprintf(f, "---- center\n");
-            if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2) {
-                start_element =
-                    modeling_data->joint_film.head +
-                    (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + element_diff) * element_increment[DIR_Y] +
-                    3 * element_increment[DIR_Z];
-                start_node =
-                    modeling_data->joint_quad.head.node +
-                    (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                    (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                    node_increment[DIR_Z];
-                column_node =
-                    modeling_data->column_hexa.head.node +
-                    (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-                    (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * node_increment[DIR_Z];
-                face1[0] = start_node;
-                face1[1] = face1[0] + node_increment[DIR_Z];
-                face1[2] = face1[0] + node_increment[DIR_X] + node_increment[DIR_Z];
-                face1[3] = face1[0] + node_increment[DIR_X];
-                face2[0] = column_node;
-                face2[1] = column_node + node_increment[DIR_Z];
-                face2[2] = column_node + node_increment[DIR_X] + node_increment[DIR_Z];
-                face2[3] = column_node + node_increment[DIR_X];
-                print_FILM_node(f, start_element, face1, face2, 1);
-                print_COPYELM(f, start_element, 0, 0, element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3);
-                print_COPYELM(
-                    f,
-                    start_element,
-                    start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 3) * element_increment[DIR_Z],
-                    element_increment[DIR_Z],
-                    element_increment[DIR_X],
-                    node_increment[DIR_X],
-                    modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1
-                );
-            }
-        }
-        
-        if(boundary_type == CENTER_Y) {
             // ウェブ
-            start_element =
-                modeling_data->joint_film.head +
-                element_increment[DIR_X] +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
-            start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            int column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-            int face1[4] = {
-                start_node,
-                start_node + node_increment[DIR_X],
-                start_node + node_increment[DIR_X] + node_increment[DIR_Z],
-                start_node + node_increment[DIR_Z]
-            };
-            int face2[4] = {
-                column_node,
-                column_node + node_increment[DIR_X],
-                column_node + node_increment[DIR_X] + node_increment[DIR_Z],
-                column_node + node_increment[DIR_Z]
-            };
-            print_FILM_node(f, start_element, face1, face2, 1);
-            print_COPYELM(f, start_element, 0, 0, element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-            print_COPYELM(
-                f,
-                start_element,
-                start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                element_increment[DIR_Z],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1
-            );
-            start_element =
-                modeling_data->joint_film.head +
-                (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-                2 * element_increment[DIR_Z];
             start_node =
-                modeling_data->joint_quad.head.node +
-                (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-            column_node =
-                modeling_data->column_hexa.head.node +
-                (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-                (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-            face1[0] = start_node;
-            face1[1] = start_node + node_increment[DIR_X];
-            face1[2] = start_node + node_increment[DIR_X] + node_increment[DIR_Z];
-            face1[3] = start_node + node_increment[DIR_Z];
-            face2[0] = column_node;
-            face2[1] = column_node + node_increment[DIR_X];
-            face2[2] = column_node + node_increment[DIR_X] + node_increment[DIR_Z];
-            face2[3] = column_node + node_increment[DIR_Z];
-            print_FILM_node(f, start_element, face1, face2, 1);
-            print_COPYELM(f, start_element, 0, 0, element_increment[DIR_Z], node_increment[DIR_Z], modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1);
-            print_COPYELM(
-                f,
-                start_element,
-                start_element + (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] - 1) * element_increment[DIR_Z],
-                element_increment[DIR_Z],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1
-            );
-        }
-    }
-
-    // xy平面 ---------------------------------------------------------
-    fprintf(f, "---- xy\n");
-    // 上下フランジ、柱面
-    for(int i = 0; i < 2; i++) {
-        BoundaryType boundary_type = COLUMN_BEAM_Z;
-        if(i == 1) {
-            boundary_type = BEAM_COLUMN_Z;
-        }
-        int quad_node =
-            modeling_data->joint_quad.head.node + 
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        int hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_START_Z] + i * 2) * node_increment[DIR_Z];
-        int film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * element_increment[DIR_X] +
-            element_increment[DIR_Y] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_BEAM_Z] + i * 3) * element_increment[DIR_Z];
-        int face1[4] = {
-            quad_node,
-            quad_node + node_increment[DIR_Y],
-            quad_node + node_increment[DIR_X] + node_increment[DIR_Y],
-            quad_node + node_increment[DIR_X]
-        };
-        int face2[4] = {
-            hexa_node,
-            hexa_node + node_increment[DIR_Y],
-            hexa_node + node_increment[DIR_X] + node_increment[DIR_Y],
-            hexa_node + node_increment[DIR_X]
-        };
-        if(boundary_type == BEAM_COLUMN_Z) {
-            // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-            reverse_array(face1, 4);
-            reverse_array(face2, 4);
-        }
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(f, film_element, 0, 0, element_increment[DIR_X], node_increment[DIR_X], modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - 1);
-        print_COPYELM(
-            f,
-            film_element,
-            film_element + (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - 1) * element_increment[DIR_X],
-            element_increment[DIR_X],
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1
-        );
-        quad_node += (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X]) * node_increment[DIR_X];
-        hexa_node += (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X]) * node_increment[DIR_X];
-        film_element += (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] + 1) * node_increment[DIR_X];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-        if(boundary_type == BEAM_COLUMN_Z) {
-            // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-            reverse_array(face1, 4);
-            reverse_array(face2, 4);
-        }
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(f, film_element, 0, 0, element_increment[DIR_X], node_increment[DIR_X], modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1);
-        print_COPYELM(
-            f,
-            film_element,
-            film_element + (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1) * element_increment[DIR_X],
-            element_increment[DIR_X],
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1
-        );
-        // 梁フランジ方向
-        quad_node =
-            modeling_data->joint_quad.head.node + 
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_START_Z] + i * 2) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-            element_increment[DIR_X] +
-            (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[COLUMN_BEAM_Z] + i * 3) * element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-        if(boundary_type == BEAM_COLUMN_Z) {
-            // 配列の要素順番を逆転して局所座標系のz軸方向を逆にする
-            reverse_array(face1, 4);
-            reverse_array(face2, 4);
-        }
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(f, film_element, 0, 0, element_increment[DIR_X], node_increment[DIR_X], modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1);
-        print_COPYELM(
-            f,
-            film_element,
-            film_element + (modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X],
-            element_increment[DIR_X],
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] - 1
-        );
-    }
-
-    // 上下フランジ接合部面 - 境界
-    // 左
-    int quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X];
-    int hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-    int film_element =
-        modeling_data->joint_film.head +
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * element_increment[DIR_X] +
-        element_increment[DIR_Y] +
-        element_increment[DIR_Z];
-    int face1[4] = {
-        quad_node,
-        quad_node + node_increment[DIR_X],
-        quad_node + node_increment[DIR_X] + node_increment[DIR_Y],
-        quad_node + node_increment[DIR_Y]
-    };
-    int face2[4] = {
-        hexa_node,
-        hexa_node + node_increment[DIR_X] + node_increment[DIR_Z],
-        hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] + node_increment[DIR_Z],
-        hexa_node + node_increment[DIR_Y]
-    };
-    print_FILM_node(f, film_element, face1, face2, 1);
-    int pre_element = film_element;
-    // 角
-    quad_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    film_element +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_X];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_Y];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Z];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] + node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_Y] + node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    // 左上
-    quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-    hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * node_increment[DIR_Z];
-    film_element =
-        modeling_data->joint_film.head +
-        (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * element_increment[DIR_X] +
-        element_increment[DIR_Y] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_Y];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_X] - node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    print_COPYELM(
-        f,
-        pre_element,
-        film_element,
-        film_element - pre_element,
-        element_increment[DIR_Y],
-        node_increment[DIR_Y],
-        modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1
-    );
-    // 角
-    quad_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    film_element +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_X] - node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    
-    quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-    film_element =
-        modeling_data->joint_film.head +
-        element_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-        element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_X];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_Y];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_X];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] + node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_Y] + node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    pre_element = film_element;
-    quad_node +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-    hexa_node +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * node_increment[DIR_Z];
-    film_element +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_X];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    print_COPYELM(
-        f,
-        pre_element,
-        film_element,
-        film_element - pre_element,
-        element_increment[DIR_X],
-        node_increment[DIR_X],
-        modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-    );
-    // 内部 - 下
-    int element_set = modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - 1;
-    if(element_set > 0) {
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-            element_increment[DIR_Y] +
-            element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_X];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_Y];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_X];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_Y];
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y],
-                element_increment[DIR_Y],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                element_set - 1
-            );
-        }
-        // 内部 - 上
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_ORTHOGONAL_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-            element_increment[DIR_Y] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y],
-                element_increment[DIR_Y],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                element_set - 1
-            );
-        }
-    }
-    element_set = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] - 1;
-    if(element_set > 0) {
-        // 梁ウェブ - 下
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 2) * element_increment[DIR_Y] +
-            element_increment[DIR_X] +
-            element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_X];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_Y];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_X];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_Y];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_X],
-            node_increment[DIR_X],
-            modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X],
-                element_increment[DIR_X],
-                element_increment[DIR_Y],
-                node_increment[DIR_Y],
-                element_set - 1
-            );
-        }
-        // 梁ウェブ - 上
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] + 
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 2) * element_increment[DIR_Y] +
-            element_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_X],
-            node_increment[DIR_X],
-            modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X],
-                element_increment[DIR_X],
-                element_increment[DIR_Y],
-                node_increment[DIR_Y],
-                element_set - 1
-            );
-        }
-    }   
-
-    // 右
-    quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * node_increment[DIR_X];
-    hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-    film_element =
-        modeling_data->joint_film.head +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-        element_increment[DIR_Y] +
-        element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_X];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_Y];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node - node_increment[DIR_Z];
-    face2[2] = hexa_node + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_Y];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    pre_element = film_element;
-    // 角
-    quad_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    film_element +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_X];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_Y];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node - node_increment[DIR_Z];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face2[3] = hexa_node + node_increment[DIR_Y];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    // 上
-    quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-    hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-    film_element =
-        modeling_data->joint_film.head +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 2) * element_increment[DIR_X] +
-        element_increment[DIR_Y] +
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_Y];
-    face2[2] = hexa_node + node_increment[DIR_Y] + node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    print_COPYELM(
-        f,
-        pre_element,
-        film_element,
-        film_element - pre_element,
-        element_increment[DIR_Y],
-        node_increment[DIR_Y],
-        modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1
-    );
-    // 角
-    quad_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    film_element +=
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_Y];
-    face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face2[3] = hexa_node + node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    // 梁ウェブ
-    quad_node =
-        modeling_data->joint_quad.head.node + 
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y];
-    hexa_node =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * node_increment[DIR_Y] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z]) * node_increment[DIR_Z];
-    film_element =
-        modeling_data->joint_film.head +
-        (modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-        (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * element_increment[DIR_Y] +
-        element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_X];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_Y];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_X];
-    face2[2] = hexa_node + 2 * node_increment[DIR_X] + node_increment[DIR_Y] + node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] + node_increment[DIR_Z];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    pre_element = film_element;
-    quad_node +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-    hexa_node +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * node_increment[DIR_Z];
-    film_element +=
-        (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1) * element_increment[DIR_Z];
-    face1[0] = quad_node;
-    face1[1] = quad_node + node_increment[DIR_Y];
-    face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-    face1[3] = quad_node + node_increment[DIR_X];
-    face2[0] = hexa_node;
-    face2[1] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[2] = hexa_node + 2 * node_increment[DIR_X] + node_increment[DIR_Y] - node_increment[DIR_Z];
-    face2[3] = hexa_node + node_increment[DIR_X];
-    print_FILM_node(f, film_element, face1, face2, 1);
-    print_COPYELM(
-        f,
-        pre_element,
-        film_element,
-        film_element - pre_element,
-        element_increment[DIR_X],
-        node_increment[DIR_X],
-        modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - 1
-    );
-
-    // 直交梁内部 - 下
-    element_set = modeling_data->boundary_index[ORTHOGONAL_BEAM_COLUMN_X] - modeling_data->boundary_index[COLUMN_CENTER_X] - 1;
-    if(element_set > 0) {
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-            element_increment[DIR_Y] +
-            element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_X];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_Y];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_X];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_Y];
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y],
-                element_increment[DIR_Y],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                element_set - 1
-            );
-        }
-        // 内部 - 上
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-            element_increment[DIR_Y] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_Y],
-            node_increment[DIR_Y],
-            modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * element_increment[DIR_Y],
-                element_increment[DIR_Y],
-                element_increment[DIR_X],
-                node_increment[DIR_X],
-                element_set - 1
-            );
-        }
-    }
-    // 梁内部 - 下
-    element_set = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] - 1;
-    if(element_set > 0) {
-        // 梁ウェブ - 下
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 2) * element_increment[DIR_Y] +
-            element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_X];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_Y];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_X];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_Y];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_X],
-            node_increment[DIR_X],
-            modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X],
-                element_increment[DIR_X],
-                element_increment[DIR_Y],
-                node_increment[DIR_Y],
-                element_set - 1
-            );
-        }
-        // 梁ウェブ - 上
-        quad_node =
-            modeling_data->joint_quad.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] + 
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-        hexa_node =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1) * node_increment[DIR_X] +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1) * node_increment[DIR_Y] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 1) * node_increment[DIR_Z];
-        film_element =
-            modeling_data->joint_film.head +
-            (modeling_data->boundary_index[COLUMN_BEAM_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 2) * element_increment[DIR_Y] +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 3) * element_increment[DIR_X] +
-            (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 2) * element_increment[DIR_Z];
-        face1[0] = quad_node;
-        face1[1] = quad_node + node_increment[DIR_Y];
-        face1[2] = quad_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face1[3] = quad_node + node_increment[DIR_X];
-        face2[0] = hexa_node;
-        face2[1] = hexa_node + node_increment[DIR_Y];
-        face2[2] = hexa_node + node_increment[DIR_X] + node_increment[DIR_Y];
-        face2[3] = hexa_node + node_increment[DIR_X];
-
-        print_FILM_node(f, film_element, face1, face2, 1);
-        print_COPYELM(
-            f,
-            film_element,
-            0,
-            0,
-            element_increment[DIR_X],
-            node_increment[DIR_X],
-            modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1
-        );
-        if(element_set > 1) {
-            print_COPYELM(
-                f,
-                film_element,
-                film_element + (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X] - 1) * element_increment[DIR_X],
-                element_increment[DIR_X],
-                element_increment[DIR_Y],
-                node_increment[DIR_Y],
-                element_set - 1
-            );
-        }
-    }   
-    fprintf(f, "\n");
-}
-
-
-void add_beam_hexa(FILE *f, ModelingData *modeling_data) {
-    fprintf(f, "---- BEAM HEXA ----\n");
-    // ポインタ配列に各方向を格納
-    NodeCoordinate* coordinates[3] = {modeling_data->x, modeling_data->y, modeling_data->z};
-
-    int node_increment[3] = {
-        modeling_data->beam.increment[0].node,
-        modeling_data->beam.increment[1].node,
-        modeling_data->beam.increment[2].node
-    };
-    int element_increment[3] = {
-        modeling_data->beam.increment[0].element,
-        modeling_data->beam.increment[1].element,
-        modeling_data->beam.increment[2].element
-    };
-
-    // 左 -----------------------------------------------------
-    int start[3] = {
-        modeling_data->boundary_index[BEAM_START_X],
-        modeling_data->boundary_index[COLUMN_BEAM_Y],
-        modeling_data->boundary_index[COLUMN_BEAM_Z]
-    };
-    int end[3] = {
-        modeling_data->boundary_index[JIG_BEAM_X],
-        modeling_data->boundary_index[CENTER_Y],
-        modeling_data->boundary_index[BEAM_COLUMN_Z]
-    };
-    
-    generate_hexa(f, coordinates, modeling_data->beam.head.node, modeling_data->beam.head.element, start, end, node_increment, element_increment, 5);
-    // 右 -----------------------------------------------------
-    int start_node =
-        modeling_data->beam.head.node +
-        (modeling_data->boundary_index[BEAM_JIG_X] - modeling_data->boundary_index[BEAM_START_X]) * node_increment[DIR_X];
-    int start_element =
-        modeling_data->beam.head.element +
-        (modeling_data->boundary_index[BEAM_JIG_X] - modeling_data->boundary_index[BEAM_START_X]) * element_increment[DIR_X];
-
-    start[DIR_X] = modeling_data->boundary_index[BEAM_JIG_X];
-    end[DIR_X] = modeling_data->boundary_index[BEAM_END_X];
-
-    generate_hexa(f, coordinates, start_node, start_element, start, end, node_increment, element_increment, 5);
-
-}
-
-void add_beam_quad(FILE *f, ModelingData *modeling_data) {
-
-    fprintf(f, "---- BEAM QUAD ----\n");
-    // ポインタ配列に各方向を格納
-    NodeCoordinate* coordinates[3] = {modeling_data->x, modeling_data->y, modeling_data->z};
-
-    int node_increment[3] = {
-        modeling_data->beam.increment[0].node,
-        modeling_data->beam.increment[1].node,
-        modeling_data->beam.increment[2].node
-    };
-    int element_increment[3] = {
-        modeling_data->beam.increment[0].element,
-        modeling_data->beam.increment[1].element,
-        modeling_data->beam.increment[2].element
-    };
-
-    // 節点定義
-    if(modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] > 2) {
-        // 0 : 左, 1 : 右
-        for(int i = 0; i < 2; i++) {
-            BoundaryType boundary_type = JIG_BEAM_X;
-            if(i == 1) {
-                boundary_type = COLUMN_BEAM_X;
-            }
-            // 下フランジ
-            int start_node =
-                modeling_data->beam.head.node +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X];
-            int start[3] = {
-                modeling_data->boundary_index[boundary_type] + 1,
-                modeling_data->boundary_index[COLUMN_BEAM_Y],
-                modeling_data->boundary_index[COLUMN_BEAM_Z]
-            };
-            int end[3] = {
-                modeling_data->boundary_index[boundary_type + 1] - 1,
-                modeling_data->boundary_index[CENTER_Y],
-                modeling_data->boundary_index[COLUMN_BEAM_Z]
-            };
-            plot_node(f, coordinates, start_node, start, end, node_increment);
-            // 上フランジ
-            start_node =
-                modeling_data->beam.head.node +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z]) * node_increment[DIR_Z];
-            start[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z];
-            end[DIR_Z] = start[DIR_Z];
-            plot_node(f, coordinates, start_node, start, end, node_increment);
-            
-            // ウェブ
-            start_node =
-                modeling_data->beam.head.node +
-                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X] +
-                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y]) * node_increment[DIR_Y] +
-                node_increment[DIR_Z];
-
-            start[DIR_Y] = modeling_data->boundary_index[CENTER_Y];
-            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
-            end[DIR_Y] = modeling_data->boundary_index[CENTER_Y];
-            end[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z] - 1;
-            plot_node(f, coordinates, start_node, start, end, node_increment);
+                modeling_data->beam.head.node +
+                (modeling_data->boundary_index[boundary_type] - modeling_data->boundary_index[BEAM_START_X] + 1) * node_increment[DIR_X] +
+                (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y]) * node_increment[DIR_Y] +
+                node_increment[DIR_Z];
+
+            start[DIR_Y] = modeling_data->boundary_index[CENTER_Y];
+            start[DIR_Z] = modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
+            end[DIR_Y] = modeling_data->boundary_index[CENTER_Y];
+            end[DIR_Z] = modeling_data->boundary_index[BEAM_COLUMN_Z] - 1;
+            plot_node(f, coordinates, start_node, start, end, node_increment);
         }
     }
 
@@ -3324,12 +1801,70 @@ void add_beam_quad(FILE *f, ModelingData *modeling_data) {
 }
 
 
+/**
+ * 強制変位を与える節点(柱の下端、上端の面の中央)
+ * rigid_jig が 1 の場合は治具を削除するため、柱と治具の境界面の中央の節点にする。
+ */
+void get_load_node(ModelingData *modeling_data, int load_nodes[], int rigid_jig) {
+    int bottom_z = rigid_jig ? JIG_COLUMN_Z : COLUMN_START_Z;
+    int top_z = rigid_jig ? COLUMN_JIG_Z : COLUMN_END_Z;
+    int center =
+        modeling_data->column_hexa.head.node +
+        (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * modeling_data->column_hexa.increment[DIR_X].node +
+        (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * modeling_data->column_hexa.increment[DIR_Y].node;
+    load_nodes[0] =
+        center + (modeling_data->boundary_index[bottom_z] - modeling_data->boundary_index[COLUMN_START_Z]) * modeling_data->column_hexa.increment[DIR_Z].node;
+    // 接合部の上下で節点の層が2つ増える
+    load_nodes[1] =
+        center + (modeling_data->boundary_index[top_z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * modeling_data->column_hexa.increment[DIR_Z].node;
+}
+
+/**
+ * 柱の下端、上端の載荷点(get_load_node)の間の距離
+ */
+double get_load_height(ModelingData *modeling_data, int rigid_jig) {
+    int bottom_z = rigid_jig ? JIG_COLUMN_Z : COLUMN_START_Z;
+    int top_z = rigid_jig ? COLUMN_JIG_Z : COLUMN_END_Z;
+    return modeling_data->z->coordinate[modeling_data->boundary_index[top_z]] - modeling_data->z->coordinate[modeling_data->boundary_index[bottom_z]];
+}
+
 /**
  * 柱、梁を選択して端部をピン指示にする。
+ * rigid_jig が 1 の場合は治具を削除するため、梁と治具の境界面の節点を z 方向に
+ * 面の中央(梁芯、z軸中心)の節点へ従属させ、その節点をピン支持にする。
  */
-void set_pin(FILE *f, ModelingData *modeling_data, char parts) {
+void set_pin(FILE *f, ModelingData *modeling_data, char parts, int rigid_jig) {
     fprintf(f, "---- SET PIN ----\n");
-    if(parts == 'b' || parts == 'B') {
+    if((parts == 'b' || parts == 'B') && rigid_jig) {
+        int node_num_y = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_BEAM_Y] + 1;
+        int node_num_z = modeling_data->boundary_index[BEAM_COLUMN_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z] + 1;
+        int center_z = modeling_data->boundary_index[CENTAR_Z] - modeling_data->boundary_index[COLUMN_BEAM_Z];
+        int* slave = (int*)malloc((size_t)node_num_y * node_num_z * sizeof(int));
+        if(slave == NULL) {
+            fprintf(stderr, "Error: Memory allocation for set_pin failed\n");
+            return;
+        }
+        // 0 : 左, 1 : 右
+        BoundaryType faces[2] = {JIG_BEAM_X, BEAM_JIG_X};
+        for(int side = 0; side < 2; side++) {
+            int face_node =
+                modeling_data->beam.head.node +
+                (modeling_data->boundary_index[faces[side]] - modeling_data->boundary_index[BEAM_START_X]) * modeling_data->beam.increment[DIR_X].node;
+            int master = face_node + (node_num_y - 1) * modeling_data->beam.increment[DIR_Y].node + center_z * modeling_data->beam.increment[DIR_Z].node;
+            int slave_num = 0;
+            for(int j = 0; j < node_num_y; j++) {
+                for(int k = 0; k < node_num_z; k++) {
+                    if(j == node_num_y - 1 && k == center_z) {
+                        continue;
+                    }
+                    slave[slave_num++] = face_node + j * modeling_data->beam.increment[DIR_Y].node + k * modeling_data->beam.increment[DIR_Z].node;
+                }
+            }
+            print_SUB1_set(f, slave, slave_num, 3, master, 3);
+            print_REST_set(f, &master, 1, 001);
+        }
+        free(slave);
+    } else if(parts == 'b' || parts == 'B') {
         int start_node = modeling_data->beam.head.node;
         print_REST(
             f,
@@ -3357,71 +1892,42 @@ void set_pin(FILE *f, ModelingData *modeling_data, char parts) {
     fprintf(f, "\n");
 }
 
-void set_roller(FILE *f, ModelingData *modeling_data, char parts) {
+/**
+ * 柱端面の節点を x 方向に載荷点(get_load_node)へ従属させる。
+ * rigid_jig が 1 の場合は治具を削除するため、柱と治具の境界面の節点を従属させる。
+ */
+void set_roller(FILE *f, ModelingData *modeling_data, char parts, int rigid_jig) {
     fprintf(f, "---- SET ROLLER ----\n");
     if(parts == 'c' || parts == 'C') {
-        // 柱、下端
+        // 柱端面の節点(主節点を除く)を主節点に従属させる
         int center = modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X];
-        int master_bottom =
-            modeling_data->column_hexa.head.node +
-            (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * modeling_data->column_hexa.increment[DIR_X].node +
-            (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * modeling_data->column_hexa.increment[DIR_Y].node;
-        
-        for(int i = 0; i < modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]; i++) {
-            int node = modeling_data->column_hexa.head.node + i * modeling_data->column_hexa.increment[DIR_X].node;
-            if(i != center) {
-                print_SUB1(
-                    f,
-                    node,
-                    node + (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * modeling_data->column_hexa.increment[DIR_Y].node,
-                    modeling_data->column_hexa.increment[DIR_Y].node,
-                    1,
-                    master_bottom,
-                    1
-                );
-            } else {
-                print_SUB1(
-                    f,
-                    node,
-                    node + (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1) * modeling_data->column_hexa.increment[DIR_Y].node,
-                    modeling_data->column_hexa.increment[DIR_Y].node,
-                    1,
-                    master_bottom,
-                    1
-                );
-            }
+        int node_num_x = modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X] + 1;
+        int node_num_y = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] + 1;
+        int* slave = (int*)malloc((size_t)node_num_x * node_num_y * sizeof(int));
+        if(slave == NULL) {
+            fprintf(stderr, "Error: Memory allocation for set_roller failed\n");
+            return;
         }
-        // 柱、上端
-        int master_top =
-            master_bottom + (modeling_data->boundary_index[COLUMN_END_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * modeling_data->column_hexa.increment[DIR_Z].node;
-
-        for(int i = 0; i < modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X]; i++) {
-            int node =
-                modeling_data->column_hexa.head.node + i * modeling_data->column_hexa.increment[DIR_X].node +
-                (modeling_data->boundary_index[COLUMN_END_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * modeling_data->column_hexa.increment[DIR_Z].node;
-            if(i != center) {
-                print_SUB1(
-                    f,
-                    node,
-                    node + (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * modeling_data->column_hexa.increment[DIR_Y].node,
-                    modeling_data->column_hexa.increment[DIR_Y].node,
-                    1,
-                    master_top,
-                    1
-                );
-            } else {
-                print_SUB1(
-                    f,
-                    node,
-                    node + (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y] - 1) * modeling_data->column_hexa.increment[DIR_Y].node,
-                    modeling_data->column_hexa.increment[DIR_Y].node,
-                    1,
-                    master_top,
-                    1
-                );
+        // 柱、下端と上端
+        int masters[2];
+        get_load_node(modeling_data, masters, rigid_jig);
+
+        for(int end = 0; end < 2; end++) {
+            int slave_num = 0;
+            for(int i = 0; i < node_num_x; i++) {
+                int node =
+                    masters[end] + (i - center) * modeling_data->column_hexa.increment[DIR_X].node -
+                    (node_num_y - 1) * modeling_data->column_hexa.increment[DIR_Y].node;
+                for(int j = 0; j < node_num_y; j++) {
+                    if(i == center && j == node_num_y - 1) {
+                        continue;
+                    }
+                    slave[slave_num++] = node + j * modeling_data->column_hexa.increment[DIR_Y].node;
+                }
             }
+            print_SUB1_set(f, slave, slave_num, 1, masters[end], 1);
         }
-
+        free(slave);
     } else {
         printf("non\n");
         return ;
@@ -3429,6 +1935,72 @@ void set_roller(FILE *f, ModelingData *modeling_data, char parts) {
     fprintf(f, "\n");
 }
 
+/**
+ * 主筋の付着(LINE要素)と接合部鋼板の境界面(FILM要素)
+ *
+ * ここまでに書き込んだ節点、要素を読み込み、同じ座標にある節点の組から作る(mesh_interface.c)。
+ * - LINE: 主筋(BEAM)とコンクリート(HEXA)。要素番号は主筋の要素番号 + (rebar_line.head - rebar_fiber.head)
+ * - FILM: 接合部の鋼板(QUAD)とコンクリート(HEXA)。直交梁ウェブ(TYPQ 5)は TYPF 2、それ以外は TYPF 1。
+ *         要素番号は joint_film.head から順に付ける。
+ */
+int add_interface_elements(FILE *f, const char *fileName, ModelingData *modeling_data) {
+    fflush(f);
+    MeshModel* model = create_mesh_model();
+    if (model == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (read_mesh_model(fileName, model) != MESH_MODEL_SUCCESS) {
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+    MeshInterface* mesh_interface = create_mesh_interface(model);
+    MeshSelection* solids = create_mesh_selection(model, SELECT_ELEMENT);
+    MeshSelection* parts = create_mesh_selection(model, SELECT_ELEMENT);
+    MeshSelection* web = create_mesh_selection(model, SELECT_ELEMENT);
+    MeshModel* lines = create_mesh_model();
+    MeshModel* films = create_mesh_model();
+    int result = EXIT_FAILURE;
+    if (mesh_interface != NULL && solids != NULL && parts != NULL && web != NULL && lines != NULL && films != NULL) {
+        select_elements_by_type(model, ELEMENT_HEXA, -1, solids);
+
+        // 主筋の付着
+        select_elements_by_type(model, ELEMENT_BEAM, -1, parts);
+        int line_offset = modeling_data->rebar_line.head.element - modeling_data->rebar_fiber->head.element;
+        int line_num = generate_bond_lines(mesh_interface, parts, solids, line_offset, lines);
+
+        // 接合部鋼板
+        clear_mesh_selection(parts);
+        select_elements_by_type(model, ELEMENT_QUAD, -1, parts);
+        select_elements_by_type(model, ELEMENT_QUAD, 5, web);
+        selection_minus(parts, web);
+        int film_id = modeling_data->joint_film.head;
+        int film_num = generate_interface_films(mesh_interface, parts, solids, 1, &film_id, films);
+        int web_num = generate_interface_films(mesh_interface, web, solids, 2, &film_id, films);
+
+        if (line_num >= 0 && film_num >= 0 && web_num >= 0) {
+            if (film_id - modeling_data->joint_film.head > modeling_data->joint_film.occupied_indices) {
+                fprintf(stderr, "Error: joint film elements exceed the reserved numbers\n");
+            } else {
+                fprintf(f, "---- REBAR LINE ----\n");
+                print_interface_elements(f, lines);
+                fprintf(f, "\n");
+                fprintf(f, "---- JOINT FILM ----\n");
+                print_interface_elements(f, films);
+                fprintf(f, "\n");
+                result = EXIT_SUCCESS;
+            }
+        }
+    }
+    free_mesh_model(films);
+    free_mesh_model(lines);
+    free_mesh_selection(web);
+    free_mesh_selection(parts);
+    free_mesh_selection(solids);
+    free_mesh_interface(mesh_interface);
+    free_mesh_model(model);
+    return result;
+}
+
 void fix_cut_surface(FILE *f, ModelingData *modeling_data) {
     fprintf(f, "---- FIX CUT SURFACE ----\n");
     // 柱
@@ -3495,15 +2067,6 @@ void fix_cut_surface(FILE *f, ModelingData *modeling_data) {
     fprintf(f, "\n");
 }
 
-void get_load_node(ModelingData *modeling_data, int load_nodes[]) {
-    load_nodes[0] =
-        modeling_data->column_hexa.head.node +
-        (modeling_data->boundary_index[COLUMN_CENTER_X] - modeling_data->boundary_index[BEAM_COLUMN_X]) * modeling_data->column_hexa.increment[DIR_X].node +
-        (modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y]) * modeling_data->column_hexa.increment[DIR_Y].node;
-    load_nodes[1] =
-        load_nodes[0] + (modeling_data->boundary_index[COLUMN_END_Z] - modeling_data->boundary_index[COLUMN_START_Z] + 2) * modeling_data->column_hexa.increment[DIR_Z].node;
-}
-
 void print_type_mat(FILE *f) {
     // 要素タイプ
     print_TYPH(f, 1, 1, 'c');
@@ -3539,36 +2102,57 @@ void print_type_mat(FILE *f) {
 
 /**
  * 軸力導入するstepデータを書き込む
+ * rigid_jig が 1 の場合は治具を削除するため、治具に接するコンクリートの要素の面に荷重を与える。
  */
-void print_axial_force_step(FILE *f, ModelingData *modeling_data) {
+void print_axial_force_step(FILE *f, ModelingData *modeling_data, int rigid_jig) {
     double unit = 10;
     print_STEP(f, 1);
 
-    int element_index = modeling_data->column_hexa.head.element;
+    int bottom_z = rigid_jig ? JIG_COLUMN_Z : COLUMN_START_Z;
+    int top_z = rigid_jig ? COLUMN_JIG_Z : COLUMN_END_Z;
+    int element_index = modeling_data->column_hexa.head.element +
+        (modeling_data->boundary_index[bottom_z] - modeling_data->boundary_index[COLUMN_START_Z]) * modeling_data->column_hexa.increment[DIR_Z].element;
     int element_increment_x = modeling_data->column_hexa.increment[DIR_X].element;
     int element_increment_y = modeling_data->column_hexa.increment[DIR_Y].element;
     // 柱のx方向要素数
     int element_num_x = modeling_data->boundary_index[COLUMN_BEAM_X] - modeling_data->boundary_index[BEAM_COLUMN_X];
     // 柱のy方向要素数
     int element_num_y = modeling_data->boundary_index[CENTER_Y] - modeling_data->boundary_index[COLUMN_SURFACE_START_Y];
-    int element_diff = (element_num_x - 1) * element_increment_x;
+    int* elements = (int*)malloc((size_t)element_num_x * element_num_y * sizeof(int));
+    if(elements == NULL) {
+        fprintf(stderr, "Error: Memory allocation for print_axial_force_step failed\n");
+        return;
+    }
     // 柱下部
+    int element_count = 0;
     for(int i = 0; i < element_num_y; i++) {
-        int start_element = element_index + element_increment_y * i;
-        print_UE(f, start_element, start_element + element_diff, element_increment_x, unit, 'z', 1);
+        for(int j = 0; j < element_num_x; j++) {
+            elements[element_count++] = element_index + element_increment_y * i + element_increment_x * j;
+        }
     }
+    print_UE_set(f, elements, element_count, unit, 'z', 1);
 
     element_index = modeling_data->column_hexa.head.element + 
-        (modeling_data->boundary_index[COLUMN_END_Z] - modeling_data->boundary_index[COLUMN_START_Z] - 1) * modeling_data->column_hexa.increment[DIR_Z].element;
+        (modeling_data->boundary_index[top_z] - modeling_data->boundary_index[COLUMN_START_Z] - 1) * modeling_data->column_hexa.increment[DIR_Z].element;
     // 柱上部
+    element_count = 0;
     for(int i = 0; i < element_num_y; i++) {
-        int start_element = element_index + element_increment_y * i;
-        print_UE(f, start_element, start_element + element_diff, element_increment_x, -1 * unit, 'z', 2);
+        for(int j = 0; j < element_num_x; j++) {
+            elements[element_count++] = element_index + element_increment_y * i + element_increment_x * j;
+        }
     }
+    print_UE_set(f, elements, element_count, -1 * unit, 'z', 2);
+    free(elements);
     print_OUT(f, 1, 0, 0);
     fprintf(f, "\n");
 }
 
+/**
+ * 強制変位のstepデータを書き込む
+ *
+ * @param load_nodes get_load_node で求めた柱の下端、上端の載荷点。柱端面(--rigid-jig の場合は
+ *        治具との境界面)の節点は set_roller で x 方向に従属させている
+ */
 void print_load_step(FILE *f, int load_nodes[]) {
     print_STEP(f, 10);
     print_FN(f, load_nodes[0], 0, 0, -10, 'x');
@@ -3585,12 +2169,370 @@ void debug_step_print(FILE *f) {
 }
 
 
+/**
+ * オプションを既定値(後処理なし)にする
+ */
+void initialize_modeling_rcs_option(ModelingRcsOption *option) {
+    if(option == NULL) {
+        return;
+    }
+    option->node_order = NODE_ORDER_DEFAULT;
+    option->node_map_file_name = NULL;
+    option->element_order = ELEMENT_ORDER_DEFAULT;
+    option->element_map_file_name = NULL;
+    option->partition_num = 0;
+    option->partition_file_name = NULL;
+    option->compress = 0;
+    option->fit_id_budget = 0;
+    option->estimate = 0;
+    option->scope = MODEL_SCOPE_HALF;
+    option->symmetry_map_file_name = NULL;
+    option->frame_bay_num = 1;
+    option->frame_story_num = 1;
+    option->submodel = SUBMODEL_NONE;
+    option->rigid_jig = 0;
+    option->adaptive_steps = 0;
+    option->yield_drift = 0.0;
+    option->restart_run_num = 0;
+    option->output_budget = 0.0;
+    option->section = 0;
+    option->rebar_area = 0.0;
+    option->bond_zone = BOND_ZONE_ALL;
+    option->bond_zone_min = -SUBMODEL_UNBOUNDED;
+    option->bond_zone_max = SUBMODEL_UNBOUNDED;
+    for(int axis = 0; axis < 3; axis++) {
+        option->submodel_box.min[axis] = -SUBMODEL_UNBOUNDED;
+        option->submodel_box.max[axis] = SUBMODEL_UNBOUNDED;
+    }
+}
+
+/**
+ * ファイルの行数を数える
+ *
+ * @return 行数。開けない場合は -1
+ */
+static int count_file_lines(const char *fileName) {
+    FILE *f = fopen(fileName, "r");
+    if(f == NULL) {
+        return -1;
+    }
+    int lines = 0;
+    int c;
+    while((c = fgetc(f)) != EOF) {
+        if(c == '\n') {
+            lines++;
+        }
+    }
+    fclose(f);
+    return lines;
+}
+
+/**
+ * 後処理のオプションの組み合わせを確認する(ffiを書き込む前に行う)
+ *
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+static int check_post_process_options(const ModelingRcsOption *option) {
+    int renumbered = option->node_order != NODE_ORDER_DEFAULT || option->element_order != ELEMENT_ORDER_DEFAULT;
+    int framed = option->frame_bay_num > 1 || option->frame_story_num > 1;
+    // 架構の他の接合部はCOPYカードのまま書き込むため、展開したモデルが必要な後処理とは組み合わせない
+    if(framed && (renumbered || option->partition_num > 0 || option->scope == MODEL_SCOPE_QUARTER || option->scope == MODEL_SCOPE_QUARTER_ANTISYMMETRIC)) {
+        fprintf(stderr, "Error: --frame cannot be combined with --renumber, --reorder-elements, --partition or --quarter\n");
+        return EXIT_FAILURE;
+    }
+    // 部分モデルは番号を詰めて対応表を書き込むため、番号の付け替え、架構とは組み合わせない
+    if(option->submodel != SUBMODEL_NONE && (renumbered || framed)) {
+        fprintf(stderr, "Error: --submodel cannot be combined with --renumber, --reorder-elements or --frame\n");
+        return EXIT_FAILURE;
+    }
+    // 架構は梁端、柱端の面の節点を結ぶため、治具を削除したモデルとは組み合わせない
+    if(option->rigid_jig && framed) {
+        fprintf(stderr, "Error: --rigid-jig cannot be combined with --frame\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 書き込んだffiを読み込み、オプションの後処理を行って書き直す。
+ * 後処理が無い場合は何もしない。オプションの組み合わせは check_post_process_options で確認してあること。
+ * 失敗した場合、書き直す前のffiは呼び出し側で削除する。
+ *
+ * @param outputFileName modeling_rcsで書き込んだffi
+ * @param option オプション
+ * @param modeling_data 対称面の座標(boundary_index[CENTER_Y]、boundary_index[COLUMN_CENTER_X])
+ */
+int post_process_ffi(const char *outputFileName, const ModelingRcsOption *option, const ModelingData *modeling_data) {
+    int renumbered = option->node_order != NODE_ORDER_DEFAULT || option->element_order != ELEMENT_ORDER_DEFAULT;
+    int framed = option->frame_bay_num > 1 || option->frame_story_num > 1;
+    int rewrite = renumbered || option->compress || option->scope != MODEL_SCOPE_HALF || framed || option->submodel != SUBMODEL_NONE
+        || option->rigid_jig || option->bond_zone != BOND_ZONE_ALL;
+    if(!rewrite && option->partition_num <= 0) {
+        return EXIT_SUCCESS;
+    }
+    int line_num = count_file_lines(outputFileName);
+
+    MeshModel* model = create_mesh_model();
+    if(model == NULL) {
+        return EXIT_FAILURE;
+    }
+    if(read_mesh_model(outputFileName, model) != MESH_MODEL_SUCCESS) {
+        fprintf(stderr, "Failed to read %s\n", outputFileName);
+        free_mesh_model(model);
+        return EXIT_FAILURE;
+    }
+
+    int result = EXIT_SUCCESS;
+    // 治具の削除(境界面の SUB1 は書き込み時に載荷点へ向けてある)
+    if(option->rigid_jig) {
+        RigidJigStatistics statistics;
+        if(remove_jig_elements(model, RIGID_JIG_TYPE, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to remove the jig elements\n");
+            result = EXIT_FAILURE;
+        } else {
+            print_rigid_jig_statistics(&statistics);
+        }
+    }
+
+    // 主筋の付着区間(区間の外は主筋の節点をコンクリートと共有する)
+    if(result == EXIT_SUCCESS && option->bond_zone != BOND_ZONE_ALL) {
+        double z_min = option->bond_zone_min;
+        double z_max = option->bond_zone_max;
+        if(option->bond_zone == BOND_ZONE_JOINT) {
+            z_min = modeling_data->z->coordinate[modeling_data->boundary_index[COLUMN_BEAM_Z]];
+            z_max = modeling_data->z->coordinate[modeling_data->boundary_index[BEAM_COLUMN_Z]];
+        }
+        BondZoneStatistics statistics;
+        if(restrict_bond_zone(model, z_min, z_max, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to restrict the bond zone\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("bond zone: z = %.1f - %.1f\n", z_min, z_max);
+            print_bond_zone_statistics(&statistics);
+        }
+    }
+
+    // フルモデル(梁芯の面で鏡映する)
+    if(result == EXIT_SUCCESS && option->scope == MODEL_SCOPE_FULL) {
+        double plane = modeling_data->y->coordinate[modeling_data->boundary_index[CENTER_Y]];
+        MirrorStatistics statistics;
+        if(mirror_mesh_model(model, DIR_Y + 1, plane, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to mirror the half model\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("full model: +%d nodes (%d on y = %.1f), +%d elements (%d on the plane), released %d restraints (kept on node %d), offset %d / %d\n",
+                statistics.node_num, statistics.plane_node_num, plane, statistics.element_num, statistics.plane_element_num,
+                statistics.released_restraint_num, statistics.anchor_node, statistics.node_offset, statistics.element_offset);
+        }
+    }
+
+    // 1/4モデル(柱芯の面で切断する)
+    if(result == EXIT_SUCCESS && (option->scope == MODEL_SCOPE_QUARTER || option->scope == MODEL_SCOPE_QUARTER_ANTISYMMETRIC)) {
+        double plane = modeling_data->x->coordinate[modeling_data->boundary_index[COLUMN_CENTER_X]];
+        SymmetryKind kind = (option->scope == MODEL_SCOPE_QUARTER) ? SYMMETRY_SYMMETRIC : SYMMETRY_ANTISYMMETRIC;
+        int* mirror_node = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+        int* mirror_element = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+        SymmetryLoad* adjusted_load = (SymmetryLoad*)malloc(((size_t)model->step_card_num + 1) * sizeof(SymmetryLoad));
+        SymmetryCutStatistics statistics;
+        if(mirror_node == NULL || mirror_element == NULL || adjusted_load == NULL
+           || cut_mesh_model(model, DIR_X + 1, plane, kind, mirror_node, mirror_element, adjusted_load, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to cut the half model\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("quarter model (%s): -%d nodes, -%d elements, %d nodes restrained on x = %.1f\n",
+                kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric",
+                statistics.removed_node_num, statistics.removed_element_num, statistics.plane_node_num, plane);
+            if(statistics.conflict_num > 0) {
+                printf("Warning: %d SUB1/zero FN on the symmetry plane were removed (they act in a restrained direction)\n", statistics.conflict_num);
+            }
+            if(statistics.adjusted_load_num > 0) {
+                printf("Warning: %d FN/UE are not %s about x = %.1f: %d removed, %d replaced by their %s part\n",
+                    statistics.adjusted_load_num, kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric", plane,
+                    statistics.removed_load_num,
+                    statistics.adjusted_load_num - statistics.removed_load_num, kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric");
+                printf("     : they are listed in the symmetry map\n");
+            }
+            if(statistics.unmatched_node_num > 0 || statistics.unmatched_element_num > 0) {
+                printf("Warning: %d nodes, %d elements have no mirror image (the model is not symmetric)\n",
+                    statistics.unmatched_node_num, statistics.unmatched_element_num);
+            }
+            char map_file_name[1024];
+            if(option->symmetry_map_file_name != NULL) {
+                snprintf(map_file_name, sizeof(map_file_name), "%s", option->symmetry_map_file_name);
+            } else {
+                snprintf(map_file_name, sizeof(map_file_name), "%s.quarter.csv", outputFileName);
+            }
+            result = write_symmetry_map(map_file_name, model, DIR_X + 1, kind, mirror_node, mirror_element,
+                                        adjusted_load, statistics.adjusted_load_num);
+        }
+        free(mirror_node);
+        free(mirror_element);
+        free(adjusted_load);
+    }
+
+    // 部分モデル
+    if(result == EXIT_SUCCESS && option->submodel != SUBMODEL_NONE) {
+        SelectBox box = option->submodel_box;
+        if(option->submodel == SUBMODEL_PANEL || option->submodel == SUBMODEL_JOINT) {
+            box.min[2] = modeling_data->z->coordinate[modeling_data->boundary_index[COLUMN_BEAM_Z]];
+            box.max[2] = modeling_data->z->coordinate[modeling_data->boundary_index[BEAM_COLUMN_Z]];
+        }
+        if(option->submodel == SUBMODEL_JOINT) {
+            box.min[0] = modeling_data->x->coordinate[modeling_data->boundary_index[BEAM_COLUMN_X]];
+            box.max[0] = modeling_data->x->coordinate[modeling_data->boundary_index[COLUMN_BEAM_X]];
+        }
+        int* original_node = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+        int* original_element = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+        SubmodelStatistics statistics;
+        if(original_node == NULL || original_element == NULL
+           || extract_submodel(model, &box, original_node, original_element, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to extract the submodel\n");
+            result = EXIT_FAILURE;
+        } else {
+            print_submodel_statistics(&statistics);
+            if(option->node_map_file_name != NULL) {
+                result = write_node_map(option->node_map_file_name, model, original_node);
+            }
+            if(result == EXIT_SUCCESS && option->element_map_file_name != NULL) {
+                result = write_element_map(option->element_map_file_name, model, original_element);
+            }
+        }
+        free(original_node);
+        free(original_element);
+    }
+
+    // 節点番号の付け替え
+    if(result == EXIT_SUCCESS && option->node_order == NODE_ORDER_RCM) {
+        int* original_id = (int*)malloc(((size_t)model->node_num + 1) * sizeof(int));
+        RenumberStatistics before, after;
+        if(original_id == NULL || renumber_nodes_rcm(model, original_id, &before, &after) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to renumber nodes\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("renumber (RCM): bandwidth %d -> %d, profile %lld -> %lld, components %d\n",
+                before.bandwidth, after.bandwidth, before.profile, after.profile, after.component_num);
+            if(option->node_map_file_name != NULL) {
+                result = write_node_map(option->node_map_file_name, model, original_id);
+            }
+        }
+        free(original_id);
+    }
+
+    // 要素番号の付け替え
+    if(result == EXIT_SUCCESS && option->element_order == ELEMENT_ORDER_FRONT) {
+        int* original_id = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+        FrontStatistics before, after;
+        if(original_id == NULL || renumber_elements_front(model, original_id, &before, &after) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to reorder elements\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("reorder elements: max front %d -> %d, mean front %.1f -> %.1f\n",
+                before.max_front, after.max_front, before.mean_front, after.mean_front);
+            if(option->element_map_file_name != NULL) {
+                result = write_element_map(option->element_map_file_name, model, original_id);
+            }
+        }
+        free(original_id);
+    }
+
+    // 要素の分割(番号を付け替えた後の要素番号で書き込む)
+    if(result == EXIT_SUCCESS && option->partition_num > 0) {
+        int* part = (int*)malloc(((size_t)model->element_num + 1) * sizeof(int));
+        PartitionStatistics statistics;
+        if(part == NULL || partition_mesh_elements(model, option->partition_num, part) != EXIT_SUCCESS
+           || compute_partition_statistics(model, option->partition_num, part, &statistics) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to partition elements\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("partition (%d parts): elements %d - %d, imbalance %.3f, edge cut %d, interface nodes %d\n",
+                statistics.part_num, statistics.min_part_size, statistics.max_part_size, statistics.imbalance,
+                statistics.edge_cut, statistics.interface_node_num);
+            char partition_file_name[1024];
+            if(option->partition_file_name != NULL) {
+                snprintf(partition_file_name, sizeof(partition_file_name), "%s", option->partition_file_name);
+            } else {
+                snprintf(partition_file_name, sizeof(partition_file_name), "%s.epart.%d.csv", outputFileName, option->partition_num);
+            }
+            result = write_element_partition(partition_file_name, model, part);
+        }
+        free(part);
+    }
+
+    // 架構(接合部を x、z 方向に並べる)
+    if(result == EXIT_SUCCESS && framed) {
+        FrameLayout layout;
+        // ハーフモデルの梁端、柱端の切断面の拘束(y)は結んだ後も残す
+        int interface_rc = (option->scope == MODEL_SCOPE_FULL) ? 0 : 10;
+        if(plan_frame_layout(model, option->frame_bay_num, option->frame_story_num, &layout) != EXIT_SUCCESS
+           || assemble_frame(model, &layout, interface_rc) != EXIT_SUCCESS) {
+            fprintf(stderr, "Failed to assemble the frame\n");
+            result = EXIT_FAILURE;
+        } else {
+            printf("frame %d x %d: pitch %.1f / %.1f, offset %d / %d, %d stitched node pairs\n",
+                layout.bay_num, layout.story_num, layout.pitch[0], layout.pitch[1],
+                layout.node_offset, layout.element_offset, layout.stitch_num);
+            if(layout.unmatched_num > 0) {
+                printf("Warning: %d beam/column end nodes have no node at the same position on the opposite end\n", layout.unmatched_num);
+            }
+        }
+    }
+
+    if(result == EXIT_SUCCESS && rewrite) {
+        if(write_mesh_model(outputFileName, model) != MESH_MODEL_SUCCESS) {
+            fprintf(stderr, "Failed to write %s\n", outputFileName);
+            result = EXIT_FAILURE;
+        } else if(option->compress) {
+            printf("compress: lines %d -> %d\n", line_num, count_file_lines(outputFileName));
+        }
+    }
+    free_mesh_model(model);
+    return result;
+}
+
 #define OUT_FILE_NAME  "out.ffi"
 /**
  * @param inputFileName rcsモデリングデータのファイル名
  * @param outputFileName
  */
+/**
+ * source_dataからModelingDataを作成する
+ *
+ * @return ModelingData。失敗した場合はNULL
+ */
+static ModelingData* build_modeling_data(JsonData *source_data) {
+    // ModelingDataを初期化  原点(0)の分も要素数に加算
+    ModelingData* modeling_data = create_modeling_data(
+        source_data->mesh_x.mesh_num + 1,
+        source_data->mesh_y.mesh_num + 1,
+        source_data->mesh_z.mesh_num + 1,
+        source_data->rebar.rebar_num
+    );
+    if (modeling_data == NULL) {
+        fprintf(stderr, "Failed to create ModelingData\n");
+        return NULL;
+    }
+
+    // データ格納
+    if(make_modeling_data(modeling_data, source_data) != EXIT_SUCCESS) {
+        printf("Failed to input for ModelingData\n");
+        free_modeling_data(modeling_data);
+        return NULL;
+    }
+    return modeling_data;
+}
+
 ModelingRcsResult modeling_rcs(const char *inputFileName, const char *outputFileName) {
+    ModelingRcsOption option;
+    initialize_modeling_rcs_option(&option);
+    return modeling_rcs_with_option(inputFileName, outputFileName, &option);
+}
+
+/**
+ * @param inputFileName rcsモデリングデータのファイル名
+ * @param outputFileName
+ * @param option 出力のオプション
+ */
+ModelingRcsResult modeling_rcs_with_option(const char *inputFileName, const char *outputFileName, const ModelingRcsOption *option) {
     /*名称
         source_data  : JSONファイルの入力データ
         modeling_data: モデリングに必要なデータ
@@ -3611,41 +2553,190 @@ ModelingRcsResult modeling_rcs(const char *inputFileName, const char *outputFile
     * 
     */
 
+    clock_t start_time = clock();
+
+    // 後処理のオプションの組み合わせ(ffiを書き込む前に確認する)
+    if (!option->estimate && !option->section && check_post_process_options(option) != EXIT_SUCCESS) {
+        return MODELING_RCS_ERROR;
+    }
+
     // JSONファイルの読み込み ---------------------------------------------------------------------
     JsonData* source_data = new_json_data();  // 初期化
 	JsonParserResult result = json_parser(inputFileName, source_data);  // データ読み込み
+    // auto_meshの指定があれば、寸法からメッシュ分割を作る
+    if (result == JSON_PARSER_SUCCESS && generate_auto_mesh(source_data) != EXIT_SUCCESS) {
+        result = JSON_PARSER_ERROR;
+    }
 	if (result == JSON_PARSER_SUCCESS) {
-		print_json_data(source_data, 0);
+		if (!option->estimate && !option->section) {
+			print_json_data(source_data, 0);
+		}
 	} else {
 		printf("Failed to parse JSON.\n");
         free_json_data(source_data);
         return MODELING_RCS_ERROR;
 	}
     
+    // 断面の検討だけを表示して終わる
+    SectionMaterial material;
+    initialize_section_material(&material);
+    if (option->rebar_area > 0.0) {
+        material.rebar_area = option->rebar_area;
+    }
+    if (option->section) {
+        SectionScreening screening;
+        int screened = screen_section(source_data, &material, &screening);
+        double elapsed_us = (double)(clock() - start_time) / CLOCKS_PER_SEC * 1.0e6;
+        printf("---- section: %s\n", inputFileName);
+        if (screened == EXIT_SUCCESS) {
+            print_section_screening(&screening, elapsed_us);
+        }
+        free_json_data(source_data);
+        return (screened == EXIT_SUCCESS) ? MODELING_RCS_SUCCESS : MODELING_RCS_ERROR;
+    }
+
     // modeling_dataの作成 ---------------------------------------------------------------------
-    // ModelingDataを初期化  原点(0)の分も要素数に加算
-    ModelingData* modeling_data = create_modeling_data(
-        source_data->mesh_x.mesh_num + 1,
-        source_data->mesh_y.mesh_num + 1,
-        source_data->mesh_z.mesh_num + 1,
-        source_data->rebar.rebar_num
-    );
+    ModelingData* modeling_data = build_modeling_data(source_data);
     if (modeling_data == NULL) {
-        fprintf(stderr, "Failed to create ModelingData\n");
         free_json_data(source_data);
         return MODELING_RCS_ERROR;
     }
 
-    // データ格納 - source_dataはここで解放
-    if(make_modeling_data(modeling_data, source_data) == EXIT_SUCCESS) {
-        print_modeling_data(modeling_data);
+    // 節点、要素番号が5桁に収まるかを書き込む前に確認する
+    IdBudget budget;
+    plan_id_budget(modeling_data, &budget);
+
+    // 規模の予測だけを表示して終わる
+    if (option->estimate) {
+        ModelEstimate estimate;
+        estimate_model(modeling_data, &estimate);
+        double elapsed_us = (double)(clock() - start_time) / CLOCKS_PER_SEC * 1.0e6;
+        printf("---- estimate: %s\n", inputFileName);
+        print_model_estimate(&estimate, elapsed_us);
+        // 書き込む場合と同じく部位の間の空きを詰めた後の番号で判定する
+        if (!id_budget_fits(&budget) && compact_id_gaps(modeling_data) > 0) {
+            plan_id_budget(modeling_data, &budget);
+        }
+        printf("max node %d, max element %d (limit %d)\n", budget.max.node, budget.max.element, ID_BUDGET_MAX);
         free_json_data(source_data);
-    } else {
-        printf("Failed to input for ModelingData\n");
+        set_modeling_data_free_log(0);
+        free_modeling_data(modeling_data);
+        set_modeling_data_free_log(1);
+        return MODELING_RCS_SUCCESS;
+    }
+    print_id_budget(&budget);
+    while (!id_budget_fits(&budget)) {
+        // 部位の間の空きを詰める(節点番号だけが変わる)
+        if (compact_id_gaps(modeling_data) > 0) {
+            plan_id_budget(modeling_data, &budget);
+            print_id_budget(&budget);
+            continue;
+        }
+        if (!option->fit_id_budget) {
+            fprintf(stderr, "Error: node or element numbers exceed %d\n", ID_BUDGET_MAX);
+            fprintf(stderr, "     : coarsen mesh_x / mesh_z between the jigs and the joint (--fit-ids does this automatically)\n");
+            free_json_data(source_data);
+            free_modeling_data(modeling_data);
+            return MODELING_RCS_ERROR;
+        }
+        if (coarsen_far_field(source_data, modeling_data) != EXIT_SUCCESS) {
+            // 治具と接合部の間はこれ以上まとめられない
+            fprintf(stderr, "Error: node or element numbers exceed %d after coarsening the far field\n", ID_BUDGET_MAX);
+            fprintf(stderr, "     : the joint mesh itself is too fine; coarsen mesh_x / mesh_z inside the joint\n");
+            free_json_data(source_data);
+            free_modeling_data(modeling_data);
+            return MODELING_RCS_ERROR;
+        }
+        free_modeling_data(modeling_data);
+        modeling_data = build_modeling_data(source_data);
+        if (modeling_data == NULL) {
+            free_json_data(source_data);
+            return MODELING_RCS_ERROR;
+        }
+        plan_id_budget(modeling_data, &budget);
+        print_id_budget(&budget);
+    }
+
+    // 繰り返し載荷の変位履歴(軸力導入の次のステップから)
+    LoadingProtocol* protocol = NULL;
+    if (option->adaptive_steps && source_data->loading.level_num == 0) {
+        printf("Warning: --adaptive-steps needs \"loading\" in %s (monotonic loading is written)\n", inputFileName);
+    }
+    if (option->restart_run_num > 0 && source_data->loading.level_num == 0) {
+        fprintf(stderr, "Error: --restart-segments needs \"loading\" in %s\n", inputFileName);
         free_json_data(source_data);
         free_modeling_data(modeling_data);
         return MODELING_RCS_ERROR;
     }
+    if (option->output_budget > 0.0 && source_data->loading.level_num == 0) {
+        printf("Warning: --output-budget needs \"loading\" in %s (all steps are written)\n", inputFileName);
+    }
+    int restart_step[FFI_RESTART_RUN_MAX] = {0};
+    OutputPlan* output = NULL;
+    if (source_data->loading.level_num > 0) {
+        double height = get_load_height(modeling_data, option->rigid_jig);
+        int built = EXIT_FAILURE;
+        protocol = create_loading_protocol();
+        if (protocol != NULL && option->adaptive_steps) {
+            // 降伏の部材角: 指定、柱断面のファイバー解析、柱のせいからの推定の順
+            double yield_drift = option->yield_drift;
+            const char* source = "given";
+            SectionScreening screening;
+            if (yield_drift <= 0.0 && screen_section(source_data, &material, &screening) == EXIT_SUCCESS && screening.yield_drift > 0.0) {
+                yield_drift = screening.yield_drift;
+                source = "fiber section";
+            }
+            if (yield_drift <= 0.0) {
+                yield_drift = estimate_yield_drift(source_data->column.depth, height);
+                source = "estimated";
+            }
+            printf("adaptive steps: yield drift %.5f (%s)\n", yield_drift, source);
+            built = build_adaptive_loading_protocol(source_data->loading.levels, source_data->loading.level_num,
+                                                    height, yield_drift, 2, protocol);
+        } else if (protocol != NULL) {
+            built = build_loading_protocol(source_data->loading.levels, source_data->loading.level_num, height, 2, protocol);
+        }
+        // 再開点(STEP の区切り)で分ける
+        if (built == EXIT_SUCCESS && option->restart_run_num > 0) {
+            built = plan_restart_steps(protocol, option->restart_run_num, restart_step);
+        }
+        if (built != EXIT_SUCCESS) {
+            free_loading_protocol(protocol);
+            free_json_data(source_data);
+            free_modeling_data(modeling_data);
+            return MODELING_RCS_ERROR;
+        }
+        printf("loading: %d levels, %d peaks, steps %d - %d in %d STEP cards\n", source_data->loading.level_num,
+            protocol->peak_num, protocol->first_step, protocol->last_step, protocol->segment_num);
+
+        // 結果出力の計画(再開点で分けた後の STEP の区間ごと)
+        if (option->output_budget > 0.0) {
+            ModelEstimate estimate;
+            double budget_bytes = option->output_budget * 1024.0 * 1024.0;
+            estimate_model(modeling_data, &estimate);
+            // 後処理で鏡映、切断、並べた後の規模(部分モデル、治具の削除は考えない)
+            double scale = option->frame_bay_num * option->frame_story_num;
+            if (option->scope == MODEL_SCOPE_FULL) {
+                scale *= 2.0;
+            } else if (option->scope == MODEL_SCOPE_QUARTER || option->scope == MODEL_SCOPE_QUARTER_ANTISYMMETRIC) {
+                scale *= 0.5;
+            }
+            output = create_output_plan();
+            if (output == NULL || plan_output(protocol, (int)(estimate.node_num * scale), (int)(estimate.element_num * scale),
+                                              budget_bytes, output) != EXIT_SUCCESS) {
+                free_output_plan(output);
+                free_loading_protocol(protocol);
+                free_json_data(source_data);
+                free_modeling_data(modeling_data);
+                return MODELING_RCS_ERROR;
+            }
+            print_output_plan(output, budget_bytes);
+        }
+    }
+
+    // source_dataはここで解放
+    print_modeling_data(modeling_data);
+    free_json_data(source_data);
     
     // ffiの書き込み -----------------------------------------------------------------
     //ファイルオープン
@@ -3653,53 +2744,86 @@ ModelingRcsResult modeling_rcs(const char *inputFileName, const char *outputFile
     if(fout == NULL)
     {
         printf("ERROR: out.ffi cant open.\n");
+        free_loading_protocol(protocol);
+        free_output_plan(output);
         free_modeling_data(modeling_data);
         return MODELING_RCS_ERROR;
     }
 
     // 強制変位を与える節点を取得
     int load_nodes[2] = {0};
-    get_load_node(modeling_data, load_nodes);
+    get_load_node(modeling_data, load_nodes, option->rigid_jig);
 
     // 解析制御データ
-    print_head_template(fout, 10, load_nodes[1], 'x', load_nodes[1], 'x');
+    print_head_template(fout, (protocol != NULL) ? protocol->last_step : 10, load_nodes[1], 'x', load_nodes[1], 'x');
 
     // 柱 - 六面体要素
     add_column_hexa(fout, modeling_data);
 
-    // 柱主筋 - 線材要素,LINE要素
-    add_reber_fiber_line(fout, modeling_data);
+    // 柱主筋 - 線材要素
+    add_rebar_fiber(fout, modeling_data);
 
     //接合部 - 四辺形要素
     add_joint_quad(fout, modeling_data);
-    //接合部 - FILM要素
-    add_joint_film(fout, modeling_data);
 
     //梁 - 六面体要素
     add_beam_hexa(fout, modeling_data);
     //梁 - 四辺形要素
     add_beam_quad(fout, modeling_data);
 
+    // 主筋付着 - LINE要素, 接合部 - FILM要素
+    if (add_interface_elements(fout, outputFileName, modeling_data) != EXIT_SUCCESS) {
+        fprintf(stderr, "Failed to generate interface elements\n");
+        fclose(fout);
+        remove(outputFileName);
+        free_loading_protocol(protocol);
+        free_output_plan(output);
+        free_modeling_data(modeling_data);
+        return MODELING_RCS_ERROR;
+    }
+
     // 切断面拘束
     fix_cut_surface(fout, modeling_data);
 
     // 境界条件
-    set_pin(fout, modeling_data, 'b');
-    set_roller(fout, modeling_data, 'c');
+    set_pin(fout, modeling_data, 'b', option->rigid_jig);
+    set_roller(fout, modeling_data, 'c', option->rigid_jig);
     
     // 要素タイプ、材料モデル
     print_type_mat(fout);
 
     // 軸力導入
-    print_axial_force_step(fout, modeling_data);
+    print_axial_force_step(fout, modeling_data, option->rigid_jig);
 
-    // 強制変位
-    print_load_step(fout, load_nodes);
+    // 強制変位("loading" が無い場合は単調載荷)
+    if (protocol != NULL) {
+        print_loading_protocol(fout, protocol, load_nodes, output);
+        free_loading_protocol(protocol);
+        free_output_plan(output);
+    } else {
+        print_load_step(fout, load_nodes);
+    }
 
     // END
     fprintf(fout, "\nEND\n");
     fclose(fout);
 
+    // 要素形状のチェック
+    check_mesh_quality(outputFileName);
+
+    // 後処理(失敗した場合は後処理の前のモデルを残さない)
+    if(post_process_ffi(outputFileName, option, modeling_data) != EXIT_SUCCESS) {
+        remove(outputFileName);
+        free_modeling_data(modeling_data);
+        return MODELING_RCS_ERROR;
+    }
+
+    // 再開点で分けた解析
+    if (option->restart_run_num > 0 && write_restart_runs(outputFileName, restart_step, option->restart_run_num) != EXIT_SUCCESS) {
+        free_modeling_data(modeling_data);
+        return MODELING_RCS_ERROR;
+    }
+
     free_modeling_data(modeling_data);  // メモリの解放
     return MODELING_RCS_SUCCESS;
 
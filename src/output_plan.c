@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "output_plan.h"
+
+/**
+ * 結果出力(OUT)の計画(--output-budget)
+ *
+ * 長い繰り返し載荷で全てのステップを LEVEL=(3) で出力すると結果のファイルが大きくなり、書き込みで解析が遅くなる。
+ * 履歴の要点(反転 = 正負の最大の変位、0 を通るステップ、最後のステップ)は LEVEL=(3) で必ず出力し、
+ * 残りの予算でその他のステップを一定の間隔で POST だけ出力する。
+ * OUT は STEP の区間ごとに、同じレベル、同じ間隔で続くステップを1枚にまとめる。
+ */
+
+OutputPlan* create_output_plan() {
+    OutputPlan* plan = (OutputPlan*)malloc(sizeof(OutputPlan));
+    if (plan == NULL) {
+        fprintf(stderr, "Error: Memory allocation for OutputPlan failed\n");
+        return NULL;
+    }
+    *plan = (OutputPlan){0};
+    return plan;
+}
+
+int free_output_plan(OutputPlan* plan) {
+    if (plan == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(plan->range);
+    free(plan);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 1ステップの結果の大きさの目安(バイト)
+ *
+ * @param level OUT の出力レベル(1:RESULT 2:POST 3:1+2)
+ */
+double estimate_output_step_bytes(int node_num, int element_num, int level) {
+    double bytes = 0.0;
+    if (level & OUTPUT_LEVEL_RESULT) {
+        bytes += (double)node_num * OUTPUT_RESULT_NODE_BYTES + (double)element_num * OUTPUT_RESULT_ELEMENT_BYTES;
+    }
+    if (level & OUTPUT_LEVEL_POST) {
+        bytes += (double)node_num * OUTPUT_POST_NODE_BYTES + (double)element_num * OUTPUT_POST_ELEMENT_BYTES;
+    }
+    return bytes;
+}
+
+/**
+ * OUT カードを1枚加える
+ */
+static int add_output_range(OutputPlan* plan, int start, int end, int interval, int level) {
+    if (plan->range_num >= plan->range_capacity) {
+        int capacity = (plan->range_capacity == 0) ? 16 : plan->range_capacity * 2;
+        OutputRange* new_range = (OutputRange*)realloc(plan->range, (size_t)capacity * sizeof(OutputRange));
+        if (new_range == NULL) {
+            fprintf(stderr, "Error: Failed to grow OutputPlan\n");
+            return EXIT_FAILURE;
+        }
+        plan->range = new_range;
+        plan->range_capacity = capacity;
+    }
+    plan->range[plan->range_num] = (OutputRange){start, end, interval, level};
+    plan->range_num++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 区間 first ... last のステップの出力レベル(level[step - first_step]、0 は出力しない)を OUT にまとめる。
+ * 同じレベルで間隔が等しいステップを先頭から順に1枚にする。
+ */
+static int add_output_ranges(OutputPlan* plan, const unsigned char level[], int first_step, int first, int last) {
+    int start = 0;
+    int end = 0;
+    int interval = 0;
+    for (int step = first; step <= last + 1; step++) {
+        int current = (step <= last) ? level[step - first_step] : 0;
+        if (step <= last && current == 0) {
+            continue;
+        }
+        if (start > 0 && step <= last && current == level[start - first_step] &&
+            (interval == 0 || step - end == interval)) {
+            interval = step - end;
+            end = step;
+            continue;
+        }
+        if (start > 0 && add_output_range(plan, start, end, (interval == 0) ? 1 : interval, level[start - first_step]) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        start = end = step;
+        interval = 0;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 変位履歴の結果出力を予算に収まるように計画する
+ *
+ * - 反転(次のステップで向きが変わる)、0 を通る(符号が変わる、0 になる)ステップと最後のステップを key とし、LEVEL=(3) で出力する。
+ *   key だけで予算を超える場合は key を POST だけにする(それでも超える場合はそのまま出力し、print_output_plan が警告する)。
+ * - 全てのステップを LEVEL=(3) で出力しても予算に収まる場合はそうする(key_step_num は全てのステップ)。
+ * - 収まらない場合は残りの予算でその他のステップを POST だけ出力する。間隔はステップ番号が interval の倍数のものが予算に収まる最小の値。
+ * 大きさは node_num、element_num から estimate_output_step_bytes で見積もる。
+ *
+ * @param budget_bytes 結果の大きさの予算(バイト)
+ * @return EXIT_SUCCESS / EXIT_FAILURE
+ */
+int plan_output(const LoadingProtocol* protocol, int node_num, int element_num, double budget_bytes, OutputPlan* plan) {
+    if (protocol == NULL || plan == NULL || protocol->segment_num == 0 || budget_bytes <= 0.0) {
+        fprintf(stderr, "Error: invalid arguments passed to plan_output\n");
+        return EXIT_FAILURE;
+    }
+    int first_step = protocol->first_step;
+    int step_num = protocol->last_step - first_step + 1;
+    int* increment = (int*)malloc((size_t)step_num * sizeof(int));
+    unsigned char* level = (unsigned char*)calloc((size_t)step_num, sizeof(unsigned char));
+    if (increment == NULL || level == NULL) {
+        fprintf(stderr, "Error: Memory allocation for plan_output failed\n");
+        free(increment);
+        free(level);
+        return EXIT_FAILURE;
+    }
+    int k = 0;
+    for (int s = 0; s < protocol->segment_num; s++) {
+        for (int n = 0; n < protocol->segment[s].step_num; n++) {
+            increment[k++] = protocol->segment[s].increment;
+        }
+    }
+
+    // key のステップ
+    plan->range_num = 0;
+    plan->key_step_num = 0;
+    int position = 0;
+    for (k = 0; k < step_num; k++) {
+        int previous = position;
+        position += increment[k];
+        int reversal = k + 1 < step_num && (long long)increment[k] * increment[k + 1] < 0;
+        int crossing = position == 0 || (long long)previous * position < 0;
+        if (reversal || crossing || k == step_num - 1) {
+            level[k] = OUTPUT_LEVEL_ALL;
+            plan->key_step_num++;
+        }
+    }
+
+    double step_all = estimate_output_step_bytes(node_num, element_num, OUTPUT_LEVEL_ALL);
+    double step_post = estimate_output_step_bytes(node_num, element_num, OUTPUT_LEVEL_POST);
+    plan->full_bytes = step_all * step_num;
+    plan->key_level = OUTPUT_LEVEL_ALL;
+    double key_bytes = step_all * plan->key_step_num;
+    if (key_bytes > budget_bytes) {
+        plan->key_level = OUTPUT_LEVEL_POST;
+        key_bytes = step_post * plan->key_step_num;
+        for (k = 0; k < step_num; k++) {
+            if (level[k]) level[k] = OUTPUT_LEVEL_POST;
+        }
+    }
+
+    // その他のステップの間隔
+    int other_num = step_num - plan->key_step_num;
+    double rest = budget_bytes - key_bytes;
+    plan->sparse_interval = 0;
+    plan->sparse_step_num = 0;
+    if (other_num > 0 && rest >= step_all * other_num && plan->key_level == OUTPUT_LEVEL_ALL) {
+        // 全てのステップが予算に収まる
+        for (k = 0; k < step_num; k++) {
+            level[k] = OUTPUT_LEVEL_ALL;
+        }
+        plan->key_step_num = step_num;
+        key_bytes = plan->full_bytes;
+    } else if (other_num > 0 && rest >= step_post) {
+        int interval = (int)((double)other_num * step_post / rest);
+        if (interval < 1) interval = 1;
+        for (; interval <= step_num; interval++) {
+            int count = 0;
+            for (k = 0; k < step_num; k++) {
+                if (!level[k] && (first_step + k) % interval == 0) count++;
+            }
+            if (count * step_post <= rest) {
+                plan->sparse_interval = interval;
+                plan->sparse_step_num = count;
+                break;
+            }
+        }
+        for (k = 0; plan->sparse_interval > 0 && k < step_num; k++) {
+            if (!level[k] && (first_step + k) % plan->sparse_interval == 0) level[k] = OUTPUT_LEVEL_POST;
+        }
+    }
+    plan->bytes = key_bytes + step_post * plan->sparse_step_num;
+
+    // STEP の区間ごとに OUT にまとめる
+    int result = EXIT_SUCCESS;
+    int end = first_step - 1;
+    for (int s = 0; s < protocol->segment_num && result == EXIT_SUCCESS; s++) {
+        result = add_output_ranges(plan, level, first_step, end + 1, end + protocol->segment[s].step_num);
+        end += protocol->segment[s].step_num;
+    }
+    free(increment);
+    free(level);
+    return result;
+}
+
+/**
+ * 計画した出力の大きさを表示する
+ */
+void print_output_plan(const OutputPlan* plan, double budget_bytes) {
+    if (plan == NULL) {
+        return;
+    }
+    const double mb = 1024.0 * 1024.0;
+    if (plan->sparse_interval > 0) {
+        printf("output: %d key steps (LEVEL=%d), %d steps every %d (LEVEL=2), %d OUT cards\n", plan->key_step_num, plan->key_level,
+               plan->sparse_step_num, plan->sparse_interval, plan->range_num);
+    } else {
+        printf("output: %d steps (LEVEL=%d), %d OUT cards\n", plan->key_step_num, plan->key_level, plan->range_num);
+    }
+    printf("output: estimated %.1f MB of %.1f MB budget (all steps: %.1f MB)\n", plan->bytes / mb, budget_bytes / mb, plan->full_bytes / mb);
+    if (plan->bytes > budget_bytes) {
+        printf("Warning: key steps alone exceed the output budget\n");
+    }
+}
@@ -34,22 +34,21 @@ bool is_integer_within_digits(int value, int digits) {
 }
 
 /**
- * 入力ファイルに先頭の解析制御データを書き込む
- * 
- * @param f ファイルストリーム
- * @param last_step 実行する解析の最終ステップ
- * @param disp_node 変位をモニターする節点番号
- * @param disp_dir 変位をモニターする方向
- * @param load_node 荷重をモニターする節点番号
- * @param load_dir 荷重をモニターする方向
+ * 解析制御データの EXEC カードを書き込む
+ *
+ * @param first_step 実行する解析の最初のステップ
+ * @param last_step 実行する解析の最終ステップ(0の場合は空白)
+ * @param restart 1の場合は前の解析の再開用データから続ける(RESTART=(1))。0の場合は空白
  */
-int print_head_template(FILE *f, int last_step, int disp_node, char disp_dir, int load_node, char load_dir) {
-
-    // ファイルポインタを確認
+int print_EXEC(FILE *f, int first_step, int last_step, int restart) {
     if (f == NULL) {
         fprintf(stderr, "Error: Invalid file pointer\n");
         return EXIT_FAILURE;
     }
+    if (first_step < 1 || is_integer_within_digits(first_step, 5) == false) {
+        fprintf(stderr, "Error: 'first_step' must be 1 - 99999\n");
+        return EXIT_FAILURE;
+    }
 
     // last_stepの確認
     char last_step_str[6] = " ";
@@ -69,6 +68,29 @@ int print_head_template(FILE *f, int last_step, int disp_node, char disp_dir, in
         }
     }
 
+    fprintf(f, "EXEC :STEP (%5d)-->(%5s)  ELASTIC=( ) CHECK=(1) POST=(1) RESTART=(%1s)\n",
+            first_step, last_step_str, restart ? "1" : " ");
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 入力ファイルに先頭の解析制御データを書き込む
+ * 
+ * @param f ファイルストリーム
+ * @param last_step 実行する解析の最終ステップ
+ * @param disp_node 変位をモニターする節点番号
+ * @param disp_dir 変位をモニターする方向
+ * @param load_node 荷重をモニターする節点番号
+ * @param load_dir 荷重をモニターする方向
+ */
+int print_head_template(FILE *f, int last_step, int disp_node, char disp_dir, int load_node, char load_dir) {
+
+    // ファイルポインタを確認
+    if (f == NULL) {
+        fprintf(stderr, "Error: Invalid file pointer\n");
+        return EXIT_FAILURE;
+    }
+
     // disp_node
     char disp_node_str[6] = " ";
     if(disp_node < 0) {
@@ -135,14 +157,21 @@ int print_head_template(FILE *f, int last_step, int disp_node, char disp_dir, in
         f,
         "-------------------< FINAL version 11  Input data >---------------------\n"
         "TITL :\n"
-        "EXEC :STEP (    1)-->(%5s)  ELASTIC=( ) CHECK=(1) POST=(1) RESTART=( )\n"
-        "LIST :ECHO=(0)  MODEL=(1)  RESULTS=(1)  MESSAGE=(2)  WARNING=(2)  (0:NO)\n"
-        "FILE :CONV=(2)  GRAPH=(2)  MONITOR=(2)  HISTORY=(1)  ELEMENT=(0)  (0:NO)\n"
-        "DISP :DISPLACEMENT MONITOR NODE NO.(%5s)  DIR=(%1d)    FACTOR=\n"
-        "LOAD :APPLIED LOAD MONITOR NODE NO.(%5s)  DIR=(%1d)    FACTOR=\n"
-        "UNIT :STRESS=(3) (1:kgf/cm**2  2:tf/m**2  3:N/mm**2=MPa)\n\n",
-        last_step_str, disp_node_str, disp_direction_int, load_node_str, load_direction_int
     );
+    if (result >= 0 && print_EXEC(f, 1, last_step, 0) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    if (result >= 0) {
+        result = fprintf(
+            f,
+            "LIST :ECHO=(0)  MODEL=(1)  RESULTS=(1)  MESSAGE=(2)  WARNING=(2)  (0:NO)\n"
+            "FILE :CONV=(2)  GRAPH=(2)  MONITOR=(2)  HISTORY=(1)  ELEMENT=(0)  (0:NO)\n"
+            "DISP :DISPLACEMENT MONITOR NODE NO.(%5s)  DIR=(%1d)    FACTOR=\n"
+            "LOAD :APPLIED LOAD MONITOR NODE NO.(%5s)  DIR=(%1d)    FACTOR=\n"
+            "UNIT :STRESS=(3) (1:kgf/cm**2  2:tf/m**2  3:N/mm**2=MPa)\n\n",
+            disp_node_str, disp_direction_int, load_node_str, load_direction_int
+        );
+    }
 
     // 書き込んだ文字数が0未満であればエラーを返す
     if(result < 0) {
@@ -390,6 +419,15 @@ void print_UE(FILE *f, int start_element, int end_element, int interval, double
 }
 
 void print_OUT(FILE *f, int start_step, int end_step, int interval) {
+    print_OUT_level(f, start_step, end_step, interval, 3);
+}
+
+/**
+ * 出力レベルを指定して OUT カードを書き込む
+ *
+ * @param level 1:RESULT 2:POST 3:1+2
+ */
+void print_OUT_level(FILE *f, int start_step, int end_step, int interval, int level) {
     char end_node_str[6] = " ";
     char interval_str[6] = " ";
     if (end_step != 0)
@@ -401,5 +439,5 @@ void print_OUT(FILE *f, int start_step, int end_step, int interval) {
         sprintf(interval_str, "%d", interval);
     }
 
-    fprintf(f," OUT :STEP  S(%5d)-E(%5s)-I(%5s) LEVEL=(3) (1:RESULT 2:POST 3:1+2)\n", start_step, end_node_str, interval_str);
+    fprintf(f," OUT :STEP  S(%5d)-E(%5s)-I(%5s) LEVEL=(%1d) (1:RESULT 2:POST 3:1+2)\n", start_step, end_node_str, interval_str, level);
 }
\ No newline at end of file
@@ -0,0 +1,522 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "range_set.h"
+#include "print_ffi.h"
+
+/**
+ * 節点番号、要素番号の集合を S-E-I (と INC-SET) のカードにまとめる。
+ *
+ * 1段(S-E-I)は、昇順の番号を連続する等差数列に分ける分け方のうち、数が最小のものを動的計画法で求める。
+ *   dp[j] (先頭 j 個を覆う最小の数) は j について単調に増えるため、
+ *   j-1 番目で終わる最も長い等差数列の先頭を L として dp[j] = dp[L] + 1 となる。
+ * 連続しない(入れ子の)等差数列も拾うため、数個先の番号との差のうち多く現れる d ごとに d おきの並びに分けたものも試す。
+ * 2段(INC-SET)は、個数と I が同じ S-E-I を集め、S の並びを同じ方法で等差数列に分ける。
+ * さらに、得られた INC おきの並びを1段目とする(S-E-I と INC-SET の向きを入れ替える)分け方も試す。
+ * いずれもカードが最も少ない候補を使い、集合をちょうど覆い、余分な番号を含まない。
+ */
+
+// 1段の等差数列(count 個、1つだけの場合は interval = 0)
+typedef struct {
+    int start;
+    int interval;
+    int count;
+} RangePiece;
+
+RangeSetList* create_range_set_list() {
+    RangeSetList* list = (RangeSetList*)malloc(sizeof(RangeSetList));
+    if (list == NULL) {
+        fprintf(stderr, "Error: Memory allocation for RangeSetList failed\n");
+        return NULL;
+    }
+    list->range_num = 0;
+    list->range_capacity = 0;
+    list->range = NULL;
+    return list;
+}
+
+int free_range_set_list(RangeSetList* list) {
+    if (list == NULL) {
+        return EXIT_FAILURE;
+    }
+    free(list->range);
+    free(list);
+    return EXIT_SUCCESS;
+}
+
+static int add_range_set(RangeSetList* list, const RangeSet* range) {
+    if (list->range_num >= list->range_capacity) {
+        int capacity = (list->range_capacity == 0) ? 16 : list->range_capacity * 2;
+        RangeSet* new_range = (RangeSet*)realloc(list->range, (size_t)capacity * sizeof(RangeSet));
+        if (new_range == NULL) {
+            fprintf(stderr, "Error: Failed to grow RangeSetList\n");
+            return EXIT_FAILURE;
+        }
+        list->range = new_range;
+        list->range_capacity = capacity;
+    }
+    list->range[list->range_num++] = *range;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * S-E-I と、それを k*INC (k = 1 ... SET) ずらした番号を ids に加える(読み込みと同じく E < S は S、I = 0 は 1)。
+ * ids は必要に応じて再確保する。
+ *
+ * @param ids 番号の配列(NULL可)
+ * @param n 番号の数
+ * @param capacity ids の大きさ
+ * @return EXIT_SUCCESS or EXIT_FAILURE
+ */
+int append_range_ids(int** ids, int* n, int* capacity, int start, int end, int interval, int increment, int set) {
+    if (end < start) end = start;
+    if (interval == 0) interval = 1;
+    if (set < 0) set = 0;
+    int count = ((end - start) / interval + 1) * (set + 1);
+    if (*n + count > *capacity) {
+        int new_capacity = (*capacity == 0) ? 64 : *capacity;
+        while (new_capacity < *n + count) new_capacity *= 2;
+        int* new_ids = (int*)realloc(*ids, (size_t)new_capacity * sizeof(int));
+        if (new_ids == NULL) {
+            fprintf(stderr, "Error: Memory allocation for append_range_ids failed\n");
+            return EXIT_FAILURE;
+        }
+        *ids = new_ids;
+        *capacity = new_capacity;
+    }
+    for (int k = 0; k <= set; k++) {
+        for (int id = start; id <= end; id += interval) {
+            (*ids)[(*n)++] = id + k * increment;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+static int compare_int(const void* a, const void* b) {
+    int p = *(const int*)a;
+    int q = *(const int*)b;
+    return (p > q) - (p < q);
+}
+
+static int compare_range_piece(const void* a, const void* b) {
+    const RangePiece* p = (const RangePiece*)a;
+    const RangePiece* q = (const RangePiece*)b;
+    if (p->interval != q->interval) return (p->interval < q->interval) ? -1 : 1;
+    if (p->count != q->count) return (p->count < q->count) ? -1 : 1;
+    return (p->start > q->start) - (p->start < q->start);
+}
+
+static int compare_range_set(const void* a, const void* b) {
+    const RangeSet* p = (const RangeSet*)a;
+    const RangeSet* q = (const RangeSet*)b;
+    return (p->start > q->start) - (p->start < q->start);
+}
+
+/**
+ * 昇順の値を、連続する等差数列の最小の数に分ける
+ *
+ * @param first 各等差数列の先頭の位置
+ * @param length 各等差数列の個数
+ * @param work 作業配列(サイズ 2 * (n + 1))
+ * @return 等差数列の数
+ */
+static int split_progressions(const int value[], int n, int first[], int length[], int work[]) {
+    int* dp = work;
+    int* back = &work[n + 1];
+    dp[0] = 0;
+    int head = 0;  // j で終わる最も長い等差数列の先頭
+    for (int j = 0; j < n; j++) {
+        if (j == 0) {
+            head = 0;
+        } else if (j == 1 || value[j] - value[j - 1] != value[j - 1] - value[j - 2]) {
+            head = j - 1;
+        }
+        dp[j + 1] = dp[head] + 1;
+        back[j + 1] = head;
+    }
+    int num = dp[n];
+    for (int j = n, r = num - 1; j > 0; j = back[j], r--) {
+        first[r] = back[j];
+        length[r] = j - back[j];
+    }
+    return num;
+}
+
+/**
+ * 昇順の値の中に value があるか(二分探索)
+ */
+static int contains_value(const int sorted[], int n, int value) {
+    int low = 0;
+    int high = n - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        if (sorted[middle] == value) return 1;
+        if (sorted[middle] < value) low = middle + 1;
+        else high = middle - 1;
+    }
+    return 0;
+}
+
+/**
+ * 昇順の値を最小の数の連続する等差数列に分ける
+ */
+static int min_pieces(const int value[], int n, RangePiece piece[], int first[], int length[], int work[]) {
+    int num = split_progressions(value, n, first, length, work);
+    for (int r = 0; r < num; r++) {
+        piece[r].start = value[first[r]];
+        piece[r].count = length[r];
+        piece[r].interval = (length[r] > 1) ? value[first[r] + 1] - value[first[r]] : 0;
+    }
+    return num;
+}
+
+/**
+ * 昇順の値を d おきの並びに分ける(value - d が無い値から始め、value + d が続く限り伸ばす)
+ */
+static int chain_pieces(const int value[], int n, int d, RangePiece piece[]) {
+    int num = 0;
+    for (int i = 0; i < n; i++) {
+        if (contains_value(value, n, value[i] - d)) {
+            continue;
+        }
+        int count = 1;
+        while (contains_value(value, n, value[i] + count * d)) {
+            count++;
+        }
+        piece[num].start = value[i];
+        piece[num].count = count;
+        piece[num].interval = (count > 1) ? d : 0;
+        num++;
+    }
+    return num;
+}
+
+/**
+ * 多く現れる値の差(RANGE_SET_LOOKAHEAD 個先までの値との差)を RANGE_SET_CANDIDATE_NUM 個まで求める
+ *
+ * @param work 作業配列(サイズ RANGE_SET_LOOKAHEAD * n)
+ * @return 求めた数
+ */
+static int frequent_differences(const int value[], int n, int difference[], int work[]) {
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        for (int k = 1; k <= RANGE_SET_LOOKAHEAD && i + k < n; k++) {
+            work[m++] = value[i + k] - value[i];
+        }
+    }
+    qsort(work, m, sizeof(int), compare_int);
+    int best_count[RANGE_SET_CANDIDATE_NUM];
+    int num = 0;
+    for (int i = 0; i < m;) {
+        int j = i;
+        while (j < m && work[j] == work[i]) j++;
+        int count = j - i;
+        // 多い順に挿入する
+        int position = num;
+        while (position > 0 && best_count[position - 1] < count) position--;
+        if (position < RANGE_SET_CANDIDATE_NUM) {
+            int last = (num < RANGE_SET_CANDIDATE_NUM) ? num : RANGE_SET_CANDIDATE_NUM - 1;
+            for (int k = last; k > position; k--) {
+                best_count[k] = best_count[k - 1];
+                difference[k] = difference[k - 1];
+            }
+            best_count[position] = count;
+            difference[position] = work[i];
+            if (num < RANGE_SET_CANDIDATE_NUM) num++;
+        }
+        i = j;
+    }
+    return num;
+}
+
+/**
+ * 昇順の値を少ない数の等差数列(1段)に分ける。
+ * 連続する等差数列の最小の分け方と、多く現れる差 d おきの並び(1つだけ残る値は連続する等差数列に分け直す)のうち最も少ないもの。
+ *
+ * @return 等差数列の数。失敗した場合は -1
+ */
+static int best_pieces(const int value[], int n, RangePiece piece[]) {
+    int* first = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* length = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* single = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* work = (int*)malloc(RANGE_SET_LOOKAHEAD * ((size_t)n + 1) * sizeof(int));
+    RangePiece* candidate = (RangePiece*)malloc(((size_t)n + 1) * sizeof(RangePiece));
+    if (first == NULL || length == NULL || single == NULL || work == NULL || candidate == NULL) {
+        fprintf(stderr, "Error: Memory allocation for best_pieces failed\n");
+        free(first);
+        free(length);
+        free(single);
+        free(work);
+        free(candidate);
+        return -1;
+    }
+    int best = min_pieces(value, n, piece, first, length, work);
+    int difference[RANGE_SET_CANDIDATE_NUM];
+    int difference_num = frequent_differences(value, n, difference, work);
+    for (int c = 0; c < difference_num; c++) {
+        int num = chain_pieces(value, n, difference[c], candidate);
+        int kept = 0;
+        int single_num = 0;
+        for (int r = 0; r < num; r++) {
+            if (candidate[r].count > 1) {
+                candidate[kept++] = candidate[r];
+            } else {
+                single[single_num++] = candidate[r].start;
+            }
+        }
+        kept += min_pieces(single, single_num, &candidate[kept], first, length, work);
+        if (kept < best) {
+            memcpy(piece, candidate, (size_t)kept * sizeof(RangePiece));
+            best = kept;
+        }
+    }
+    free(first);
+    free(length);
+    free(single);
+    free(work);
+    free(candidate);
+    return best;
+}
+
+/**
+ * 1段の等差数列をカードにする。
+ * use_set の場合は個数と I が同じものを集め、S の並びを等差数列(INC-SET)にまとめる。
+ *
+ * @param list NULLの場合は数えるだけ
+ * @return カードの数。失敗した場合は -1
+ */
+static int group_pieces(RangePiece piece[], int piece_num, int use_set, RangeSetList* list) {
+    int card_num = 0;
+    if (!use_set) {
+        for (int r = 0; r < piece_num; r++) {
+            RangeSet range = {piece[r].start, piece[r].start + (piece[r].count - 1) * piece[r].interval,
+                              (piece[r].interval == 0) ? 1 : piece[r].interval, 0, 0};
+            if (list != NULL && add_range_set(list, &range) != EXIT_SUCCESS) {
+                return -1;
+            }
+            card_num++;
+        }
+        return card_num;
+    }
+
+    int* starts = (int*)malloc(((size_t)piece_num + 1) * sizeof(int));
+    RangePiece* progression = (RangePiece*)malloc(((size_t)piece_num + 1) * sizeof(RangePiece));
+    if (starts == NULL || progression == NULL) {
+        fprintf(stderr, "Error: Memory allocation for group_pieces failed\n");
+        free(starts);
+        free(progression);
+        return -1;
+    }
+    qsort(piece, piece_num, sizeof(RangePiece), compare_range_piece);
+    int head = 0;
+    while (head < piece_num && card_num >= 0) {
+        int tail = head;
+        while (tail < piece_num && piece[tail].interval == piece[head].interval && piece[tail].count == piece[head].count) {
+            starts[tail - head] = piece[tail].start;
+            tail++;
+        }
+        int num = best_pieces(starts, tail - head, progression);
+        if (num < 0) {
+            card_num = -1;
+            break;
+        }
+        for (int r = 0; r < num; r++) {
+            RangeSet range;
+            if (piece[head].count == 1) {
+                // 1つずつの番号は S-E-I にする
+                range.start = progression[r].start;
+                range.end = progression[r].start + (progression[r].count - 1) * progression[r].interval;
+                range.interval = (progression[r].interval == 0) ? 1 : progression[r].interval;
+                range.increment = 0;
+                range.set = 0;
+            } else {
+                range.start = progression[r].start;
+                range.end = progression[r].start + (piece[head].count - 1) * piece[head].interval;
+                range.interval = piece[head].interval;
+                range.increment = progression[r].interval;
+                range.set = progression[r].count - 1;
+            }
+            if (list != NULL && add_range_set(list, &range) != EXIT_SUCCESS) {
+                card_num = -1;
+                break;
+            }
+            card_num++;
+        }
+        head = tail;
+    }
+    free(starts);
+    free(progression);
+    return card_num;
+}
+
+/**
+ * 番号の集合(順不同、重複可)を、ちょうど覆う少ない数のカードにまとめ list に加える。
+ *
+ * @param use_set 1: S-E-I と INC-SET (REST、ETYP)、0: S-E-I だけ (SUB1、UE)
+ * @return EXIT_SUCCESS or EXIT_FAILURE
+ */
+int encode_range_set(const int ids[], int n, int use_set, RangeSetList* list) {
+    if ((ids == NULL && n > 0) || list == NULL) {
+        fprintf(stderr, "Error: NULL pointer passed to encode_range_set\n");
+        return EXIT_FAILURE;
+    }
+    if (n <= 0) {
+        return EXIT_SUCCESS;
+    }
+    int* sorted = (int*)malloc((size_t)n * sizeof(int));
+    int* first = (int*)malloc((size_t)n * sizeof(int));
+    int* length = (int*)malloc((size_t)n * sizeof(int));
+    int* work = (int*)malloc(RANGE_SET_LOOKAHEAD * ((size_t)n + 1) * sizeof(int));
+    RangePiece* piece = (RangePiece*)malloc((size_t)n * sizeof(RangePiece));
+    RangePiece* best_piece = (RangePiece*)malloc((size_t)n * sizeof(RangePiece));
+    if (sorted == NULL || first == NULL || length == NULL || work == NULL || piece == NULL || best_piece == NULL) {
+        fprintf(stderr, "Error: Memory allocation for encode_range_set failed\n");
+        free(sorted);
+        free(first);
+        free(length);
+        free(work);
+        free(piece);
+        free(best_piece);
+        return EXIT_FAILURE;
+    }
+
+    // 昇順に並べ、重複を取り除く
+    memcpy(sorted, ids, (size_t)n * sizeof(int));
+    qsort(sorted, n, sizeof(int), compare_int);
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        if (unique == 0 || sorted[unique - 1] != sorted[i]) {
+            sorted[unique++] = sorted[i];
+        }
+    }
+
+    // 1段の分け方の候補からカードが最も少ないものを選ぶ
+    int best_num;
+    int best_cost;
+    if (!use_set) {
+        best_num = best_pieces(sorted, unique, best_piece);
+        best_cost = best_num;
+    } else {
+        best_num = min_pieces(sorted, unique, best_piece, first, length, work);
+        best_cost = group_pieces(best_piece, best_num, 1, NULL);
+        // 1回目: 近い番号との差 d おき、2回目: 1回目の結果の INC おき(S-E-I と INC-SET の向きを入れ替えた並び)
+        int difference[RANGE_SET_CANDIDATE_NUM];
+        int difference_num = frequent_differences(sorted, unique, difference, work);
+        for (int round = 0; round < 2 && best_cost >= 0; round++) {
+            if (round == 1) {
+                difference_num = 0;
+                RangeSetList* trial = create_range_set_list();
+                if (trial == NULL || group_pieces(best_piece, best_num, 1, trial) < 0) {
+                    best_cost = -1;
+                } else {
+                    for (int r = 0; r < trial->range_num && difference_num < RANGE_SET_CANDIDATE_NUM; r++) {
+                        int increment = trial->range[r].increment;
+                        int known = (trial->range[r].set == 0);
+                        for (int c = 0; c < difference_num && !known; c++) {
+                            known = (difference[c] == increment);
+                        }
+                        if (!known) {
+                            difference[difference_num++] = increment;
+                        }
+                    }
+                }
+                free_range_set_list(trial);
+            }
+            for (int c = 0; c < difference_num && best_cost >= 0; c++) {
+                int num = chain_pieces(sorted, unique, difference[c], piece);
+                int cost = group_pieces(piece, num, 1, NULL);
+                if (cost < 0) {
+                    best_cost = -1;
+                } else if (cost < best_cost) {
+                    memcpy(best_piece, piece, (size_t)num * sizeof(RangePiece));
+                    best_num = num;
+                    best_cost = cost;
+                }
+            }
+        }
+    }
+
+    int result = EXIT_FAILURE;
+    int range_head = list->range_num;
+    if (best_cost >= 0 && group_pieces(best_piece, best_num, use_set, list) >= 0) {
+        qsort(&list->range[range_head], list->range_num - range_head, sizeof(RangeSet), compare_range_set);
+        result = EXIT_SUCCESS;
+    }
+
+    free(sorted);
+    free(first);
+    free(length);
+    free(work);
+    free(piece);
+    free(best_piece);
+    return result;
+}
+
+// 書き込み ----------------------------------------------------------------------------
+/**
+ * 節点の集合を REST にまとめて書き込む
+ */
+int print_REST_set(FILE* f, const int ids[], int n, int rc) {
+    RangeSetList* list = create_range_set_list();
+    if (list == NULL || encode_range_set(ids, n, 1, list) != EXIT_SUCCESS) {
+        free_range_set_list(list);
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < list->range_num; r++) {
+        const RangeSet* range = &list->range[r];
+        print_REST(f, range->start, range->end, range->interval, rc, range->increment, range->set);
+    }
+    free_range_set_list(list);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 従属節点の集合を SUB1 (同じ主節点、方向) にまとめて書き込む
+ */
+int print_SUB1_set(FILE* f, const int ids[], int n, int dir, int master, int m_dir) {
+    RangeSetList* list = create_range_set_list();
+    if (list == NULL || encode_range_set(ids, n, 0, list) != EXIT_SUCCESS) {
+        free_range_set_list(list);
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < list->range_num; r++) {
+        const RangeSet* range = &list->range[r];
+        print_SUB1(f, range->start, range->end, range->interval, dir, master, m_dir);
+    }
+    free_range_set_list(list);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素の集合を ETYP にまとめて書き込む
+ */
+int print_ETYP_set(FILE* f, const int ids[], int n, int type) {
+    RangeSetList* list = create_range_set_list();
+    if (list == NULL || encode_range_set(ids, n, 1, list) != EXIT_SUCCESS) {
+        free_range_set_list(list);
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < list->range_num; r++) {
+        const RangeSet* range = &list->range[r];
+        print_ETYP(f, range->start, range->end, range->interval, type, range->increment, range->set);
+    }
+    free_range_set_list(list);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * 要素の集合を UE (同じ荷重、方向、面) にまとめて書き込む
+ */
+int print_UE_set(FILE* f, const int ids[], int n, double unit, char direction, int face) {
+    RangeSetList* list = create_range_set_list();
+    if (list == NULL || encode_range_set(ids, n, 0, list) != EXIT_SUCCESS) {
+        free_range_set_list(list);
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < list->range_num; r++) {
+        const RangeSet* range = &list->range[r];
+        print_UE(f, range->start, range->end, range->interval, unit, direction, face);
+    }
+    free_range_set_list(list);
+    return EXIT_SUCCESS;
+}
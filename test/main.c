@@ -7,6 +7,33 @@ int main() {
 	test_json_parser();
 	test_modeling_data();
 	test_modeling_rcs();
+	test_mesh_quality();
+	test_mesh_graph();
+	test_mesh_renumber();
+	test_mesh_partition();
+	test_mesh_copy();
+	test_range_set();
+	test_mesh_select();
+	test_block_mesh();
+	test_mesh_interface();
+	test_auto_mesh();
+	test_id_budget();
+	test_estimate_model();
+	test_mirror_mesh_model();
+	test_cut_mesh_model();
+	test_frame_assembly();
+	test_merge_ffi();
+	test_extract_submodel();
+	test_rigid_jig();
+	test_restrict_bond_zone();
+	test_loading_protocol();
+	test_adaptive_loading_protocol();
+	test_restart_runs();
+	test_output_plan();
+	test_fiber_section();
+	test_simd();
+	test_extract_panel();
+	test_quarter_model();
 
 	return 0;
 }
\ No newline at end of file
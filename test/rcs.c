@@ -14,7 +14,9 @@ int main() {
         "test1",
         "test2",
         "test3",
-        "test_min"
+        "test_min",
+        "test_auto",
+        "test_cyclic"
     };
 
     size_t file_count = sizeof(filenames) / sizeof(filenames[0]);
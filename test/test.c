@@ -164,4 +164,1518 @@ void test_head_template() {
  */
 void test_modeling_rcs() {
 	modeling_rcs("../test/test.json", "../run_analysis/out.ffi");
-}
\ No newline at end of file
+}
+#include "mesh_model.h"
+#include "mesh_quality.h"
+
+/**
+ * 立方体、扁平、裏返ったHEXAと正方形、台形のQUADで形状チェックを確認する。
+ */
+void test_mesh_quality() {
+	printf("--- 'test_mesh_quality' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+
+	// 節点 1-8: 100の立方体、11-18: 600x100x100の直方体
+	const double unit[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+	for(int i = 0; i < 8; i++) {
+		add_mesh_node(model, i + 1, unit[i][0] * 100, unit[i][1] * 100, unit[i][2] * 100);
+		add_mesh_node(model, i + 11, unit[i][0] * 600, unit[i][1] * 100 + 200, unit[i][2] * 100);
+	}
+	// 台形の節点
+	add_mesh_node(model, 21, 0, 0, 300);
+	add_mesh_node(model, 22, 100, 0, 300);
+	add_mesh_node(model, 23, 80, 0, 400);
+	add_mesh_node(model, 24, 20, 0, 400);
+
+	int cube[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	int slab[8] = {11, 12, 13, 14, 15, 16, 17, 18};
+	int inverted[8] = {5, 6, 7, 8, 1, 2, 3, 4};
+	int square[4] = {1, 2, 6, 5};
+	int trapezoid[4] = {21, 22, 23, 24};
+	add_mesh_element(model, 1, ELEMENT_HEXA, 1, cube);
+	add_mesh_element(model, 2, ELEMENT_HEXA, 1, slab);
+	add_mesh_element(model, 3, ELEMENT_HEXA, 2, inverted);
+	add_mesh_element(model, 4, ELEMENT_QUAD, 1, square);
+	add_mesh_element(model, 5, ELEMENT_QUAD, 1, trapezoid);
+	print_mesh_model(model);
+
+	MeshQuality* quality = create_mesh_quality(model->element_num);
+	compute_mesh_quality(model, quality);
+	for(int e = 0; e < model->element_num; e++) {
+		printf("element %d: volume %.1f, min_jacobian %.1f, scaled_jacobian %.3f, aspect_ratio %.3f, skew %.3f\n",
+			model->element_id[e], quality->volume[e], quality->min_jacobian[e], quality->scaled_jacobian[e], quality->aspect_ratio[e], quality->skew[e]);
+	}
+	if(print_mesh_quality_summary(model, quality) == EXIT_SUCCESS) {
+		printf("no inverted element\n");
+	} else {
+		printf("inverted element found\n");
+	}
+	free_mesh_quality(quality);
+	free_mesh_model(model);
+
+	// ファイルが無い場合
+	if(check_mesh_quality("abc") == EXIT_SUCCESS) {
+		printf("success\n");
+	} else {
+		printf("failure\n");
+	}
+}
+
+#include "mesh_graph.h"
+
+/**
+ * 面を共有する2つのHEXAと、辺を共有するQUAD、BEAMで隣接関係を確認する。
+ */
+void test_mesh_graph() {
+	printf("--- 'test_mesh_graph' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// 節点 1-12: 2x1x1 の格子
+	for(int k = 0; k < 2; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 3; i++) {
+				add_mesh_node(model, 1 + i + 3 * j + 6 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	int hexa1[8] = {1, 2, 5, 4, 7, 8, 11, 10};
+	int hexa2[8] = {2, 3, 6, 5, 8, 9, 12, 11};
+	int quad[4] = {10, 11, 12, 12};
+	int beam[2] = {3, 9};
+	add_mesh_element(model, 1, ELEMENT_HEXA, 1, hexa1);
+	add_mesh_element(model, 2, ELEMENT_HEXA, 1, hexa2);
+	add_mesh_element(model, 3, ELEMENT_QUAD, 1, quad);
+	add_mesh_element(model, 4, ELEMENT_BEAM, 1, beam);
+
+	CsrGraph* node_element = build_node_element_graph(model);
+	print_csr_graph("node_element", node_element, 12);
+
+	// 節点共有、面共有
+	CsrGraph* element_graph = build_element_graph(model, node_element, 1);
+	print_csr_graph("element_element(1)", element_graph, 4);
+	free_csr_graph(element_graph);
+	element_graph = build_element_graph(model, node_element, 4);
+	print_csr_graph("element_element(4)", element_graph, 4);
+	free_csr_graph(element_graph);
+
+	CsrGraph* node_graph = build_node_graph(model, node_element);
+	print_csr_graph("node_node", node_graph, 3);
+	free_csr_graph(node_graph);
+
+	free_csr_graph(node_element);
+	free_mesh_model(model);
+
+	// NULLを渡した場合
+	if(build_node_element_graph(NULL) == NULL) {
+		printf("failure\n");
+	}
+}
+
+#include "mesh_renumber.h"
+
+/**
+ * 番号が飛び飛びの1列のHEXAをRCMで付け替え、帯幅と対応表を確認する。
+ */
+void test_mesh_renumber() {
+	printf("--- 'test_mesh_renumber' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// x方向に4要素、下面と上面で番号を大きく離す
+	for(int i = 0; i < 5; i++) {
+		add_mesh_node(model, 1 + i, i * 100.0, 0, 0);
+		add_mesh_node(model, 11 + i, i * 100.0, 100, 0);
+		add_mesh_node(model, 101 + i, i * 100.0, 0, 100);
+		add_mesh_node(model, 111 + i, i * 100.0, 100, 100);
+	}
+	// 要素番号は x 方向の並びと一致させない
+	int element_id[4] = {3, 1, 4, 2};
+	for(int i = 0; i < 4; i++) {
+		int node[8] = {1 + i, 2 + i, 12 + i, 11 + i, 101 + i, 102 + i, 112 + i, 111 + i};
+		add_mesh_element(model, element_id[i], ELEMENT_HEXA, 1, node);
+	}
+	add_mesh_restraint(model, 1, 111);
+	add_mesh_constraint(model, 5, 1, 115, 1);
+	add_mesh_step_card(model, STEP_CARD_FN, 115, 1, 0, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_UE, 4, 1, 1, 0, 1.0);
+
+	int original_id[20];
+	RenumberStatistics before, after;
+	if(renumber_nodes_rcm(model, original_id, &before, &after) == EXIT_SUCCESS) {
+		printf("bandwidth %d -> %d, profile %lld -> %lld, components %d\n",
+			before.bandwidth, after.bandwidth, before.profile, after.profile, after.component_num);
+		for(int id = 1; id <= model->node_num; id++) {
+			printf("%d <- %d\n", id, original_id[find_mesh_node(model, id)]);
+		}
+		printf("element 1: ");
+		for(int k = 0; k < 8; k++) {
+			printf("%d ", model->connectivity[k]);
+		}
+		printf("\nREST %d, SUB1 %d -> %d, FN %d\n", model->restraint[0].node, model->constraint[0].node, model->constraint[0].master, model->step_card[0].id);
+	} else {
+		printf("failure\n");
+	}
+
+	int original_element_id[4];
+	FrontStatistics front_before, front_after;
+	if(renumber_elements_front(model, original_element_id, &front_before, &front_after) == EXIT_SUCCESS) {
+		printf("max front %d -> %d, mean front %.2f -> %.2f\n",
+			front_before.max_front, front_after.max_front, front_before.mean_front, front_after.mean_front);
+		for(int id = 1; id <= model->element_num; id++) {
+			printf("element %d <- %d\n", id, original_element_id[find_mesh_element(model, id)]);
+		}
+		printf("UE %d\n", model->step_card[1].id);
+	} else {
+		printf("failure\n");
+	}
+	free_mesh_model(model);
+}
+
+#include "mesh_partition.h"
+void test_mesh_partition() {
+	printf("--- 'test_mesh_partition' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// 8 x 2 x 1 のHEXA要素
+	for(int i = 0; i <= 8; i++) {
+		for(int j = 0; j <= 2; j++) {
+			for(int k = 0; k <= 1; k++) {
+				add_mesh_node(model, 1 + i + 9 * j + 27 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int i = 0; i < 8; i++) {
+		for(int j = 0; j < 2; j++) {
+			int n = 1 + i + 9 * j;
+			int node[8] = {n, n + 1, n + 10, n + 9, n + 27, n + 28, n + 37, n + 36};
+			add_mesh_element(model, 1 + i + 8 * j, ELEMENT_HEXA, 1, node);
+		}
+	}
+
+	int part[16];
+	PartitionStatistics statistics;
+	for(int part_num = 2; part_num <= 4; part_num++) {
+		if(partition_mesh_elements(model, part_num, part) != EXIT_SUCCESS
+		   || compute_partition_statistics(model, part_num, part, &statistics) != EXIT_SUCCESS) {
+			printf("failure\n");
+			continue;
+		}
+		printf("%d parts: elements %d - %d, edge cut %d, interface nodes %d\n", part_num,
+			statistics.min_part_size, statistics.max_part_size, statistics.edge_cut, statistics.interface_node_num);
+		for(int j = 1; j >= 0; j--) {
+			for(int i = 0; i < 8; i++) {
+				printf("%d ", part[find_mesh_element(model, 1 + i + 8 * j)]);
+			}
+			printf("\n");
+		}
+	}
+	free_mesh_model(model);
+}
+
+
+// mesh_copyのテスト ----------------------------------------------------------------------
+#include "mesh_copy.h"
+
+/**
+ * 格子状の節点、要素をCOPYカードにまとめ、展開すると元に戻ることを確認する。
+ */
+void test_mesh_copy() {
+	printf("--- 'test_mesh_copy' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// 4 x 3 x 2 のHEXA要素(x方向の間隔は 100, 100, 50, 50)、x = 0 の列はタイプ 2
+	double x[5] = {0.0, 100.0, 200.0, 250.0, 300.0};
+	for(int i = 0; i <= 4; i++) {
+		for(int j = 0; j <= 3; j++) {
+			for(int k = 0; k <= 2; k++) {
+				add_mesh_node(model, 1 + i + 5 * j + 20 * k, x[i], j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int i = 0; i < 4; i++) {
+		for(int j = 0; j < 3; j++) {
+			for(int k = 0; k < 2; k++) {
+				int n = 1 + i + 5 * j + 20 * k;
+				int node[8] = {n, n + 1, n + 6, n + 5, n + 20, n + 21, n + 26, n + 25};
+				add_mesh_element(model, 1 + i + 4 * j + 12 * k, ELEMENT_HEXA, (i == 0) ? 2 : 1, node);
+			}
+		}
+	}
+
+	CopyCardList* node_cards = create_copy_card_list();
+	CopyCardList* element_cards = create_copy_card_list();
+	if(node_cards == NULL || element_cards == NULL
+	   || synthesize_node_cards(model, node_cards) != EXIT_SUCCESS
+	   || synthesize_element_cards(model, element_cards) != EXIT_SUCCESS) {
+		printf("failure\n");
+	} else {
+		printf("nodes %d -> cards %d, elements %d -> cards %d\n",
+			model->node_num, node_cards->card_num, model->element_num, element_cards->card_num);
+		print_copy_cards(stdout, model, node_cards);
+		print_copy_cards(stdout, model, element_cards);
+		printf("verify: %s\n", (verify_copy_cards(model, node_cards, element_cards) == EXIT_SUCCESS) ? "ok" : "failure");
+		// タイプを変えると一致しない
+		model->element_type[0] = 3;
+		printf("verify (changed type): %s\n", (verify_copy_cards(model, node_cards, element_cards) == EXIT_SUCCESS) ? "ok" : "failure");
+	}
+	free_copy_card_list(node_cards);
+	free_copy_card_list(element_cards);
+	free_mesh_model(model);
+}
+
+
+// range_setのテスト ----------------------------------------------------------------------
+#include "range_set.h"
+
+/**
+ * 番号の集合をカードにまとめ、展開すると元の集合に戻ることを確認する。
+ */
+void test_range_set() {
+	printf("--- 'test_range_set' ---\n");
+	// 4 x 3 の格子(行の増分 10)を2層(層の増分 100)、1つ離れた番号、重複を含む
+	int ids[64];
+	int n = 0;
+	for(int k = 0; k < 2; k++) {
+		for(int j = 0; j < 3; j++) {
+			for(int i = 0; i < 4; i++) {
+				ids[n++] = 1 + i + 10 * j + 100 * k;
+			}
+		}
+	}
+	ids[n++] = 500;
+	ids[n++] = 12;
+
+	for(int use_set = 1; use_set >= 0; use_set--) {
+		RangeSetList* list = create_range_set_list();
+		if(list == NULL || encode_range_set(ids, n, use_set, list) != EXIT_SUCCESS) {
+			printf("failure\n");
+			free_range_set_list(list);
+			continue;
+		}
+		printf("use_set %d: %d ids -> %d cards\n", use_set, n, list->range_num);
+		int* expanded = NULL;
+		int expanded_num = 0;
+		int expanded_capacity = 0;
+		for(int r = 0; r < list->range_num; r++) {
+			RangeSet* range = &list->range[r];
+			printf("S(%d)-E(%d)-I(%d) INC(%d)-SET(%d)\n", range->start, range->end, range->interval, range->increment, range->set);
+			append_range_ids(&expanded, &expanded_num, &expanded_capacity, range->start, range->end, range->interval, range->increment, range->set);
+		}
+		// 展開した番号が元の集合(重複を除く)と一致するか
+		int match = (expanded_num == n - 1);
+		for(int i = 0; i < expanded_num && match; i++) {
+			int found = 0;
+			for(int j = 0; j < n; j++) {
+				if(ids[j] == expanded[i]) found = 1;
+			}
+			for(int j = 0; j < i; j++) {
+				if(expanded[j] == expanded[i]) found = 0;
+			}
+			match = found;
+		}
+		printf("expand: %s\n", match ? "ok" : "failure");
+		free(expanded);
+		free_range_set_list(list);
+	}
+	print_ETYP_set(stdout, ids, n, 2);
+}
+
+
+// mesh_selectのテスト ----------------------------------------------------------------------
+#include "mesh_select.h"
+
+/**
+ * 範囲、平面、格子番号、タイプでの選択と集合演算を確認し、選んだ節点をRESTで書き込む。
+ */
+void test_mesh_select() {
+	printf("--- 'test_mesh_select' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// 4 x 3 x 2 のHEXA要素(x = 0 の列はタイプ 2)
+	for(int i = 0; i <= 4; i++) {
+		for(int j = 0; j <= 3; j++) {
+			for(int k = 0; k <= 2; k++) {
+				add_mesh_node(model, 1 + i + 5 * j + 20 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int i = 0; i < 4; i++) {
+		for(int j = 0; j < 3; j++) {
+			for(int k = 0; k < 2; k++) {
+				int n = 1 + i + 5 * j + 20 * k;
+				int node[8] = {n, n + 1, n + 6, n + 5, n + 20, n + 21, n + 26, n + 25};
+				add_mesh_element(model, 1 + i + 4 * j + 12 * k, ELEMENT_HEXA, (i == 0) ? 2 : 1, node);
+			}
+		}
+	}
+
+	SpatialIndex* node_index = build_spatial_index(model, SELECT_NODE);
+	SpatialIndex* element_index = build_spatial_index(model, SELECT_ELEMENT);
+	MeshSelection* nodes = create_mesh_selection(model, SELECT_NODE);
+	MeshSelection* other = create_mesh_selection(model, SELECT_NODE);
+	MeshSelection* elements = create_mesh_selection(model, SELECT_ELEMENT);
+	int ids[64];
+	if(node_index == NULL || element_index == NULL || nodes == NULL || other == NULL || elements == NULL) {
+		printf("failure\n");
+	} else {
+		printf("grid lines: %d x %d x %d\n", node_index->line_num[0], node_index->line_num[1], node_index->line_num[2]);
+
+		SelectBox box = {{50.0, 0.0, 0.0}, {250.0, 100.0, 200.0}};
+		select_in_box(node_index, &box, nodes);
+		printf("box: %d nodes\n", nodes->count);
+
+		// 下端面(z = 0)のうち、x = 400 の辺を除く
+		clear_mesh_selection(nodes);
+		select_on_plane(node_index, 2, 0.0, nodes);
+		int low[3] = {-1, 0, 0};
+		int high[3] = {-1, -1, -1};
+		select_grid_range(node_index, low, high, other);
+		selection_minus(nodes, other);
+		int n = selection_ids(model, nodes, ids);
+		printf("plane z = 0 minus x = 400: %d nodes\n", n);
+		print_REST_set(stdout, ids, n, 10);
+
+		// タイプ 2 の要素の節点のうち上端面、上端面の節点だけで作られる要素
+		select_elements_by_type(model, ELEMENT_HEXA, 2, elements);
+		printf("type 2: %d elements\n", elements->count);
+		clear_mesh_selection(nodes);
+		select_nodes_of_elements(model, elements, nodes);
+		clear_mesh_selection(other);
+		select_on_plane(node_index, 2, 200.0, other);
+		selection_and(nodes, other);
+		printf("type 2 nodes on z = 200: %d\n", nodes->count);
+		clear_mesh_selection(elements);
+		select_elements_of_nodes(model, other, 1, elements);
+		printf("elements with all nodes on z = 200: %d\n", elements->count);
+		select_elements_of_nodes(model, other, 0, elements);
+		selection_invert(elements);
+		printf("elements without nodes on z = 200: %d\n", elements->count);
+
+		// 要素の重心の範囲
+		clear_mesh_selection(elements);
+		SelectBox element_box = {{0.0, 0.0, 0.0}, {400.0, 300.0, 100.0}};
+		select_in_box(element_index, &element_box, elements);
+		n = selection_ids(model, elements, ids);
+		printf("lower layer: %d elements\n", n);
+		print_ETYP_set(stdout, ids, n, 3);
+	}
+	free_mesh_selection(nodes);
+	free_mesh_selection(other);
+	free_mesh_selection(elements);
+	free_spatial_index(node_index);
+	free_spatial_index(element_index);
+	free_mesh_model(model);
+}
+
+#include "block_mesh.h"
+
+void test_block_mesh() {
+	printf("--- 'test_block_mesh' ---\n");
+	double x[4] = {0.0, 100.0, 200.0, 300.0};
+	double y[2] = {0.0, 100.0};
+	double z[4] = {0.0, 150.0, 250.0, 400.0};
+	double* axis[3] = {x, y, z};
+	int axis_num[3] = {4, 2, 4};
+	BlockMesh* mesh = create_block_mesh(axis, axis_num);
+	MeshModel* model = create_mesh_model();
+	if(mesh == NULL || model == NULL) {
+		printf("failure\n");
+		free_block_mesh(mesh);
+		free_mesh_model(model);
+		return;
+	}
+	// 十字形の接合部: 下柱、接合部、左右の梁、上柱(接合部の上面は二重)
+	int low[5][3] = {{1, 0, 0}, {1, 0, 1}, {0, 0, 1}, {2, 0, 1}, {1, 0, 2}};
+	int high[5][3] = {{2, 1, 1}, {2, 1, 2}, {1, 1, 2}, {3, 1, 2}, {2, 1, 3}};
+	int type[5] = {1, 2, 5, 5, 1};
+	for(int b = 0; b < 5; b++) {
+		add_mesh_block(mesh, low[b], high[b], type[b]);
+	}
+	int overlap_low[3] = {0, 0, 0};
+	int overlap_high[3] = {2, 1, 1};
+	printf("overlapping block: %d\n", add_mesh_block(mesh, overlap_low, overlap_high, 1));
+	split_block_plane(mesh, 2, 2);
+	derive_block_numbering(mesh, 1, 1);
+	printf("node increment: %d %d %d\n", mesh->node_increment[0], mesh->node_increment[1], mesh->node_increment[2]);
+
+	int grid[3] = {1, 0, 2};
+	printf("node at joint top: %d (joint), %d (upper column)\n", block_node_number(mesh, 1, grid), block_node_number(mesh, 4, grid));
+
+	if(build_block_mesh_model(mesh, model) == EXIT_SUCCESS) {
+		printf("nodes: %d, elements: %d\n", model->node_num, model->element_num);
+	}
+	print_block_mesh(stdout, mesh);
+	free_mesh_model(model);
+	free_block_mesh(mesh);
+}
+
+#include "mesh_interface.h"
+
+void test_mesh_interface() {
+	printf("--- 'test_mesh_interface' ---\n");
+	MeshModel* model = create_mesh_model();
+	MeshModel* out = create_mesh_model();
+	if(model == NULL || out == NULL) {
+		printf("failure\n");
+		free_mesh_model(model);
+		free_mesh_model(out);
+		return;
+	}
+	// x = -100 ... 0 と 0 ... 100 のHEXA(x = 0 の面の節点は別)、x = 0 の鋼板(QUAD)、z方向の主筋(BEAM)
+	for(int side = 0; side < 2; side++) {
+		for(int k = 0; k < 8; k++) {
+			double x = (k == 1 || k == 2 || k == 5 || k == 6) ? 100.0 : 0.0;
+			double y = (k == 2 || k == 3 || k == 6 || k == 7) ? 100.0 : 0.0;
+			double z = (k >= 4) ? 100.0 : 0.0;
+			add_mesh_node(model, 1 + k + 10 * side, side == 0 ? x : x - 100.0, y, z);
+		}
+		int node[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+		for(int k = 0; k < 8; k++) node[k] += 10 * side;
+		add_mesh_element(model, 1 + side, ELEMENT_HEXA, 1, node);
+	}
+	add_mesh_node(model, 21, 0.0, 0.0, 0.0);
+	add_mesh_node(model, 22, 0.0, 0.0, 100.0);
+	add_mesh_node(model, 23, 0.0, 100.0, 100.0);
+	add_mesh_node(model, 24, 0.0, 100.0, 0.0);
+	int plate[4] = {21, 22, 23, 24};
+	add_mesh_element(model, 11, ELEMENT_QUAD, 5, plate);
+	// 主筋: HEXAの辺に沿うもの(付着あり)と、HEXAの節点の無い位置のもの(付着なし)
+	add_mesh_node(model, 31, 0.0, 0.0, 0.0);
+	add_mesh_node(model, 32, 0.0, 0.0, 100.0);
+	add_mesh_node(model, 33, 50.0, 0.0, 0.0);
+	add_mesh_node(model, 34, 50.0, 0.0, 100.0);
+	int bar[2] = {31, 32};
+	add_mesh_element(model, 21, ELEMENT_BEAM, 1, bar);
+	int free_bar[2] = {33, 34};
+	add_mesh_element(model, 22, ELEMENT_BEAM, 1, free_bar);
+
+	MeshInterface* mesh_interface = create_mesh_interface(model);
+	MeshSelection* solids = create_mesh_selection(model, SELECT_ELEMENT);
+	MeshSelection* parts = create_mesh_selection(model, SELECT_ELEMENT);
+	if(mesh_interface == NULL || solids == NULL || parts == NULL) {
+		printf("failure\n");
+	} else {
+		int coincident[MESH_INTERFACE_COINCIDENT_MAX];
+		int n = find_coincident_nodes(mesh_interface->hash, model, find_mesh_node(model, 1), coincident, MESH_INTERFACE_COINCIDENT_MAX);
+		printf("coincident with node 1: %d\n", n);
+
+		select_elements_by_type(model, ELEMENT_HEXA, -1, solids);
+		select_elements_by_type(model, ELEMENT_QUAD, -1, parts);
+		int film_id = 101;
+		printf("films: %d\n", generate_interface_films(mesh_interface, parts, solids, 2, &film_id, out));
+		clear_mesh_selection(parts);
+		select_elements_by_type(model, ELEMENT_BEAM, -1, parts);
+		printf("lines: %d\n", generate_bond_lines(mesh_interface, parts, solids, 100, out));
+		print_interface_elements(stdout, out);
+	}
+	free_mesh_selection(parts);
+	free_mesh_selection(solids);
+	free_mesh_interface(mesh_interface);
+	free_mesh_model(out);
+	free_mesh_model(model);
+}
+
+#include "auto_mesh.h"
+
+static void print_auto_mesh_lengths(const char* name, const Mesh* mesh) {
+	printf("%s (%d):", name, mesh->mesh_num);
+	for(int i = 0; i < mesh->mesh_num; i++) {
+		printf(" %.2f", mesh->lengths[i]);
+	}
+	printf("\n");
+}
+
+void test_auto_mesh() {
+	printf("--- 'test_auto_mesh' ---\n");
+	// 1つの軸: 100 ... 200 を寸法 20 で分割し、両側を公比 1.5 で 60 まで大きくする
+	AutoMeshGrading grading = {100.0, 200.0, 20.0, 1.5, 60.0};
+	double breakpoint[6] = {500.0, 0.0, 200.0, 100.0, 150.0, 150.0};
+	Mesh mesh = {0, NULL};
+	if(auto_mesh_axis(breakpoint, 6, &grading, 0, &mesh) == EXIT_SUCCESS) {
+		print_auto_mesh_lengths("axis", &mesh);
+	}
+	if(auto_mesh_axis(breakpoint, 6, &grading, 1, &mesh) == EXIT_SUCCESS) {
+		print_auto_mesh_lengths("axis with jig", &mesh);
+	}
+	free(mesh.lengths);
+
+	// 試験体: test_min.json の寸法
+	JsonData* data = new_json_data();
+	data->column = (Column){2250.0, 350.0, 350.0, 1500.0, 175.0, 1125.0, 37.4};
+	data->beam = (Beam){3000.0, 110.0, 320.0, 1500.0, 175.0, 1125.0, 110.0};
+	data->rebar.rebars[0].x = 50.0;
+	data->rebar.rebars[0].y = 90.0;
+	data->auto_mesh = (AutoMesh){1, 40.0, 1.3, 4.0, 300.0, 220.0};
+	if(generate_auto_mesh(data) == EXIT_SUCCESS) {
+		print_auto_mesh_lengths("mesh_x", &data->mesh_x);
+		print_auto_mesh_lengths("mesh_y", &data->mesh_y);
+		print_auto_mesh_lengths("mesh_z", &data->mesh_z);
+	}
+	// 主筋が治具の中にある場合
+	data->rebar.rebars[0].x = -1200.0;
+	printf("rebar in jig: %s\n", generate_auto_mesh(data) == EXIT_SUCCESS ? "success" : "failure");
+	free_json_data(data);
+}
+
+#include "id_budget.h"
+
+void test_id_budget() {
+	printf("--- 'test_id_budget' ---\n");
+	ModelingData* data = create_modeling_data(11, 2, 9, 2);
+	JsonData* source = new_json_data();
+	if(data == NULL || source == NULL) {
+		printf("failure\n");
+		free_modeling_data(data);
+		free_json_data(source);
+		return;
+	}
+	// 柱 60000節点、主筋2本(柱の節点の層 30 x 増分 2000)、接合部鋼板、梁
+	data->column_hexa.head = (NodeElement){1, 1};
+	data->column_hexa.occupied_indices = (NodeElement){60000, 40000};
+	data->rebar_fiber->increment = (NodeElement){2000, 1};
+	data->rebar_fiber->head = (NodeElement){60001, 40001};
+	data->rebar_fiber->occupied_indices_single = (NodeElement){60000, 29};
+	data->rebar_fiber->occupied_indices = (NodeElement){120000, 58};
+	data->rebar_line.head = (NodeElement){0, 40059};
+	data->rebar_line.occupied_indices = (NodeElement){0, 58};
+	data->joint_quad.head = (NodeElement){180001, 40117};
+	data->joint_quad.occupied_indices = (NodeElement){5000, 3000};
+	data->joint_film.head = 43117;
+	data->joint_film.occupied_indices = 3000;
+	data->beam.head = (NodeElement){185001, 46117};
+	data->beam.occupied_indices = (NodeElement){8000, 6000};
+
+	IdBudget budget;
+	plan_id_budget(data, &budget);
+	printf("fits: %d\n", id_budget_fits(&budget));
+	printf("compacted node numbers: %d\n", compact_id_gaps(data));
+	plan_id_budget(data, &budget);
+	print_id_budget(&budget);
+	printf("fits: %d\n", id_budget_fits(&budget));
+
+	// x: 治具 | 梁 4要素 | 柱 2要素 | 梁 3要素 | 治具、z: 治具 | 柱 3要素 | 柱 3要素 | 治具(梁せい 0)
+	double lengths_x[11] = {300, 200, 150, 100, 50, 25, 25, 50, 100, 150, 300};
+	double lengths_z[8] = {200, 150, 100, 50, 50, 100, 150, 200};
+	free(source->mesh_x.lengths);
+	free(source->mesh_z.lengths);
+	source->mesh_x = (Mesh){11, (double*)malloc(sizeof(lengths_x))};
+	source->mesh_z = (Mesh){8, (double*)malloc(sizeof(lengths_z))};
+	for(int i = 0; i < 11; i++) source->mesh_x.lengths[i] = lengths_x[i];
+	for(int i = 0; i < 8; i++) source->mesh_z.lengths[i] = lengths_z[i];
+	data->boundary_index[JIG_BEAM_X] = 1;
+	data->boundary_index[BEAM_COLUMN_X] = 5;
+	data->boundary_index[COLUMN_BEAM_X] = 7;
+	data->boundary_index[BEAM_JIG_X] = 10;
+	data->boundary_index[JIG_COLUMN_Z] = 1;
+	data->boundary_index[COLUMN_BEAM_Z] = 4;
+	data->boundary_index[BEAM_COLUMN_Z] = 4;
+	data->boundary_index[COLUMN_JIG_Z] = 7;
+	if(coarsen_far_field(source, data) == EXIT_SUCCESS) {
+		printf("mesh_x:");
+		for(int i = 0; i < source->mesh_x.mesh_num; i++) printf(" %.0f", source->mesh_x.lengths[i]);
+		printf("\nmesh_z:");
+		for(int i = 0; i < source->mesh_z.mesh_num; i++) printf(" %.0f", source->mesh_z.lengths[i]);
+		printf("\n");
+	}
+	free_json_data(source);
+	free_modeling_data(data);
+}
+
+#include "model_estimate.h"
+
+void test_estimate_model() {
+	printf("--- 'test_estimate_model' ---\n");
+	ModelingData* data = create_modeling_data(11, 3, 9, 4);
+	if(data == NULL) {
+		printf("failure\n");
+		return;
+	}
+	// x: 梁 2要素 | 柱 4要素(直交梁 2要素) | 梁 2要素、y: 直交梁 1要素 | 梁 1要素、z: 柱 2要素 | 接合部 2要素 | 柱 2要素
+	int boundary[BOUNDARY_X_MAX + BOUNDARY_Y_MAX + BOUNDARY_Z_MAX] = {
+		0, 1, 3, 4, 5, 6, 7, 9, 10,
+		0, 1, 2, 3, 4,
+		0, 1, 3, 4, 5, 7, 8};
+	for(int i = 0; i < BOUNDARY_X_MAX + BOUNDARY_Y_MAX + BOUNDARY_Z_MAX; i++) {
+		data->boundary_index[i] = boundary[i];
+	}
+	ModelEstimate estimate;
+	if(estimate_model(data, &estimate) == EXIT_SUCCESS) {
+		print_model_estimate(&estimate, 0.0);
+	}
+	printf("NULL: %s\n", estimate_model(NULL, &estimate) == EXIT_SUCCESS ? "success" : "failure");
+	free_modeling_data(data);
+}
+
+#include "mesh_mirror.h"
+
+/**
+ * y = 0 ... 100 のHEXA 1つと y = 100 の面上のQUADを y = 100 の面で鏡映する。
+ */
+void test_mirror_mesh_model() {
+	printf("--- 'test_mirror_mesh_model' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	// 節点 1-8: 1x1x1 の格子
+	for(int k = 0; k < 2; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 1 + i + 2 * j + 4 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	int hexa[8] = {1, 2, 4, 3, 5, 6, 8, 7};
+	int quad[4] = {3, 4, 8, 7};
+	add_mesh_element(model, 1, ELEMENT_HEXA, 1, hexa);
+	add_mesh_element(model, 2, ELEMENT_QUAD, 1, quad);
+	// 切断面(y方向)、底面(z方向)の拘束と上面の荷重
+	add_mesh_restraint(model, 3, 10);
+	add_mesh_restraint(model, 4, 11);
+	add_mesh_restraint(model, 1, 1);
+	add_mesh_constraint(model, 2, 1, 4, 1);
+	add_mesh_step_card(model, STEP_CARD_UE, 1, 3, 2, 0, -10.0);
+	add_mesh_step_card(model, STEP_CARD_FN, 6, 2, 0, 0, 1.0);
+
+	MirrorStatistics statistics;
+	if(mirror_mesh_model(model, 2, 100.0, &statistics) == EXIT_SUCCESS) {
+		printf("nodes +%d (plane %d), elements +%d (plane %d), released %d, offset %d / %d\n",
+			statistics.node_num, statistics.plane_node_num, statistics.element_num, statistics.plane_element_num,
+			statistics.released_restraint_num, statistics.node_offset, statistics.element_offset);
+		for(int n = 8; n < model->node_num; n++) {
+			printf("node %d: (%.0f, %.0f, %.0f)\n", model->node_id[n], model->x[n], model->y[n], model->z[n]);
+		}
+		for(int e = 0; e < model->element_num; e++) {
+			printf("%s %d:", element_kind_name(model->element_kind[e]), model->element_id[e]);
+			for(int k = 0; k < element_node_count(model->element_kind[e]); k++) {
+				printf(" %d", model->connectivity[e * ELEMENT_NODE_MAX + k]);
+			}
+			printf("\n");
+		}
+		int restrained_y = 0;
+		for(int r = 0; r < model->restraint_num; r++) {
+			printf("REST %d: %03d\n", model->restraint[r].node, model->restraint[r].rc);
+			if((model->restraint[r].rc / 10) % 10 != 0) restrained_y++;
+		}
+		// y方向の剛体移動を止める拘束が残っていること
+		printf("y restraint kept on node %d: %s\n", statistics.anchor_node, restrained_y > 0 ? "ok" : "missing");
+		for(int c = 0; c < model->constraint_num; c++) {
+			printf("SUB1 %d -> %d\n", model->constraint[c].node, model->constraint[c].master);
+		}
+		for(int s = 0; s < model->step_card_num; s++) {
+			printf("step card %d: id %d, dir %d, %.1f\n", model->step_card[s].kind, model->step_card[s].id, model->step_card[s].value[0], model->step_card[s].real);
+		}
+	}
+	free_mesh_model(model);
+
+	// NULLを渡した場合
+	printf("NULL: %s\n", mirror_mesh_model(NULL, 2, 0.0, &statistics) == EXIT_SUCCESS ? "success" : "failure");
+}
+
+/**
+ * x = 0 ... 200 のHEXA 2つを x = 100 の面で切断する(test_mesh_graph と同じ格子)。
+ */
+void test_cut_mesh_model() {
+	printf("--- 'test_cut_mesh_model' ---\n");
+	for(int kind = SYMMETRY_SYMMETRIC; kind <= SYMMETRY_ANTISYMMETRIC; kind++) {
+		MeshModel* model = create_mesh_model();
+		if(model == NULL) {
+			printf("MeshModel allocation failed\n");
+			return;
+		}
+		for(int k = 0; k < 2; k++) {
+			for(int j = 0; j < 2; j++) {
+				for(int i = 0; i < 3; i++) {
+					add_mesh_node(model, 1 + i + 3 * j + 6 * k, i * 100.0, j * 100.0, k * 100.0);
+				}
+			}
+		}
+		int hexa1[8] = {1, 2, 5, 4, 7, 8, 11, 10};
+		int hexa2[8] = {2, 3, 6, 5, 8, 9, 12, 11};
+		add_mesh_element(model, 1, ELEMENT_HEXA, 1, hexa1);
+		add_mesh_element(model, 2, ELEMENT_HEXA, 1, hexa2);
+		// 底面(z方向)の拘束。対称では上面の荷重(対称)、逆対称では柱頭の水平方向の強制変位(逆対称)
+		add_mesh_restraint(model, 2, 1);
+		add_mesh_restraint(model, 3, 1);
+		add_mesh_step_card(model, STEP_CARD_STEP, 1, 0, 0, 0, 0.0);
+		if(kind == SYMMETRY_SYMMETRIC) {
+			add_mesh_step_card(model, STEP_CARD_UE, 1, 3, 2, 0, -10.0);
+			add_mesh_step_card(model, STEP_CARD_UE, 2, 3, 2, 0, -10.0);
+		} else {
+			add_mesh_step_card(model, STEP_CARD_FN, 8, 1, 0, 0, 10.0);
+		}
+		add_mesh_step_card(model, STEP_CARD_STEP, 2, 0, 0, 0, 0.0);
+		add_mesh_step_card(model, STEP_CARD_FN, 8, 1, 0, 0, 0.0);
+
+		int mirror_node[13];
+		int mirror_element[3];
+		SymmetryLoad adjusted_load[6];
+		SymmetryCutStatistics statistics;
+		if(cut_mesh_model(model, 1, 100.0, kind, mirror_node, mirror_element, adjusted_load, &statistics) == EXIT_SUCCESS) {
+			printf("%s: removed %d nodes, %d elements, plane %d, unmatched %d / %d, conflict %d\n",
+				kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric",
+				statistics.removed_node_num, statistics.removed_element_num, statistics.plane_node_num,
+				statistics.unmatched_node_num, statistics.unmatched_element_num, statistics.conflict_num);
+			for(int n = 0; n < model->node_num; n++) {
+				printf(" %d->%d", model->node_id[n], mirror_node[n]);
+			}
+			printf("\nelement 1 -> %d\n", mirror_element[0]);
+			for(int r = 0; r < model->restraint_num; r++) {
+				printf("REST %d: %03d\n", model->restraint[r].node, model->restraint[r].rc);
+			}
+			for(int s = 0; s < model->step_card_num; s++) {
+				printf("step card %d: id %d\n", model->step_card[s].kind, model->step_card[s].id);
+			}
+		}
+		free_mesh_model(model);
+	}
+
+	// 切断の種類と対称性が異なる荷重は、対称では FN を除き、逆対称では UE を同じ対称性の成分(0)にして除く
+	for(int kind = SYMMETRY_SYMMETRIC; kind <= SYMMETRY_ANTISYMMETRIC; kind++) {
+		MeshModel* model = create_mesh_model();
+		if(model == NULL) {
+			printf("MeshModel allocation failed\n");
+			return;
+		}
+		for(int k = 0; k < 2; k++) {
+			for(int j = 0; j < 2; j++) {
+				for(int i = 0; i < 3; i++) {
+					add_mesh_node(model, 1 + i + 3 * j + 6 * k, i * 100.0, j * 100.0, k * 100.0);
+				}
+			}
+		}
+		int hexa1[8] = {1, 2, 5, 4, 7, 8, 11, 10};
+		int hexa2[8] = {2, 3, 6, 5, 8, 9, 12, 11};
+		add_mesh_element(model, 1, ELEMENT_HEXA, 1, hexa1);
+		add_mesh_element(model, 2, ELEMENT_HEXA, 1, hexa2);
+		add_mesh_step_card(model, STEP_CARD_STEP, 1, 0, 0, 0, 0.0);
+		if(kind == SYMMETRY_SYMMETRIC) {
+			add_mesh_step_card(model, STEP_CARD_FN, 8, 1, 0, 0, 10.0);
+		} else {
+			add_mesh_step_card(model, STEP_CARD_UE, 1, 3, 2, 0, -10.0);
+			add_mesh_step_card(model, STEP_CARD_UE, 2, 3, 2, 0, -10.0);
+		}
+		int mirror_node[13];
+		int mirror_element[3];
+		SymmetryLoad adjusted_load[4];
+		SymmetryCutStatistics statistics;
+		int result = cut_mesh_model(model, 1, 100.0, kind, mirror_node, mirror_element, adjusted_load, &statistics);
+		printf("%s with %s: %s, adjusted %d, removed %d, step cards %d\n", kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric",
+			kind == SYMMETRY_SYMMETRIC ? "lateral FN" : "axial UE", result == EXIT_SUCCESS ? "success" : "failure",
+			statistics.adjusted_load_num, statistics.removed_load_num, model->step_card_num);
+		for(int i = 0; i < statistics.adjusted_load_num; i++) {
+			printf(" %s %d -> %d (DIR %d) in STEP %d: %.2f -> %.2f\n", adjusted_load[i].kind == STEP_CARD_FN ? "FN" : "UE",
+				adjusted_load[i].id, adjusted_load[i].mirror_id, adjusted_load[i].dir, adjusted_load[i].step,
+				adjusted_load[i].value, adjusted_load[i].used);
+		}
+		free_mesh_model(model);
+	}
+}
+
+#include "frame_assembly.h"
+void test_frame_assembly() {
+	printf("--- 'test_frame_assembly' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	for(int k = 0; k < 2; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 1 + i + 2 * j + 4 * k, i * 100.0, j * 100.0, k * 200.0);
+			}
+		}
+	}
+	int hexa[8] = {1, 2, 4, 3, 5, 6, 8, 7};
+	add_mesh_element(model, 1, ELEMENT_HEXA, 1, hexa);
+	// 柱脚(z = 0)のピン、梁端(x = 100)のローラー
+	for(int n = 1; n <= 4; n++) {
+		add_mesh_restraint(model, n, 111);
+	}
+	add_mesh_restraint(model, 2, 1);
+	add_mesh_restraint(model, 6, 1);
+
+	FrameLayout layout;
+	if(plan_frame_layout(model, 2, 2, &layout) == EXIT_SUCCESS && assemble_frame(model, &layout, 10) == EXIT_SUCCESS) {
+		printf("pitch %.1f / %.1f, offset %d / %d, stitched %d, unmatched %d\n",
+			layout.pitch[0], layout.pitch[1], layout.node_offset, layout.element_offset,
+			layout.stitch_num, layout.unmatched_num);
+		printf("nodes %d, elements %d, COPY cards %d\n", model->node_num, model->element_num, model->instance_copy_num);
+		for(int r = 0; r < model->restraint_num; r++) {
+			printf("REST %d: %03d\n", model->restraint[r].node, model->restraint[r].rc);
+		}
+		for(int c = 0; c < model->constraint_num; c++) {
+			printf("SUB1 %d-D(%d) M(%d)-D(%d)\n", model->constraint[c].node, model->constraint[c].dir,
+				model->constraint[c].master, model->constraint[c].master_dir);
+		}
+	}
+	free_mesh_model(model);
+}
+
+#include "ffi_merge.h"
+/**
+ * test_min.json のモデルを2つ結合し、2つ目の番号が 1000 単位でずれることを確認する。
+ */
+void test_merge_ffi() {
+	printf("--- 'test_merge_ffi' ---\n");
+	if(modeling_rcs("../test/test_min.json", "../run_analysis/out.ffi") != MODELING_RCS_SUCCESS) {
+		printf("modeling failed\n");
+		return;
+	}
+	FfiMergeInput inputs[2] = {
+		{"../run_analysis/out.ffi", FFI_MERGE_AUTO_OFFSET, FFI_MERGE_AUTO_OFFSET, 0, 0},
+		{"../run_analysis/out.ffi", FFI_MERGE_AUTO_OFFSET, FFI_MERGE_AUTO_OFFSET, 0, 0}
+	};
+	FfiMergeStatistics statistics;
+	if(merge_ffi_files("../run_analysis/merged.ffi", inputs, 2, &statistics) != EXIT_SUCCESS) {
+		printf("merge failed\n");
+		return;
+	}
+	for(int i = 0; i < 2; i++) {
+		printf("node +%d (max %d), element +%d (max %d)\n", inputs[i].node_offset, inputs[i].max_node,
+			inputs[i].element_offset, inputs[i].max_element);
+	}
+	printf("%d definitions (%d duplicates), %d steps\n", statistics.table_num, statistics.duplicate_table_num, statistics.step_num);
+
+	MeshModel* single = create_mesh_model();
+	MeshModel* merged = create_mesh_model();
+	if(single != NULL && merged != NULL
+	   && read_mesh_model("../run_analysis/out.ffi", single) == MESH_MODEL_SUCCESS
+	   && read_mesh_model("../run_analysis/merged.ffi", merged) == MESH_MODEL_SUCCESS) {
+		printf("nodes %d -> %d, elements %d -> %d, REST %d -> %d, SUB1 %d -> %d\n",
+			single->node_num, merged->node_num, single->element_num, merged->element_num,
+			single->restraint_num, merged->restraint_num, single->constraint_num, merged->constraint_num);
+	}
+	if(single != NULL) {
+		free_mesh_model(single);
+	}
+	if(merged != NULL) {
+		free_mesh_model(merged);
+	}
+
+	// 指定したずれで番号の範囲が重なる場合(後のファイルとの重なりも)はエラー
+	FfiMergeInput overlap[3] = {
+		{"../run_analysis/out.ffi", 20000, 20000, 0, 0},
+		{"../run_analysis/out.ffi", FFI_MERGE_AUTO_OFFSET, FFI_MERGE_AUTO_OFFSET, 0, 0},
+		{"../run_analysis/out.ffi", 22000, 22000, 0, 0}
+	};
+	printf("overlapping offsets: %s\n", merge_ffi_files("../run_analysis/overlap.ffi", overlap, 3, &statistics) == EXIT_SUCCESS ? "success" : "failure");
+	FILE* removed = fopen("../run_analysis/overlap.ffi", "r");
+	printf("output %s\n", removed == NULL ? "removed" : "left");
+	if(removed != NULL) {
+		fclose(removed);
+	}
+}
+
+#include "mesh_submodel.h"
+/**
+ * z 方向に3つ並べたHEXAの中央だけを切り出し、上下の切断面の拘束、柱頭の強制変位を切断面に移すことと
+ * 番号の詰め方を確認する。
+ */
+void test_extract_submodel() {
+	printf("--- 'test_extract_submodel' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	for(int k = 0; k < 4; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 101 + i + 10 * j + 100 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int k = 0; k < 3; k++) {
+		int base = 101 + 100 * k;
+		int hexa[8] = {base, base + 1, base + 11, base + 10, base + 100, base + 101, base + 111, base + 110};
+		add_mesh_element(model, 11 + k, ELEMENT_HEXA, 1, hexa);
+	}
+	// 柱脚の拘束、柱頭の強制変位、中央の要素の荷重
+	add_mesh_restraint(model, 101, 111);
+	add_mesh_restraint(model, 202, 10);
+	add_mesh_step_card(model, STEP_CARD_FN, 401, 1, 0, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_UE, 12, 3, 1, 0, -1.0);
+
+	SelectBox box = {{-SUBMODEL_UNBOUNDED, -SUBMODEL_UNBOUNDED, 100.0}, {SUBMODEL_UNBOUNDED, SUBMODEL_UNBOUNDED, 200.0}};
+	int original_node[17];
+	int original_element[4];
+	SubmodelStatistics statistics;
+	if(extract_submodel(model, &box, original_node, original_element, &statistics) == EXIT_SUCCESS) {
+		printf("nodes %d (-%d), elements %d (-%d), cut %d, tied %d, moved %d, removed cards %d\n",
+			statistics.node_num, statistics.removed_node_num, statistics.element_num, statistics.removed_element_num,
+			statistics.cut_node_num, statistics.tied_node_num, statistics.moved_card_num, statistics.removed_card_num);
+		for(int n = 0; n < model->node_num; n++) {
+			printf(" %d<-%d", model->node_id[n], original_node[n]);
+		}
+		printf("\nelement %d<-%d:", model->element_id[0], original_element[0]);
+		for(int k = 0; k < 8; k++) {
+			printf(" %d", model->connectivity[k]);
+		}
+		printf("\n");
+		for(int r = 0; r < model->restraint_num; r++) {
+			printf("REST %d: %03d\n", model->restraint[r].node, model->restraint[r].rc);
+		}
+		for(int c = 0; c < model->constraint_num; c++) {
+			printf("SUB1 %d (DIR %d) -> %d\n", model->constraint[c].node, model->constraint[c].dir, model->constraint[c].master);
+		}
+		for(int s = 0; s < model->step_card_num; s++) {
+			printf("step card %d: id %d\n", model->step_card[s].kind, model->step_card[s].id);
+		}
+	}
+	free_mesh_model(model);
+
+	// 柱脚の要素だけを残すと、柱頭の強制変位と中央の要素の荷重を上の切断面に移す
+	model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	for(int k = 0; k < 4; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 101 + i + 10 * j + 100 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int k = 0; k < 3; k++) {
+		int base = 101 + 100 * k;
+		int hexa[8] = {base, base + 1, base + 11, base + 10, base + 100, base + 101, base + 111, base + 110};
+		add_mesh_element(model, 11 + k, ELEMENT_HEXA, 1, hexa);
+	}
+	add_mesh_step_card(model, STEP_CARD_STEP, 1, 0, 0, 0, 0.0);
+	add_mesh_step_card(model, STEP_CARD_FN, 401, 1, 0, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_UE, 12, 3, 1, 0, -1.0);
+	SelectBox base = {{-SUBMODEL_UNBOUNDED, -SUBMODEL_UNBOUNDED, 0.0}, {SUBMODEL_UNBOUNDED, SUBMODEL_UNBOUNDED, 100.0}};
+	if(extract_submodel(model, &base, NULL, NULL, &statistics) == EXIT_SUCCESS) {
+		for(int r = 0; r < model->restraint_num; r++) {
+			printf("REST %d: %03d\n", model->restraint[r].node, model->restraint[r].rc);
+		}
+		for(int s = 0; s < model->step_card_num; s++) {
+			StepCard card = model->step_card[s];
+			printf("step card %d: id %d, dir %d, face %d, %.2f\n", card.kind, card.id, card.value[0], card.value[1], card.real);
+		}
+	} else {
+		printf("moving the loads failed\n");
+	}
+	free_mesh_model(model);
+}
+
+/**
+ * test_min の接合部の層(panel)を切り出し、柱頭、柱脚の強制変位と軸力が切断面に移ることを確認する。
+ */
+void test_extract_panel() {
+	printf("--- 'test_extract_panel' ---\n");
+	ModelingRcsOption option;
+	initialize_modeling_rcs_option(&option);
+	option.submodel = SUBMODEL_PANEL;
+	if(modeling_rcs_with_option("../test/test_min.json", "../run_analysis/panel.ffi", &option) != MODELING_RCS_SUCCESS) {
+		printf("modeling_rcs --submodel panel failed\n");
+		return;
+	}
+	MeshModel* model = create_mesh_model();
+	if(model == NULL || read_mesh_model("../run_analysis/panel.ffi", model) != MESH_MODEL_SUCCESS) {
+		printf("reading panel.ffi failed\n");
+		if(model != NULL) free_mesh_model(model);
+		return;
+	}
+	printf("nodes %d, elements %d, SUB1 %d, DISP node %d\n", model->node_num, model->element_num, model->constraint_num, model->disp_node);
+	int step = 0;
+	int fn_num = 0;
+	int ue_num = 0;
+	for(int s = 0; s <= model->step_card_num; s++) {
+		if(s == model->step_card_num || model->step_card[s].kind == STEP_CARD_STEP) {
+			if(s > 0) {
+				printf("STEP %d: FN %d, UE %d\n", step, fn_num, ue_num);
+			}
+			if(s == model->step_card_num) {
+				break;
+			}
+			step = model->step_card[s].id;
+			fn_num = 0;
+			ue_num = 0;
+		}
+		StepCard card = model->step_card[s];
+		if(card.kind == STEP_CARD_FN) {
+			fn_num++;
+			printf(" FN node %d (DIR %d) %.2f\n", card.id, card.value[0], card.real);
+		} else if(card.kind == STEP_CARD_UE) {
+			ue_num++;
+		}
+	}
+	free_mesh_model(model);
+}
+
+#include "mesh_rigid_jig.h"
+/**
+ * 治具(TYPH 5)の上にHEXAを1つ載せ、治具の削除と境界面の SUB1 が残ることを確認する。
+ */
+void test_rigid_jig() {
+	printf("--- 'test_rigid_jig' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	for(int k = 0; k < 3; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 101 + i + 10 * j + 100 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+	}
+	for(int k = 0; k < 2; k++) {
+		int base = 101 + 100 * k;
+		int hexa[8] = {base, base + 1, base + 11, base + 10, base + 100, base + 101, base + 111, base + 110};
+		add_mesh_element(model, 11 + k, ELEMENT_HEXA, k == 0 ? RIGID_JIG_TYPE : 1, hexa);
+	}
+	// 治具の端面と境界面の従属条件、治具の端面と境界面の強制変位、治具と柱の荷重
+	add_mesh_constraint(model, 102, 1, 101, 1);
+	add_mesh_constraint(model, 201, 1, 211, 1);
+	add_mesh_constraint(model, 202, 1, 211, 1);
+	add_mesh_constraint(model, 212, 1, 211, 1);
+	add_mesh_restraint(model, 111, 10);
+	add_mesh_restraint(model, 211, 10);
+	add_mesh_step_card(model, STEP_CARD_FN, 101, 1, 0, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_FN, 211, 1, 0, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_UE, 11, 3, 1, 0, 10.0);
+	add_mesh_step_card(model, STEP_CARD_UE, 12, 3, 1, 0, 10.0);
+
+	RigidJigStatistics statistics;
+	if(remove_jig_elements(model, RIGID_JIG_TYPE, &statistics) == EXIT_SUCCESS) {
+		printf("nodes %d (-%d), elements %d (-%d), interface %d (untied %d), removed cards %d\n",
+			model->node_num, statistics.removed_node_num, model->element_num, statistics.removed_element_num,
+			statistics.interface_node_num, statistics.untied_node_num, statistics.removed_card_num);
+		for(int c = 0; c < model->constraint_num; c++) {
+			printf("SUB1 %d -> %d\n", model->constraint[c].node, model->constraint[c].master);
+		}
+		for(int s = 0; s < model->step_card_num; s++) {
+			printf("step card %d: id %d\n", model->step_card[s].kind, model->step_card[s].id);
+		}
+	}
+	// 治具の無いモデルはエラー
+	printf("no jig: %d\n", remove_jig_elements(model, RIGID_JIG_TYPE, &statistics));
+	free_mesh_model(model);
+}
+
+#include "mesh_bond_zone.h"
+/**
+ * z 方向に2つ並べたHEXAの角に主筋を通し、上の要素だけを付着区間にして主筋の節点の共有を確認する。
+ */
+void test_restrict_bond_zone() {
+	printf("--- 'test_restrict_bond_zone' ---\n");
+	MeshModel* model = create_mesh_model();
+	if(model == NULL) {
+		printf("MeshModel allocation failed\n");
+		return;
+	}
+	for(int k = 0; k < 3; k++) {
+		for(int j = 0; j < 2; j++) {
+			for(int i = 0; i < 2; i++) {
+				add_mesh_node(model, 101 + i + 10 * j + 100 * k, i * 100.0, j * 100.0, k * 100.0);
+			}
+		}
+		// 主筋の節点
+		add_mesh_node(model, 901 + k, 0.0, 0.0, k * 100.0);
+	}
+	for(int k = 0; k < 2; k++) {
+		int base = 101 + 100 * k;
+		int hexa[8] = {base, base + 1, base + 11, base + 10, base + 100, base + 101, base + 111, base + 110};
+		add_mesh_element(model, 11 + k, ELEMENT_HEXA, 1, hexa);
+		int beam[2] = {901 + k, 902 + k};
+		add_mesh_element(model, 21 + k, ELEMENT_BEAM, 1, beam);
+		int line[4] = {901 + k, 902 + k, base, base + 100};
+		add_mesh_element(model, 31 + k, ELEMENT_LINE, 1, line);
+	}
+	add_mesh_step_card(model, STEP_CARD_FN, 901, 3, 0, 0, 1.0);
+
+	BondZoneStatistics statistics;
+	if(restrict_bond_zone(model, 100.0, 200.0, &statistics) == EXIT_SUCCESS) {
+		printf("nodes %d, elements %d, LINE %d (-%d), merged %d, remapped %d\n",
+			model->node_num, model->element_num, statistics.line_num, statistics.removed_line_num,
+			statistics.merged_node_num, statistics.remapped_card_num);
+		for(int e = 0; e < model->element_num; e++) {
+			if(model->element_kind[e] == ELEMENT_BEAM) {
+				int b = e * ELEMENT_NODE_MAX;
+				printf("BEAM %d: %d %d\n", model->element_id[e], model->connectivity[b], model->connectivity[b + 1]);
+			}
+		}
+		printf("FN node %d\n", model->step_card[0].id);
+	}
+	free_mesh_model(model);
+}
+
+#include "loading_protocol.h"
+/**
+ * 部材角の段から変位履歴を作り、最大の変位と最後の変位(0)、STEP カードの数を確認する。
+ */
+void test_loading_protocol() {
+	printf("--- 'test_loading_protocol' ---\n");
+	LoadingLevel levels[2] = {
+		{0.0025, 2, 10},
+		{0.01, 1, 15}
+	};
+	LoadingProtocol* protocol = create_loading_protocol();
+	if(protocol == NULL) {
+		printf("LoadingProtocol allocation failed\n");
+		return;
+	}
+	if(build_loading_protocol(levels, 2, 2250.0, 2, protocol) == EXIT_SUCCESS) {
+		printf("steps %d - %d, %d peaks, %d segments\n", protocol->first_step, protocol->last_step, protocol->peak_num, protocol->segment_num);
+		int position = 0;
+		int previous = 0;
+		for(int s = 0; s < protocol->segment_num; s++) {
+			for(int k = 0; k < protocol->segment[s].step_num; k++) {
+				int next = position + protocol->segment[s].increment;
+				// 向きが変わる点(最大の変位)
+				if((next - position) * (position - previous) < 0) {
+					printf(" peak %d", position);
+				}
+				previous = position;
+				position = next;
+			}
+		}
+		printf("\nfinal %d\n", position);
+	}
+
+	// 多数の繰り返しでもカードの数は段の数で決まる
+	LoadingLevel many[1] = {{0.01, 2000, 10}};
+	if(build_loading_protocol(many, 1, 2250.0, 2, protocol) == EXIT_SUCCESS) {
+		printf("steps %d - %d, %d segments\n", protocol->first_step, protocol->last_step, protocol->segment_num);
+	}
+	many[0].cycles = 3000;
+	printf("too many steps: %d\n", build_loading_protocol(many, 1, 2250.0, 2, protocol));
+	free_loading_protocol(protocol);
+}
+
+#include <math.h>
+void test_adaptive_loading_protocol() {
+	printf("--- 'test_adaptive_loading_protocol' ---\n");
+	LoadingLevel levels[3] = {
+		{0.0025, 2, 10},
+		{0.01, 1, 15},
+		{0.03, 1, 20}
+	};
+	double yield_drift = estimate_yield_drift(400.0, 2250.0);
+	printf("yield drift %.5f\n", yield_drift);
+	LoadingProtocol* protocol = create_loading_protocol();
+	if(protocol == NULL) {
+		printf("LoadingProtocol allocation failed\n");
+		return;
+	}
+	if(build_loading_protocol(levels, 3, 2250.0, 2, protocol) == EXIT_SUCCESS) {
+		printf("uniform: steps %d - %d, %d segments\n", protocol->first_step, protocol->last_step, protocol->segment_num);
+	}
+	if(build_adaptive_loading_protocol(levels, 3, 2250.0, yield_drift, 2, protocol) == EXIT_SUCCESS) {
+		printf("adaptive: steps %d - %d, %d peaks, %d segments\n", protocol->first_step, protocol->last_step, protocol->peak_num, protocol->segment_num);
+		// 初めて通るひび割れ(0.5 - 1.5 倍)、降伏(0.7 - 1.3 倍)の範囲にかかるステップは細かい増分であること
+		int yield = (int)llround(yield_drift * 2250.0 / 2.0 * LOADING_DISP_SCALE);
+		int crack = (int)llround(LOADING_CRACK_RATIO * yield_drift * 2250.0 / 2.0 * LOADING_DISP_SCALE);
+		int fine = (int)llround((double)yield / LOADING_STEPS_TO_YIELD);
+		int window[2][2] = {{crack / 2, 3 * crack / 2}, {7 * yield / 10, 13 * yield / 10}};
+		int window_steps[2] = {0, 0};
+		int window_coarse[2] = {0, 0};
+		int position = 0;
+		int previous = 0;
+		int smallest = 0;
+		int largest = 0;
+		int max_reached = 0;
+		for(int s = 0; s < protocol->segment_num; s++) {
+			int size = abs(protocol->segment[s].increment);
+			if(smallest == 0 || size < smallest) smallest = size;
+			if(size > largest) largest = size;
+			for(int k = 0; k < protocol->segment[s].step_num; k++) {
+				int next = position + protocol->segment[s].increment;
+				if((next - position) * (position - previous) < 0) {
+					printf(" peak %d", position);
+				}
+				if(abs(next) > max_reached) {
+					for(int w = 0; w < 2; w++) {
+						if(abs(next) > window[w][0] && abs(position) < window[w][1]) {
+							window_steps[w]++;
+							if(size > fine) window_coarse[w]++;
+						}
+					}
+					max_reached = abs(next);
+				}
+				previous = position;
+				position = next;
+			}
+		}
+		printf("\nfinal %d, increment %d - %d\n", position, smallest, largest);
+		printf("crack %d - %d: %d steps, %d coarse\n", window[0][0], window[0][1], window_steps[0], window_coarse[0]);
+		printf("yield %d - %d: %d steps, %d coarse\n", window[1][0], window[1][1], window_steps[1], window_coarse[1]);
+	}
+	printf("invalid yield drift: %d\n", build_adaptive_loading_protocol(levels, 3, 2250.0, 0.0, 2, protocol));
+	free_loading_protocol(protocol);
+}
+
+#include <string.h>
+#include "ffi_restart.h"
+void test_restart_runs() {
+	printf("--- 'test_restart_runs' ---\n");
+	LoadingLevel levels[1] = {{0.01, 1, 100}};
+	LoadingProtocol* protocol = create_loading_protocol();
+	if(protocol == NULL || build_loading_protocol(levels, 1, 2250.0, 2, protocol) != EXIT_SUCCESS) {
+		printf("build_loading_protocol failed\n");
+		free_loading_protocol(protocol);
+		return;
+	}
+	int before = protocol->segment_num;
+	int final_before = 0;
+	for(int s = 0; s < protocol->segment_num; s++) {
+		final_before += protocol->segment[s].step_num * protocol->segment[s].increment;
+	}
+	// 区切りが遠いため区間を分ける
+	int restart_step[6] = {0};
+	if(plan_restart_steps(protocol, 6, restart_step) == EXIT_SUCCESS) {
+		int final_after = 0;
+		for(int s = 0; s < protocol->segment_num; s++) {
+			final_after += protocol->segment[s].step_num * protocol->segment[s].increment;
+		}
+		printf("restart steps");
+		for(int k = 0; k < 6; k++) {
+			printf(" %d", restart_step[k]);
+		}
+		printf(", segments %d -> %d, final %d -> %d\n", before, protocol->segment_num, final_before, final_after);
+	}
+	printf("too many runs: %d\n", plan_restart_steps(protocol, protocol->last_step, restart_step));
+
+	char name[FFI_RESTART_NAME_MAX];
+	restart_file_name("../run_analysis/out.ffi", 2, name, sizeof(name));
+	printf("%s\n", name);
+	restart_file_name("out", 3, name, sizeof(name));
+	printf("%s\n", name);
+
+	// EXEC と OUT(その回の範囲に切り詰め、再開点は LEVEL=(3))が異なる ffi
+	FILE* f = fopen("../run_analysis/restart.ffi", "w");
+	if(f != NULL) {
+		print_head_template(f, protocol->last_step, 101, 'x', 101, 'x');
+		print_loading_protocol(f, protocol, (int[]){101, 102}, NULL);
+		fprintf(f, "\nEND\n");
+		fclose(f);
+		if(write_restart_runs("../run_analysis/restart.ffi", restart_step, 6) == EXIT_SUCCESS) {
+			char line[FFI_RESTART_LINE_MAX];
+			for(int k = 1; k <= 6; k++) {
+				restart_file_name("../run_analysis/restart.ffi", k, name, sizeof(name));
+				FILE* run = fopen(name, "r");
+				while(run != NULL && fgets(line, sizeof(line), run) != NULL) {
+					if(strncmp(line, "EXEC :", 6) == 0 || strncmp(line, " OUT :", 6) == 0) {
+						printf("%s", line);
+					}
+				}
+				if(run != NULL) fclose(run);
+			}
+		}
+	}
+	free_loading_protocol(protocol);
+}
+
+#include "output_plan.h"
+void test_output_plan() {
+	printf("--- 'test_output_plan' ---\n");
+	LoadingLevel levels[2] = {
+		{0.0025, 2, 10},
+		{0.01, 1, 15}
+	};
+	LoadingProtocol* protocol = create_loading_protocol();
+	OutputPlan* plan = create_output_plan();
+	if(protocol == NULL || plan == NULL || build_loading_protocol(levels, 2, 2250.0, 2, protocol) != EXIT_SUCCESS) {
+		printf("build_loading_protocol failed\n");
+		free_loading_protocol(protocol);
+		free_output_plan(plan);
+		return;
+	}
+	int node_num = 1000;
+	int element_num = 800;
+	double step_all = estimate_output_step_bytes(node_num, element_num, OUTPUT_LEVEL_ALL);
+	double step_post = estimate_output_step_bytes(node_num, element_num, OUTPUT_LEVEL_POST);
+	printf("step bytes: all %.0f, post %.0f\n", step_all, step_post);
+	// 全て、key + 間隔、key だけ(POST)、予算を超える
+	double budgets[4] = {1.0e9, 30.0 * step_all, 20.0 * step_post, 1.0};
+	for(int b = 0; b < 4; b++) {
+		if(plan_output(protocol, node_num, element_num, budgets[b], plan) != EXIT_SUCCESS) {
+			continue;
+		}
+		printf("budget %.0f: key %d (LEVEL=%d), sparse %d every %d, %d OUT, bytes %.0f (all %.0f)\n", budgets[b], plan->key_step_num,
+			plan->key_level, plan->sparse_step_num, plan->sparse_interval, plan->range_num, plan->bytes, plan->full_bytes);
+	}
+	// key + 間隔の OUT
+	plan_output(protocol, node_num, element_num, 30.0 * step_all, plan);
+	print_loading_protocol(stdout, protocol, (int[]){101, 102}, plan);
+	free_output_plan(plan);
+	free_loading_protocol(protocol);
+}
+
+#include <time.h>
+#include "fiber_section.h"
+void test_fiber_section() {
+	printf("--- 'test_fiber_section' ---\n");
+	JsonData* data = new_json_data();
+	if(data == NULL || json_parser("../test/test1.json", data) != JSON_PARSER_SUCCESS) {
+		printf("json_parser failed\n");
+		free_json_data(data);
+		return;
+	}
+	SectionMaterial material;
+	initialize_section_material(&material);
+	FiberSection* section = create_fiber_section(data, &material);
+	if(section == NULL) {
+		free_json_data(data);
+		return;
+	}
+	printf("%d rebars, %d concrete fibers, N %.1f kN\n", section->rebar_num, section->concrete_num, section->axial_force / 1.0e3);
+	// 曲率 0: 一様な圧縮、曲げモーメント 0
+	double axial = 0.0;
+	double moment = 0.0;
+	section_force(section, 0.001, 0.0, &axial, &moment);
+	printf("uniform 0.001: N %.1f kN, M %.3f kN*m\n", axial / 1.0e3, moment / 1.0e6);
+	free_fiber_section(section);
+
+	SectionScreening screening;
+	clock_t start = clock();
+	int runs = 100;
+	for(int r = 0; r < runs; r++) {
+		screen_section(data, &material, &screening);
+	}
+	double elapsed_us = (double)(clock() - start) / CLOCKS_PER_SEC * 1.0e6 / runs;
+	print_section_screening(&screening, elapsed_us);
+	// M-φ は降伏の後も増え、終局まで正
+	int monotonic = 1;
+	for(int k = 1; k < screening.column.point_num; k++) {
+		if(screening.column.curvature[k] <= screening.column.curvature[k - 1] || screening.column.moment[k] <= 0.0) {
+			monotonic = 0;
+		}
+	}
+	printf("curvature increasing: %d, yield < max: %d\n", monotonic, screening.column.yield_moment < screening.column.max_moment);
+
+	// 主筋を増やすと降伏モーメントが増える
+	double yield_moment = screening.column.yield_moment;
+	material.rebar_area = 2.0 * FIBER_REBAR_AREA;
+	screen_section(data, &material, &screening);
+	printf("double rebar area: My %.1f -> %.1f kN*m\n", yield_moment / 1.0e6, screening.column.yield_moment / 1.0e6);
+
+	// 軸力が圧縮耐力を超える
+	material.axial_stress = 100.0;
+	printf("axial force over capacity: %d\n", screen_section(data, &material, &screening));
+	free_json_data(data);
+}
+
+#include "simd.h"
+/**
+ * コンパイルした SIMD の経路(SIMD_WIDTH)の演算をスカラーの計算と比べる。make SIMD=avx2 の場合は AVX2 の経路を通る。
+ */
+void test_simd() {
+	printf("--- 'test_simd' ---\n");
+	enum { N = 16 };
+	double a[N], b[N], c[N], result[N];
+	for(int i = 0; i < N; i++) {
+		a[i] = 0.5 * i - 3.0;
+		b[i] = 1.0 + 0.25 * i;
+		c[i] = 2.0 - 0.125 * i * i;
+	}
+	double max_difference = 0.0;
+	for(int i = 0; i < N; i += SIMD_WIDTH) {
+		simd_double x = simd_load(&a[i]);
+		simd_double y = simd_load(&b[i]);
+		simd_double z = simd_load(&c[i]);
+		simd_double r = simd_fmadd(x, y, z);
+		r = simd_add(r, simd_div(simd_sqrt(simd_abs(z)), y));
+		r = simd_sub(r, simd_mul(simd_min(x, z), simd_max(y, simd_set1(2.0))));
+		simd_store(&result[i], r);
+	}
+	for(int i = 0; i < N; i++) {
+		double expected = a[i] * b[i] + c[i] + sqrt(fabs(c[i])) / b[i] - fmin(a[i], c[i]) * fmax(b[i], 2.0);
+		double difference = fabs(result[i] - expected);
+		if(difference > max_difference) max_difference = difference;
+	}
+	printf("SIMD_WIDTH %d: max difference %s\n", SIMD_WIDTH, max_difference < 1e-12 ? "< 1e-12" : "too large");
+
+	// 3次元ベクトルの内積、外積
+	double x[N], y[N], z[N], dot[N], cross[N];
+	for(int i = 0; i < N; i++) {
+		x[i] = i;
+		y[i] = 1.0;
+		z[i] = -0.5 * i;
+	}
+	for(int i = 0; i < N; i += SIMD_WIDTH) {
+		simd_vec3 u = simd_vec3_load(&x[i], &y[i], &z[i]);
+		simd_vec3 v = simd_vec3_load(&y[i], &z[i], &x[i]);
+		simd_store(&dot[i], simd_vec3_dot(u, v));
+		simd_store(&cross[i], simd_vec3_cross(u, v).z);
+	}
+	int mismatch = 0;
+	for(int i = 0; i < N; i++) {
+		if(fabs(dot[i] - (x[i] * y[i] + y[i] * z[i] + z[i] * x[i])) > 1e-12) mismatch++;
+		if(fabs(cross[i] - (x[i] * z[i] - y[i] * y[i])) > 1e-12) mismatch++;
+	}
+	printf("vec3 mismatch %d\n", mismatch);
+}
+
+/**
+ * test_min の出力を対称、逆対称の1/4モデルにし、対称性が異なる荷重(対称で水平方向の強制変位、
+ * 逆対称で軸力)だけが除かれ、対応表に書き込まれることを確認する。
+ */
+void test_quarter_model() {
+	printf("--- 'test_quarter_model' ---\n");
+	for(int kind = SYMMETRY_SYMMETRIC; kind <= SYMMETRY_ANTISYMMETRIC; kind++) {
+		ModelingRcsOption option;
+		initialize_modeling_rcs_option(&option);
+		option.scope = (kind == SYMMETRY_SYMMETRIC) ? MODEL_SCOPE_QUARTER : MODEL_SCOPE_QUARTER_ANTISYMMETRIC;
+		option.symmetry_map_file_name = "../run_analysis/quarter.csv";
+		if(modeling_rcs_with_option("../test/test_min.json", "../run_analysis/quarter.ffi", &option) != MODELING_RCS_SUCCESS) {
+			printf("modeling_rcs --quarter %s failed\n", kind == SYMMETRY_SYMMETRIC ? "sym" : "anti");
+			continue;
+		}
+		MeshModel* model = create_mesh_model();
+		if(model == NULL || read_mesh_model("../run_analysis/quarter.ffi", model) != MESH_MODEL_SUCCESS) {
+			printf("reading quarter.ffi failed\n");
+			if(model != NULL) free_mesh_model(model);
+			continue;
+		}
+		int fn_num = 0;
+		int ue_num = 0;
+		for(int s = 0; s < model->step_card_num; s++) {
+			if(model->step_card[s].kind == STEP_CARD_FN) fn_num++;
+			if(model->step_card[s].kind == STEP_CARD_UE) ue_num++;
+		}
+		printf("%s: nodes %d, elements %d, FN %d, UE %d\n", kind == SYMMETRY_SYMMETRIC ? "symmetric" : "antisymmetric",
+			model->node_num, model->element_num, fn_num, ue_num);
+		free_mesh_model(model);
+
+		FILE* f = fopen("../run_analysis/quarter.csv", "r");
+		if(f == NULL) {
+			printf("quarter.csv is missing\n");
+			continue;
+		}
+		char line[256];
+		int fn_row = 0;
+		int ue_row = 0;
+		while(fgets(line, sizeof(line), f) != NULL) {
+			if(strncmp(line, "fn,", 3) == 0) fn_row++;
+			if(strncmp(line, "ue,", 3) == 0) ue_row++;
+		}
+		fclose(f);
+		printf("symmetry map: fn %d, ue %d\n", fn_row, ue_row);
+	}
+}